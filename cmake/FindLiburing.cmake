@@ -0,0 +1,39 @@
+# Copyright (c) 2016 Hartmut Kaiser
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+find_package(PkgConfig)
+pkg_check_modules(PC_LIBURING QUIET liburing)
+
+find_path(LIBURING_INCLUDE_DIR liburing.h
+  HINTS
+  ${LIBURING_ROOT} ENV LIBURING_ROOT
+  ${PC_LIBURING_INCLUDEDIR}
+  ${PC_LIBURING_INCLUDE_DIRS}
+  PATH_SUFFIXES include)
+
+find_library(LIBURING_LIBRARY NAMES uring liburing
+  HINTS
+    ${LIBURING_ROOT} ENV LIBURING_ROOT
+    ${PC_LIBURING_LIBDIR}
+    ${PC_LIBURING_LIBRARY_DIRS}
+  PATH_SUFFIXES lib lib64)
+
+set(LIBURING_LIBRARIES ${LIBURING_LIBRARY} CACHE INTERNAL "")
+set(LIBURING_INCLUDE_DIRS ${LIBURING_INCLUDE_DIR} CACHE INTERNAL "")
+
+find_package_handle_standard_args(Liburing DEFAULT_MSG
+  LIBURING_LIBRARY LIBURING_INCLUDE_DIR)
+
+foreach(v LIBURING_ROOT)
+  get_property(_type CACHE ${v} PROPERTY TYPE)
+  if(_type)
+    set_property(CACHE ${v} PROPERTY ADVANCED 1)
+    if("x${_type}" STREQUAL "xUNINITIALIZED")
+      set_property(CACHE ${v} PROPERTY TYPE PATH)
+    endif()
+  endif()
+endforeach()
+
+mark_as_advanced(LIBURING_ROOT LIBURING_LIBRARY LIBURING_INCLUDE_DIR)
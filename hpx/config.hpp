@@ -489,6 +489,20 @@
 #endif
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// Size of the small object buffer (in bytes) of util::function and
+// util::unique_function. Larger function objects are allocated on the heap.
+#if !defined(HPX_FUNCTION_STORAGE_SIZE)
+#  define HPX_FUNCTION_STORAGE_SIZE (3 * sizeof(void*))
+#endif
+
+// Size of the small object buffer (in bytes) of the functions run by HPX
+// threads and of the continuations attached to futures. These usually bind
+// a future or an intrusive_ptr and a couple of arguments.
+#if !defined(HPX_THREAD_FUNCTION_STORAGE_SIZE)
+#  define HPX_THREAD_FUNCTION_STORAGE_SIZE (8 * sizeof(void*))
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 #if defined(HPX_MSVC)
 #   define HPX_NOINLINE __declspec(noinline)
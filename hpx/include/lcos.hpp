@@ -13,10 +13,15 @@
 #include <hpx/lcos/packaged_action.hpp>
 
 #include <hpx/lcos/barrier.hpp>
+#include <hpx/lcos/split_phase_barrier.hpp>
 #include <hpx/lcos/latch.hpp>
 #include <hpx/lcos/queue.hpp>
+#include <hpx/lcos/channel.hpp>
 #include <hpx/lcos/reduce.hpp>
 #include <hpx/lcos/gather.hpp>
+#include <hpx/lcos/all_gather.hpp>
+#include <hpx/lcos/all_reduce.hpp>
+#include <hpx/lcos/all_to_all.hpp>
 
 #include <hpx/include/local_lcos.hpp>
 #include <hpx/include/async.hpp>
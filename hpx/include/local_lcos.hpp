@@ -9,12 +9,14 @@
 
 #include <hpx/hpx_fwd.hpp>
 #include <hpx/lcos/local/barrier.hpp>
+#include <hpx/lcos/local/big_reader_mutex.hpp>
 #include <hpx/lcos/local/condition_variable.hpp>
 #include <hpx/lcos/local/counting_semaphore.hpp>
 #include <hpx/dataflow.hpp>
 #include <hpx/lcos/local/event.hpp>
 #include <hpx/lcos/local/latch.hpp>
 #include <hpx/lcos/local/mutex.hpp>
+#include <hpx/lcos/local/queue_mutex.hpp>
 #include <hpx/lcos/local/shared_mutex.hpp>
 #include <hpx/lcos/local/recursive_mutex.hpp>
 
@@ -25,6 +27,7 @@
 #include <hpx/lcos/local/and_gate.hpp>
 #include <hpx/lcos/local/trigger.hpp>
 #include <hpx/lcos/local/receive_buffer.hpp>
+#include <hpx/lcos/local/channel.hpp>
 
 #endif
 
@@ -8,8 +8,10 @@
 
 #include <hpx/runtime/threads/thread_executor.hpp>
 #include <hpx/runtime/threads/executors/default_executor.hpp>
+#include <hpx/runtime/threads/executors/deadline_executor.hpp>
 #include <hpx/runtime/threads/executors/thread_pool_executors.hpp>
 #include <hpx/runtime/threads/executors/thread_pool_os_executors.hpp>
+#include <hpx/runtime/threads/executors/named_pool_executors.hpp>
 #include <hpx/runtime/threads/executors/service_executors.hpp>
 
 #endif
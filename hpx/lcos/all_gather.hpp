@@ -0,0 +1,401 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_gather.hpp
+
+#if !defined(HPX_LCOS_ALL_GATHER_HPP)
+#define HPX_LCOS_ALL_GATHER_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// Gather a set of values from all localities and distribute them to
+    /// all of them
+    ///
+    /// This function collects the values supplied by all call sites
+    /// operating on the given base name. The call sites on the same locality
+    /// collect their values locally first, the localities exchange their
+    /// values using recursive doubling (which requires only log2(N)
+    /// communication steps for N localities).
+    ///
+    /// \param  basename    The base name identifying the all_gather operation
+    /// \param  result      A future referring to the value to contribute
+    ///                     from this call site.
+    /// \param  num_sites   The number of participating localities (default:
+    ///                     all localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_gather operation performed on the
+    ///                     given base name. This is optional and needs to be
+    ///                     supplied only if the all_gather operation on the
+    ///                     given base name has to be performed more than once.
+    /// \param num_local_sites The number of call sites on each locality
+    ///                     (for instance one for each worker thread). This
+    ///                     value is optional and defaults to one.
+    /// \param this_local_site The sequence number of this call site on its
+    ///                     locality (in the range [0, num_local_sites)). This
+    ///                     value is optional and defaults to zero.
+    /// \param this_site    The sequence number of this locality in the range
+    ///                     [0, num_sites). This value is optional and defaults
+    ///                     to whatever hpx::get_locality_id() returns. If it
+    ///                     is supplied by one locality, it has to be supplied
+    ///                     by all of them.
+    ///
+    /// \returns    This function returns a future holding a vector with all
+    ///             gathered values, the value of call site \a l on site
+    ///             \a s is stored at position s * num_local_sites + l. It will
+    ///             become ready once the all_gather operation has been
+    ///             completed.
+    ///
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_gather(char const* basename, hpx::future<T> result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t num_local_sites = 1, std::size_t this_local_site = 0,
+        std::size_t this_site = std::size_t(-1));
+
+    /// Gather a set of values from all localities and distribute them to
+    /// all of them
+    ///
+    /// This function collects the values supplied by all call sites
+    /// operating on the given base name. The call sites on the same locality
+    /// collect their values locally first, the localities exchange their
+    /// values using recursive doubling (which requires only log2(N)
+    /// communication steps for N localities).
+    ///
+    /// \param  basename    The base name identifying the all_gather operation
+    /// \param  result      The value to contribute from this call site.
+    /// \param  num_sites   The number of participating localities (default:
+    ///                     all localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_gather operation performed on the
+    ///                     given base name. This is optional and needs to be
+    ///                     supplied only if the all_gather operation on the
+    ///                     given base name has to be performed more than once.
+    /// \param num_local_sites The number of call sites on each locality
+    ///                     (for instance one for each worker thread). This
+    ///                     value is optional and defaults to one.
+    /// \param this_local_site The sequence number of this call site on its
+    ///                     locality (in the range [0, num_local_sites)). This
+    ///                     value is optional and defaults to zero.
+    /// \param this_site    The sequence number of this locality in the range
+    ///                     [0, num_sites). This value is optional and defaults
+    ///                     to whatever hpx::get_locality_id() returns. If it
+    ///                     is supplied by one locality, it has to be supplied
+    ///                     by all of them.
+    ///
+    /// \returns    This function returns a future holding a vector with all
+    ///             gathered values, the value of call site \a l on site
+    ///             \a s is stored at position s * num_local_sites + l. It will
+    ///             become ready once the all_gather operation has been
+    ///             completed.
+    ///
+    template <typename T>
+    hpx::future<std::vector<typename std::decay<T>::type> >
+    all_gather(char const* basename, T && result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t num_local_sites = 1, std::size_t this_local_site = 0,
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        struct all_gather_tag {};
+
+        template <typename T>
+        struct all_gather_action
+        {
+            typedef typename collective_mailbox_action<
+                    std::vector<T>, all_gather_tag
+                >::type type;
+        };
+
+        // the state shared by all call sites on the same locality
+        template <typename T>
+        struct all_gather_state
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            all_gather_state()
+              : arrived_(0), result_(promise_.get_future())
+            {}
+
+            mutex_type mtx_;
+            std::size_t arrived_;
+            std::vector<T> values_;
+            lcos::local::promise<std::vector<T> > promise_;
+            hpx::shared_future<std::vector<T> > result_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // While exchanging values using recursive doubling, a site sends the
+        // values of the 'count' sites starting at 'first' followed by the
+        // values of their surplus partner sites (if any).
+        template <typename T>
+        std::vector<T> all_gather_collect(std::vector<T> const& data,
+            std::size_t first, std::size_t count, std::size_t p2,
+            std::size_t num_sites, std::size_t m)
+        {
+            std::vector<T> values;
+            values.reserve(2 * count * m);
+
+            for (std::size_t s = first; s != first + count; ++s)
+            {
+                values.insert(values.end(),
+                    data.begin() + s * m, data.begin() + (s + 1) * m);
+            }
+            for (std::size_t s = first + p2; s < first + count + p2; ++s)
+            {
+                if (s >= num_sites)
+                    break;
+                values.insert(values.end(),
+                    data.begin() + s * m, data.begin() + (s + 1) * m);
+            }
+            return values;
+        }
+
+        template <typename T>
+        void all_gather_place(std::vector<T>& data, std::vector<T> values,
+            std::size_t first, std::size_t count, std::size_t p2,
+            std::size_t num_sites, std::size_t m)
+        {
+            typename std::vector<T>::iterator it = values.begin();
+
+            for (std::size_t s = first; s != first + count; ++s)
+            {
+                std::move(it, it + m, data.begin() + s * m);
+                it += m;
+            }
+            for (std::size_t s = first + p2; s < first + count + p2; ++s)
+            {
+                if (s >= num_sites)
+                    break;
+                std::move(it, it + m, data.begin() + s * m);
+                it += m;
+            }
+            HPX_ASSERT(it == values.end());
+        }
+
+        // Exchange the values of all localities using recursive doubling
+        // (see all_reduce_sites).
+        template <typename T>
+        std::vector<T> all_gather_sites(std::string const& name,
+            std::string const& sites, std::vector<T> values,
+            std::size_t num_sites, std::size_t this_site)
+        {
+            typedef std::vector<T> values_type;
+
+            if (num_sites < 2)
+                return values;
+
+            register_site(sites, this_site);
+
+            std::size_t const m = values.size();
+            std::size_t const p2 = collective_lower_power_of_two(num_sites);
+            std::size_t const extra = num_sites - p2;
+            std::size_t const last_step = std::size_t(-1);
+
+            if (this_site >= p2)
+            {
+                send_to_site<all_gather_tag>(name, sites, 0, this_site - p2, values);
+                return receive_from_site<all_gather_tag, values_type>(
+                    name, last_step).get();
+            }
+
+            std::vector<T> data(num_sites * m);
+            std::move(values.begin(), values.end(),
+                data.begin() + this_site * m);
+
+            if (this_site < extra)
+            {
+                values_type other = receive_from_site<
+                        all_gather_tag, values_type
+                    >(name, 0).get();
+                std::move(other.begin(), other.end(),
+                    data.begin() + (this_site + p2) * m);
+            }
+
+            std::size_t step = 1;
+            for (std::size_t d = 1; d < p2; d <<= 1, ++step)
+            {
+                std::size_t peer = this_site ^ d;
+                send_to_site<all_gather_tag>(name, sites, step, peer,
+                    all_gather_collect(data, this_site & ~(d - 1), d, p2,
+                        num_sites, m));
+
+                all_gather_place(data,
+                    receive_from_site<all_gather_tag, values_type>(
+                        name, step).get(),
+                    peer & ~(d - 1), d, p2, num_sites, m);
+            }
+
+            if (this_site < extra)
+                send_to_site<all_gather_tag>(name, sites, last_step,
+                    this_site + p2, data);
+
+            return data;
+        }
+
+        template <typename T>
+        void all_gather_set_result(
+            boost::shared_ptr<all_gather_state<T> > state,
+            hpx::future<std::vector<T> > f)
+        {
+            try {
+                state->promise_.set_value(f.get());
+            }
+            catch (...) {
+                state->promise_.set_exception(boost::current_exception());
+            }
+        }
+
+        template <typename T>
+        std::vector<T> all_gather_get_result(
+            hpx::shared_future<std::vector<T> > f)
+        {
+            return f.get();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<std::vector<typename util::decay<T>::type> >
+    all_gather(char const* basename, T && result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t num_local_sites = 1, std::size_t this_local_site = 0,
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<T>::type value_type;
+        typedef std::vector<value_type> result_type;
+
+        if (num_local_sites == 0)
+            num_local_sites = 1;
+
+        if (this_local_site >= num_local_sites)
+        {
+            return hpx::make_exceptional_future<result_type>(
+                HPX_GET_EXCEPTION(bad_parameter, "hpx::lcos::all_gather",
+                    "the local site number must be smaller than the number "
+                    "of local sites"));
+        }
+
+        if (num_sites == std::size_t(-1))
+            num_sites = hpx::get_num_localities_sync();
+
+        std::string sites(detail::collective_sites_name(
+            "/all_gather", basename, this_site != std::size_t(-1)));
+        if (this_site == std::size_t(-1))
+            this_site = hpx::get_locality_id();
+
+        if (this_site >= num_sites)
+        {
+            return hpx::make_exceptional_future<result_type>(
+                HPX_GET_EXCEPTION(bad_parameter, "hpx::lcos::all_gather",
+                    "the site number must be smaller than the number of "
+                    "sites"));
+        }
+
+        std::string name(
+            detail::collective_name("/all_gather", basename, generation));
+
+        if (num_local_sites == 1)
+        {
+            return hpx::async(&detail::all_gather_sites<value_type>,
+                std::move(name), std::move(sites),
+                result_type(1, std::forward<T>(result)), num_sites,
+                this_site);
+        }
+
+        // collect the values of all call sites on this locality first
+        typedef detail::all_gather_state<value_type> state_type;
+        typedef detail::local_sites_registry<state_type> registry_type;
+
+        boost::shared_ptr<state_type> state =
+            registry_type::get().find(name);
+
+        bool last = false;
+        {
+            std::lock_guard<typename state_type::mutex_type> l(state->mtx_);
+            if (state->values_.empty())
+                state->values_.resize(num_local_sites);
+            state->values_[this_local_site] = std::forward<T>(result);
+            last = (++state->arrived_ == num_local_sites);
+        }
+
+        if (last)
+        {
+            registry_type::get().remove(name);
+
+            using util::placeholders::_1;
+            hpx::async(&detail::all_gather_sites<value_type>,
+                std::move(name), std::move(sites), std::move(state->values_),
+                num_sites, this_site
+            ).then(util::bind(
+                &detail::all_gather_set_result<value_type>, state, _1));
+        }
+
+        return state->result_.then(
+            &detail::all_gather_get_result<value_type>);
+    }
+
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_gather(char const* basename, hpx::future<T> result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t num_local_sites = 1, std::size_t this_local_site = 0,
+        std::size_t this_site = std::size_t(-1))
+    {
+        std::string name(basename);
+        return result.then(
+            [=](hpx::future<T> f)
+            {
+                return all_gather(name.c_str(), f.get(), num_sites,
+                    generation, num_local_sites, this_local_site, this_site);
+            });
+    }
+}}
+
+#define HPX_REGISTER_ALL_GATHER_DECLARATION(Value, name)                      \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::detail::all_gather_action<Value>::type,                    \
+        BOOST_PP_CAT(all_gather_action_, name))                               \
+    /**/
+
+#define HPX_REGISTER_ALL_GATHER(Value, name)                                  \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::detail::all_gather_action<Value>::type,                    \
+        BOOST_PP_CAT(all_gather_action_, name))                               \
+    /**/
+
+#endif // DOXYGEN
+#endif
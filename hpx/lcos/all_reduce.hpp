@@ -0,0 +1,338 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_reduce.hpp
+
+#if !defined(HPX_LCOS_ALL_REDUCE_HPP)
+#define HPX_LCOS_ALL_REDUCE_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// Reduce a set of values from all localities and distribute the result
+    /// to all of them
+    ///
+    /// This function combines the values supplied by all call sites
+    /// operating on the given base name using the given reduction operation.
+    /// The call sites on the same locality combine their values locally
+    /// first, the localities combine their partial results using recursive
+    /// doubling (which requires only log2(N) communication steps for N
+    /// localities).
+    ///
+    /// \param  basename    The base name identifying the all_reduce operation
+    /// \param  result      A future referring to the value to contribute to
+    ///                     the reduction from this call site.
+    /// \param  op          The (associative and commutative) binary
+    ///                     reduction operation.
+    /// \param  num_sites   The number of participating localities (default:
+    ///                     all localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_reduce operation performed on the
+    ///                     given base name. This is optional and needs to be
+    ///                     supplied only if the all_reduce operation on the
+    ///                     given base name has to be performed more than once.
+    /// \param num_local_sites The number of call sites on each locality
+    ///                     (for instance one for each worker thread). This
+    ///                     value is optional and defaults to one.
+    /// \param this_site    The sequence number of this locality in the range
+    ///                     [0, num_sites). This value is optional and defaults
+    ///                     to whatever hpx::get_locality_id() returns. If it
+    ///                     is supplied by one locality, it has to be supplied
+    ///                     by all of them.
+    ///
+    /// \returns    This function returns a future holding the reduced value.
+    ///             It will become ready once the all_reduce operation has
+    ///             been completed.
+    ///
+    template <typename T, typename F>
+    hpx::future<T>
+    all_reduce(char const* basename, hpx::future<T> result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t num_local_sites = 1,
+        std::size_t this_site = std::size_t(-1));
+
+    /// Reduce a set of values from all localities and distribute the result
+    /// to all of them
+    ///
+    /// This function combines the values supplied by all call sites
+    /// operating on the given base name using the given reduction operation.
+    /// The call sites on the same locality combine their values locally
+    /// first, the localities combine their partial results using recursive
+    /// doubling (which requires only log2(N) communication steps for N
+    /// localities).
+    ///
+    /// \param  basename    The base name identifying the all_reduce operation
+    /// \param  result      The value to contribute to the reduction from
+    ///                     this call site.
+    /// \param  op          The (associative and commutative) binary
+    ///                     reduction operation.
+    /// \param  num_sites   The number of participating localities (default:
+    ///                     all localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_reduce operation performed on the
+    ///                     given base name. This is optional and needs to be
+    ///                     supplied only if the all_reduce operation on the
+    ///                     given base name has to be performed more than once.
+    /// \param num_local_sites The number of call sites on each locality
+    ///                     (for instance one for each worker thread). This
+    ///                     value is optional and defaults to one.
+    /// \param this_site    The sequence number of this locality in the range
+    ///                     [0, num_sites). This value is optional and defaults
+    ///                     to whatever hpx::get_locality_id() returns. If it
+    ///                     is supplied by one locality, it has to be supplied
+    ///                     by all of them.
+    ///
+    /// \returns    This function returns a future holding the reduced value.
+    ///             It will become ready once the all_reduce operation has
+    ///             been completed.
+    ///
+    template <typename T, typename F>
+    hpx::future<typename std::decay<T>::type>
+    all_reduce(char const* basename, T && result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t num_local_sites = 1,
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/preprocessor/cat.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        struct all_reduce_tag {};
+
+        template <typename T>
+        struct all_reduce_action
+        {
+            typedef typename collective_mailbox_action<
+                    T, all_reduce_tag
+                >::type type;
+        };
+
+        // the state shared by all call sites on the same locality
+        template <typename T>
+        struct all_reduce_state
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            all_reduce_state()
+              : arrived_(0), has_value_(false),
+                result_(promise_.get_future())
+            {}
+
+            mutex_type mtx_;
+            std::size_t arrived_;
+            bool has_value_;
+            T value_;
+            lcos::local::promise<T> promise_;
+            hpx::shared_future<T> result_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Combine the values of all localities using recursive doubling. If
+        // the number of sites is not a power of two, the surplus sites hand
+        // their value to a partner site first and receive the result from it
+        // at the end. Partial results are always combined in the order of
+        // the sites, which gives the same result everywhere.
+        template <typename T, typename F>
+        T all_reduce_sites(std::string const& name, std::string const& sites,
+            T value, F const& op, std::size_t num_sites, std::size_t this_site)
+        {
+            if (num_sites < 2)
+                return value;
+
+            register_site(sites, this_site);
+
+            std::size_t const p2 = collective_lower_power_of_two(num_sites);
+            std::size_t const extra = num_sites - p2;
+            std::size_t const last_step = std::size_t(-1);
+
+            if (this_site >= p2)
+            {
+                send_to_site<all_reduce_tag>(name, sites, 0, this_site - p2, value);
+                return receive_from_site<all_reduce_tag, T>(name, last_step)
+                    .get();
+            }
+
+            if (this_site < extra)
+            {
+                value = op(value,
+                    receive_from_site<all_reduce_tag, T>(name, 0).get());
+            }
+
+            std::size_t step = 1;
+            for (std::size_t d = 1; d < p2; d <<= 1, ++step)
+            {
+                std::size_t peer = this_site ^ d;
+                send_to_site<all_reduce_tag>(name, sites, step, peer, value);
+
+                T other = receive_from_site<all_reduce_tag, T>(name, step).get();
+                if (peer < this_site)
+                    value = op(other, value);
+                else
+                    value = op(value, other);
+            }
+
+            if (this_site < extra)
+                send_to_site<all_reduce_tag>(name, sites, last_step,
+                    this_site + p2, value);
+
+            return value;
+        }
+
+        template <typename T>
+        void all_reduce_set_result(
+            boost::shared_ptr<all_reduce_state<T> > state, hpx::future<T> f)
+        {
+            try {
+                state->promise_.set_value(f.get());
+            }
+            catch (...) {
+                state->promise_.set_exception(boost::current_exception());
+            }
+        }
+
+        template <typename T>
+        T all_reduce_get_result(hpx::shared_future<T> f)
+        {
+            return f.get();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename F>
+    hpx::future<typename util::decay<T>::type>
+    all_reduce(char const* basename, T && result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t num_local_sites = 1,
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<T>::type result_type;
+        typedef typename util::decay<F>::type reduce_op_type;
+
+        if (num_sites == std::size_t(-1))
+            num_sites = hpx::get_num_localities_sync();
+
+        std::string sites(detail::collective_sites_name(
+            "/all_reduce", basename, this_site != std::size_t(-1)));
+        if (this_site == std::size_t(-1))
+            this_site = hpx::get_locality_id();
+
+        if (this_site >= num_sites)
+        {
+            return hpx::make_exceptional_future<result_type>(
+                HPX_GET_EXCEPTION(bad_parameter, "hpx::lcos::all_reduce",
+                    "the site number must be smaller than the number of "
+                    "sites"));
+        }
+
+        std::string name(
+            detail::collective_name("/all_reduce", basename, generation));
+
+        if (num_local_sites <= 1)
+        {
+            return hpx::async(
+                &detail::all_reduce_sites<result_type, reduce_op_type>,
+                std::move(name), std::move(sites), std::forward<T>(result),
+                reduce_op_type(std::forward<F>(op)), num_sites, this_site);
+        }
+
+        // combine the values of all call sites on this locality first
+        typedef detail::all_reduce_state<result_type> state_type;
+        typedef detail::local_sites_registry<state_type> registry_type;
+
+        boost::shared_ptr<state_type> state =
+            registry_type::get().find(name);
+
+        bool last = false;
+        {
+            std::lock_guard<typename state_type::mutex_type> l(state->mtx_);
+            if (state->has_value_)
+            {
+                state->value_ = op(state->value_, std::forward<T>(result));
+            }
+            else
+            {
+                state->value_ = std::forward<T>(result);
+                state->has_value_ = true;
+            }
+            last = (++state->arrived_ == num_local_sites);
+        }
+
+        if (last)
+        {
+            registry_type::get().remove(name);
+
+            using util::placeholders::_1;
+            hpx::async(
+                &detail::all_reduce_sites<result_type, reduce_op_type>,
+                std::move(name), std::move(sites), std::move(state->value_),
+                reduce_op_type(std::forward<F>(op)), num_sites, this_site
+            ).then(util::bind(
+                &detail::all_reduce_set_result<result_type>, state, _1));
+        }
+
+        return state->result_.then(
+            &detail::all_reduce_get_result<result_type>);
+    }
+
+    template <typename T, typename F>
+    hpx::future<T>
+    all_reduce(char const* basename, hpx::future<T> result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t num_local_sites = 1,
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<F>::type reduce_op_type;
+
+        std::string name(basename);
+        reduce_op_type reduce_op(std::forward<F>(op));
+        return result.then(
+            [=](hpx::future<T> f)
+            {
+                return all_reduce(name.c_str(), f.get(), reduce_op,
+                    num_sites, generation, num_local_sites, this_site);
+            });
+    }
+}}
+
+#define HPX_REGISTER_ALL_REDUCE_DECLARATION(Value, name)                      \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::detail::all_reduce_action<Value>::type,                    \
+        BOOST_PP_CAT(all_reduce_action_, name))                               \
+    /**/
+
+#define HPX_REGISTER_ALL_REDUCE(Value, name)                                  \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::detail::all_reduce_action<Value>::type,                    \
+        BOOST_PP_CAT(all_reduce_action_, name))                               \
+    /**/
+
+#endif // DOXYGEN
+#endif
@@ -0,0 +1,227 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_to_all.hpp
+
+#if !defined(HPX_LCOS_ALL_TO_ALL_HPP)
+#define HPX_LCOS_ALL_TO_ALL_HPP
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// Exchange a set of values between all localities
+    ///
+    /// Each locality sends a separate value to each of the localities
+    /// operating on the given base name. The values are exchanged directly
+    /// between the localities, each locality sends to its neighbors in ring
+    /// order to spread the load.
+    ///
+    /// \param  basename    The base name identifying the all_to_all operation
+    /// \param  result      A future referring to the values to send to the
+    ///                     localities, the value at position \a s is sent to
+    ///                     site \a s.
+    /// \param  num_sites   The number of participating localities (default:
+    ///                     all localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_to_all operation performed on the
+    ///                     given base name. This is optional and needs to be
+    ///                     supplied only if the all_to_all operation on the
+    ///                     given base name has to be performed more than once.
+    /// \param this_site    The sequence number of this locality in the range
+    ///                     [0, num_sites). This value is optional and defaults
+    ///                     to whatever hpx::get_locality_id() returns. If it
+    ///                     is supplied by one locality, it has to be supplied
+    ///                     by all of them.
+    ///
+    /// \returns    This function returns a future holding a vector with the
+    ///             received values, the value at position \a s was sent by
+    ///             site \a s. It will become ready once all values have
+    ///             been received.
+    ///
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_to_all(char const* basename, hpx::future<std::vector<T> > result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+
+    /// Exchange a set of values between all localities
+    ///
+    /// Each locality sends a separate value to each of the localities
+    /// operating on the given base name. The values are exchanged directly
+    /// between the localities, each locality sends to its neighbors in ring
+    /// order to spread the load.
+    ///
+    /// \param  basename    The base name identifying the all_to_all operation
+    /// \param  result      The values to send to the localities, the value
+    ///                     at position \a s is sent to site \a s.
+    /// \param  num_sites   The number of participating localities (default:
+    ///                     all localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_to_all operation performed on the
+    ///                     given base name. This is optional and needs to be
+    ///                     supplied only if the all_to_all operation on the
+    ///                     given base name has to be performed more than once.
+    /// \param this_site    The sequence number of this locality in the range
+    ///                     [0, num_sites). This value is optional and defaults
+    ///                     to whatever hpx::get_locality_id() returns. If it
+    ///                     is supplied by one locality, it has to be supplied
+    ///                     by all of them.
+    ///
+    /// \returns    This function returns a future holding a vector with the
+    ///             received values, the value at position \a s was sent by
+    ///             site \a s. It will become ready once all values have
+    ///             been received.
+    ///
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_to_all(char const* basename, std::vector<T> result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+
+#include <boost/preprocessor/cat.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        struct all_to_all_tag {};
+
+        template <typename T>
+        struct all_to_all_action
+        {
+            typedef typename collective_mailbox_action<
+                    T, all_to_all_tag
+                >::type type;
+        };
+
+        template <typename T>
+        std::vector<T> all_to_all_get_result(
+            hpx::future<std::vector<hpx::future<T> > > f)
+        {
+            std::vector<hpx::future<T> > values = f.get();
+
+            std::vector<T> result;
+            result.reserve(values.size());
+            for (hpx::future<T>& value : values)
+                result.push_back(value.get());
+
+            return result;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_to_all(char const* basename, std::vector<T> result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        if (num_sites == std::size_t(-1))
+            num_sites = hpx::get_num_localities_sync();
+
+        std::string sites(detail::collective_sites_name(
+            "/all_to_all", basename, this_site != std::size_t(-1)));
+        if (this_site == std::size_t(-1))
+            this_site = hpx::get_locality_id();
+
+        if (this_site >= num_sites)
+        {
+            return hpx::make_exceptional_future<std::vector<T> >(
+                HPX_GET_EXCEPTION(bad_parameter, "hpx::lcos::all_to_all",
+                    "the site number must be smaller than the number of "
+                    "sites"));
+        }
+
+        if (result.size() != num_sites)
+        {
+            return hpx::make_exceptional_future<std::vector<T> >(
+                HPX_GET_EXCEPTION(bad_parameter, "hpx::lcos::all_to_all",
+                    "the number of values must be equal to the number of "
+                    "sites"));
+        }
+
+        std::string name(
+            detail::collective_name("/all_to_all", basename, generation));
+
+        if (num_sites > 1)
+            detail::register_site(sites, this_site);
+
+        // the step of each value is the site it was sent from
+        for (std::size_t k = 1; k < num_sites; ++k)
+        {
+            std::size_t dest = (this_site + k) % num_sites;
+            detail::send_to_site<detail::all_to_all_tag>(
+                name, sites, this_site, dest, result[dest]);
+        }
+
+        std::vector<hpx::future<T> > values;
+        values.reserve(num_sites);
+        for (std::size_t s = 0; s != num_sites; ++s)
+        {
+            if (s == this_site)
+            {
+                values.push_back(
+                    hpx::make_ready_future(std::move(result[this_site])));
+            }
+            else
+            {
+                values.push_back(detail::receive_from_site<
+                        detail::all_to_all_tag, T
+                    >(name, s));
+            }
+        }
+
+        return hpx::when_all(std::move(values)).then(
+            &detail::all_to_all_get_result<T>);
+    }
+
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_to_all(char const* basename, hpx::future<std::vector<T> > result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        std::string name(basename);
+        return result.then(
+            [=](hpx::future<std::vector<T> > f)
+            {
+                return all_to_all(name.c_str(), f.get(), num_sites,
+                    generation, this_site);
+            });
+    }
+}}
+
+#define HPX_REGISTER_ALL_TO_ALL_DECLARATION(Value, name)                      \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::detail::all_to_all_action<Value>::type,                    \
+        BOOST_PP_CAT(all_to_all_action_, name))                               \
+    /**/
+
+#define HPX_REGISTER_ALL_TO_ALL(Value, name)                                  \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::detail::all_to_all_action<Value>::type,                    \
+        BOOST_PP_CAT(all_to_all_action_, name))                               \
+    /**/
+
+#endif // DOXYGEN
+#endif
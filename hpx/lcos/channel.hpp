@@ -0,0 +1,150 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_CHANNEL_HPP)
+#define HPX_LCOS_CHANNEL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/include/client.hpp>
+#include <hpx/lcos/server/channel.hpp>
+#include <hpx/runtime/components/derived_component_factory.hpp>
+#include <hpx/runtime/components/server/component.hpp>
+
+#include <boost/preprocessor/cat.hpp>
+#include <boost/preprocessor/stringize.hpp>
+
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos
+{
+    /// The client side representation of a distributed channel. A channel
+    /// passes values between senders and receivers running on any locality,
+    /// see lcos::local::channel.
+    ///
+    /// The component type of each channel instantiation needs to be
+    /// registered using HPX_REGISTER_CHANNEL. As for lcos::queue, the
+    /// operations are named get_value() and set_value() as get() refers to
+    /// the id of the component.
+    template <typename ValueType, typename RemoteType = ValueType>
+    class channel
+      : public components::client_base<
+            channel<ValueType, RemoteType>,
+            lcos::server::channel<ValueType, RemoteType>
+        >
+    {
+        typedef components::client_base<
+                channel, lcos::server::channel<ValueType, RemoteType>
+            > base_type;
+
+    public:
+        channel()
+        {}
+
+        /// Create a client side representation for the existing
+        /// \a server#channel instance with the given global id \a gid.
+        channel(future<id_type> && gid)
+          : base_type(std::move(gid))
+        {}
+
+        ///////////////////////////////////////////////////////////////////////
+        // exposed functionality of this component
+
+        /// Retrieve the next value from the channel. The returned future
+        /// becomes ready as soon as a value is available.
+        future<ValueType> get_value()
+        {
+            typedef typename lcos::server::channel<
+                    ValueType, RemoteType
+                >::get_value_async_action action_type;
+
+            HPX_ASSERT(this->get_gid());
+            return hpx::async<action_type>(this->get_gid());
+        }
+
+        /// Send a value through the channel. The returned future becomes
+        /// ready as soon as the channel has accepted the value.
+        future<void> set_value(RemoteType && val)
+        {
+            typedef typename lcos::server::channel<
+                    ValueType, RemoteType
+                >::set_value_async_action action_type;
+
+            HPX_ASSERT(this->get_gid());
+            return hpx::async<action_type>(this->get_gid(), std::move(val));
+        }
+
+        future<void> set_value(RemoteType const& val)
+        {
+            return set_value(RemoteType(val));
+        }
+
+        /// Close the channel, all receivers waiting for a value are resumed
+        /// with an exception.
+        future<void> close()
+        {
+            typedef lcos::base_lco::set_exception_action action_type;
+
+            HPX_ASSERT(this->get_gid());
+            boost::exception_ptr exception =
+                HPX_GET_EXCEPTION(hpx::invalid_status, "channel::close",
+                    "this channel was closed");
+            return hpx::async<action_type>(this->get_gid(), exception);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        ValueType get_value_sync()
+        {
+            return get_value().get();
+        }
+
+        void set_value_sync(RemoteType const& val)
+        {
+            set_value(val).get();
+        }
+
+        void set_value_sync(RemoteType && val) //-V659
+        {
+            set_value(std::move(val)).get();
+        }
+
+        void close_sync()
+        {
+            close().get();
+        }
+    };
+}}
+
+/// Declare the actions of lcos::channel<Value>, \a Name has to be a unique
+/// identifier for this instantiation.
+#define HPX_REGISTER_CHANNEL_DECLARATION(Value, Name)                         \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        ::hpx::lcos::server::channel<Value>::get_value_async_action,          \
+        BOOST_PP_CAT(channel_get_value_action_, Name));                       \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        ::hpx::lcos::server::channel<Value>::set_value_async_action,          \
+        BOOST_PP_CAT(channel_set_value_action_, Name))                        \
+/**/
+
+/// Register the component type and the actions of lcos::channel<Value>,
+/// \a Name has to be a unique identifier for this instantiation.
+#define HPX_REGISTER_CHANNEL(Value, Name)                                     \
+    HPX_REGISTER_ACTION(                                                      \
+        ::hpx::lcos::server::channel<Value>::get_value_async_action,          \
+        BOOST_PP_CAT(channel_get_value_action_, Name));                       \
+    HPX_REGISTER_ACTION(                                                      \
+        ::hpx::lcos::server::channel<Value>::set_value_async_action,          \
+        BOOST_PP_CAT(channel_set_value_action_, Name));                       \
+    typedef ::hpx::components::component<                                     \
+            ::hpx::lcos::server::channel<Value>                               \
+        > BOOST_PP_CAT(channel_component_, Name);                             \
+    HPX_REGISTER_DERIVED_COMPONENT_FACTORY(                                   \
+        BOOST_PP_CAT(channel_component_, Name),                               \
+        BOOST_PP_CAT(channel_component_, Name),                               \
+        "hpx::lcos::base_lco_with_value<" BOOST_PP_STRINGIZE(Value) ", "      \
+            BOOST_PP_STRINGIZE(Value) ">")                                    \
+/**/
+
+#endif
@@ -0,0 +1,289 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_DETAIL_COLLECTIVE_MAILBOX_HPP)
+#define HPX_LCOS_DETAIL_COLLECTIVE_MAILBOX_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/apply.hpp>
+#include <hpx/runtime/actions/basic_action.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/find_here.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Each site of a collective operation (all_reduce, all_gather, etc.) is
+    // hosted by a locality. The values exchanged between the sites are
+    // delivered to a mailbox on the receiving locality, where they are
+    // identified by the name of the operation and by the step of the
+    // algorithm they belong to. Values may arrive before the receiving site
+    // asks for them.
+    template <typename T, typename Tag>
+    class collective_mailbox
+    {
+        typedef lcos::local::spinlock mutex_type;
+        typedef std::pair<std::string, std::size_t> key_type;
+
+        struct entry
+        {
+            entry()
+              : has_value_(false), has_future_(false)
+            {}
+
+            lcos::local::promise<T> promise_;
+            bool has_value_;
+            bool has_future_;
+        };
+
+        typedef std::map<key_type, entry> entries_type;
+
+    public:
+        static collective_mailbox& get()
+        {
+            static collective_mailbox mailbox;
+            return mailbox;
+        }
+
+        // store a value sent by another site
+        void set_value(std::string const& name, std::size_t step, T && t)
+        {
+            key_type key(name, step);
+
+            std::unique_lock<mutex_type> l(mtx_);
+            entry& e = entries_[key];
+            HPX_ASSERT(!e.has_value_);
+
+            if (e.has_future_)
+            {
+                // the value was asked for already, hand it over
+                lcos::local::promise<T> p(std::move(e.promise_));
+                entries_.erase(key);
+
+                l.unlock();
+                p.set_value(std::move(t));
+                return;
+            }
+
+            e.has_value_ = true;
+            e.promise_.set_value(std::move(t));
+        }
+
+        // retrieve the value sent by another site
+        hpx::future<T> get_value(std::string const& name, std::size_t step)
+        {
+            key_type key(name, step);
+
+            std::lock_guard<mutex_type> l(mtx_);
+            entry& e = entries_[key];
+            HPX_ASSERT(!e.has_future_);
+
+            hpx::future<T> f = e.promise_.get_future();
+            if (e.has_value_)
+                entries_.erase(key);
+            else
+                e.has_future_ = true;
+
+            return f;
+        }
+
+        // this is exposed as an action invoked by the sending site
+        static void deliver(std::string const& name, std::size_t step, T t)
+        {
+            get().set_value(name, step, std::move(t));
+        }
+
+    private:
+        mutex_type mtx_;
+        entries_type entries_;
+    };
+
+    template <typename T, typename Tag>
+    struct collective_mailbox_action
+    {
+        typedef collective_mailbox<T, Tag> mailbox_type;
+        typedef typename HPX_MAKE_DIRECT_ACTION(
+                mailbox_type::deliver
+            )::type type;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // By default, site s is hosted by locality s. If the sites are numbered
+    // explicitly, each site registers the locality hosting it using the base
+    // name of the operation (the 'sites' name below), which is how the other
+    // sites find it. The numbering of the sites is fixed for a base name,
+    // the localities are looked up only once.
+    class collective_site_registry
+    {
+        typedef lcos::local::spinlock mutex_type;
+        typedef std::pair<std::string, std::size_t> key_type;
+        typedef std::map<key_type, hpx::id_type> localities_type;
+
+    public:
+        static collective_site_registry& get()
+        {
+            static collective_site_registry registry;
+            return registry;
+        }
+
+        // make this locality known as the host of the given site
+        void register_site(std::string const& sites, std::size_t site)
+        {
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (!registered_.insert(key_type(sites, site)).second)
+                    return;
+            }
+            hpx::register_with_basename(sites, hpx::find_here(), site).get();
+        }
+
+        // return the locality hosting the given site
+        hpx::id_type find_site(std::string const& sites, std::size_t site)
+        {
+            key_type key(sites, site);
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                localities_type::const_iterator it = localities_.find(key);
+                if (it != localities_.end())
+                    return it->second;
+            }
+
+            hpx::id_type id = hpx::find_from_basename(sites, site).get();
+
+            std::lock_guard<mutex_type> l(mtx_);
+            localities_.insert(std::make_pair(key, id));
+            return id;
+        }
+
+    private:
+        mutex_type mtx_;
+        std::set<key_type> registered_;
+        localities_type localities_;
+    };
+
+    // the name used to register explicitly numbered sites, empty if site s
+    // is hosted by locality s
+    inline std::string collective_sites_name(char const* operation,
+        char const* basename, bool explicit_sites)
+    {
+        if (!explicit_sites)
+            return std::string();
+
+        std::string name(operation);
+        name += "/sites";
+        name += basename;
+        return name;
+    }
+
+    inline void register_site(std::string const& sites, std::size_t site)
+    {
+        if (!sites.empty())
+            collective_site_registry::get().register_site(sites, site);
+    }
+
+    inline hpx::id_type find_site(std::string const& sites, std::size_t site)
+    {
+        if (sites.empty())
+            return naming::get_id_from_locality_id(boost::uint32_t(site));
+        return collective_site_registry::get().find_site(sites, site);
+    }
+
+    // send a value to the mailbox of the given site
+    template <typename Tag, typename T>
+    void send_to_site(std::string const& name, std::string const& sites,
+        std::size_t step, std::size_t site, T const& t)
+    {
+        typedef typename collective_mailbox_action<T, Tag>::type action_type;
+        hpx::apply(action_type(), find_site(sites, site), name, step, t);
+    }
+
+    // wait for the value sent to this site
+    template <typename Tag, typename T>
+    hpx::future<T> receive_from_site(std::string const& name, std::size_t step)
+    {
+        return collective_mailbox<T, Tag>::get().get_value(name, step);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // All call sites of a collective operation on the same locality share
+    // the state of the operation, the last call site to arrive invokes the
+    // operation between the localities on behalf of all of them.
+    template <typename State>
+    class local_sites_registry
+    {
+        typedef lcos::local::spinlock mutex_type;
+        typedef std::map<std::string, boost::shared_ptr<State> > states_type;
+
+    public:
+        static local_sites_registry& get()
+        {
+            static local_sites_registry registry;
+            return registry;
+        }
+
+        boost::shared_ptr<State> find(std::string const& name)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            typename states_type::iterator it = states_.find(name);
+            if (it == states_.end())
+            {
+                it = states_.insert(
+                    std::make_pair(name, boost::make_shared<State>())).first;
+            }
+            return it->second;
+        }
+
+        void remove(std::string const& name)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            states_.erase(name);
+        }
+
+    private:
+        mutex_type mtx_;
+        states_type states_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline std::string collective_name(char const* operation,
+        char const* basename, std::size_t generation)
+    {
+        std::string name(operation);
+        name += basename;
+        if (generation != std::size_t(-1))
+            name += std::to_string(generation) + "/";
+        return name;
+    }
+
+    // return the largest power of two not larger than the number of sites
+    inline std::size_t collective_lower_power_of_two(std::size_t num_sites)
+    {
+        std::size_t p2 = 1;
+        while (2 * p2 <= num_sites)
+            p2 *= 2;
+        return p2;
+    }
+}}}
+
+#endif
@@ -22,6 +22,8 @@
 #include <hpx/util/unique_function.hpp>
 #include <hpx/util/deferred_call.hpp>
 
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/detail/atomic_count.hpp>
 #include <boost/exception_ptr.hpp>
 #include <boost/intrusive_ptr.hpp>
@@ -31,6 +33,8 @@
 #include <boost/type_traits/aligned_storage.hpp>
 #include <boost/type_traits/alignment_of.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 
@@ -57,11 +61,24 @@ namespace detail
     void intrusive_ptr_add_ref(future_data_refcnt_base* p);
     void intrusive_ptr_release(future_data_refcnt_base* p);
 
+#if defined(HPX_HAVE_FUTURE_DATA_POOL)
+    ///////////////////////////////////////////////////////////////////////
+    // Shared states are allocated from a cache of free blocks owned by the
+    // calling OS thread, see future_data.cpp.
+    HPX_EXPORT void* allocate_shared_state(std::size_t size);
+    HPX_EXPORT void deallocate_shared_state(void* p, std::size_t size);
+#endif
+
+    // release the cached blocks of the calling OS thread
+    HPX_EXPORT void reset_shared_state_cache();
+
     ///////////////////////////////////////////////////////////////////////
     struct future_data_refcnt_base
     {
     private:
-        typedef util::unique_function_nonser<void()> completed_callback_type;
+        typedef util::unique_function<
+                void(), false, HPX_THREAD_FUNCTION_STORAGE_SIZE
+            > completed_callback_type;
     public:
         typedef void has_future_data_refcnt_base;
 
@@ -79,6 +96,28 @@ namespace detail
             delete this;
         }
 
+#if defined(HPX_HAVE_FUTURE_DATA_POOL)
+        // The destructor is virtual, so the sized operator delete receives
+        // the size of the most derived type.
+        static void* operator new(std::size_t size)
+        {
+            return allocate_shared_state(size);
+        }
+        static void operator delete(void* p, std::size_t size)
+        {
+            deallocate_shared_state(p, size);
+        }
+
+        // The placement operator new has to be overloaded as well (the
+        // overloads above hide the global ones).
+        static void* operator new(std::size_t, void* p)
+        {
+            return p;
+        }
+        static void operator delete(void*, void*)
+        {}
+#endif
+
     protected:
         future_data_refcnt_base() : count_(0) {}
 
@@ -204,7 +243,8 @@ namespace detail
     };
 
     template <typename F1, typename F2>
-    static HPX_FORCEINLINE util::unique_function_nonser<void()>
+    static HPX_FORCEINLINE util::unique_function<
+        void(), false, HPX_THREAD_FUNCTION_STORAGE_SIZE>
     compose_cb(F1 && f1, F2 && f2)
     {
         if (!f1)
@@ -235,6 +275,41 @@ namespace detail
         std::size_t& count_;
     };
 
+    // Decides whether a continuation can be run directly on the current
+    // thread without exceeding the allowed recursion depth (or the available
+    // stack space). Continuations run directly while the guard is alive are
+    // accounted for.
+    struct run_inline_guard
+    {
+#if defined(HPX_WINDOWS)
+        bool run_inline() const
+        {
+            return true;
+        }
+#elif defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
+        bool run_inline() const
+        {
+            std::ptrdiff_t remaining_stack =
+                this_thread::get_available_stack_space();
+
+            if(remaining_stack < 0)
+            {
+                HPX_THROW_EXCEPTION(out_of_memory,
+                    "run_inline_guard::run_inline",
+                    "Stack overflow");
+            }
+            return remaining_stack >= 8 * HPX_THREADS_STACK_OVERHEAD;
+        }
+#else
+        bool run_inline() const
+        {
+            return cnt_.count_ <= HPX_CONTINUATION_MAX_RECURSION_DEPTH;
+        }
+
+        handle_continuation_recursion_count cnt_;
+#endif
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     HPX_EXPORT bool run_on_completed_on_new_thread(
         util::unique_function_nonser<bool()> && f, error_code& ec);
@@ -246,15 +321,76 @@ namespace detail
         HPX_NON_COPYABLE(future_data);
 
         typedef typename future_data_result<Result>::type result_type;
-        typedef util::unique_function_nonser<void()> completed_callback_type;
+        typedef util::unique_function<
+                void(), false, HPX_THREAD_FUNCTION_STORAGE_SIZE
+            > completed_callback_type;
         typedef lcos::local::spinlock mutex_type;
 
+        // The state of the shared state is kept in a single word. While the
+        // future is not ready it holds the list of the attached continuations
+        // and the flags 'pending' (the result is being stored) and 'waiting'
+        // (threads are blocked on the condition variable). Once the result
+        // has been stored it is either 'value' or 'exception'.
         enum state
         {
             empty = 0,
-            ready = 1,
-            value = 2 | ready,
-            exception = 4 | ready
+            pending = 1,
+            waiting = 2,
+            ready = 4,
+            value = 8 | ready,
+            exception = 16 | ready
+        };
+
+        static const std::uintptr_t flags_mask = pending | waiting;
+
+    private:
+        // Continuations attached to a future which is not ready yet. The
+        // nodes are at least 8-byte aligned, the low bits of their address
+        // are used for the flags above.
+        struct continuation_node
+        {
+            explicit continuation_node(completed_callback_type && f)
+              : f_(std::move(f)), next_(0)
+            {}
+
+#if defined(HPX_HAVE_FUTURE_DATA_POOL)
+            static void* operator new(std::size_t size)
+            {
+                return allocate_shared_state(size);
+            }
+            static void operator delete(void* p, std::size_t size)
+            {
+                deallocate_shared_state(p, size);
+            }
+#endif
+
+            completed_callback_type f_;
+            continuation_node* next_;
+        };
+
+        static continuation_node* get_continuations(std::uintptr_t s)
+        {
+            return reinterpret_cast<continuation_node*>(s & ~flags_mask);
+        }
+
+        // release all continuations which have not been invoked
+        struct delete_continuations
+        {
+            explicit delete_continuations(continuation_node* head)
+              : head_(head)
+            {}
+
+            ~delete_continuations()
+            {
+                while (head_ != 0)
+                {
+                    continuation_node* next = head_->next_;
+                    delete head_;
+                    head_ = next;
+                }
+            }
+
+            continuation_node* head_;
         };
 
     public:
@@ -310,7 +446,8 @@ namespace detail
             // - there are multiple readers only (shared_future, lock hurts
             //   concurrency)
 
-            if (state_ == empty) {
+            std::uintptr_t const s = state_.load(boost::memory_order_acquire);
+            if (!(s & ready)) {
                 // the value has already been moved out of this future
                 HPX_THROWS_IF(ec, no_state,
                     "future_data::get_result",
@@ -321,7 +458,7 @@ namespace detail
             // the thread has been re-activated by one of the actions
             // supported by this promise (see promise::set_event
             // and promise::set_exception).
-            if (state_ == exception)
+            if (s == exception)
             {
                 boost::exception_ptr* exception_ptr =
                     static_cast<boost::exception_ptr*>(storage_.address());
@@ -357,27 +494,8 @@ namespace detail
         // allowed
         void handle_on_completed(completed_callback_type && on_completed)
         {
-#if defined(HPX_WINDOWS)
-            bool recurse_asynchronously = false;
-#elif defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
-            std::ptrdiff_t remaining_stack =
-                this_thread::get_available_stack_space();
-
-            if(remaining_stack < 0)
-            {
-                HPX_THROW_EXCEPTION(out_of_memory,
-                    "future_data::handle_on_completed",
-                    "Stack overflow");
-            }
-            bool recurse_asynchronously =
-                remaining_stack < 8 * HPX_THREADS_STACK_OVERHEAD;
-#else
-            handle_continuation_recursion_count cnt;
-            bool recurse_asynchronously =
-                cnt.count_ > HPX_CONTINUATION_MAX_RECURSION_DEPTH;
-#endif
-
-            if (!recurse_asynchronously)
+            run_inline_guard guard;
+            if (guard.run_inline())
             {
                 // directly execute continuation on this thread
                 on_completed();
@@ -412,73 +530,48 @@ namespace detail
         template <typename Target>
         void set_value(Target && data, error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(this->mtx_);
-
             // check whether the data has already been set
-            if (is_ready_locked()) {
-                l.unlock();
+            if (!claim()) {
                 HPX_THROWS_IF(ec, promise_already_satisfied,
                     "future_data::set_value",
                     "data has already been set for this future");
                 return;
             }
 
-            completed_callback_type on_completed;
-
-            on_completed = std::move(this->on_completed_);
-
             // set the data
-            result_type* value_ptr =
-                static_cast<result_type*>(storage_.address());
-            ::new ((void*)value_ptr) result_type(
-                future_data_result<Result>::set(std::forward<Target>(data)));
-            state_ = value;
-
-            // handle all threads waiting for the future to become ready
-            cond_.notify_all(std::move(l), ec);
-
-            // Note: cv.notify_all() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
+            try {
+                result_type* value_ptr =
+                    static_cast<result_type*>(storage_.address());
+                ::new ((void*)value_ptr) result_type(
+                    future_data_result<Result>::set(
+                        std::forward<Target>(data)));
+            }
+            catch (...) {
+                unclaim();
+                throw;
+            }
 
-            // invoke the callback (continuation) function
-            if (on_completed)
-                handle_on_completed(std::move(on_completed));
+            publish(value, ec);
         }
 
         template <typename Target>
         void set_exception(Target && data, error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(this->mtx_);
-
             // check whether the data has already been set
-            if (is_ready_locked()) {
-                l.unlock();
+            if (!claim()) {
                 HPX_THROWS_IF(ec, promise_already_satisfied,
                     "future_data::set_exception",
                     "data has already been set for this future");
                 return;
             }
 
-            completed_callback_type on_completed;
-
-            on_completed = std::move(this->on_completed_);
-
             // set the data
             boost::exception_ptr* exception_ptr =
                 static_cast<boost::exception_ptr*>(storage_.address());
             ::new ((void*)exception_ptr) boost::exception_ptr(
                 std::forward<Target>(data));
-            state_ = exception;
-
-            // handle all threads waiting for the future to become ready
-            cond_.notify_all(std::move(l), ec);
-
-            // Note: cv.notify_all() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
 
-            // invoke the callback (continuation) function
-            if (on_completed)
-                handle_on_completed(std::move(on_completed));
+            publish(exception, ec);
         }
 
         // helper functions for setting data (if successful) or the error (if
@@ -522,9 +615,10 @@ namespace detail
         {
             // no locking is required as semantics guarantee a single writer
             // and no reader
+            std::uintptr_t const s = state_.load(boost::memory_order_acquire);
 
             // release any stored data and callback functions
-            switch (state_) {
+            switch (s) {
             case value:
             {
                 result_type* value_ptr =
@@ -539,11 +633,14 @@ namespace detail
                 exception_ptr->~exception_ptr();
                 break;
             }
-            default: break;
+            default:
+            {
+                delete_continuations d(get_continuations(s));
+                break;
+            }
             }
 
-            state_ = empty;
-            on_completed_ = completed_callback_type();
+            state_.store(empty, boost::memory_order_release);
         }
 
         // continuation support
@@ -555,32 +652,45 @@ namespace detail
         {
             if (!data_sink) return;
 
-            std::unique_lock<mutex_type> l(this->mtx_);
-
-            if (is_ready_locked()) {
-
-                HPX_ASSERT(!on_completed_);
-
-                // invoke the callback (continuation) function right away
-                l.unlock();
+            std::uintptr_t s = state_.load(boost::memory_order_acquire);
+            if (!(s & ready))
+            {
+                // push the callback onto the list of continuations, this
+                // fails only if the future became ready in the meantime
+                continuation_node* node =
+                    new continuation_node(std::move(data_sink));
+                HPX_ASSERT(
+                    (reinterpret_cast<std::uintptr_t>(node) & 7) == 0);
+
+                do {
+                    node->next_ = get_continuations(s);
+                    if (state_.compare_exchange_weak(s,
+                            reinterpret_cast<std::uintptr_t>(node) |
+                                (s & flags_mask),
+                            boost::memory_order_acq_rel,
+                            boost::memory_order_acquire))
+                    {
+                        return;
+                    }
+                } while (!(s & ready));
 
-                handle_on_completed(std::move(data_sink));
-            }
-            else {
-                // store a combined callback wrapping the old and the new one
-                this->on_completed_ = compose_cb(
-                    std::move(data_sink), std::move(on_completed_));
+                data_sink = std::move(node->f_);
+                delete node;
             }
+
+            // invoke the callback (continuation) function right away
+            handle_on_completed(std::move(data_sink));
         }
 
         virtual void wait(error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(mtx_);
-
             // block if this entry is empty
-            if (state_ == empty) {
-                cond_.wait(std::move(l), "future_data::wait", ec);
-                if (ec) return;
+            if (!is_ready()) {
+                std::unique_lock<mutex_type> l(mtx_);
+                if (set_waiting()) {
+                    cond_.wait(std::move(l), "future_data::wait", ec);
+                    if (ec) return;
+                }
             }
 
             if (&ec != &throws)
@@ -591,19 +701,20 @@ namespace detail
         wait_until(boost::chrono::steady_clock::time_point const& abs_time,
             error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(mtx_);
-
             // block if this entry is empty
-            if (state_ == empty) {
-                threads::thread_state_ex_enum const reason =
-                    cond_.wait_until(std::move(l), abs_time,
-                        "future_data::wait_until", ec);
-                if (ec) return future_status::uninitialized;
-
-                if (reason == threads::wait_timeout)
-                    return future_status::timeout;
-
-                return future_status::ready;
+            if (!is_ready()) {
+                std::unique_lock<mutex_type> l(mtx_);
+                if (set_waiting()) {
+                    threads::thread_state_ex_enum const reason =
+                        cond_.wait_until(std::move(l), abs_time,
+                            "future_data::wait_until", ec);
+                    if (ec) return future_status::uninitialized;
+
+                    if (reason == threads::wait_timeout)
+                        return future_status::timeout;
+
+                    return future_status::ready;
+                }
             }
 
             if (&ec != &throws)
@@ -616,34 +727,101 @@ namespace detail
         /// \a future.
         bool is_ready() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return is_ready_locked();
+            return (state_.load(boost::memory_order_acquire) & ready) != 0;
         }
 
         bool is_ready_locked() const
         {
-            return (state_ & ready) != 0;
+            return is_ready();
         }
 
         bool has_value() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return state_ == value;
+            return state_.load(boost::memory_order_acquire) == value;
         }
 
         bool has_exception() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return state_ == exception;
+            return state_.load(boost::memory_order_acquire) == exception;
+        }
+
+    private:
+        // Acquire the exclusive right to store the result, fails if the
+        // result has been stored already or is being stored.
+        bool claim()
+        {
+            std::uintptr_t s = state_.load(boost::memory_order_relaxed);
+            do {
+                if (s & (ready | pending))
+                    return false;
+            } while (!state_.compare_exchange_weak(s, s | pending,
+                boost::memory_order_acquire, boost::memory_order_relaxed));
+            return true;
+        }
+
+        void unclaim()
+        {
+            state_.fetch_and(~std::uintptr_t(pending),
+                boost::memory_order_release);
+        }
+
+        // Make the stored result visible, wake up all waiting threads and
+        // invoke all attached continuations.
+        void publish(state s, error_code& ec)
+        {
+            std::uintptr_t const old =
+                state_.exchange(s, boost::memory_order_acq_rel);
+            HPX_ASSERT(old & pending);
+
+            delete_continuations continuations(get_continuations(old));
+
+            // handle all threads waiting for the future to become ready
+            if (old & waiting) {
+                std::unique_lock<mutex_type> l(mtx_);
+                cond_.notify_all(std::move(l), ec);
+
+                // Note: cv.notify_all() above 'consumes' the lock 'l' and
+                //       leaves it unlocked when returning.
+            }
+
+            // invoke the callback (continuation) functions, the most
+            // recently attached one first
+            while (continuations.head_ != 0)
+            {
+                continuation_node* node = continuations.head_;
+                continuations.head_ = node->next_;
+
+                completed_callback_type on_completed(std::move(node->f_));
+                delete node;
+
+                handle_on_completed(std::move(on_completed));
+            }
+        }
+
+        // Announce that a thread is about to block on the condition
+        // variable, fails if the future has become ready. This has to be
+        // called while holding mtx_.
+        bool set_waiting()
+        {
+            std::uintptr_t s = state_.load(boost::memory_order_acquire);
+            while (!(s & ready))
+            {
+                if ((s & waiting) || state_.compare_exchange_weak(s,
+                        s | waiting, boost::memory_order_acq_rel,
+                        boost::memory_order_acquire))
+                {
+                    return true;
+                }
+            }
+            return false;
         }
 
     protected:
         mutable mutex_type mtx_;
-        completed_callback_type on_completed_;
 
     private:
         local::detail::condition_variable cond_;    // threads waiting in read
-        state state_;                               // current state
+        boost::atomic<std::uintptr_t> state_;       // current state
         typename future_data_storage<Result>::type storage_;
     };
 
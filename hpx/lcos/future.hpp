@@ -387,6 +387,12 @@ namespace hpx { namespace lcos { namespace detail
     >::type
     make_continuation_exec(Future const& future, Executor& exec, F && f);
 
+    template <typename ContResult, typename Future, typename F>
+    inline typename hpx::traits::detail::shared_state_ptr<
+        typename continuation_result<ContResult>::type
+    >::type
+    make_ready_continuation(Future && future, F && f);
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Future>
     typename hpx::traits::detail::shared_state_ptr<
@@ -569,6 +575,26 @@ namespace hpx { namespace lcos { namespace detail
                 typename hpx::traits::detail::shared_state_ptr<result_type>::type
                 shared_state_ptr;
 
+            // Run continuations of ready futures which may be executed
+            // synchronously right away. This avoids creating a continuation
+            // object and registering a completion callback, the result still
+            // needs its own shared state. Continuations attached to futures
+            // which are not ready yet are not fused, they are run by the
+            // completing thread through the regular continuation path.
+            if ((policy & launch::sync) && shared_state_->is_ready())
+            {
+                run_inline_guard guard;
+                if (guard.run_inline())
+                {
+                    shared_state_ptr p =
+                        detail::make_ready_continuation<continuation_result_type>(
+                            hpx::traits::future_access<Derived>::create(shared_state_),
+                            std::forward<F>(f));
+                    return hpx::traits::future_access<future<result_type> >::
+                        create(std::move(p));
+                }
+            }
+
             shared_state_ptr p =
                 detail::make_continuation<continuation_result_type>(
                     *static_cast<Derived const*>(this), policy, std::forward<F>(f));
@@ -0,0 +1,85 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_LCOS_LOCAL_BIG_READER_MUTEX_HPP
+#define HPX_LCOS_LOCAL_BIG_READER_MUTEX_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/config/export_definitions.hpp>
+#include <hpx/lcos/local/queue_mutex.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/scoped_array.hpp>
+
+#include <cstddef>
+
+namespace hpx { namespace lcos { namespace local
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A reader-writer mutex optimized for workloads dominated by readers
+    // (a 'big-reader' lock).
+    //
+    // Each worker thread has its own reader indicator (placed on a separate
+    // cache line), acquiring and releasing the mutex for reading touches
+    // this indicator and reads the writer flag only. Readers running on
+    // different worker threads therefore do not contend with each other.
+    // Writers are serialized using a queue_mutex, a writer announces itself
+    // by setting the writer flag and waits for all reader indicators to
+    // drain. Readers arriving while a writer is active back off and wait for
+    // the writer to release the mutex.
+    //
+    // Acquiring the mutex for writing is considerably more expensive than
+    // for lcos::local::shared_mutex, this mutex should be used only if
+    // writers are rare.
+    class big_reader_mutex
+    {
+        HPX_NON_COPYABLE(big_reader_mutex);
+
+    private:
+        struct reader_indicator
+        {
+            reader_indicator()
+              : count_(0)
+            {}
+
+            // HPX threads may be resumed on a different worker thread, the
+            // count of a single indicator may therefore become negative
+            boost::atomic<boost::int64_t> count_;
+            char padding_[BOOST_LOCKFREE_CACHELINE_BYTES
+                - sizeof(boost::atomic<boost::int64_t>)];
+        };
+
+    public:
+        HPX_EXPORT big_reader_mutex(char const* const description = "");
+
+        HPX_EXPORT ~big_reader_mutex();
+
+        HPX_EXPORT void lock_shared();
+
+        HPX_EXPORT bool try_lock_shared();
+
+        HPX_EXPORT void unlock_shared();
+
+        HPX_EXPORT void lock();
+
+        HPX_EXPORT bool try_lock();
+
+        HPX_EXPORT void unlock();
+
+    private:
+        reader_indicator& get_reader_indicator();
+        boost::int64_t get_reader_count() const;
+
+    private:
+        std::size_t num_indicators_;
+        boost::scoped_array<reader_indicator> indicators_;
+        boost::atomic<bool> writer_;
+        queue_mutex writer_mtx_;
+    };
+}}}
+
+#endif
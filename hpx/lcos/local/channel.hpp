@@ -0,0 +1,412 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/lcos/local/channel.hpp
+
+#if !defined(HPX_LCOS_LOCAL_CHANNEL_HPP)
+#define HPX_LCOS_LOCAL_CHANNEL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lockfree/queue.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace local
+{
+    /// A channel is a multi-producer/multi-consumer queue of values of type
+    /// \a T. Values are sent through a channel using \a set() and are
+    /// received in the same order using \a get(). Both operations return
+    /// futures: a receiver waiting for a value and a sender waiting for free
+    /// space in a bounded channel don't block the OS thread, they suspend
+    /// the HPX-thread waiting on the returned future (or attach a
+    /// continuation to it).
+    ///
+    /// A bounded channel buffers at most \a capacity values. Any additional
+    /// sender is parked until a receiver has retrieved a buffered value. An
+    /// unbounded channel never parks senders.
+    ///
+    /// Values are buffered in a lock-free queue. The mutex protects only the
+    /// parked senders and the waiting receivers, it is acquired only if a
+    /// receiver finds the channel empty or a sender finds it full.
+    ///
+    /// \note   A \a local::channel is not a LCO in the sense that it has no
+    ///         global id and it can't be triggered using the action (parcel)
+    ///         mechanism. Use lcos::channel instead if this is required.
+    template <typename T, typename Mutex = lcos::local::spinlock>
+    class channel
+    {
+        HPX_NON_COPYABLE(channel);
+
+    private:
+        typedef Mutex mutex_type;
+
+        // a sender waiting for free space in the channel
+        struct parked_sender
+        {
+            parked_sender(std::unique_ptr<T> && value)
+              : value_(std::move(value))
+            {}
+
+            parked_sender(parked_sender && rhs)
+              : value_(std::move(rhs.value_)),
+                promise_(std::move(rhs.promise_))
+            {}
+
+            std::unique_ptr<T> value_;
+            lcos::local::promise<void> promise_;
+        };
+
+    public:
+        typedef T value_type;
+
+        /// Create an unbounded channel
+        channel()
+          : capacity_((std::numeric_limits<std::size_t>::max)()),
+            free_slots_(capacity_),
+            size_(0),
+            waiting_receivers_(0),
+            waiting_senders_(0),
+            closed_(false),
+            buffer_(64)
+        {}
+
+        /// Create a channel buffering at most \a capacity values.
+        ///
+        /// \param capacity [in] The maximal number of values which can be
+        ///                 sent before a sender is parked, must not be zero.
+        explicit channel(std::size_t capacity)
+          : capacity_(capacity),
+            free_slots_(capacity),
+            size_(0),
+            waiting_receivers_(0),
+            waiting_senders_(0),
+            closed_(false),
+            buffer_((std::min)(capacity, std::size_t(64)))
+        {
+            if (capacity == 0)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::lcos::local::channel::channel",
+                    "the capacity of a bounded channel must not be zero");
+            }
+        }
+
+        ~channel()
+        {
+            T* value = 0;
+            while (buffer_.pop(value))
+                delete value;
+        }
+
+        /// Retrieve the next value from the channel. The returned future
+        /// becomes ready as soon as a value is available. If the channel was
+        /// closed and no values are left, the returned future holds an
+        /// exception.
+        hpx::future<T> get()
+        {
+            T* value = 0;
+            if (buffer_.pop(value))
+                return hpx::make_ready_future(take(value));
+
+            std::unique_lock<mutex_type> l(mtx_);
+
+            // announce this receiver before looking for a value once more,
+            // senders look for waiting receivers after pushing a value
+            ++waiting_receivers_;
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+
+            if (buffer_.pop(value))
+            {
+                --waiting_receivers_;
+                l.unlock();
+                return hpx::make_ready_future(take(value));
+            }
+
+            // the value of a parked sender might not have been moved to the
+            // buffer yet, it is the oldest value sent
+            if (!senders_.empty())
+            {
+                --waiting_receivers_;
+
+                parked_sender s = std::move(senders_.front());
+                senders_.pop_front();
+                --waiting_senders_;
+
+                l.unlock();
+                T result = std::move(*s.value_);
+                s.promise_.set_value();
+                return hpx::make_ready_future(std::move(result));
+            }
+
+            if (closed_.load())
+            {
+                --waiting_receivers_;
+                l.unlock();
+                return hpx::make_exceptional_future<T>(
+                    HPX_GET_EXCEPTION(hpx::invalid_status,
+                        "hpx::lcos::local::channel::get",
+                        "this channel was closed"));
+            }
+
+            // wait for the next value sent
+            receivers_.push_back(lcos::local::promise<T>());
+            return receivers_.back().get_future();
+        }
+
+        /// Send the given value through the channel. The returned future
+        /// becomes ready as soon as the value was handed to a receiver or
+        /// was placed into the buffer of the channel. Sending a value
+        /// through a closed channel returns a future holding an exception.
+        hpx::future<void> set(T value)
+        {
+            if (closed_.load())
+            {
+                return hpx::make_exceptional_future<void>(
+                    HPX_GET_EXCEPTION(hpx::invalid_status,
+                        "hpx::lcos::local::channel::set",
+                        "attempting to send a value through a closed "
+                        "channel"));
+            }
+
+            std::unique_ptr<T> v(new T(std::move(value)));
+
+            // parked senders go first, this keeps the values of each sender
+            // in order
+            if (waiting_senders_.load() == 0 && try_claim_slot())
+            {
+                push(v);
+                notify_receivers();
+                return hpx::make_ready_future();
+            }
+
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+
+                // announce this sender before looking for a free slot once
+                // more, receivers look for parked senders after freeing a
+                // slot
+                ++waiting_senders_;
+                if (!senders_.empty() || !try_claim_slot())
+                {
+                    // the channel is full, park the sender
+                    senders_.push_back(parked_sender(std::move(v)));
+                    return senders_.back().promise_.get_future();
+                }
+
+                push(v);
+                --waiting_senders_;
+            }
+
+            notify_receivers();
+            return hpx::make_ready_future();
+        }
+
+        /// Close the channel. No values can be sent through a closed
+        /// channel anymore. Values sent before the channel was closed can
+        /// still be received, all receivers waiting for a value are
+        /// resumed with an exception.
+        void close()
+        {
+            std::deque<lcos::local::promise<T> > receivers;
+
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                closed_.store(true);
+                std::swap(receivers, receivers_);
+                waiting_receivers_ -= receivers.size();
+            }
+
+            // values sent concurrently are handed to the waiting receivers
+            while (!receivers.empty())
+            {
+                T* value = 0;
+                if (buffer_.pop(value))
+                {
+                    receivers.front().set_value(take(value));
+                }
+                else
+                {
+                    receivers.front().set_exception(
+                        HPX_GET_EXCEPTION(hpx::invalid_status,
+                            "hpx::lcos::local::channel::close",
+                            "this channel was closed"));
+                }
+                receivers.pop_front();
+            }
+        }
+
+        /// Synchronously retrieve the next value, this suspends the calling
+        /// HPX-thread until a value is available.
+        T get_sync(error_code& ec = throws)
+        {
+            return get().get(ec);
+        }
+
+        /// Synchronously send a value, this suspends the calling HPX-thread
+        /// while the channel is full.
+        void set_sync(T value, error_code& ec = throws)
+        {
+            set(std::move(value)).get(ec);
+        }
+
+        /// Return the number of values which can currently be received
+        /// without waiting (including those of parked senders).
+        std::size_t size() const
+        {
+            return size_.load() + waiting_senders_.load();
+        }
+
+        /// Return the maximal number of buffered values
+        std::size_t capacity() const
+        {
+            return capacity_;
+        }
+
+        /// Return whether this channel was closed
+        bool is_closed() const
+        {
+            return closed_.load();
+        }
+
+    private:
+        bool is_bounded() const
+        {
+            return capacity_ != (std::numeric_limits<std::size_t>::max)();
+        }
+
+        bool try_claim_slot()
+        {
+            if (!is_bounded())
+                return true;
+
+            std::size_t slots = free_slots_.load();
+            while (slots != 0)
+            {
+                if (free_slots_.compare_exchange_weak(slots, slots - 1))
+                    return true;
+            }
+            return false;
+        }
+
+        // push a value into the buffer, the caller has claimed a slot
+        void push(std::unique_ptr<T>& value)
+        {
+            ++size_;
+            if (!buffer_.push(value.get()))
+            {
+                --size_;
+                if (is_bounded())
+                    ++free_slots_;
+                HPX_THROW_EXCEPTION(hpx::out_of_memory,
+                    "hpx::lcos::local::channel::push",
+                    "could not allocate a node of the channel buffer");
+            }
+            value.release();
+        }
+
+        // retrieve a value popped off the buffer and free its slot
+        T take(T* value)
+        {
+            std::unique_ptr<T> v(value);
+            T result = std::move(*v);
+
+            --size_;
+            release_slot();
+
+            return result;
+        }
+
+        void release_slot()
+        {
+            if (!is_bounded())
+                return;
+
+            ++free_slots_;
+            if (waiting_senders_.load() != 0)
+                resume_senders();
+        }
+
+        // move the values of parked senders into the freed slots
+        void resume_senders()
+        {
+            for (;;)
+            {
+                lcos::local::promise<void> sender;
+
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    if (senders_.empty() || !try_claim_slot())
+                        return;
+
+                    // push while holding the lock to keep the values of
+                    // each sender in order
+                    parked_sender s = std::move(senders_.front());
+                    senders_.pop_front();
+                    push(s.value_);
+                    --waiting_senders_;
+
+                    sender = std::move(s.promise_);
+                }
+
+                notify_receivers();
+                sender.set_value();
+            }
+        }
+
+        // hand buffered values to waiting receivers, called after a value
+        // was pushed
+        void notify_receivers()
+        {
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            while (waiting_receivers_.load() != 0)
+            {
+                T* value = 0;
+                lcos::local::promise<T> receiver;
+
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    if (receivers_.empty() || !buffer_.pop(value))
+                        return;
+
+                    receiver = std::move(receivers_.front());
+                    receivers_.pop_front();
+                    --waiting_receivers_;
+                }
+
+                receiver.set_value(take(value));
+            }
+        }
+
+    private:
+        mutable mutex_type mtx_;
+        std::size_t const capacity_;
+
+        boost::atomic<std::size_t> free_slots_;
+        boost::atomic<std::size_t> size_;
+        boost::atomic<std::size_t> waiting_receivers_;
+        boost::atomic<std::size_t> waiting_senders_;
+        boost::atomic<bool> closed_;
+
+        boost::lockfree::queue<T*> buffer_;
+        std::deque<lcos::local::promise<T> > receivers_;
+        std::deque<parked_sender> senders_;
+    };
+}}}
+
+#endif
@@ -527,6 +527,72 @@ namespace hpx { namespace lcos { namespace detail
         static_cast<shared_state*>(p.get())->attach_exec(future, exec);
         return p;
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Run the continuation for a future which is ready already directly on
+    // the calling thread. The result is stored in a plain shared state, if
+    // the continuation returns a future its shared state is used instead.
+    // This is used by future::then only, there is no equivalent for futures
+    // which become ready later.
+    template <typename ContResult, typename Future, typename F>
+    inline typename traits::detail::shared_state_ptr<
+        typename continuation_result<ContResult>::type
+    >::type
+    make_ready_continuation(Future& future, F& f, boost::mpl::false_)
+    {
+        typedef typename continuation_result<ContResult>::type result_type;
+        typedef future_data<result_type> shared_state;
+
+        typename traits::detail::shared_state_ptr<result_type>::type p(
+            new shared_state());
+        invoke_continuation(f, future, *static_cast<shared_state*>(p.get()));
+        return p;
+    }
+
+    template <typename ContResult, typename Future, typename F>
+    inline typename traits::detail::shared_state_ptr<
+        typename continuation_result<ContResult>::type
+    >::type
+    make_ready_continuation(Future& future, F& f, boost::mpl::true_)
+    {
+        typedef typename continuation_result<ContResult>::type result_type;
+        typedef typename traits::detail::shared_state_ptr<result_type>::type
+            shared_state_ptr;
+
+        try {
+            // take by value, as the future may go away immediately
+            shared_state_ptr inner_state =
+                traits::detail::get_shared_state(f(std::move(future)));
+
+            if (inner_state.get() == 0)
+            {
+                HPX_THROW_EXCEPTION(no_state,
+                    "make_ready_continuation",
+                    "the inner future has no valid shared state");
+            }
+            return inner_state;
+        }
+        catch (...) {
+            shared_state_ptr p(new future_data<result_type>());
+            p->set_exception(boost::current_exception());
+            return p;
+        }
+    }
+
+    template <typename ContResult, typename Future, typename F>
+    inline typename traits::detail::shared_state_ptr<
+        typename continuation_result<ContResult>::type
+    >::type
+    make_ready_continuation(Future && future, F && f)
+    {
+        typedef typename boost::mpl::bool_<
+                traits::detail::is_unique_future<ContResult>::value
+            >::type is_future_result;
+
+        typename util::decay<Future>::type future_(std::move(future));
+        return make_ready_continuation<ContResult>(future_, f,
+            is_future_result());
+    }
 }}}
 
 ///////////////////////////////////////////////////////////////////////////////
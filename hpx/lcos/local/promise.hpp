@@ -16,10 +16,54 @@
 #include <boost/intrusive_ptr.hpp>
 #include <boost/utility/swap.hpp>
 
+#include <memory>
+#include <type_traits>
+
 namespace hpx { namespace lcos { namespace local
 {
     namespace detail
     {
+        ///////////////////////////////////////////////////////////////////////
+        // A shared state which is allocated and released using the given
+        // allocator instead of the default heap.
+        template <typename R, typename Allocator>
+        class shared_state_alloc : public lcos::detail::future_data<R>
+        {
+        public:
+            typedef typename std::allocator_traits<Allocator>::
+                template rebind_alloc<shared_state_alloc> allocator_type;
+            typedef std::allocator_traits<allocator_type> traits;
+
+            explicit shared_state_alloc(allocator_type const& alloc)
+              : alloc_(alloc)
+            {}
+
+            static shared_state_alloc* create(Allocator const& a)
+            {
+                allocator_type alloc(a);
+                shared_state_alloc* p = traits::allocate(alloc, 1);
+                try {
+                    traits::construct(alloc, p, alloc);
+                }
+                catch (...) {
+                    traits::deallocate(alloc, p, 1);
+                    throw;
+                }
+                return p;
+            }
+
+        private:
+            void destroy()
+            {
+                allocator_type alloc(alloc_);
+                traits::destroy(alloc, this);
+                traits::deallocate(alloc, this, 1);
+            }
+
+            allocator_type alloc_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
         template <typename R>
         class promise_base
         {
@@ -35,6 +79,13 @@ namespace hpx { namespace lcos { namespace local
               , has_result_(false)
             {}
 
+            template <typename Allocator>
+            promise_base(std::allocator_arg_t, Allocator const& a)
+              : shared_state_(shared_state_alloc<R, Allocator>::create(a))
+              , future_retrieved_(false)
+              , has_result_(false)
+            {}
+
             promise_base(promise_base&& other) HPX_NOEXCEPT
               : shared_state_(std::move(other.shared_state_))
               , future_retrieved_(other.future_retrieved_)
@@ -182,6 +233,13 @@ namespace hpx { namespace lcos { namespace local
           : base_type()
         {}
 
+        // Effects: constructs a promise object and a shared state. The
+        //          shared state is allocated using the given allocator.
+        template <typename Allocator>
+        promise(std::allocator_arg_t, Allocator const& a)
+          : base_type(std::allocator_arg, a)
+        {}
+
         // Effects: constructs a new promise object and transfers ownership of
         //          the shared state of other (if any) to the newly-
         //          constructed object.
@@ -290,6 +348,13 @@ namespace hpx { namespace lcos { namespace local
           : base_type()
         {}
 
+        // Effects: constructs a promise object and a shared state. The
+        //          shared state is allocated using the given allocator.
+        template <typename Allocator>
+        promise(std::allocator_arg_t, Allocator const& a)
+          : base_type(std::allocator_arg, a)
+        {}
+
         // Effects: constructs a new promise object and transfers ownership of
         //          the shared state of other (if any) to the newly-
         //          constructed object.
@@ -380,6 +445,13 @@ namespace hpx { namespace lcos { namespace local
           : base_type()
         {}
 
+        // Effects: constructs a promise object and a shared state. The
+        //          shared state is allocated using the given allocator.
+        template <typename Allocator>
+        promise(std::allocator_arg_t, Allocator const& a)
+          : base_type(std::allocator_arg, a)
+        {}
+
         // Effects: constructs a new promise object and transfers ownership of
         //          the shared state of other (if any) to the newly-
         //          constructed object.
@@ -466,6 +538,15 @@ namespace hpx { namespace lcos { namespace local
     }
 }}}
 
+namespace std
+{
+    // Requires: Allocator shall be an allocator (17.6.3.5)
+    template <typename R, typename Allocator>
+    struct uses_allocator<hpx::lcos::local::promise<R>, Allocator>
+      : std::true_type
+    {};
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 #if defined(HPX_HAVE_AWAIT)
 
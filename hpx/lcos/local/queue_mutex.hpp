@@ -0,0 +1,63 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_LCOS_LOCAL_QUEUE_MUTEX_HPP
+#define HPX_LCOS_LOCAL_QUEUE_MUTEX_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/config/export_definitions.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+
+#include <boost/atomic.hpp>
+
+namespace hpx { namespace lcos { namespace local
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A fair mutex based on the queue lock by Mellor-Crummey and Scott (MCS).
+    //
+    // Each HPX thread waiting for the mutex enqueues a node (living on its
+    // own stack) and suspends itself. Releasing the mutex grants it directly
+    // to the thread which has been waiting for the longest time and resumes
+    // that thread. The mutex is acquired in FIFO order, waiting threads do
+    // not compete for a shared memory location, and no internal lock is
+    // held while suspending or resuming threads.
+    //
+    // The mutex itself serves as the queue node of the current owner
+    // (following the variant of the MCS lock by Auslander et al.), which
+    // allows to expose the usual lock()/unlock() interface.
+    class queue_mutex
+    {
+        HPX_NON_COPYABLE(queue_mutex);
+
+    private:
+        struct queue_node
+        {
+            queue_node()
+              : next_(0), state_(0), id_(threads::invalid_thread_id_repr)
+            {}
+
+            boost::atomic<queue_node*> next_;
+            boost::atomic<int> state_;
+            threads::thread_id_repr_type id_;
+        };
+
+    public:
+        HPX_EXPORT queue_mutex(char const* const description = "");
+
+        HPX_EXPORT ~queue_mutex();
+
+        HPX_EXPORT void lock();
+
+        HPX_EXPORT bool try_lock();
+
+        HPX_EXPORT void unlock();
+
+    private:
+        boost::atomic<queue_node*> tail_;
+        queue_node owner_;      // the queue node of the current owner
+    };
+}}}
+
+#endif
@@ -0,0 +1,129 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_SERVER_CHANNEL_HPP)
+#define HPX_LCOS_SERVER_CHANNEL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/exception_fwd.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/channel.hpp>
+#include <hpx/runtime/actions/component_action.hpp>
+#include <hpx/runtime/components/component_type.hpp>
+#include <hpx/runtime/components/server/component_base.hpp>
+#include <hpx/lcos/base_lco_with_value.hpp>
+#include <hpx/traits/get_remote_result.hpp>
+
+#include <cstddef>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace server
+{
+    /// A channel passes values between (possibly remote) senders and
+    /// receivers, see lcos::local::channel.
+    template <typename ValueType, typename RemoteType = ValueType>
+    class channel;
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ValueType, typename RemoteType>
+    class channel
+      : public lcos::base_lco_with_value<ValueType, RemoteType>
+      , public components::component_base<channel<ValueType, RemoteType> >
+    {
+    public:
+        typedef lcos::base_lco_with_value<ValueType, RemoteType> base_type_holder;
+
+    private:
+        typedef components::component_base<channel> base_type;
+
+    public:
+        // an unbounded channel
+        channel()
+        {}
+
+        explicit channel(std::size_t capacity)
+          : channel_(capacity)
+        {}
+
+        // disambiguate base classes
+        using base_type::finalize;
+        typedef typename base_type::wrapping_type wrapping_type;
+
+        static components::component_type get_component_type()
+        {
+            return components::get_component_type<channel>();
+        }
+        static void set_component_type(components::component_type type)
+        {
+            components::set_component_type<channel>(type);
+        }
+
+        // standard LCO action implementations
+
+        /// Send a value through the channel. The set_value_action is a
+        /// direct action, this doesn't wait for a bounded channel to accept
+        /// the value. A parked value is delivered once a receiver has
+        /// retrieved a buffered value.
+        void set_value (RemoteType && result)
+        {
+            hpx::future<void> f = channel_.set(
+                traits::get_remote_result<ValueType, RemoteType>::call(
+                    std::move(result)));
+            if (f.is_ready())
+                f.get();        // propagate errors
+        }
+
+        /// The \a function set_exception is called whenever a
+        /// \a set_exception_action is applied on an instance of a LCO. It
+        /// closes the channel.
+        ///
+        /// \param e      [in] The exception encapsulating the error to report
+        ///               to this LCO instance.
+        void set_exception(boost::exception_ptr const& /*e*/)
+        {
+            channel_.close();
+        }
+
+        // Retrieve the next value from the channel. This suspends the
+        // calling HPX-thread until a value is available, lcos::channel uses
+        // get_value_async_action instead.
+        ValueType get_value(error_code& ec = throws)
+        {
+            return channel_.get().get(ec);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The operations exposed by lcos::channel return futures, the
+        // HPX-threads executing the actions never wait for the channel.
+
+        /// Retrieve the next value from the channel. The result is sent back
+        /// once a value is available.
+        hpx::future<ValueType> get_value_async()
+        {
+            return channel_.get();
+        }
+
+        /// Send a value through the channel. The result is sent back once
+        /// the channel has accepted the value.
+        hpx::future<void> set_value_async(RemoteType && value)
+        {
+            return channel_.set(
+                traits::get_remote_result<ValueType, RemoteType>::call(
+                    std::move(value)));
+        }
+
+        HPX_DEFINE_COMPONENT_ACTION(channel, get_value_async,
+            get_value_async_action);
+        HPX_DEFINE_COMPONENT_ACTION(channel, set_value_async,
+            set_value_async_action);
+
+    private:
+        lcos::local::channel<ValueType> channel_;
+    };
+}}}
+
+#endif
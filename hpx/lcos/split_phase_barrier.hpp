@@ -0,0 +1,90 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file split_phase_barrier.hpp
+
+#if !defined(HPX_LCOS_SPLIT_PHASE_BARRIER_HPP)
+#define HPX_LCOS_SPLIT_PHASE_BARRIER_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/exception_fwd.hpp>
+#include <hpx/lcos/future.hpp>
+
+#include <cstddef>
+#include <string>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos
+{
+    /// A split_phase_barrier synchronizes a set of localities without
+    /// blocking any of them. Each participating locality creates its own
+    /// instance using the same base name. Arriving at the barrier
+    /// (\a arrive) and waiting for all other localities to arrive
+    /// (\a wait_async) are separate operations, which allows to overlap
+    /// local work with the synchronization.
+    ///
+    /// The localities synchronize using a dissemination algorithm: in
+    /// round k each locality notifies the locality at distance 2^k and waits
+    /// for the notification of the locality at the same distance in the
+    /// opposite direction. No locality sends or receives more than
+    /// log2(N) messages for each phase of the barrier.
+    ///
+    /// \note   By default, the participating localities are the localities
+    ///         0 to N-1. Instances of split_phase_barrier are not
+    ///         thread-safe, each locality should use its instance from one
+    ///         HPX-thread at a time.
+    class HPX_EXPORT split_phase_barrier
+    {
+        HPX_NON_COPYABLE(split_phase_barrier);
+
+    public:
+        /// Create the representation of the barrier on this locality
+        ///
+        /// \param basename     [in] The base name identifying the barrier,
+        ///                     it has to be the same on all localities.
+        /// \param num_sites    [in] The number of participating localities
+        ///                     (default: all localities).
+        /// \param this_site    [in] The sequence number of this locality in
+        ///                     the range [0, num_sites) (default: the
+        ///                     locality id). If it is supplied by one
+        ///                     locality, it has to be supplied by all of them.
+        explicit split_phase_barrier(std::string const& basename,
+            std::size_t num_sites = std::size_t(-1),
+            std::size_t this_site = std::size_t(-1));
+
+        /// Signal the arrival of this locality at the barrier, this starts
+        /// the next phase of the barrier. This function does not block.
+        void arrive();
+
+        /// Return a future which becomes ready once all localities have
+        /// arrived at the barrier during the current phase (the phase
+        /// started by the last invocation of \a arrive).
+        hpx::future<void> wait_async() const;
+
+        /// Arrive at the barrier and wait for all other localities to
+        /// arrive as well.
+        void wait(error_code& ec = throws);
+
+        /// Return the number of phases started on this locality
+        std::size_t generation() const
+        {
+            return generation_;
+        }
+
+    private:
+        std::string basename_;
+        std::string sites_;
+        std::size_t num_sites_;
+        std::size_t this_site_;
+        std::size_t generation_;
+        hpx::shared_future<void> phase_;
+    };
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
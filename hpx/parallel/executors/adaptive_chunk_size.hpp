@@ -0,0 +1,234 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/adaptive_chunk_size.hpp
+
+#if !defined(HPX_PARALLEL_ADAPTIVE_CHUNK_SIZE_HPP)
+#define HPX_PARALLEL_ADAPTIVE_CHUNK_SIZE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/traits/is_executor_parameters.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/executors/executor_parameter_traits.hpp>
+#include <hpx/parallel/executors/executor_information_traits.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/date_time_chrono.hpp>
+
+#include <cstddef>
+#include <algorithm>
+#include <mutex>
+
+#include <boost/cstdint.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
+{
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        // The measurements shared by all copies of an adaptive_chunk_size
+        // object.
+        struct adaptive_chunk_size_data
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            adaptive_chunk_size_data()
+              : iteration_time_(0.),
+                chunk_time_(0), chunk_iterations_(0),
+                exec_time_(0), total_time_(0), idle_rate_(-1.)
+            {}
+
+            // Blend the execution times of the chunks reported since the
+            // previous call into the running estimate, the newer
+            // measurements have the same weight as all older ones combined.
+            double get()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (chunk_iterations_ != 0)
+                {
+                    double sample = double(chunk_time_) / chunk_iterations_;
+                    if (iteration_time_ == 0.)
+                        iteration_time_ = sample;
+                    else
+                        iteration_time_ = (iteration_time_ + sample) / 2.;
+
+                    chunk_time_ = 0;
+                    chunk_iterations_ = 0;
+                }
+                return iteration_time_;
+            }
+
+            void add(std::size_t count, boost::uint64_t elapsed)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                chunk_time_ += elapsed;
+                chunk_iterations_ += count;
+            }
+
+            // Return the idle rate of the worker threads (between 0 and 1)
+            // since the previous call, or -1 if the idle rates are not
+            // collected.
+            double idle_rate()
+            {
+                boost::uint64_t exec_time = 0, total_time = 0;
+                if (!threads::get_idle_rate_times(exec_time, total_time))
+                    return -1.;
+
+                std::lock_guard<mutex_type> l(mtx_);
+                if (total_time > total_time_ && exec_time >= exec_time_)
+                {
+                    double const exec = double(exec_time - exec_time_);
+                    double const total = double(total_time - total_time_);
+                    idle_rate_ = (std::max)(0., 1. - exec / total);
+
+                    exec_time_ = exec_time;
+                    total_time_ = total_time;
+                }
+                return idle_rate_;
+            }
+
+            mutable mutex_type mtx_;
+            double iteration_time_;     // nanoseconds per iteration
+
+            // the chunks executed since the estimate was updated
+            boost::uint64_t chunk_time_;
+            boost::uint64_t chunk_iterations_;
+
+            // the idle rate times at the end of the previous window
+            boost::uint64_t exec_time_;
+            boost::uint64_t total_time_;
+            double idle_rate_;
+        };
+        /// \endcond
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Loop iterations are divided into pieces and then assigned to threads.
+    /// The number of loop iterations combined is chosen such that the
+    /// execution time of each of the pieces falls into the given time band.
+    ///
+    /// The execution time of each chunk is measured and is combined with
+    /// the measurements taken during earlier invocations. If no measurements
+    /// are available yet, 1% of the overall number of iterations is executed
+    /// to measure the execution time of an iteration. All copies of an
+    /// \a adaptive_chunk_size object share their measurements, using the
+    /// same object for the same loop allows to adapt to changing costs of
+    /// the iterations over time.
+    ///
+    /// If the idle rates of the worker threads are collected (see
+    /// HPX_WITH_THREAD_IDLE_RATES), the chunk size moves towards the lower
+    /// end of the time band while the worker threads were idle since the
+    /// previous invocation (creating more parallelism), and towards its
+    /// upper end while they were busy (reducing the overheads).
+    ///
+    /// \note No chunk is made larger than necessary to give each processing
+    ///       unit a chunk.
+    ///
+    struct adaptive_chunk_size : executor_parameters_tag
+    {
+    public:
+        /// Construct an \a adaptive_chunk_size executor parameters object
+        ///
+        /// \note Default constructed \a adaptive_chunk_size executor
+        ///       parameter types will combine as many loop iterations as
+        ///       necessary for each of the chunks to run between 50 and 200
+        ///       microseconds.
+        ///
+        adaptive_chunk_size()
+          : min_time_(50000), max_time_(200000),
+            data_(boost::make_shared<detail::adaptive_chunk_size_data>())
+        {}
+
+        /// Construct an \a adaptive_chunk_size executor parameters object
+        ///
+        /// \param min_time     [in] The minimal time any of the scheduled
+        ///                     chunks should run.
+        /// \param max_time     [in] The maximal time any of the scheduled
+        ///                     chunks should run.
+        ///
+        adaptive_chunk_size(hpx::util::steady_duration const& min_time,
+                hpx::util::steady_duration const& max_time)
+          : min_time_(min_time.value().count()),
+            max_time_(max_time.value().count()),
+            data_(boost::make_shared<detail::adaptive_chunk_size_data>())
+        {
+            HPX_ASSERT(min_time_ <= max_time_);
+        }
+
+        /// \cond NOINTERNAL
+        template <typename Executor, typename F>
+        std::size_t get_chunk_size(Executor& exec, F && f, std::size_t count)
+        {
+            std::size_t const cores = executor_information_traits<Executor>::
+                processing_units_count(exec, *this);
+            std::size_t const max_chunk_size = (count + cores - 1) / cores;
+
+            double t = data_->get();
+            if (t == 0. && count > 100*cores)
+            {
+                using hpx::util::high_resolution_clock;
+                boost::uint64_t start = high_resolution_clock::now();
+
+                std::size_t test_chunk_size = f();
+                if (test_chunk_size != 0)
+                {
+                    data_->add(test_chunk_size,
+                        high_resolution_clock::now() - start);
+                    t = data_->get();
+                }
+            }
+
+            if (t == 0.)
+                return max_chunk_size;
+
+            // select the target time for each chunk based on how busy the
+            // worker threads were since the previous invocation
+            double target = double(min_time_ + max_time_) / 2.;
+            double idle = data_->idle_rate();
+            if (idle >= 0.)
+            {
+                idle = (std::min)(idle, 1.);
+                target = max_time_ - idle * double(max_time_ - min_time_);
+            }
+
+            std::size_t chunk_size = std::size_t(target / t);
+            return (std::max)(std::size_t(1),
+                (std::min)(chunk_size, max_chunk_size));
+        }
+
+        // the partitioners report the execution time of each chunk
+        void chunk_executed(std::size_t count, boost::uint64_t elapsed)
+        {
+            if (count != 0)
+                data_->add(count, elapsed);
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive & ar, const unsigned int version)
+        {
+            ar & min_time_ & max_time_;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        boost::uint64_t min_time_;      // nanoseconds
+        boost::uint64_t max_time_;      // nanoseconds
+        boost::shared_ptr<detail::adaptive_chunk_size_data> data_;
+        /// \endcond
+    };
+}}}
+
+#endif
@@ -15,6 +15,9 @@
 #include <hpx/util/always_void.hpp>
 #include <hpx/util/decay.hpp>
 
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -184,6 +187,62 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
                     typename hpx::util::decay_unwrap<Parameters>::type
                 >::call(params, exec);
         }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Parameters, typename Enable = void>
+        struct has_chunk_executed_helper
+          : std::false_type
+        {};
+
+        template <typename Parameters>
+        struct has_chunk_executed_helper<Parameters,
+                typename hpx::util::always_void<decltype(
+                    std::declval<Parameters&>().chunk_executed(
+                        std::size_t(), boost::uint64_t())
+                )>::type>
+          : std::true_type
+        {};
+
+        // Returns whether the executor parameters object wants to be
+        // informed about the execution time of each chunk
+        template <typename Parameters>
+        struct has_chunk_executed
+          : has_chunk_executed_helper<
+                typename hpx::util::decay_unwrap<Parameters>::type>
+        {};
+
+        template <typename Parameters_>
+        struct chunk_executed_helper
+        {
+            template <typename Parameters>
+            static void call(hpx::traits::detail::wrap_int, Parameters&,
+                std::size_t, boost::uint64_t)
+            {
+            }
+
+            template <typename Parameters>
+            static auto call(int, Parameters& params, std::size_t count,
+                    boost::uint64_t elapsed)
+            ->  decltype(params.chunk_executed(count, elapsed))
+            {
+                params.chunk_executed(count, elapsed);
+            }
+
+            static void call(Parameters_& params, std::size_t count,
+                boost::uint64_t elapsed)
+            {
+                call(0, params, count, elapsed);
+            }
+        };
+
+        template <typename Parameters>
+        void call_chunk_executed(Parameters& params, std::size_t count,
+            boost::uint64_t elapsed)
+        {
+            chunk_executed_helper<
+                    typename hpx::util::decay_unwrap<Parameters>::type
+                >::call(params, count, elapsed);
+        }
     }
     /// \endcond
 
@@ -273,6 +332,23 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
         {
             return detail::call_processing_units_parameter_count(params);
         }
+
+        /// Report the time it took to execute a chunk of loop iterations.
+        ///
+        /// \param params   [in] The executor parameters object to inform.
+        /// \param count    [in] The number of loop iterations of the chunk.
+        /// \param elapsed  [in] The execution time of the chunk (in
+        ///                 nanoseconds).
+        ///
+        /// \note This calls params.chunk_executed(count, elapsed) if it
+        ///       exists; otherwise it does nothing. The partitioners measure
+        ///       the execution time of the chunks only if it exists.
+        ///
+        static void chunk_executed(executor_parameters_type& params,
+            std::size_t count, boost::uint64_t elapsed)
+        {
+            detail::call_chunk_executed(params, count, elapsed);
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
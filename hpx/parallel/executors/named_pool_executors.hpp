@@ -0,0 +1,33 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/named_pool_executors.hpp
+
+#if !defined(HPX_PARALLEL_EXECUTORS_NAMED_POOL_EXECUTORS_HPP)
+#define HPX_PARALLEL_EXECUTORS_NAMED_POOL_EXECUTORS_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/executors/named_pool_executors.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/executors/thread_executor_traits.hpp>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Creates a new named_pool_executor
+    ///
+    /// \param pool_name    [in] The name of the thread pool to run all work
+    ///                     on. The pool is either configured in the section
+    ///                     [hpx.threadpools.<pool_name>] or created by
+    ///                     calling \a hpx::threads::executors::create_named_pool.
+    ///
+    /// \note All tasks executed by this executor run as HPX-threads on the
+    ///       OS-threads of the given pool, using the scheduling policy of
+    ///       that pool.
+    ///
+    typedef threads::executors::named_pool_executor named_pool_executor;
+}}}
+
+#endif
@@ -9,19 +9,114 @@
 #define HPX_PARALLEL_EXECUTORS_PARALLEL_EXECUTOR_MAY_13_2015_1057AM
 
 #include <hpx/config.hpp>
+#include <hpx/async.hpp>
 #include <hpx/traits/is_executor.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/latch.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/parallel/config/inline_namespace.hpp>
 #include <hpx/parallel/executors/executor_traits.hpp>
 #include <hpx/parallel/executors/auto_chunk_size.hpp>
 #include <hpx/runtime/threads/thread_executor.hpp>
+#include <hpx/util/deferred_call.hpp>
 
+#include <boost/exception_ptr.hpp>
+#include <boost/range/functions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
 {
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Launches the tasks of a bulk execution from all worker threads.
+        // Each call to spawn() is responsible for a range of the shape and a
+        // range of worker threads. The range is split in two, the upper part
+        // is handed to a new HPX-thread placed directly onto the queue of the
+        // first worker thread of its range, the lower part is processed by
+        // the current thread. Once a single worker thread is left, the tasks
+        // of the remaining elements are launched from there, which places
+        // them onto the queue of that worker thread as well.
+        template <typename Result, typename F, typename Iter>
+        struct bulk_spawner
+        {
+            bulk_spawner(launch policy, std::vector<hpx::future<Result> >& results,
+                    lcos::local::latch& l, F& f, std::size_t first_thread,
+                    std::size_t num_threads)
+              : policy_(policy), results_(results), latch_(l), f_(f),
+                first_thread_(first_thread), num_threads_(num_threads)
+            {}
+
+            void spawn(std::size_t base, std::size_t size, Iter it,
+                std::size_t first_worker, std::size_t num_workers)
+            {
+                while (num_workers > 1)
+                {
+                    std::size_t lower_workers = num_workers / 2;
+                    std::size_t lower_size = size * lower_workers / num_workers;
+
+                    Iter upper = it;
+                    std::advance(upper, lower_size);
+
+                    std::size_t worker = first_worker + lower_workers;
+                    try {
+                        threads::register_thread_nullary(
+                            util::deferred_call(&bulk_spawner::spawn, this,
+                                base + lower_size, size - lower_size, upper,
+                                worker, num_workers - lower_workers),
+                            "parallel_executor::bulk_async_execute",
+                            threads::pending, false,
+                            threads::thread_priority_normal,
+                            (first_thread_ + worker) % num_threads_);
+                    }
+                    catch (...) {
+                        // launch the upper part from this thread instead
+                        spawn(base + lower_size, size - lower_size, upper,
+                            worker, num_workers - lower_workers);
+                    }
+
+                    size = lower_size;
+                    num_workers = lower_workers;
+                }
+
+                std::size_t i = 0;
+                try {
+                    for (/**/; i != size; ++i, ++it)
+                        results_[base + i] = hpx::async(policy_, f_, *it);
+                }
+                catch (...) {
+                    boost::exception_ptr e = boost::current_exception();
+                    for (/**/; i != size; ++i)
+                    {
+                        results_[base + i] =
+                            hpx::make_exceptional_future<Result>(e);
+                    }
+                }
+
+                latch_.count_down(1);
+            }
+
+            launch policy_;
+            std::vector<hpx::future<Result> >& results_;
+            lcos::local::latch& latch_;
+            F& f_;
+            std::size_t first_thread_;
+            std::size_t num_threads_;
+        };
+        /// \endcond
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     /// A \a parallel_executor creates groups of parallel execution agents
     /// which execute in threads implicitly created by the executor. This
@@ -51,6 +146,49 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
         {
             return hpx::async(l_, std::forward<F>(f));
         }
+
+        // Launch all tasks of a bulk execution. The tasks are launched from
+        // all worker threads in a divide and conquer fashion instead of
+        // being launched one after the other from the calling thread.
+        template <typename F, typename Shape>
+        std::vector<hpx::future<
+            typename detail::bulk_async_execute_result<F, Shape>::type
+        > >
+        bulk_async_execute(F && f, Shape const& shape)
+        {
+            typedef typename
+                    detail::bulk_async_execute_result<F, Shape>::type
+                result_type;
+            typedef typename boost::range_const_iterator<Shape>::type
+                iterator_type;
+
+            std::size_t size = boost::size(shape);
+            std::vector<hpx::future<result_type> > results(size);
+
+            std::size_t num_threads = hpx::get_os_thread_count();
+            std::size_t num_workers = (std::min)(num_threads, size);
+
+            if (num_workers < 2 || !(l_ & launch::async_policies) ||
+                threads::get_self_ptr() == 0)
+            {
+                std::size_t i = 0;
+                for (auto const& elem: shape)
+                    results[i++] = hpx::async(l_, f, elem);
+                return results;
+            }
+
+            lcos::local::latch l(num_workers);
+            detail::bulk_spawner<
+                    result_type, typename std::remove_reference<F>::type, iterator_type
+                > spawner(l_, results, l, f, hpx::get_worker_thread_num(),
+                    num_threads);
+
+            // this thread launches the first part of the tasks itself
+            spawner.spawn(0, size, boost::begin(shape), 0, num_workers);
+
+            l.wait();
+            return results;
+        }
         /// \endcond
 
     private:
@@ -10,13 +10,19 @@
 #include <hpx/lcos/future.hpp>
 #include <hpx/util/tuple.hpp>
 #include <hpx/util/decay.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
 
 #include <hpx/parallel/executors/executor_traits.hpp>
 #include <hpx/parallel/executors/executor_parameter_traits.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/algorithms/detail/is_negative.hpp>
 
+#include <boost/cstdint.hpp>
+
 #include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -288,6 +294,87 @@ namespace hpx { namespace parallel { namespace util { namespace detail
 
         return shape;
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Measures the execution time of each chunk of loop iterations and
+    // reports it to (a copy of) the executor parameters object, see
+    // executor_parameter_traits::chunk_executed. The number of iterations is
+    // the last element of the tuples describing the chunks.
+    template <typename Parameters, typename F>
+    struct timed_chunk_function
+    {
+    private:
+        struct report_chunk
+        {
+            report_chunk(Parameters& params, std::size_t count)
+              : params_(params), count_(count),
+                start_(hpx::util::high_resolution_clock::now())
+            {}
+
+            ~report_chunk()
+            {
+                executor_parameter_traits<Parameters>::chunk_executed(params_,
+                    count_, hpx::util::high_resolution_clock::now() - start_);
+            }
+
+            Parameters& params_;
+            std::size_t count_;
+            boost::uint64_t start_;
+        };
+
+    public:
+        template <typename Parameters_, typename F_>
+        timed_chunk_function(Parameters_ && params, F_ && f)
+          : params_(std::forward<Parameters_>(params)),
+            f_(std::forward<F_>(f))
+        {}
+
+        template <typename Tuple>
+        auto operator()(Tuple && t)
+        ->  decltype(std::declval<F&>()(std::forward<Tuple>(t)))
+        {
+            typedef typename hpx::util::decay<Tuple>::type tuple_type;
+
+            report_chunk r(params_, hpx::util::get<
+                    hpx::util::tuple_size<tuple_type>::value - 1
+                >(t));
+            return f_(std::forward<Tuple>(t));
+        }
+
+    private:
+        Parameters params_;
+        F f_;
+    };
+
+    template <typename ExPolicy, typename F>
+    typename std::enable_if<
+        parallel::v3::detail::has_chunk_executed<
+            typename hpx::util::decay<ExPolicy>::type::executor_parameters_type
+        >::value,
+        timed_chunk_function<
+            typename hpx::util::decay<ExPolicy>::type::executor_parameters_type,
+            typename hpx::util::decay<F>::type>
+    >::type
+    make_chunk_function(ExPolicy && policy, F && f)
+    {
+        typedef typename hpx::util::decay<ExPolicy>::type::executor_parameters_type
+            parameters_type;
+        return timed_chunk_function<
+                parameters_type, typename hpx::util::decay<F>::type
+            >(policy.parameters(), std::forward<F>(f));
+    }
+
+    template <typename ExPolicy, typename F>
+    typename std::enable_if<
+        !parallel::v3::detail::has_chunk_executed<
+            typename hpx::util::decay<ExPolicy>::type::executor_parameters_type
+        >::value,
+        F&&
+    >::type
+    make_chunk_function(ExPolicy &&, F && f)
+    {
+        return std::forward<F>(f);
+    }
 }}}}
 
 #endif
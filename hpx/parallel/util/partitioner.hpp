@@ -67,7 +67,8 @@ namespace hpx { namespace parallel { namespace util
                     using hpx::util::placeholders::_1;
                     workitems = executor_traits::async_execute(
                         policy.executor(),
-                        bind(invoke_fused(), std::forward<F1>(f1), _1),
+                        detail::make_chunk_function(policy,
+                            bind(invoke_fused(), std::forward<F1>(f1), _1)),
                         shape);
 
                     std::move(workitems.begin(), workitems.end(),
@@ -140,7 +141,8 @@ namespace hpx { namespace parallel { namespace util
                     using hpx::util::placeholders::_1;
                     workitems = executor_traits::async_execute(
                         policy.executor(),
-                        bind(invoke_fused(), std::forward<F1>(f1), _1),
+                        detail::make_chunk_function(policy,
+                            bind(invoke_fused(), std::forward<F1>(f1), _1)),
                         shape);
                 }
                 catch (...) {
@@ -185,7 +187,8 @@ namespace hpx { namespace parallel { namespace util
                     using hpx::util::placeholders::_1;
                     workitems = executor_traits::async_execute(
                         policy.executor(),
-                        bind(invoke_fused(), std::forward<F1>(f1), _1),
+                        detail::make_chunk_function(policy,
+                            bind(invoke_fused(), std::forward<F1>(f1), _1)),
                         shape);
 
                     std::move(workitems.begin(), workitems.end(),
@@ -236,7 +239,8 @@ namespace hpx { namespace parallel { namespace util
                     using hpx::util::placeholders::_1;
                     workitems = executor_traits::async_execute(
                         policy.executor(),
-                        bind(invoke_fused(), std::forward<F1>(f1), _1),
+                        detail::make_chunk_function(policy,
+                            bind(invoke_fused(), std::forward<F1>(f1), _1)),
                         shape);
 
                     std::move(workitems.begin(), workitems.end(),
@@ -313,7 +317,8 @@ namespace hpx { namespace parallel { namespace util
                     using hpx::util::placeholders::_1;
                     workitems = executor_traits::async_execute(
                         policy.executor(),
-                        bind(invoke_fused(), std::forward<F1>(f1), _1),
+                        detail::make_chunk_function(policy,
+                            bind(invoke_fused(), std::forward<F1>(f1), _1)),
                         shape);
                 }
                 catch (std::bad_alloc const&) {
@@ -364,7 +369,8 @@ namespace hpx { namespace parallel { namespace util
                     using hpx::util::placeholders::_1;
                     workitems = executor_traits::async_execute(
                         policy.executor(),
-                        bind(invoke_fused(), std::forward<F1>(f1), _1),
+                        detail::make_chunk_function(policy,
+                            bind(invoke_fused(), std::forward<F1>(f1), _1)),
                         shape);
 
                     std::move(workitems.begin(), workitems.end(),
@@ -66,7 +66,8 @@ namespace hpx { namespace parallel { namespace util
                     using hpx::util::placeholders::_1;
                     workitems = executor_traits::async_execute(
                         policy.executor(),
-                        bind(invoke_fused(), std::forward<F1>(f1), _1),
+                        detail::make_chunk_function(policy,
+                            bind(invoke_fused(), std::forward<F1>(f1), _1)),
                         shape);
 
                     std::move(workitems.begin(), workitems.end(),
@@ -119,7 +120,8 @@ namespace hpx { namespace parallel { namespace util
                     using hpx::util::placeholders::_1;
                     workitems = executor_traits::async_execute(
                         policy.executor(),
-                        bind(invoke_fused(), std::forward<F1>(f1), _1),
+                        detail::make_chunk_function(policy,
+                            bind(invoke_fused(), std::forward<F1>(f1), _1)),
                         shape);
 
                     std::move(workitems.begin(), workitems.end(),
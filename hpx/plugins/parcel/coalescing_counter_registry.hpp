@@ -38,6 +38,9 @@ namespace hpx { namespace plugins { namespace parcel
             get_counter_type num_messages;
             get_counter_type num_parcels_per_message;
             get_counter_type average_time_between_parcels;
+            get_counter_type batch_size;
+            get_counter_type flush_timeout;
+            get_counter_type average_parcel_latency;
         };
 
         typedef std::unordered_map<
@@ -51,13 +54,20 @@ namespace hpx { namespace plugins { namespace parcel
         void register_action(std::string const& name,
             get_counter_type num_parcels, get_counter_type num_messages,
             get_counter_type time_between_parcels,
-            get_counter_type average_time_between_parcels);
+            get_counter_type average_time_between_parcels,
+            get_counter_type batch_size, get_counter_type flush_timeout,
+            get_counter_type average_parcel_latency);
 
         get_counter_type get_parcels_counter(std::string const& name) const;
         get_counter_type get_messages_counter(std::string const& name) const;
         get_counter_type get_parcels_per_message_counter(std::string const& name) const;
         get_counter_type get_average_time_between_parcels_counter(
             std::string const& name) const;
+        get_counter_type get_batch_size_counter(std::string const& name) const;
+        get_counter_type get_flush_timeout_counter(
+            std::string const& name) const;
+        get_counter_type get_average_parcel_latency_counter(
+            std::string const& name) const;
 
         bool counter_discoverer(
             performance_counters::counter_info const& info,
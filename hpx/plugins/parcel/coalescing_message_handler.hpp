@@ -54,12 +54,17 @@ namespace hpx { namespace plugins { namespace parcel
         boost::int64_t get_messages_count(bool reset);
         boost::int64_t get_parcels_per_message_count(bool reset);
         boost::int64_t get_average_time_between_parcels(bool reset);
+        boost::int64_t get_batch_size(bool reset);
+        boost::int64_t get_flush_timeout(bool reset);
+        boost::int64_t get_average_parcel_latency(bool reset);
 
         // register the given action
         static void register_action(char const* action, error_code& ec);
 
     protected:
         bool timer_flush();
+        void start_timer(std::unique_lock<mutex_type>& l);
+        void adapt_parameters(boost::int64_t now);
         bool flush_locked(std::unique_lock<mutex_type>& l,
             parcelset::policies::message_handler::flush_mode mode,
             bool stop_buffering);
@@ -72,6 +77,21 @@ namespace hpx { namespace plugins { namespace parcel
         bool stopped_;
         bool allow_background_flush_;
 
+        // coalescing parameters, these are adjusted to the observed parcel
+        // arrival rate if adaptive coalescing is enabled
+        bool adaptive_;
+        std::size_t batch_size_;            // maximal parcels per message
+        std::size_t max_batch_size_;
+        boost::int64_t interval_;           // flush timeout (ns)
+        boost::int64_t max_latency_;        // latency cap (ns)
+        double arrival_interval_;           // average time between parcels (ns)
+        double latency_;                    // average wait of oldest
+                                            // parcel (ns)
+        boost::int64_t last_arrival_;
+        boost::int64_t first_arrival_;      // arrival time of oldest parcel
+        boost::int64_t buffered_arrivals_;  // sum of arrival times of buffered
+                                            // parcels relative to oldest one
+
         // performance counter data
         boost::int64_t num_parcels_;
         boost::int64_t reset_num_parcels_;
@@ -81,6 +101,10 @@ namespace hpx { namespace plugins { namespace parcel
         boost::int64_t reset_num_parcels_per_message_messages_;
         boost::int64_t started_at_;
         boost::int64_t reset_time_num_parcels_;
+        boost::int64_t num_sent_parcels_;
+        boost::int64_t reset_num_sent_parcels_;
+        boost::int64_t parcel_latency_;     // accumulated wait of parcels (ns)
+        boost::int64_t reset_parcel_latency_;
     };
 }}}
 
@@ -12,6 +12,7 @@
 #include <hpx/plugins/parcelport/mpi/header.hpp>
 #include <hpx/runtime/parcelset/decode_parcels.hpp>
 #include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/runtime/parcelset/receive_buffer_pool.hpp>
 
 #include <vector>
 
@@ -32,8 +33,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace mpi
 
         typedef hpx::lcos::local::spinlock mutex_type;
 
-        typedef std::vector<char>
-            data_type;
+        typedef receive_buffer_type data_type;
         typedef parcel_buffer<data_type, data_type> buffer_type;
 
     public:
@@ -0,0 +1,79 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_HEADER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_HEADER_HPP
+
+#include <hpx/config/defines.hpp>
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A message is written to the ring buffer as a stream of bytes:
+    //
+    //      header
+    //      transmission chunks (only if there are zero-copy chunks)
+    //      archive data
+    //      for each zero-copy chunk:
+    //          chunk_descriptor
+    //          chunk data (only if the chunk was not placed into a segment)
+    //
+    struct header
+    {
+        header()
+          : size_(0), numbytes_(0), num_chunks_first_(0),
+            num_chunks_second_(0)
+        {}
+
+        template <typename Buffer>
+        explicit header(Buffer const& buffer)
+          : size_(buffer.size_), numbytes_(buffer.data_size_),
+            num_chunks_first_(buffer.num_chunks_.first),
+            num_chunks_second_(buffer.num_chunks_.second)
+        {
+            HPX_ASSERT(size_ == buffer.data_.size());
+        }
+
+        boost::uint64_t size_;              // size of the archive data
+        boost::uint64_t numbytes_;          // overall number of bytes
+        boost::uint32_t num_chunks_first_;  // number of zero-copy chunks
+        boost::uint32_t num_chunks_second_; // number of index chunks
+    };
+
+    // Zero-copy chunks which are larger than a configurable threshold are
+    // not streamed through the ring buffer but handed over in a dedicated
+    // shared memory segment of their own. The segment is created by the
+    // sender and removed by the receiver once the data has been received.
+    struct chunk_descriptor
+    {
+        chunk_descriptor()
+          : segment_id_(0)
+        {}
+
+        // zero if the data of the chunk follows in the ring buffer
+        boost::uint64_t segment_id_;
+    };
+
+    inline std::string chunk_segment_name(locality const& receiver,
+        boost::int32_t sender_pid, boost::uint64_t segment_id)
+    {
+        return "/hpx.shmem." + std::to_string(receiver.pid()) + "." +
+            std::to_string(receiver.nonce()) + "." +
+            std::to_string(sender_pid) + "." + std::to_string(segment_id);
+    }
+}}}}
+
+#endif
+
+#endif
+
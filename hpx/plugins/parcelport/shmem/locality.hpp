@@ -0,0 +1,119 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_LOCALITY_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_LOCALITY_HPP
+
+#include <hpx/config/defines.hpp>
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+#include <hpx/util/safe_bool.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/io/ios_state.hpp>
+
+#include <string>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace shmem
+    {
+        // A locality reachable through shared memory is identified by the
+        // name of the host it runs on, by its process id, and by a nonce
+        // chosen at startup. The process id and the nonce determine the name
+        // of the shared memory segment holding the mailbox of the locality,
+        // the nonce prevents a locality from picking up stale segments left
+        // behind by an earlier run which used the same process id.
+        class locality
+        {
+        public:
+            locality()
+              : pid_(-1), nonce_(0)
+            {}
+
+            locality(std::string const& host, boost::int32_t pid,
+                    boost::uint32_t nonce)
+              : host_(host), pid_(pid), nonce_(nonce)
+            {}
+
+            std::string const& host() const
+            {
+                return host_;
+            }
+
+            boost::int32_t pid() const
+            {
+                return pid_;
+            }
+
+            boost::uint32_t nonce() const
+            {
+                return nonce_;
+            }
+
+            static const char *type()
+            {
+                return "shmem";
+            }
+
+            operator util::safe_bool<locality>::result_type() const
+            {
+                return util::safe_bool<locality>()(pid_ != -1);
+            }
+
+            void save(serialization::output_archive & ar) const
+            {
+                ar << host_;
+                ar << pid_;
+                ar << nonce_;
+            }
+
+            void load(serialization::input_archive & ar)
+            {
+                ar >> host_;
+                ar >> pid_;
+                ar >> nonce_;
+            }
+
+        private:
+            friend bool operator==(locality const & lhs, locality const & rhs)
+            {
+                return lhs.pid_ == rhs.pid_ && lhs.nonce_ == rhs.nonce_ &&
+                    lhs.host_ == rhs.host_;
+            }
+
+            friend bool operator<(locality const & lhs, locality const & rhs)
+            {
+                if (lhs.host_ != rhs.host_)
+                    return lhs.host_ < rhs.host_;
+                if (lhs.pid_ != rhs.pid_)
+                    return lhs.pid_ < rhs.pid_;
+                return lhs.nonce_ < rhs.nonce_;
+            }
+
+            friend std::ostream & operator<<(std::ostream & os, locality const & loc)
+            {
+                boost::io::ios_flags_saver ifs(os);
+                os << loc.host_ << ":" << loc.pid_ << ":" << std::hex
+                   << loc.nonce_;
+
+                return os;
+            }
+
+            std::string host_;
+            boost::int32_t pid_;
+            boost::uint32_t nonce_;
+        };
+    }}
+}}
+
+#endif
+
+#endif
+
@@ -0,0 +1,227 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_MAILBOX_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_MAILBOX_HPP
+
+#include <hpx/config/defines.hpp>
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/config.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/ring_buffer.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The mailbox of a locality is a shared memory segment which holds one
+    // ring buffer for each of the localities sending messages to it. The
+    // segment is created by the receiving locality, each sending locality
+    // acquires a ring buffer of its own when it connects for the first time.
+    // Every ring buffer has exactly one producer and one consumer.
+    //
+    // The segment is laid out as follows:
+    //
+    //      mailbox_header
+    //      ring_buffer_header[num_rings]
+    //      <padding up to the next page boundary>
+    //      char[ring_size] for each of the ring buffers
+    //
+    struct mailbox_header
+    {
+        boost::atomic<boost::uint64_t> magic_;
+        boost::uint64_t num_rings_;
+        boost::uint64_t ring_size_;
+        char pad0_[cache_line_size - 3 * sizeof(boost::uint64_t)];
+
+        boost::atomic<boost::uint64_t> num_producers_;
+        char pad1_[cache_line_size - sizeof(boost::uint64_t)];
+    };
+
+    class mailbox
+    {
+        HPX_MOVABLE_ONLY(mailbox);
+
+        static boost::uint64_t const magic = 0x6870782d73686d31ull;  // "hpx-shm1"
+        static std::size_t const page_size = 4096;
+
+        static std::size_t data_offset(std::size_t num_rings)
+        {
+            std::size_t offset = sizeof(mailbox_header) +
+                num_rings * sizeof(ring_buffer_header);
+            return (offset + page_size - 1) & ~(page_size - 1);
+        }
+
+    public:
+        mailbox()
+          : header_(0), owner_(false)
+        {}
+
+        mailbox(mailbox && rhs)
+          : segment_(std::move(rhs.segment_)), header_(rhs.header_),
+            name_(std::move(rhs.name_)), owner_(rhs.owner_)
+        {
+            rhs.header_ = 0;
+            rhs.owner_ = false;
+        }
+
+        ~mailbox()
+        {
+            if (owner_)
+                segment::remove(name_);
+        }
+
+        static std::string segment_name(locality const& loc)
+        {
+            return "/hpx.shmem." + std::to_string(loc.pid()) + "." +
+                std::to_string(loc.nonce());
+        }
+
+        // Create the mailbox of the given locality. The size of each ring
+        // buffer has to be a power of two.
+        void create(locality const& here, std::size_t num_rings,
+            std::size_t ring_size, error_code& ec = throws)
+        {
+            HPX_ASSERT(num_rings != 0);
+            HPX_ASSERT(ring_size >= page_size &&
+                (ring_size & (ring_size - 1)) == 0);
+
+            name_ = segment_name(here);
+            segment_.create(name_,
+                data_offset(num_rings) + num_rings * ring_size, ec);
+            if (ec) return;
+
+            owner_ = true;
+
+            header_ = new (segment_.data()) mailbox_header;
+            header_->num_rings_ = num_rings;
+            header_->ring_size_ = ring_size;
+            header_->num_producers_.store(0, boost::memory_order_relaxed);
+
+            for (std::size_t i = 0; i != num_rings; ++i)
+            {
+                ring_buffer_header* r = new (ring(i)) ring_buffer_header;
+                r->head_.store(0, boost::memory_order_relaxed);
+                r->tail_.store(0, boost::memory_order_relaxed);
+                r->producer_pid_ = -1;
+            }
+
+            // make the mailbox visible to the producers
+            header_->magic_.store(magic, boost::memory_order_release);
+        }
+
+        // Map the mailbox of the given locality
+        void open(locality const& dest, error_code& ec = throws)
+        {
+            name_ = segment_name(dest);
+            segment_.open(name_, ec);
+            if (ec) return;
+
+            if (segment_.size() < sizeof(mailbox_header) ||
+                reinterpret_cast<mailbox_header*>(segment_.data())->
+                    magic_.load(boost::memory_order_acquire) != magic)
+            {
+                segment_.unmap();
+                HPX_THROWS_IF(ec, network_error, "shmem::mailbox::open",
+                    "the shared memory segment '" + name_ +
+                    "' does not hold a valid mailbox");
+                return;
+            }
+
+            header_ = reinterpret_cast<mailbox_header*>(segment_.data());
+        }
+
+        bool valid() const
+        {
+            return header_ != 0;
+        }
+
+        std::size_t num_rings() const
+        {
+            return static_cast<std::size_t>(header_->num_rings_);
+        }
+
+        std::size_t ring_size() const
+        {
+            return static_cast<std::size_t>(header_->ring_size_);
+        }
+
+        // Return the number of ring buffers which have been acquired by
+        // producers so far.
+        std::size_t num_producers() const
+        {
+            std::size_t n = static_cast<std::size_t>(
+                header_->num_producers_.load(boost::memory_order_acquire));
+            return (std::min)(n, num_rings());
+        }
+
+        // Acquire a ring buffer for the producer with the given process id,
+        // return its index.
+        std::size_t acquire_ring(boost::int32_t producer_pid,
+            error_code& ec = throws)
+        {
+            std::size_t i = static_cast<std::size_t>(
+                header_->num_producers_.fetch_add(1));
+            if (i >= num_rings())
+            {
+                HPX_THROWS_IF(ec, network_error, "shmem::mailbox::acquire_ring",
+                    "the mailbox '" + name_ + "' has no ring buffer left, "
+                    "increase hpx.parcel.shmem.max_peers");
+                return std::size_t(-1);
+            }
+
+            ring(i)->producer_pid_ = producer_pid;
+
+            if (&ec != &throws)
+                ec = make_success_code();
+            return i;
+        }
+
+        ring_buffer_header* ring(std::size_t i) const
+        {
+            HPX_ASSERT(i < static_cast<std::size_t>(header_->num_rings_));
+            return reinterpret_cast<ring_buffer_header*>(
+                segment_.data() + sizeof(mailbox_header)) + i;
+        }
+
+        ring_writer writer(std::size_t i) const
+        {
+            return ring_writer(ring(i), ring_data(i), ring_size());
+        }
+
+        ring_reader reader(std::size_t i) const
+        {
+            return ring_reader(ring(i), ring_data(i), ring_size());
+        }
+
+    private:
+        char* ring_data(std::size_t i) const
+        {
+            return segment_.data() + data_offset(num_rings()) +
+                i * ring_size();
+        }
+
+        segment segment_;
+        mailbox_header* header_;
+        std::string name_;
+        bool owner_;
+    };
+}}}}
+
+#endif
+
+#endif
+
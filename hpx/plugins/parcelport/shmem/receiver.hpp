@@ -0,0 +1,348 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_HPP
+
+#include <hpx/config/defines.hpp>
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/error_code.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/shmem/header.hpp>
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/mailbox.hpp>
+#include <hpx/plugins/parcelport/shmem/ring_buffer.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/runtime/parcelset/receive_buffer_pool.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A receiver connection reads the messages from one of the ring buffers
+    // of the mailbox of this locality. A message is assembled from the data
+    // available whenever the ring buffer is polled, it is decoded as soon as
+    // it has been received completely.
+    template <typename Parcelport>
+    struct receiver_connection
+    {
+    private:
+        enum connection_state
+        {
+            initialized
+          , rcvd_header
+          , rcvd_transmission_chunks
+          , rcvd_data
+        };
+
+        enum chunk_state
+        {
+            chunk_initial
+          , chunk_rcvd_descriptor
+        };
+
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        typedef receive_buffer_type data_type;
+        typedef parcel_buffer<data_type, data_type> buffer_type;
+
+    public:
+        receiver_connection()
+          : state_(initialized)
+          , offset_(0)
+          , chunks_idx_(0)
+          , chunk_state_(chunk_initial)
+          , ring_(0)
+          , pp_(0)
+        {}
+
+        void init(Parcelport & pp, mailbox const& mb, std::size_t ring,
+            locality const& here)
+        {
+            pp_ = &pp;
+            ring_ = mb.ring(ring);
+            reader_ = mb.reader(ring);
+            here_ = here;
+        }
+
+        // Read the data available in the ring buffer, decode all messages
+        // which have been received completely. Return whether any data was
+        // available.
+        bool receive(std::size_t num_thread = -1)
+        {
+            bool has_work = false;
+            while (true)
+            {
+                buffer_type buffer;
+                boost::exception_ptr error;
+                {
+                    std::unique_lock<mutex_type> l(mtx_, std::try_to_lock);
+                    if (!l || reader_.empty())
+                        return has_work;
+
+                    has_work = true;
+                    if (!receive_message(buffer))
+                        return has_work;
+
+                    std::swap(error, error_);
+                }
+
+                // the data of the message is incomplete, report the error
+                // instead of decoding it
+                if (error)
+                {
+                    LPT_(error)
+                        << "shmem::receiver_connection: dropping message, "
+                           "the data of one of its chunks was lost";
+                    hpx::report_error(error);
+                    continue;
+                }
+
+                // decode the message outside of the lock, which allows for
+                // the next message to be received concurrently
+                decode_parcels(*pp_, std::move(buffer), num_thread);
+            }
+            return has_work;
+        }
+
+    private:
+        // read the remainder of a piece of data, the number of bytes of the
+        // piece which have been read already is kept in offset_
+        bool read(void* data, std::size_t size)
+        {
+            HPX_ASSERT(offset_ <= size);
+            offset_ += reader_.read(static_cast<char*>(data) + offset_,
+                size - offset_);
+
+            if (offset_ != size)
+                return false;
+
+            offset_ = 0;
+            return true;
+        }
+
+        bool receive_message(buffer_type& result)
+        {
+            switch (state_)
+            {
+                case initialized:
+                    return receive_header(result);
+                case rcvd_header:
+                    return receive_transmission_chunks(result);
+                case rcvd_transmission_chunks:
+                    return receive_data(result);
+                case rcvd_data:
+                    return receive_chunks(result);
+                default:
+                    HPX_ASSERT(false);
+            }
+            return false;
+        }
+
+        bool receive_header(buffer_type& result)
+        {
+            if (!read(&header_, sizeof(header_)))
+                return false;
+
+            performance_counters::parcels::data_point& data = buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds();
+            data.bytes_ = static_cast<std::size_t>(header_.numbytes_);
+
+            buffer_.data_.resize(static_cast<std::size_t>(header_.size_));
+            buffer_.num_chunks_ = typename buffer_type::count_chunks_type(
+                header_.num_chunks_first_, header_.num_chunks_second_);
+
+            // determine the size of the chunk buffer
+            std::size_t num_zero_copy_chunks =
+                static_cast<std::size_t>(header_.num_chunks_first_);
+            if (num_zero_copy_chunks != 0)
+            {
+                buffer_.transmission_chunks_.resize(num_zero_copy_chunks +
+                    static_cast<std::size_t>(header_.num_chunks_second_));
+                buffer_.chunks_.resize(num_zero_copy_chunks);
+            }
+
+            state_ = rcvd_header;
+            return receive_transmission_chunks(result);
+        }
+
+        bool receive_transmission_chunks(buffer_type& result)
+        {
+            HPX_ASSERT(state_ == rcvd_header);
+
+            std::vector<typename buffer_type::transmission_chunk_type>& chunks =
+                buffer_.transmission_chunks_;
+            if (!chunks.empty() &&
+                !read(chunks.data(), chunks.size() *
+                    sizeof(typename buffer_type::transmission_chunk_type)))
+            {
+                return false;
+            }
+
+            state_ = rcvd_transmission_chunks;
+            return receive_data(result);
+        }
+
+        bool receive_data(buffer_type& result)
+        {
+            HPX_ASSERT(state_ == rcvd_transmission_chunks);
+            if (!read(buffer_.data_.data(), buffer_.data_.size()))
+                return false;
+
+            state_ = rcvd_data;
+            return receive_chunks(result);
+        }
+
+        bool receive_chunks(buffer_type& result)
+        {
+            HPX_ASSERT(state_ == rcvd_data);
+
+            while (chunks_idx_ < buffer_.chunks_.size())
+            {
+                data_type& c = buffer_.chunks_[chunks_idx_];
+
+                if (chunk_state_ == chunk_initial)
+                {
+                    if (!read(&descriptor_, sizeof(descriptor_)))
+                        return false;
+
+                    c.resize(static_cast<std::size_t>(
+                        buffer_.transmission_chunks_[chunks_idx_].second));
+
+                    if (descriptor_.segment_id_ != 0)
+                        receive_segment(c);
+
+                    chunk_state_ = chunk_rcvd_descriptor;
+                }
+
+                if (descriptor_.segment_id_ == 0 && !read(c.data(), c.size()))
+                    return false;
+
+                chunk_state_ = chunk_initial;
+                ++chunks_idx_;
+            }
+
+            performance_counters::parcels::data_point& data = buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds() - data.time_;
+
+            // hand the message to the caller and prepare for the next one
+            result = std::move(buffer_);
+            buffer_ = buffer_type();
+            chunks_idx_ = 0;
+            state_ = initialized;
+
+            return true;
+        }
+
+        // copy the data of a chunk which was placed into a segment of its
+        // own, the error is kept until the whole message has been read from
+        // the ring buffer
+        void receive_segment(data_type& c)
+        {
+            std::string name(chunk_segment_name(here_, ring_->producer_pid_,
+                descriptor_.segment_id_));
+
+            error_code ec;
+            segment s;
+            s.open(name, ec);
+            segment::remove(name);
+
+            if (!ec && s.size() < c.size())
+            {
+                HPX_THROWS_IF(ec, invalid_data,
+                    "shmem::receiver_connection::receive_segment",
+                    "shared memory segment " + name +
+                    " is smaller than the chunk it is supposed to hold");
+            }
+
+            if (ec)
+            {
+                if (!error_)
+                    error_ = hpx::detail::access_exception(ec);
+                return;
+            }
+
+            std::memcpy(c.data(), s.data(), c.size());
+        }
+
+        mutex_type mtx_;
+
+        connection_state state_;
+        header header_;
+        chunk_descriptor descriptor_;
+        std::size_t offset_;
+        std::size_t chunks_idx_;
+        chunk_state chunk_state_;
+
+        ring_reader reader_;
+        ring_buffer_header* ring_;
+        locality here_;
+        boost::exception_ptr error_;
+
+        buffer_type buffer_;
+        util::high_resolution_timer timer_;
+
+        Parcelport * pp_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Parcelport>
+    struct receiver
+    {
+        typedef receiver_connection<Parcelport> connection_type;
+
+        receiver(Parcelport & pp)
+          : pp_(pp)
+        {}
+
+        // Create the mailbox other localities will write their messages to
+        void create(locality const& here, std::size_t num_rings,
+            std::size_t ring_size)
+        {
+            mailbox_.create(here, num_rings, ring_size);
+
+            connections_.reset(new connection_type[num_rings]);
+            for (std::size_t i = 0; i != num_rings; ++i)
+                connections_[i].init(pp_, mailbox_, i, here);
+        }
+
+        bool background_work(std::size_t num_thread)
+        {
+            if (!mailbox_.valid())
+                return false;
+
+            // poll the ring buffers which have been handed out to senders
+            bool has_work = false;
+            std::size_t num_producers = mailbox_.num_producers();
+            for (std::size_t i = 0; i != num_producers; ++i)
+                has_work = connections_[i].receive(num_thread) || has_work;
+
+            return has_work;
+        }
+
+    private:
+        Parcelport & pp_;
+
+        mailbox mailbox_;
+        std::unique_ptr<connection_type[]> connections_;
+    };
+}}}}
+
+#endif
+
+#endif
+
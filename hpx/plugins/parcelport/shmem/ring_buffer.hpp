@@ -0,0 +1,180 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_RING_BUFFER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_RING_BUFFER_HPP
+
+#include <hpx/config/defines.hpp>
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+// The ring buffers live in memory shared between processes, which requires
+// the atomic counters to be lock-free (and therefore address-free).
+#if !defined(BOOST_ATOMIC_INT64_LOCK_FREE) || BOOST_ATOMIC_INT64_LOCK_FREE != 2
+#  error "The shared memory parcelport requires lock-free 64 bit atomics"
+#endif
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    static std::size_t const cache_line_size = 64;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The control block of a single-producer single-consumer ring buffer
+    // which is placed into shared memory. The counters hold the overall
+    // number of bytes written and read, they never wrap around in practice.
+    // Each side updates its own counter only, the counters are kept on
+    // separate cache lines to avoid false sharing between the processes.
+    struct ring_buffer_header
+    {
+        typedef boost::atomic<boost::uint64_t> counter_type;
+
+        counter_type head_;         // updated by the producer only
+        char pad0_[cache_line_size - sizeof(counter_type)];
+
+        counter_type tail_;         // updated by the consumer only
+        char pad1_[cache_line_size - sizeof(counter_type)];
+
+        // the process id of the producer, it is written before the first
+        // data is published
+        boost::int32_t producer_pid_;
+        char pad2_[cache_line_size - sizeof(boost::int32_t)];
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The producer side of a ring buffer. The position of the consumer is
+    // re-read only if the cached value does not leave enough space, which
+    // avoids touching the cache line of the consumer for most writes.
+    class ring_writer
+    {
+    public:
+        ring_writer()
+          : header_(0), data_(0), capacity_(0), head_(0), cached_tail_(0)
+        {}
+
+        ring_writer(ring_buffer_header* header, char* data,
+                std::size_t capacity)
+          : header_(header), data_(data), capacity_(capacity),
+            head_(header->head_.load(boost::memory_order_relaxed)),
+            cached_tail_(header->tail_.load(boost::memory_order_acquire))
+        {
+            // the capacity has to be a power of two
+            HPX_ASSERT(capacity != 0 && (capacity & (capacity - 1)) == 0);
+        }
+
+        // Copy as many of the given bytes into the ring buffer as fit, return
+        // the number of bytes written.
+        std::size_t write(void const* src, std::size_t size)
+        {
+            std::size_t available = capacity_ - std::size_t(head_ - cached_tail_);
+            if (available < size)
+            {
+                cached_tail_ = header_->tail_.load(boost::memory_order_acquire);
+                available = capacity_ - std::size_t(head_ - cached_tail_);
+            }
+
+            std::size_t count = (std::min)(size, available);
+            if (count == 0)
+                return 0;
+
+            std::size_t pos = std::size_t(head_) & (capacity_ - 1);
+            std::size_t first = (std::min)(count, capacity_ - pos);
+
+            char const* p = static_cast<char const*>(src);
+            std::memcpy(data_ + pos, p, first);
+            if (first != count)
+                std::memcpy(data_, p + first, count - first);
+
+            head_ += count;
+            header_->head_.store(head_, boost::memory_order_release);
+            return count;
+        }
+
+    private:
+        ring_buffer_header* header_;
+        char* data_;
+        std::size_t capacity_;
+        boost::uint64_t head_;
+        boost::uint64_t cached_tail_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The consumer side of a ring buffer, the position of the producer is
+    // cached the same way.
+    class ring_reader
+    {
+    public:
+        ring_reader()
+          : header_(0), data_(0), capacity_(0), tail_(0), cached_head_(0)
+        {}
+
+        ring_reader(ring_buffer_header* header, char* data,
+                std::size_t capacity)
+          : header_(header), data_(data), capacity_(capacity),
+            tail_(header->tail_.load(boost::memory_order_relaxed)),
+            cached_head_(header->head_.load(boost::memory_order_acquire))
+        {
+            HPX_ASSERT(capacity != 0 && (capacity & (capacity - 1)) == 0);
+        }
+
+        // Return whether there is data available to be read
+        bool empty()
+        {
+            if (cached_head_ != tail_)
+                return false;
+
+            cached_head_ = header_->head_.load(boost::memory_order_acquire);
+            return cached_head_ == tail_;
+        }
+
+        // Copy at most the given number of bytes out of the ring buffer,
+        // return the number of bytes read.
+        std::size_t read(void* dest, std::size_t size)
+        {
+            std::size_t available = std::size_t(cached_head_ - tail_);
+            if (available < size)
+            {
+                cached_head_ = header_->head_.load(boost::memory_order_acquire);
+                available = std::size_t(cached_head_ - tail_);
+            }
+
+            std::size_t count = (std::min)(size, available);
+            if (count == 0)
+                return 0;
+
+            std::size_t pos = std::size_t(tail_) & (capacity_ - 1);
+            std::size_t first = (std::min)(count, capacity_ - pos);
+
+            char* p = static_cast<char*>(dest);
+            std::memcpy(p, data_ + pos, first);
+            if (first != count)
+                std::memcpy(p + first, data_, count - first);
+
+            tail_ += count;
+            header_->tail_.store(tail_, boost::memory_order_release);
+            return count;
+        }
+
+    private:
+        ring_buffer_header* header_;
+        char* data_;
+        std::size_t capacity_;
+        boost::uint64_t tail_;
+        boost::uint64_t cached_head_;
+    };
+}}}}
+
+#endif
+
+#endif
+
@@ -0,0 +1,95 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SEGMENT_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SEGMENT_HPP
+
+#include <hpx/config/defines.hpp>
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/config.hpp>
+#include <hpx/exception_fwd.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    // A named POSIX shared memory segment mapped into the address space of
+    // this process. The mapping is removed when the segment object goes out
+    // of scope, the name of the segment has to be removed explicitly.
+    class HPX_EXPORT segment
+    {
+        HPX_MOVABLE_ONLY(segment);
+
+    public:
+        segment()
+          : data_(0), size_(0)
+        {}
+
+        segment(segment && rhs)
+          : data_(rhs.data_), size_(rhs.size_)
+        {
+            rhs.data_ = 0;
+            rhs.size_ = 0;
+        }
+
+        ~segment()
+        {
+            unmap();
+        }
+
+        segment& operator=(segment && rhs)
+        {
+            if (this != &rhs)
+            {
+                unmap();
+                data_ = rhs.data_;
+                size_ = rhs.size_;
+                rhs.data_ = 0;
+                rhs.size_ = 0;
+            }
+            return *this;
+        }
+
+        // Create a new segment of the given size, a stale segment of the same
+        // name is replaced. The memory of the new segment is zero-initialized.
+        void create(std::string const& name, std::size_t size,
+            error_code& ec = throws);
+
+        // Map an existing segment
+        void open(std::string const& name, error_code& ec = throws);
+
+        // Unmap the segment from the address space of this process
+        void unmap();
+
+        // Remove the name of a segment, existing mappings stay valid
+        static void remove(std::string const& name);
+
+        char* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        bool valid() const
+        {
+            return data_ != 0;
+        }
+
+    private:
+        char* data_;
+        std::size_t size_;
+    };
+}}}}
+
+#endif
+
+#endif
+
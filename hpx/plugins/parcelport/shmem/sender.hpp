@@ -0,0 +1,211 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SENDER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SENDER_HPP
+
+#include <hpx/config/defines.hpp>
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <hpx/plugins/parcelport/shmem/header.hpp>
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/mailbox.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/plugins/parcelport/shmem/sender_connection.hpp>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A channel represents the ring buffer this locality owns in the mailbox
+    // of another locality. All connections to the same destination share
+    // the channel, their messages are written to the ring buffer one after
+    // the other.
+    struct channel
+    {
+        typedef hpx::lcos::local::spinlock mutex_type;
+        typedef boost::shared_ptr<sender_connection> connection_ptr;
+        typedef std::deque<connection_ptr> connection_list;
+
+        channel(boost::int32_t sender_pid, locality const& receiver,
+                std::size_t segment_threshold)
+          : sender_pid_(sender_pid)
+          , receiver_(receiver)
+          , segment_threshold_(segment_threshold)
+          , next_segment_id_(0)
+        {}
+
+        void connect(error_code& ec)
+        {
+            mailbox_.open(receiver_, ec);
+            if (ec) return;
+
+            std::size_t ring = mailbox_.acquire_ring(sender_pid_, ec);
+            if (ec) return;
+
+            writer_ = mailbox_.writer(ring);
+        }
+
+        // Write the message of the given connection if no other message is
+        // waiting to be written, queue the connection otherwise. Return
+        // whether the message has been written completely.
+        bool send_or_enqueue(connection_ptr const& c)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (pending_.empty() && c->send())
+                return true;
+
+            pending_.push_back(c);
+            return false;
+        }
+
+        // Continue writing the messages of the queued connections, the
+        // connections whose messages have been written completely are
+        // handed back to the caller.
+        bool background_work(connection_list& done)
+        {
+            std::unique_lock<mutex_type> l(mtx_, std::try_to_lock);
+            if (!l || pending_.empty())
+                return false;
+
+            while (!pending_.empty() && pending_.front()->send())
+            {
+                done.push_back(std::move(pending_.front()));
+                pending_.pop_front();
+            }
+            return true;
+        }
+
+        // Copy the data of a large chunk into a segment of its own, return
+        // the id of the segment (or zero if the data has to be written to
+        // the ring buffer). This is called while the channel is locked.
+        boost::uint64_t place_chunk(serialization::serialization_chunk const& c)
+        {
+            if (c.size_ < segment_threshold_)
+                return 0;
+
+            boost::uint64_t id = ++next_segment_id_;
+
+            error_code ec(lightweight);
+            segment s;
+            s.create(chunk_segment_name(receiver_, sender_pid_, id),
+                c.size_, ec);
+            if (ec)
+                return 0;       // fall back to the ring buffer
+
+            std::memcpy(s.data(), c.data_.cpos_, c.size_);
+            return id;
+        }
+
+        ring_writer& writer()
+        {
+            return writer_;
+        }
+
+    private:
+        mutex_type mtx_;
+        connection_list pending_;
+
+        mailbox mailbox_;
+        ring_writer writer_;
+
+        boost::int32_t sender_pid_;
+        locality receiver_;
+        std::size_t segment_threshold_;
+        boost::uint64_t next_segment_id_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct sender
+    {
+        typedef sender_connection connection_type;
+        typedef boost::shared_ptr<connection_type> connection_ptr;
+        typedef boost::shared_ptr<channel> channel_ptr;
+
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        sender(boost::int32_t pid, std::size_t segment_threshold)
+          : pid_(pid)
+          , segment_threshold_(segment_threshold)
+        {
+        }
+
+        connection_ptr create_connection(locality const& dest,
+            parcelset::locality const& there,
+            performance_counters::parcels::gatherer & parcels_sent,
+            error_code& ec)
+        {
+            channel_ptr ch = get_channel(dest, ec);
+            if (ec) return connection_ptr();
+
+            return boost::make_shared<connection_type>(ch, there, parcels_sent);
+        }
+
+        bool background_work()
+        {
+            channel::connection_list done;
+            bool has_work = false;
+            {
+                std::unique_lock<mutex_type> l(channels_mtx_, std::try_to_lock);
+                if (!l)
+                    return false;
+
+                for (channel_ptr const& ch : channels_)
+                    has_work = ch->background_work(done) || has_work;
+            }
+
+            // notify the parcelport outside of the locks, as this might
+            // trigger sending further messages
+            for (connection_ptr const& c : done)
+            {
+                error_code ec;
+                c->postprocess(ec);
+            }
+            return has_work;
+        }
+
+    private:
+        channel_ptr get_channel(locality const& dest, error_code& ec)
+        {
+            std::lock_guard<mutex_type> l(channels_mtx_);
+
+            std::map<locality, channel_ptr>::iterator it =
+                channel_map_.find(dest);
+            if (it != channel_map_.end())
+                return it->second;
+
+            channel_ptr ch = boost::make_shared<channel>(
+                pid_, dest, segment_threshold_);
+            ch->connect(ec);
+            if (ec) return channel_ptr();
+
+            channel_map_.insert(std::make_pair(dest, ch));
+            channels_.push_back(ch);
+            return ch;
+        }
+
+        boost::int32_t pid_;
+        std::size_t segment_threshold_;
+
+        mutex_type channels_mtx_;
+        std::map<locality, channel_ptr> channel_map_;
+        std::vector<channel_ptr> channels_;
+    };
+}}}}
+
+#endif
+
+#endif
+
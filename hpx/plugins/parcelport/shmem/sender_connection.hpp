@@ -0,0 +1,293 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SENDER_CONNECTION_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SENDER_CONNECTION_HPP
+
+#include <hpx/config/defines.hpp>
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/plugins/parcelport/shmem/header.hpp>
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/ring_buffer.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    struct channel;
+    struct sender_connection;
+
+    ring_writer& get_writer(channel &);
+    boost::uint64_t place_chunk(channel &,
+        serialization::serialization_chunk const&);
+    bool send_or_enqueue(channel &,
+        boost::shared_ptr<sender_connection> const&);
+
+    // A sender connection writes one message at a time to the ring buffer
+    // of the channel to its destination. If the ring buffer is full, the
+    // connection is queued with the channel and the remaining data is
+    // written from the background work of the parcelport.
+    struct sender_connection
+      : parcelset::parcelport_connection<
+            sender_connection
+          , std::vector<char>
+        >
+    {
+    private:
+        typedef std::vector<char> data_type;
+
+        enum connection_state
+        {
+            initialized
+          , sent_header
+          , sent_transmission_chunks
+          , sent_data
+          , sent_chunks
+        };
+
+        enum chunk_state
+        {
+            chunk_initial
+          , chunk_placed
+          , chunk_sent_descriptor
+        };
+
+        typedef
+            parcelset::parcelport_connection<sender_connection, data_type>
+            base_type;
+
+    public:
+        sender_connection(
+            boost::shared_ptr<channel> const& ch
+          , parcelset::locality const& there
+          , performance_counters::parcels::gatherer & parcels_sent
+        )
+          : state_(initialized)
+          , channel_(ch)
+          , offset_(0)
+          , chunks_idx_(0)
+          , chunk_state_(chunk_initial)
+          , parcels_sent_(parcels_sent)
+          , there_(there)
+        {
+        }
+
+        parcelset::locality const& destination() const
+        {
+            return there_;
+        }
+
+        void verify(parcelset::locality const & parcel_locality_id) const
+        {
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write(Handler && handler, ParcelPostprocess && parcel_postprocess)
+        {
+            HPX_ASSERT(!buffer_.data_.empty());
+
+            buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
+
+            header_ = header(buffer_);
+            state_ = initialized;
+            offset_ = 0;
+            chunks_idx_ = 0;
+            chunk_state_ = chunk_initial;
+
+            handler_ = std::forward<Handler>(handler);
+            postprocess_handler_ =
+                std::forward<ParcelPostprocess>(parcel_postprocess);
+
+            // The message is written right away if no other connection to
+            // the same destination is waiting for space in the ring buffer.
+            if (send_or_enqueue(*channel_, shared_from_this()))
+            {
+                error_code ec;
+                postprocess(ec);
+            }
+        }
+
+        // Write as much of the message as possible, return whether the
+        // message has been written completely. This must be called by one
+        // thread at a time only.
+        bool send()
+        {
+            switch(state_)
+            {
+                case initialized:
+                    return send_header();
+                case sent_header:
+                    return send_transmission_chunks();
+                case sent_transmission_chunks:
+                    return send_data();
+                case sent_data:
+                    return send_chunks();
+                case sent_chunks:
+                    return done();
+                default:
+                    HPX_ASSERT(false);
+            }
+
+            return false;
+        }
+
+        void postprocess(error_code const& ec)
+        {
+            util::unique_function_nonser<
+                void(
+                    error_code const&
+                  , parcelset::locality const&
+                  , boost::shared_ptr<sender_connection>
+                )
+            > postprocess_handler(std::move(postprocess_handler_));
+            postprocess_handler(ec, there_, shared_from_this());
+        }
+
+    private:
+        // write the remainder of a piece of data, the number of bytes of the
+        // piece which have been written already is kept in offset_
+        bool write(void const* data, std::size_t size)
+        {
+            HPX_ASSERT(offset_ <= size);
+            offset_ += get_writer(*channel_).write(
+                static_cast<char const*>(data) + offset_, size - offset_);
+
+            if (offset_ != size)
+                return false;
+
+            offset_ = 0;
+            return true;
+        }
+
+        bool send_header()
+        {
+            HPX_ASSERT(state_ == initialized);
+            if (!write(&header_, sizeof(header_)))
+                return false;
+
+            state_ = sent_header;
+            return send_transmission_chunks();
+        }
+
+        bool send_transmission_chunks()
+        {
+            HPX_ASSERT(state_ == sent_header);
+
+            std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
+                buffer_.transmission_chunks_;
+            if (!chunks.empty() &&
+                !write(chunks.data(), chunks.size() *
+                    sizeof(parcel_buffer_type::transmission_chunk_type)))
+            {
+                return false;
+            }
+
+            state_ = sent_transmission_chunks;
+            return send_data();
+        }
+
+        bool send_data()
+        {
+            HPX_ASSERT(state_ == sent_transmission_chunks);
+            if (!write(buffer_.data_.data(), buffer_.data_.size()))
+                return false;
+
+            state_ = sent_data;
+            return send_chunks();
+        }
+
+        bool send_chunks()
+        {
+            HPX_ASSERT(state_ == sent_data);
+
+            while (chunks_idx_ < buffer_.chunks_.size())
+            {
+                serialization::serialization_chunk& c =
+                    buffer_.chunks_[chunks_idx_];
+
+                if (c.type_ == serialization::chunk_type_pointer)
+                {
+                    if (chunk_state_ == chunk_initial)
+                    {
+                        // large chunks are copied into a segment of their own
+                        descriptor_.segment_id_ = place_chunk(*channel_, c);
+                        chunk_state_ = chunk_placed;
+                    }
+
+                    if (chunk_state_ == chunk_placed)
+                    {
+                        if (!write(&descriptor_, sizeof(descriptor_)))
+                            return false;
+                        chunk_state_ = chunk_sent_descriptor;
+                    }
+
+                    if (descriptor_.segment_id_ == 0 &&
+                        !write(c.data_.cpos_, c.size_))
+                    {
+                        return false;
+                    }
+
+                    chunk_state_ = chunk_initial;
+                }
+
+                ++chunks_idx_;
+            }
+
+            state_ = sent_chunks;
+            return done();
+        }
+
+        bool done()
+        {
+            error_code ec;
+            handler_(ec);
+
+            buffer_.data_point_.time_ =
+                timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
+            parcels_sent_.add_data(buffer_.data_point_);
+            buffer_.clear();
+
+            return true;
+        }
+
+        connection_state state_;
+        boost::shared_ptr<channel> channel_;
+
+        header header_;
+        chunk_descriptor descriptor_;
+        std::size_t offset_;
+        std::size_t chunks_idx_;
+        chunk_state chunk_state_;
+
+        util::unique_function_nonser<
+            void(
+                error_code const&
+            )
+        > handler_;
+        util::unique_function_nonser<
+            void(
+                error_code const&
+              , parcelset::locality const&
+              , boost::shared_ptr<sender_connection>
+            )
+        > postprocess_handler_;
+
+        util::high_resolution_timer timer_;
+        performance_counters::parcels::gatherer & parcels_sent_;
+
+        parcelset::locality there_;
+    };
+}}}}
+
+#endif
+
+#endif
+
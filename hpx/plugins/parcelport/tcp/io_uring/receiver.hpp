@@ -0,0 +1,386 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_TCP_IO_URING_RECEIVER_HPP
+#define HPX_PARCELSET_POLICIES_TCP_IO_URING_RECEIVER_HPP
+
+#include <hpx/config/defines.hpp>
+#if defined(HPX_HAVE_PARCELPORT_TCP) && defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/tcp/io_uring/connection_handler.hpp>
+#include <hpx/plugins/parcelport/tcp/io_uring/ring.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/receive_buffer_pool.hpp>
+#include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+
+namespace hpx { namespace parcelset { namespace policies { namespace tcp {
+    namespace io_uring
+{
+    // The receiver reads the data written by either of the senders of the tcp
+    // parcelport. A multishot receive delivers whatever arrived on the
+    // socket in the provided buffers of the ring, this data is copied into
+    // the parcel buffer piece by piece.
+    class receiver
+      : public parcelport_connection<
+            receiver, receive_buffer_type, receive_buffer_type>
+    {
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        typedef util::unique_function_nonser<
+                void(boost::system::error_code const&)
+            > handler_type;
+
+        enum read_state
+        {
+            read_header,
+            read_transmission_chunks,
+            read_data,
+            read_chunks
+        };
+
+    public:
+        receiver(ring& r, int fd, boost::uint64_t max_inbound_size,
+            connection_handler& parcelport)
+          : ring_(r)
+          , fd_(fd)
+          , max_inbound_size_(max_inbound_size)
+          , recv_op_(*this, &receiver::handle_read)
+          , ack_op_(*this, &receiver::handle_write_ack)
+          , state_(read_header)
+          , target_(0), target_size_(0), received_(0), chunk_(0)
+          , ack_(0)
+          , parcelport_(parcelport)
+        {}
+
+        ~receiver()
+        {
+            shutdown();
+
+            std::lock_guard<mutex_type> lk(mtx_);
+            if (fd_ != -1)
+            {
+                ::close(fd_);    // give the socket back to the OS
+                fd_ = -1;
+            }
+        }
+
+        /// Start receiving messages, the handler is called once the
+        /// connection has been closed.
+        template <typename Handler>
+        void async_read(Handler && handler)
+        {
+            handler_ = std::forward<Handler>(handler);
+
+            start_message();
+            arm();
+        }
+
+        void shutdown()
+        {
+            // this makes the outstanding receive operation complete
+            std::lock_guard<mutex_type> lk(mtx_);
+            if (fd_ != -1)
+                ::shutdown(fd_, SHUT_RDWR);
+        }
+
+    private:
+        void arm()
+        {
+            int fd = fd_;
+            int group = ring_.buffer_group();
+            if (!ring_.submit(recv_op_,
+                    [fd, group](::io_uring_sqe* sqe)
+                    {
+                        ::io_uring_prep_recv_multishot(sqe, fd, 0, 0, 0);
+                        ::io_uring_sqe_set_flags(sqe, IOSQE_BUFFER_SELECT);
+                        sqe->buf_group = static_cast<__u16>(group);
+                    }))
+            {
+                handler_(boost::asio::error::make_error_code(
+                    boost::asio::error::operation_aborted));
+            }
+        }
+
+        void handle_read(int res, unsigned flags)
+        {
+            if (res > 0)
+            {
+                HPX_ASSERT(flags & IORING_CQE_F_BUFFER);
+
+                unsigned bid = flags >> IORING_CQE_BUFFER_SHIFT;
+                if (!error_ &&
+                    !consume(ring_.buffer(bid), static_cast<std::size_t>(res)))
+                {
+                    // report this problem back to the handler once the
+                    // receive operation has terminated, discard everything
+                    // which arrives in the meantime
+                    error_ = boost::asio::error::make_error_code(
+                        boost::asio::error::operation_not_supported);
+                    shutdown();
+                }
+                ring_.release_buffer(bid);
+
+                if (flags & IORING_CQE_F_MORE)
+                    return;
+
+                // the receive operation may terminate at any time, e.g.
+                // because the provided buffers ran out
+                if (!error_)
+                {
+                    arm();
+                    return;
+                }
+            }
+            else if (res == -ENOBUFS && !error_)
+            {
+                // all provided buffers were in use, those have been released
+                // in the meantime
+                arm();
+                return;
+            }
+            else if (flags & IORING_CQE_F_MORE)
+            {
+                return;
+            }
+
+            // the connection has been closed
+            if (!error_)
+            {
+                if (res == 0)
+                {
+                    error_ = boost::asio::error::make_error_code(
+                        boost::asio::error::eof);
+                }
+                else
+                {
+                    error_ = make_error_code(res);
+                }
+            }
+            handler_(error_);
+        }
+
+        void handle_write_ack(int res, unsigned)
+        {
+            if (res < 0)
+                shutdown();
+        }
+
+        // Copy received data into the message, returns false if the data
+        // can't be accepted.
+        bool consume(char const* data, std::size_t size)
+        {
+            while (size != 0)
+            {
+                std::size_t n = (std::min)(size, target_size_ - received_);
+                std::memcpy(target_ + received_, data, n);
+                received_ += n;
+                data += n;
+                size -= n;
+
+                while (received_ == target_size_)
+                {
+                    if (!next_target())
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        void set_target(void* target, std::size_t size, read_state state)
+        {
+            target_ = static_cast<char*>(target);
+            target_size_ = size;
+            received_ = 0;
+            state_ = state;
+        }
+
+        void start_message()
+        {
+            // Store the time of the begin of the read operation
+            performance_counters::parcels::data_point& data = buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds();
+            data.serialization_time_ = 0;
+            data.bytes_ = 0;
+            data.num_parcels_ = 0;
+
+            set_target(header_, sizeof(header_), read_header);
+        }
+
+        // Determine where the next part of the message has to go, returns
+        // false if the message is invalid.
+        bool next_target()
+        {
+            std::size_t num_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<boost::uint32_t>(buffer_.num_chunks_.first));
+
+            switch (state_)
+            {
+            case read_header:
+                {
+                    char const* p = header_;
+                    std::memcpy(&buffer_.size_, p, sizeof(buffer_.size_));
+                    p += sizeof(buffer_.size_);
+                    std::memcpy(&buffer_.data_size_, p,
+                        sizeof(buffer_.data_size_));
+                    p += sizeof(buffer_.data_size_);
+                    std::memcpy(static_cast<void*>(&buffer_.num_chunks_), p,
+                        sizeof(buffer_.num_chunks_));
+
+                    // Determine the length of the serialized data.
+                    boost::uint64_t inbound_size = buffer_.size_;
+                    if (inbound_size > max_inbound_size_)
+                        return false;
+
+                    buffer_.data_point_.bytes_ =
+                        static_cast<std::size_t>(inbound_size);
+
+                    num_zero_copy_chunks = static_cast<std::size_t>(
+                        static_cast<boost::uint32_t>(buffer_.num_chunks_.first));
+                    std::size_t num_non_zero_copy_chunks =
+                        static_cast<std::size_t>(
+                            static_cast<boost::uint32_t>(
+                                buffer_.num_chunks_.second));
+
+                    if (num_zero_copy_chunks != 0)
+                    {
+                        typedef parcel_buffer_type::transmission_chunk_type
+                            transmission_chunk_type;
+
+                        std::vector<transmission_chunk_type>& chunks =
+                            buffer_.transmission_chunks_;
+
+                        chunks.resize(static_cast<std::size_t>(
+                            num_zero_copy_chunks + num_non_zero_copy_chunks));
+
+                        set_target(chunks.data(), chunks.size() *
+                            sizeof(transmission_chunk_type),
+                            read_transmission_chunks);
+                        return true;
+                    }
+                }
+                // fall through, there is no chunk description
+
+            case read_transmission_chunks:
+                // receive the main buffer holding data which was serialized
+                // normally
+                buffer_.data_.resize(static_cast<std::size_t>(buffer_.size_));
+                set_target(buffer_.data_.data(), buffer_.data_.size(),
+                    read_data);
+                return true;
+
+            case read_data:
+                // add appropriately sized chunk buffers for the zero-copy data
+                buffer_.chunks_.resize(num_zero_copy_chunks);
+                chunk_ = 0;
+                break;
+
+            case read_chunks:
+                ++chunk_;
+                break;
+            }
+
+            if (chunk_ != num_zero_copy_chunks)
+            {
+                std::size_t chunk_size = static_cast<std::size_t>(
+                    buffer_.transmission_chunks_[chunk_].second);
+                buffer_.chunks_[chunk_].resize(chunk_size);
+                set_target(buffer_.chunks_[chunk_].data(), chunk_size,
+                    read_chunks);
+                return true;
+            }
+
+            handle_message();
+            return true;
+        }
+
+        void handle_message()
+        {
+            // complete data point and pass it along
+            buffer_.data_point_.time_ = timer_.elapsed_nanoseconds() -
+                buffer_.data_point_.time_;
+
+            // decode the received parcels.
+            decode_parcels(parcelport_, std::move(buffer_), -1);
+            buffer_ = parcel_buffer_type();
+
+            // now send acknowledgment byte, the sender won't send the next
+            // message before it has received it
+            ack_ = true;
+
+            int fd = fd_;
+            bool const* ack = &ack_;
+            ring_.submit(ack_op_,
+                [fd, ack](::io_uring_sqe* sqe)
+                {
+                    ::io_uring_prep_send(sqe, fd, ack, sizeof(*ack),
+                        MSG_NOSIGNAL);
+                });
+
+            start_message();
+        }
+
+        ring& ring_;
+        int fd_;
+
+        boost::uint64_t max_inbound_size_;
+
+        operation<receiver> recv_op_;
+        operation<receiver> ack_op_;
+
+        /// The part of the message which is being received
+        read_state state_;
+        char* target_;
+        std::size_t target_size_;
+        std::size_t received_;
+        std::size_t chunk_;
+
+        char header_[2 * sizeof(util::integer::ulittle64_t) +
+            sizeof(parcel_buffer_type::count_chunks_type)];
+
+        bool ack_;
+
+        /// The handler used to process the incoming request.
+        connection_handler& parcelport_;
+
+        /// Called once the connection has been closed.
+        handler_type handler_;
+        boost::system::error_code error_;
+
+        /// Counters and timers for parcels received.
+        util::high_resolution_timer timer_;
+
+        mutex_type mtx_;
+    };
+
+    // this makes sure we can store our connections in a set
+    inline bool operator<(boost::shared_ptr<receiver> const& lhs,
+        boost::shared_ptr<receiver> const& rhs)
+    {
+        return lhs.get() < rhs.get();
+    }
+}}}}}
+
+#endif
+
+#endif
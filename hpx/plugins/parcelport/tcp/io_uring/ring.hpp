@@ -0,0 +1,166 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_TCP_IO_URING_RING_HPP
+#define HPX_PARCELSET_POLICIES_TCP_IO_URING_RING_HPP
+
+#include <hpx/config/defines.hpp>
+#if defined(HPX_HAVE_PARCELPORT_TCP) && defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <liburing.h>
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace tcp {
+    namespace io_uring
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Convert the result of a completed operation into an error code
+    inline boost::system::error_code make_error_code(int res)
+    {
+        if (res >= 0)
+            return boost::system::error_code();
+        return boost::system::error_code(-res, boost::system::system_category());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // An operation submitted to the ring, its address is used as the user
+    // data of the submission queue entries.
+    struct operation_base
+    {
+        virtual ~operation_base() {}
+
+        // Called for every completion of the operation. Multishot operations
+        // complete more than once, the last completion has no
+        // IORING_CQE_F_MORE flag set.
+        virtual void complete(int res, unsigned flags) = 0;
+    };
+
+    // An operation of a connection. The connection is kept alive until the
+    // last completion of the operation has been handled.
+    template <typename Connection>
+    class operation : public operation_base
+    {
+        typedef void (Connection::*handler_type)(int, unsigned);
+
+    public:
+        operation(Connection& c, handler_type h)
+          : c_(c), h_(h)
+        {}
+
+        void start()
+        {
+            self_ = c_.shared_from_this();
+        }
+
+        void complete(int res, unsigned flags)
+        {
+            boost::shared_ptr<Connection> self(self_);
+            if (!(flags & IORING_CQE_F_MORE))
+                self_.reset();
+
+            (c_.*h_)(res, flags);
+        }
+
+    private:
+        Connection& c_;
+        handler_type h_;
+        boost::shared_ptr<Connection> self_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The ring is shared by all connections of the parcelport. Its
+    // completions are reaped by a single thread of the parcel pool which
+    // runs all completion handlers. Operations may be submitted from any
+    // thread, submissions made by completion handlers are batched and handed
+    // to the kernel once all available completions have been handled.
+    //
+    // Incoming data is received into a ring of provided buffers which is
+    // registered with the kernel, a multishot receive picks the next free
+    // buffer for each chunk of data arriving on a connection.
+    class HPX_EXPORT ring
+    {
+        HPX_NON_COPYABLE(ring);
+
+        typedef lcos::local::spinlock mutex_type;
+
+    public:
+        ring(std::size_t entries, std::size_t num_buffers,
+            std::size_t buffer_size);
+        ~ring();
+
+        // Submit an operation, prep is called to fill in the submission
+        // queue entry. Returns false if the ring has been stopped already.
+        template <typename Operation, typename F>
+        bool submit(Operation& op, F && prep)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (stopped_)
+                return false;
+
+            op.start();
+
+            ::io_uring_sqe* sqe = get_sqe();
+            prep(sqe);
+            ::io_uring_sqe_set_data(sqe, static_cast<operation_base*>(&op));
+
+            ++outstanding_;
+            if (!is_reaping())
+                ::io_uring_submit(&ring_);
+            return true;
+        }
+
+        // Access to the provided buffers, these are returned to the ring
+        // once their content has been consumed. This may be done from the
+        // completion handlers only.
+        int buffer_group() const
+        {
+            return 0;
+        }
+
+        char const* buffer(unsigned bid) const
+        {
+            return buffers_.data() + bid * buffer_size_;
+        }
+
+        void release_buffer(unsigned bid);
+
+        // Reap completions until the ring has been stopped and all
+        // operations have completed.
+        void run();
+
+        // Cancel all outstanding operations and make run() return once
+        // those have completed.
+        void stop();
+
+    private:
+        ::io_uring_sqe* get_sqe();
+        bool is_reaping() const;
+
+        mutex_type mtx_;
+        ::io_uring ring_;
+
+        ::io_uring_buf_ring* buffer_ring_;
+        std::size_t num_buffers_;
+        std::size_t buffer_size_;
+        std::vector<char> buffers_;
+
+        boost::atomic<std::size_t> outstanding_;
+        boost::atomic<bool> stopped_;
+    };
+}}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,301 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_TCP_IO_URING_SENDER_HPP
+#define HPX_PARCELSET_POLICIES_TCP_IO_URING_SENDER_HPP
+
+#include <hpx/config/defines.hpp>
+#if defined(HPX_HAVE_PARCELPORT_TCP) && defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+
+#include <hpx/config/asio.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/plugins/parcelport/tcp/locality.hpp>
+#include <hpx/plugins/parcelport/tcp/io_uring/ring.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace tcp {
+    namespace io_uring
+{
+    // The sender writes the same data as the Boost.Asio based sender of the
+    // tcp parcelport and waits for the acknowledgment byte of the receiver.
+    // Only connecting the socket is done through Boost.Asio.
+    class sender
+      : public parcelset::parcelport_connection<sender, std::vector<char> >
+    {
+    public:
+        /// Construct a sending parcelport_connection with the given io_service.
+        sender(boost::asio::io_service& io_service, ring& r,
+            parcelset::locality const& locality_id,
+            performance_counters::parcels::gatherer& parcels_sent)
+          : socket_(io_service)
+          , ring_(r)
+          , send_op_(*this, &sender::handle_write)
+          , ack_op_(*this, &sender::handle_read_ack)
+          , first_iov_(0)
+          , ack_(0)
+          , there_(locality_id), parcels_sent_(parcels_sent)
+        {
+            std::memset(&msg_, 0, sizeof(msg_));
+        }
+
+        ~sender()
+        {
+            // gracefully and portably shutdown the socket
+            if (socket_.is_open()) {
+                boost::system::error_code ec;
+                socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+                socket_.close(ec);    // close the socket to give it back to the OS
+            }
+        }
+
+        /// Get the socket associated with the parcelport_connection.
+        boost::asio::ip::tcp::socket& socket() { return socket_; }
+
+        parcelset::locality const& destination() const
+        {
+            return there_;
+        }
+
+        void verify(parcelset::locality const & parcel_locality_id) const
+        {
+#if defined(HPX_DEBUG)
+            boost::system::error_code ec;
+            boost::asio::ip::tcp::socket::endpoint_type endpoint
+                = socket_.remote_endpoint(ec);
+
+            locality const & impl = parcel_locality_id.get<locality>();
+            // We just ignore failures here. Those are the reason for
+            // remote endpoint not connected errors which occur
+            // when the runtime is in state_shutdown
+            if(!ec)
+            {
+                HPX_ASSERT(impl.address() ==
+                    endpoint.address().to_string());
+                HPX_ASSERT(impl.port() ==
+                    endpoint.port());
+            }
+#endif
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write(Handler && handler,
+            ParcelPostprocess && parcel_postprocess)
+        {
+            HPX_ASSERT(!buffer_.data_.empty());
+
+            handler_ = std::forward<Handler>(handler);
+            postprocess_handler_ = std::forward<ParcelPostprocess>(parcel_postprocess);
+
+#if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
+            state_ = state_async_write;
+#endif
+            /// Increment sends and begin timer.
+            buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
+
+            // Write the serialized data to the socket. We use "gather-write"
+            // to send both the header and the data in a single write
+            // operation, the layout is the same as for the Boost.Asio based
+            // sender.
+            iov_.clear();
+            add_buffer(&buffer_.size_, sizeof(buffer_.size_));
+            add_buffer(&buffer_.data_size_, sizeof(buffer_.data_size_));
+
+            // add chunk description
+            add_buffer(&buffer_.num_chunks_, sizeof(buffer_.num_chunks_));
+
+            std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
+                buffer_.transmission_chunks_;
+            if (!chunks.empty()) {
+                add_buffer(chunks.data(), chunks.size() *
+                    sizeof(parcel_buffer_type::transmission_chunk_type));
+
+                // add main buffer holding data which was serialized normally
+                add_buffer(buffer_.data_.data(), buffer_.data_.size());
+
+                // now add chunks themselves, those hold zero-copy serialized chunks
+                for (serialization::serialization_chunk& c : buffer_.chunks_)
+                {
+                    if (c.type_ == serialization::chunk_type_pointer)
+                        add_buffer(c.data_.cpos_, c.size_);
+                }
+            }
+            else {
+                // add main buffer holding data which was serialized normally
+                add_buffer(buffer_.data_.data(), buffer_.data_.size());
+            }
+
+            first_iov_ = 0;
+            submit_write();
+        }
+
+    private:
+        void add_buffer(void const* data, std::size_t size)
+        {
+            if (size == 0)
+                return;
+
+            iovec iov;
+            iov.iov_base = const_cast<void*>(data);
+            iov.iov_len = size;
+            iov_.push_back(iov);
+        }
+
+        void submit_write()
+        {
+            msg_.msg_iov = iov_.data() + first_iov_;
+            msg_.msg_iovlen = iov_.size() - first_iov_;
+
+            int fd = socket_.native_handle();
+            msghdr const* msg = &msg_;
+            if (!ring_.submit(send_op_,
+                    [fd, msg](::io_uring_sqe* sqe)
+                    {
+                        ::io_uring_prep_sendmsg(sqe, fd, msg, MSG_NOSIGNAL);
+                    }))
+            {
+                handle_write(-ECANCELED, 0);
+            }
+        }
+
+        /// handle completed (possibly partial) write operation
+        void handle_write(int res, unsigned)
+        {
+            if (res > 0)
+            {
+                // skip the data written already, continue with the rest
+                std::size_t bytes = static_cast<std::size_t>(res);
+                while (first_iov_ != iov_.size() &&
+                    bytes >= iov_[first_iov_].iov_len)
+                {
+                    bytes -= iov_[first_iov_].iov_len;
+                    ++first_iov_;
+                }
+                if (first_iov_ != iov_.size())
+                {
+                    iovec& iov = iov_[first_iov_];
+                    iov.iov_base = static_cast<char*>(iov.iov_base) + bytes;
+                    iov.iov_len -= bytes;
+
+                    submit_write();
+                    return;
+                }
+            }
+            else if (res == 0)
+            {
+                res = -EPIPE;
+            }
+
+#if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
+            state_ = state_handle_write;
+#endif
+            boost::system::error_code e = make_error_code(res);
+
+            // just call initial handler
+            handler_(e);
+            if (e)
+            {
+                // inform post-processing handler of error as well
+                postprocess_handler_(e, there_, shared_from_this());
+                return;
+            }
+
+            // complete data point and push back onto gatherer
+            buffer_.data_point_.time_ =
+                timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
+            parcels_sent_.add_data(buffer_.data_point_);
+
+            // now handle the acknowledgment byte which is sent by the receiver
+            int fd = socket_.native_handle();
+            int quickack = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_QUICKACK,
+                &quickack, sizeof(quickack));
+
+            bool* ack = &ack_;
+            if (!ring_.submit(ack_op_,
+                    [fd, ack](::io_uring_sqe* sqe)
+                    {
+                        ::io_uring_prep_recv(sqe, fd, ack, sizeof(*ack),
+                            MSG_WAITALL);
+                    }))
+            {
+                handle_read_ack(-ECANCELED, 0);
+            }
+        }
+
+        void handle_read_ack(int res, unsigned)
+        {
+#if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
+            state_ = state_handle_read_ack;
+#endif
+            boost::system::error_code e;
+            if (res == 0)
+                e = boost::asio::error::eof;
+            else
+                e = make_error_code(res);
+
+            buffer_.clear();
+            // Call post-processing handler, which will send remaining pending
+            // parcels. Pass along the connection so it can be reused if more
+            // parcels have to be sent.
+            postprocess_handler_(e, there_, shared_from_this());
+        }
+
+        /// Socket for the parcelport_connection.
+        boost::asio::ip::tcp::socket socket_;
+
+        ring& ring_;
+        operation<sender> send_op_;
+        operation<sender> ack_op_;
+
+        /// The data still to be written
+        std::vector<iovec> iov_;
+        std::size_t first_iov_;
+        msghdr msg_;
+
+        bool ack_;
+
+        /// the other (receiving) end of this connection
+        parcelset::locality there_;
+
+        /// Counters and their data containers.
+        util::high_resolution_timer timer_;
+        performance_counters::parcels::gatherer& parcels_sent_;
+
+        util::unique_function_nonser<
+            void(
+                boost::system::error_code const&
+            )
+        > handler_;
+        util::unique_function_nonser<
+            void(
+                boost::system::error_code const&
+              , parcelset::locality const&
+              , boost::shared_ptr<sender>
+            )
+        > postprocess_handler_;
+    };
+}}}}}
+
+#endif
+
+#endif
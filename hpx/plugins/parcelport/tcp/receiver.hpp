@@ -18,6 +18,7 @@
 #include <hpx/config/asio.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
 #include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/receive_buffer_pool.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
@@ -43,7 +44,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
     class connection_handler;
 
     class receiver
-      : public parcelport_connection<receiver, std::vector<char>, std::vector<char> >
+      : public parcelport_connection<
+            receiver, receive_buffer_type, receive_buffer_type>
     {
         typedef hpx::lcos::local::spinlock mutex_type;
     public:
@@ -14,10 +14,17 @@
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/integer/endian.hpp>
 
+#include <boost/atomic.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <algorithm>
 #include <sstream>
 #include <vector>
 
@@ -85,6 +92,185 @@ namespace hpx { namespace parcelset
         return chunks;
     }
 
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // protect from un-handled exceptions bubbling up
+        template <typename F>
+        void decode_message_guarded(F && f)
+        {
+            try {
+                try {
+                    f();
+                }
+                catch (hpx::exception const& e) {
+                    LPT_(error)
+                        << "decode_message: caught hpx::exception: "
+                        << e.what();
+                    hpx::report_error(boost::current_exception());
+                }
+                catch (boost::system::system_error const& e) {
+                    LPT_(error)
+                        << "decode_message: caught boost::system::error: "
+                        << e.what();
+                    hpx::report_error(boost::current_exception());
+                }
+                catch (boost::exception const&) {
+                    LPT_(error)
+                        << "decode_message: caught boost::exception.";
+                    hpx::report_error(boost::current_exception());
+                }
+                catch (std::exception const& e) {
+                    // We have to repackage all exceptions thrown by the
+                    // serialization library as otherwise we will loose the
+                    // e.what() description of the problem, due to slicing.
+                    boost::throw_exception(boost::enable_error_info(
+                        hpx::exception(serialization_error, e.what())));
+                }
+            }
+            catch (...) {
+                LPT_(error)
+                    << "decode_message: caught unknown exception.";
+                hpx::report_error(boost::current_exception());
+            }
+        }
+
+        // De-serialize the next parcel from the archive and add it to the
+        // incoming parcel queue, returns the time spent in add_received_parcel
+        template <typename Parcelport>
+        boost::int64_t decode_and_add_parcel(Parcelport & pp,
+            serialization::input_archive & archive, std::size_t num_thread)
+        {
+            parcel p;
+            archive >> p;
+
+            // make sure this parcel ended up on the right locality
+            naming::gid_type const& here = hpx::get_locality();
+            if (hpx::get_runtime_ptr() && here &&
+                (naming::get_locality_id_from_gid(
+                     p.destination_locality()) !=
+                 naming::get_locality_id_from_gid(here)))
+            {
+                std::ostringstream os;
+                os << "parcel destination does not match "
+                      "locality which received the parcel ("
+                   << here << "), " << p;
+                HPX_THROW_EXCEPTION(invalid_status,
+                    "hpx::parcelset::decode_message",
+                    os.str());
+                return 0;
+            }
+
+            // be sure not to measure add_parcel as serialization time
+            util::high_resolution_timer timer;
+            pp.add_received_parcel(std::move(p), num_thread);
+            return timer.elapsed_nanoseconds();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The minimal number of parcels worth decoding on a separate thread
+        static const std::size_t min_parcels_per_decode_task = 16;
+
+        typedef util::integer::ulittle64_t parcel_offset_type;
+
+        // The state shared by all threads decoding the parcels of one message
+        template <typename Parcelport, typename Buffer>
+        struct decode_parcels_data
+        {
+            decode_parcels_data(Parcelport & pp, Buffer && buffer,
+                    std::vector<parcel_offset_type> && offsets,
+                    std::size_t num_tasks, std::size_t num_thread)
+              : pp_(pp), buffer_(std::move(buffer)),
+                offsets_(std::move(offsets)), num_thread_(num_thread),
+                remaining_(num_tasks), serialization_time_(0)
+            {}
+
+            Parcelport & pp_;
+            Buffer buffer_;
+            std::vector<parcel_offset_type> offsets_;
+            std::size_t num_thread_;
+            boost::atomic<std::size_t> remaining_;
+            boost::atomic<boost::int64_t> serialization_time_;
+        };
+
+        template <typename Parcelport, typename Buffer>
+        void decode_parcels_range(
+            boost::shared_ptr<decode_parcels_data<Parcelport, Buffer> > data,
+            std::size_t first, std::size_t last)
+        {
+            decode_message_guarded(
+                [&]()
+                {
+                    util::high_resolution_timer timer;
+                    boost::int64_t overall_add_parcel_time = 0;
+
+                    serialization::input_archive archive(data->buffer_.data_,
+                        data->buffer_.data_size_);
+
+                    for (std::size_t i = first; i != last; ++i)
+                    {
+                        archive.set_position(data->offsets_[i]);
+                        overall_add_parcel_time += decode_and_add_parcel(
+                            data->pp_, archive, data->num_thread_);
+                    }
+
+                    data->serialization_time_ += timer.elapsed_nanoseconds() -
+                        overall_add_parcel_time;
+                });
+
+            // the last thread to finish updates the performance data
+            if (--data->remaining_ == 0)
+            {
+                performance_counters::parcels::data_point& point =
+                    data->buffer_.data_point_;
+
+                point.num_parcels_ = data->offsets_.size();
+                point.raw_bytes_ = data->buffer_.data_.size();
+                point.serialization_time_ = data->serialization_time_.load();
+
+                data->pp_.add_received_data(point);
+            }
+        }
+
+        // Distribute the parcels of the message over several threads, this
+        // requires for the message to carry a valid index of parcel offsets.
+        template <typename Parcelport, typename Buffer>
+        void decode_parcels_parallel(Parcelport & pp, Buffer && buffer,
+            std::vector<parcel_offset_type> && offsets, std::size_t num_tasks,
+            std::size_t num_thread)
+        {
+            typedef decode_parcels_data<Parcelport, Buffer> data_type;
+
+            std::size_t const parcel_count = offsets.size();
+            boost::shared_ptr<data_type> data(boost::make_shared<data_type>(
+                pp, std::move(buffer), std::move(offsets), num_tasks,
+                num_thread));
+
+            std::size_t const num_os_threads = hpx::get_os_thread_count();
+            std::size_t first = 0;
+            for (std::size_t i = 0; i != num_tasks; ++i)
+            {
+                std::size_t last = first +
+                    (parcel_count - first) / (num_tasks - i);
+
+                error_code ec(lightweight);
+                hpx::applier::register_thread_nullary(
+                    util::bind(&decode_parcels_range<Parcelport, Buffer>,
+                        data, first, last),
+                    "decode_parcels",
+                    threads::pending, true, threads::thread_priority_boost,
+                    i % num_os_threads, threads::thread_stacksize_default, ec);
+
+                // decode the parcels directly if no thread could be created
+                if (ec)
+                    decode_parcels_range(data, first, last);
+
+                first = last;
+            }
+            HPX_ASSERT(first == parcel_count);
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Parcelport, typename Buffer>
     void decode_message(
@@ -98,9 +284,12 @@ namespace hpx { namespace parcelset
             decode_chunks(buffer));
         boost::uint64_t inbound_data_size = buffer.data_size_;
 
-        // protect from un-handled exceptions bubbling up
-        try {
-            try {
+        std::vector<detail::parcel_offset_type> offsets;
+        std::size_t num_tasks = 0;
+
+        detail::decode_message_guarded(
+            [&]()
+            {
                 // mark start of serialization
                 util::high_resolution_timer timer;
                 boost::int64_t overall_add_parcel_time = 0;
@@ -113,35 +302,39 @@ namespace hpx { namespace parcelset
                         inbound_data_size, &chunks);
 
                     if(parcel_count == 0)
-                        archive >> parcel_count; //-V128
-                    for(std::size_t i = 0; i != parcel_count; ++i)
                     {
-                        // de-serialize parcel and add it to incoming parcel queue
-                        parcel p;
-                        archive >> p;
-                        // make sure this parcel ended up on the right locality
-
-                        naming::gid_type const& here = hpx::get_locality();
-                        if (hpx::get_runtime_ptr() && here &&
-                            (naming::get_locality_id_from_gid(
-                                 p.destination_locality()) !=
-                             naming::get_locality_id_from_gid(here)))
+                        archive >> parcel_count; //-V128
+
+                        // batches of parcels are preceded by an index of
+                        // parcel offsets, which is left zeroed if the
+                        // parcels can't be decoded independently
+                        if (parcel_count > 1)
                         {
-                            std::ostringstream os;
-                            os << "parcel destination does not match "
-                                  "locality which received the parcel ("
-                               << here << "), " << p;
-                            HPX_THROW_EXCEPTION(invalid_status,
-                                "hpx::parcelset::decode_message",
-                                os.str());
-                            return;
+                            offsets.resize(parcel_count);
+                            serialization::load_binary(archive, offsets.data(),
+                                parcel_count *
+                                    sizeof(detail::parcel_offset_type));
+
+                            if (chunks.empty() && hpx::is_running() &&
+                                boost::uint64_t(offsets[0]) != 0)
+                            {
+                                num_tasks = (std::min)(
+                                    hpx::get_os_thread_count(),
+                                    parcel_count /
+                                        detail::min_parcels_per_decode_task);
+                            }
+
+                            // leave the decoding to separate threads
+                            if (num_tasks > 1)
+                                return;
                         }
+                    }
 
-                        // be sure not to measure add_parcel as serialization time
-                        boost::int64_t add_parcel_time = timer.elapsed_nanoseconds();
-                        pp.add_received_parcel(std::move(p), num_thread);
-                        overall_add_parcel_time += timer.elapsed_nanoseconds() -
-                            add_parcel_time;
+                    for(std::size_t i = 0; i != parcel_count; ++i)
+                    {
+                        // de-serialize parcel and add it to incoming parcel queue
+                        overall_add_parcel_time += detail::decode_and_add_parcel(
+                            pp, archive, num_thread);
                     }
 
                     // complete received data with parcel count
@@ -154,36 +347,16 @@ namespace hpx { namespace parcelset
                     overall_add_parcel_time;
 
                 pp.add_received_data(data);
-            }
-            catch (hpx::exception const& e) {
-                LPT_(error)
-                    << "decode_message: caught hpx::exception: "
-                    << e.what();
-                hpx::report_error(boost::current_exception());
-            }
-            catch (boost::system::system_error const& e) {
-                LPT_(error)
-                    << "decode_message: caught boost::system::error: "
-                    << e.what();
-                hpx::report_error(boost::current_exception());
-            }
-            catch (boost::exception const&) {
-                LPT_(error)
-                    << "decode_message: caught boost::exception.";
-                hpx::report_error(boost::current_exception());
-            }
-            catch (std::exception const& e) {
-                // We have to repackage all exceptions thrown by the
-                // serialization library as otherwise we will loose the
-                // e.what() description of the problem, due to slicing.
-                boost::throw_exception(boost::enable_error_info(
-                    hpx::exception(serialization_error, e.what())));
-            }
-        }
-        catch (...) {
-            LPT_(error)
-                << "decode_message: caught unknown exception.";
-            hpx::report_error(boost::current_exception());
+            });
+
+        if (num_tasks > 1)
+        {
+            detail::decode_message_guarded(
+                [&]()
+                {
+                    detail::decode_parcels_parallel(pp, std::move(buffer),
+                        std::move(offsets), num_tasks, num_thread);
+                });
         }
     }
 
@@ -23,6 +23,7 @@
 
 #include <boost/cstdint.hpp>
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
@@ -119,6 +120,31 @@ namespace hpx
                 }
             }
 
+            // A batch of parcels is preceded by an index of the offsets of
+            // the parcels in the archive data, which allows to decode the
+            // parcels of a message concurrently. The index is filled in only
+            // if the parcels were written to the archive data in one piece
+            // (no compression, no zero-copy chunks), otherwise it is left
+            // zeroed and the receiver decodes the parcels sequentially.
+            template <typename Buffer, typename Offsets>
+            void encode_parcel_offsets(Buffer & buffer, std::size_t index_pos,
+                Offsets const& offsets)
+            {
+                for (serialization::serialization_chunk& c : buffer.chunks_)
+                {
+                    if (c.type_ == serialization::chunk_type_pointer)
+                        return;
+                }
+
+                std::size_t index_size =
+                    offsets.size() * sizeof(typename Offsets::value_type);
+                if (index_pos + index_size > buffer.data_.size())
+                    return;
+
+                std::memcpy(&buffer.data_[index_pos], offsets.data(),
+                    index_size);
+            }
+
             inline std::size_t
             get_archive_size(parcel const& p, boost::uint32_t flags,
                 boost::uint32_t dest_locality_id,
@@ -165,6 +191,11 @@ namespace hpx
                             typename Buffer::allocator_type
                         >::call(buffer.data_.get_allocator());
 
+                    // index of the parcel offsets (for batches of parcels)
+                    typedef util::integer::ulittle64_t offset_type;
+                    std::vector<offset_type> offsets;
+                    std::size_t index_pos = 0;
+
                     // preallocate data
                     for (/**/; parcels_sent != parcels_size; ++parcels_sent)
                     {
@@ -195,15 +226,36 @@ namespace hpx
                         if(num_parcels != std::size_t(-1))
                             archive << parcels_sent; //-V128
 
+                        // reserve space for the index of parcel offsets
+                        if (parcels_sent > 1)
+                        {
+                            offsets.resize(parcels_sent, offset_type(0));
+                            index_pos = archive.current_pos();
+                            serialization::save_binary(archive, offsets.data(),
+                                parcels_sent * sizeof(offset_type));
+                        }
+
                         for(std::size_t i = 0; i != parcels_sent; ++i)
                         {
                             LPT_(debug) << ps[i];
+                            if (!offsets.empty())
+                            {
+                                // each parcel has to be decodable on its own
+                                archive.reset_pointer_tracker();
+                                offsets[i] = archive.current_pos();
+                            }
                             archive << ps[i];
                         }
 
                         arg_size = archive.bytes_written();
                     }
 
+                    if (!offsets.empty() && filter.get() == 0)
+                    {
+                        detail::encode_parcel_offsets(
+                            buffer, index_pos, offsets);
+                    }
+
                     // store the time required for serialization
                     buffer.data_point_.serialization_time_ =
                         timer.elapsed_nanoseconds();
@@ -0,0 +1,119 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_RECEIVE_BUFFER_POOL_HPP
+#define HPX_PARCELSET_RECEIVE_BUFFER_POOL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/config/export_definitions.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The memory used for receiving messages is recycled through a pool
+        // of blocks, sorted into size classes (powers of two). Blocks larger
+        // than the largest size class are not pooled.
+        HPX_EXPORT void* receive_buffer_allocate(std::size_t size);
+        HPX_EXPORT void receive_buffer_deallocate(void* p, std::size_t size);
+
+        // Return the number of allocations which could (not) be satisfied
+        // from the pool
+        HPX_EXPORT boost::int64_t get_receive_buffer_pool_hits(bool reset);
+        HPX_EXPORT boost::int64_t get_receive_buffer_pool_misses(bool reset);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // This allocator draws its memory from the receive buffer pool. Elements
+    // constructed without arguments are default-initialized (i.e. left
+    // uninitialized for trivial types), which avoids zeroing the buffers
+    // before they are overwritten with the received data.
+    template <typename T>
+    struct receive_buffer_allocator
+    {
+        typedef T value_type;
+        typedef T* pointer;
+        typedef T const* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef receive_buffer_allocator<U> other;
+        };
+
+        receive_buffer_allocator() HPX_NOEXCEPT {}
+
+        template <typename U>
+        receive_buffer_allocator(receive_buffer_allocator<U> const&) HPX_NOEXCEPT
+        {}
+
+        pointer allocate(size_type n, void const* = 0)
+        {
+            return static_cast<pointer>(
+                detail::receive_buffer_allocate(n * sizeof(T)));
+        }
+
+        void deallocate(pointer p, size_type n)
+        {
+            detail::receive_buffer_deallocate(p, n * sizeof(T));
+        }
+
+        size_type max_size() const HPX_NOEXCEPT
+        {
+            return size_type(-1) / sizeof(T);
+        }
+
+        template <typename U>
+        void construct(U* p)
+        {
+            ::new (static_cast<void*>(p)) U;
+        }
+
+        template <typename U, typename... Ts>
+        void construct(U* p, Ts &&... ts)
+        {
+            ::new (static_cast<void*>(p)) U(std::forward<Ts>(ts)...);
+        }
+
+        template <typename U>
+        void destroy(U* p)
+        {
+            p->~U();
+        }
+    };
+
+    template <typename T, typename U>
+    bool operator==(receive_buffer_allocator<T> const&,
+        receive_buffer_allocator<U> const&) HPX_NOEXCEPT
+    {
+        return true;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(receive_buffer_allocator<T> const&,
+        receive_buffer_allocator<U> const&) HPX_NOEXCEPT
+    {
+        return false;
+    }
+
+    // The buffer type to be used for receiving the data of messages, the
+    // memory is given back to the pool as soon as the message was decoded.
+    typedef std::vector<char, receive_buffer_allocator<char> >
+        receive_buffer_type;
+}}
+
+#endif
@@ -133,6 +133,14 @@ namespace hpx { namespace serialization
             return basic_archive<input_archive>::current_pos();
         }
 
+        // Continue reading at the given position of the archive (as returned
+        // by current_pos() of the output_archive which wrote the data).
+        void set_position(std::size_t pos)
+        {
+            buffer_->set_position(pos);
+            size_ = pos;
+        }
+
     private:
         friend struct basic_archive<input_archive>;
         template <class T>
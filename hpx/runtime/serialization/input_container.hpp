@@ -154,6 +154,22 @@ namespace hpx { namespace serialization
             }
         }
 
+        // Continue reading at the given position in the (uncompressed)
+        // data, this is supported for archives without zero-copy chunks only.
+        void set_position(std::size_t pos) // override
+        {
+            HPX_ASSERT(!filter_ && chunks_ == 0);
+
+            if (pos > cont_.size())
+            {
+                HPX_THROW_EXCEPTION(serialization_error
+                  , "input_container::set_position"
+                  , "archive data bstream is too short");
+                return;
+            }
+            current_ = pos;
+        }
+
         Container const& cont_;
         std::size_t current_;
         std::unique_ptr<binary_filter> filter_;
@@ -108,6 +108,13 @@ namespace hpx { namespace serialization
             return basic_archive<output_archive>::current_pos();
         }
 
+        // Forget about all pointers serialized so far, the data written
+        // afterwards does not refer back to anything written before.
+        void reset_pointer_tracker()
+        {
+            pointer_tracker_.clear();
+        }
+
     private:
         friend struct basic_archive<output_archive>;
         template <class T>
@@ -64,8 +64,9 @@ namespace hpx { namespace threads { namespace coroutines
         typedef impl_type::pointer impl_ptr;
         typedef impl_type::thread_id_repr_type thread_id_repr_type;
 
-        typedef util::unique_function_nonser<
-            thread_state_enum(thread_state_ex_enum)
+        typedef util::unique_function<
+            thread_state_enum(thread_state_ex_enum), false,
+            HPX_THREAD_FUNCTION_STORAGE_SIZE
         > functor_type;
 
         coroutine() : m_pimpl(0) {}
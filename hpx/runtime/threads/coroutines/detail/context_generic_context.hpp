@@ -220,6 +220,9 @@ namespace hpx { namespace threads { namespace coroutines
                 if (ctx_ && stack_pointer_)
 #endif
                 {
+#if defined(_POSIX_VERSION)
+                    posix::release_stack_state(stack_state_, stack_size_);
+#endif
                     alloc_.deallocate(stack_pointer_, stack_size_);
 #if BOOST_VERSION < 105600
                     ctx_.fc_stack.size = 0;
@@ -291,6 +294,9 @@ namespace hpx { namespace threads { namespace coroutines
             stack_allocator alloc_;
             std::size_t stack_size_;
             void * stack_pointer_;
+#if defined(_POSIX_VERSION)
+            posix::stack_state stack_state_;
+#endif
         };
 
         typedef fcontext_context_impl context_impl;
@@ -201,7 +201,8 @@ namespace hpx { namespace threads { namespace coroutines
                     VALGRIND_STACK_DEREGISTER(
                         reinterpret_cast<std::size_t>(m_sp[valgrind_id_idx]));
 #endif
-                    posix::free_stack(m_stack, static_cast<std::size_t>(m_stack_size));
+                    posix::free_stack(m_stack,
+                        static_cast<std::size_t>(m_stack_size), m_stack_state);
                 }
             }
 
@@ -215,8 +216,8 @@ namespace hpx { namespace threads { namespace coroutines
             {
                 if (m_stack)
                 {
-                    if (posix::reset_stack(
-                        m_stack, static_cast<std::size_t>(m_stack_size)))
+                    if (posix::reset_stack(m_stack,
+                        static_cast<std::size_t>(m_stack_size), m_stack_state))
                         increment_stack_unbind_count();
                 }
             }
@@ -225,6 +226,7 @@ namespace hpx { namespace threads { namespace coroutines
             {
                 if (m_stack)
                 {
+                    posix::rebind_stack_state(m_stack_state);
                     increment_stack_recycle_count();
 
                     // On rebind, we initialize our stack to ensure a virgin stack
@@ -346,6 +348,7 @@ namespace hpx { namespace threads { namespace coroutines
 
             std::ptrdiff_t m_stack_size;
             void* m_stack;
+            posix::stack_state m_stack_state;
         };
 
         typedef x86_linux_context_impl context_impl;
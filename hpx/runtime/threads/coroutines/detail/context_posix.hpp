@@ -216,6 +216,7 @@ namespace hpx { namespace threads { namespace coroutines
                 cb_(&cb)
             {
                 HPX_ASSERT(m_stack);
+                watermark_stack(m_stack, static_cast<std::size_t>(m_stack_size));
                 funp_ = &trampoline<Functor>;
                 int error = HPX_COROUTINE_MAKE_CONTEXT(
                     &m_ctx, m_stack, m_stack_size, funp_, cb_, NULL);
@@ -226,7 +227,7 @@ namespace hpx { namespace threads { namespace coroutines
             ~ucontext_context_impl()
             {
                 if (m_stack)
-                    free_stack(m_stack, m_stack_size);
+                    free_stack(m_stack, m_stack_size, m_stack_state);
             }
 
             // Return the size of the reserved stack address space.
@@ -253,8 +254,8 @@ namespace hpx { namespace threads { namespace coroutines
             {
                 if (m_stack)
                 {
-                    if (posix::reset_stack(
-                        m_stack, static_cast<std::size_t>(m_stack_size)))
+                    if (posix::reset_stack(m_stack,
+                        static_cast<std::size_t>(m_stack_size), m_stack_state))
                         increment_stack_unbind_count();
                 }
             }
@@ -263,6 +264,7 @@ namespace hpx { namespace threads { namespace coroutines
             {
                 if (m_stack)
                 {
+                    posix::rebind_stack_state(m_stack_state);
                     // just reset the context stack pointer to its initial value at
                     // the stack start
                     increment_stack_recycle_count();
@@ -312,6 +314,7 @@ namespace hpx { namespace threads { namespace coroutines
             // declare m_stack_size first so we can use it to initialize m_stack
             std::ptrdiff_t m_stack_size;
             void * m_stack;
+            stack_state m_stack_state;
             void * cb_;
             void(*funp_)(void*);
         };
@@ -65,8 +65,9 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         typedef thread_state_ex_enum arg_type;
         typedef context_base::thread_id_repr_type thread_id_repr_type;
 
-        typedef util::unique_function_nonser<
-            thread_state_enum(thread_state_ex_enum)
+        typedef util::unique_function<
+            thread_state_enum(thread_state_ex_enum), false,
+            HPX_THREAD_FUNCTION_STORAGE_SIZE
         > functor_type;
 
         typedef boost::intrusive_ptr<coroutine_impl> pointer;
@@ -30,6 +30,7 @@
 #define HPX_RUNTIME_THREADS_COROUTINES_DETAIL_SELF_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/throw_exception.hpp>
 #include <hpx/runtime/threads/thread_enums.hpp>
 #include <hpx/runtime/threads/coroutines/detail/coroutine_accessor.hpp>
 #include <hpx/runtime/threads/coroutines/detail/coroutine_impl.hpp>
@@ -84,7 +85,13 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         arg_type yield_impl(result_type arg)
         {
-            HPX_ASSERT(m_pimpl);
+            if (!m_pimpl)
+            {
+                HPX_THROW_EXCEPTION(invalid_status,
+                    "coroutine_self::yield_impl",
+                    "a thread running without its own stack can't be "
+                    "suspended");
+            }
 
             this->m_pimpl->bind_result(&arg);
 
@@ -131,21 +138,18 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         bool pending() const
         {
-            HPX_ASSERT(m_pimpl);
-            return m_pimpl->pending() != 0;
+            return m_pimpl ? m_pimpl->pending() != 0 : false;
         }
 
         thread_id_repr_type get_thread_id() const
         {
-            HPX_ASSERT(m_pimpl);
-            return m_pimpl->get_thread_id();
+            return m_pimpl ? m_pimpl->get_thread_id() : stackless_id_;
         }
 
         std::size_t get_thread_phase() const
         {
 #if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
-            HPX_ASSERT(m_pimpl);
-            return m_pimpl->get_thread_phase();
+            return m_pimpl ? m_pimpl->get_thread_phase() : 0;
 #else
             return 0;
 #endif
@@ -154,44 +158,79 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         std::ptrdiff_t get_available_stack_space()
         {
 #if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
-            return m_pimpl->get_available_stack_space();
-#else
-            return (std::numeric_limits<std::ptrdiff_t>::max)();
+            if (m_pimpl)
+                return m_pimpl->get_available_stack_space();
 #endif
+            return (std::numeric_limits<std::ptrdiff_t>::max)();
         }
 
         explicit coroutine_self(impl_type * pimpl, coroutine_self* next_self = 0)
-          : m_pimpl(pimpl), next_self_(next_self)
+          : m_pimpl(pimpl), next_self_(next_self),
+            stackless_id_(0), stackless_recursion_count_(0),
+            stackless_tss_(0)
         {}
 
+        // Create the self object for a thread which is executed directly on
+        // the stack of the invoking worker thread (see
+        // thread_stacksize_nostack). Such a thread can't be suspended. Its
+        // thread specific storage is owned by the thread object, as it has
+        // to outlive the self object.
+        struct stackless_tag {};
+
+        coroutine_self(thread_id_repr_type id, coroutine_self* next_self,
+                tss_storage** tss, stackless_tag)
+          : m_pimpl(0), next_self_(next_self),
+            stackless_id_(id), stackless_recursion_count_(0),
+            stackless_tss_(tss)
+        {
+            HPX_ASSERT(tss);
+        }
+
+        bool is_stackless() const
+        {
+            return m_pimpl == 0;
+        }
+
 #if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
         std::size_t get_thread_data() const
         {
-            HPX_ASSERT(m_pimpl);
+            if (!m_pimpl)
+            {
+                return *stackless_tss_ ?
+                    get_tss_thread_data(*stackless_tss_) : 0;
+            }
             return m_pimpl->get_thread_data();
         }
         std::size_t set_thread_data(std::size_t data)
         {
-            HPX_ASSERT(m_pimpl);
+            if (!m_pimpl)
+                return set_tss_thread_data(*stackless_tss_, data);
             return m_pimpl->set_thread_data(data);
         }
 
         tss_storage* get_thread_tss_data()
         {
-            HPX_ASSERT(m_pimpl);
+            if (!m_pimpl)
+                return *stackless_tss_;
             return m_pimpl->get_thread_tss_data(false);
         }
 
         tss_storage* get_or_create_thread_tss_data()
         {
-            HPX_ASSERT(m_pimpl);
+            if (!m_pimpl)
+            {
+                if (!*stackless_tss_)
+                    *stackless_tss_ = create_tss_storage();
+                return *stackless_tss_;
+            }
             return m_pimpl->get_thread_tss_data(true);
         }
 #endif
 
         std::size_t& get_continuation_recursion_count()
         {
-            HPX_ASSERT(m_pimpl);
+            if (!m_pimpl)
+                return stackless_recursion_count_;
             return m_pimpl->get_continuation_recursion_count();
         }
 
@@ -210,6 +249,11 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         }
         impl_ptr m_pimpl;
         coroutine_self* next_self_;
+
+        // data used by stackless threads only
+        thread_id_repr_type stackless_id_;
+        std::size_t stackless_recursion_count_;
+        tss_storage** stackless_tss_;
     };
 }}}}
 
@@ -49,6 +49,10 @@
 #include <cstdlib>
 #include <stdexcept>
 
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/type_traits/type_with_alignment.hpp>
 
 #if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
@@ -77,48 +81,73 @@ namespace posix
 {
     HPX_EXPORT extern bool use_guard_pages;
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Stacks are carved out of slabs holding stack_slab_size stacks each,
+    // the slabs are optionally backed by huge pages.
+    enum huge_pages_mode
+    {
+        huge_pages_none = 0,            ///< use normal pages only
+        huge_pages_transparent = 1,     ///< advise the kernel to use THP
+        huge_pages_explicit = 2         ///< map slabs using MAP_HUGETLB
+    };
+
+    // Control what happens to the memory of a stack if the stack was used
+    // beyond its first page and its thread object is being recycled.
+    enum stack_release_policy
+    {
+        release_always = 0,             ///< always give the memory back
+        release_never = 1,              ///< keep the memory committed
+        release_high_water_mark = 2,    ///< keep up to stack_high_water_mark
+        release_idle_timeout = 3        ///< release rarely recycled stacks
+    };
+
+    HPX_EXPORT extern std::size_t stack_slab_size;
+    HPX_EXPORT extern huge_pages_mode use_huge_pages;
+    HPX_EXPORT extern stack_release_policy release_policy;
+    HPX_EXPORT extern std::size_t stack_high_water_mark;    // in bytes
+    HPX_EXPORT extern boost::uint64_t stack_idle_timeout;   // in milliseconds
+
+    // Per-stack bookkeeping needed by the release policies.
+    struct stack_state
+    {
+        stack_state()
+          : committed_(false), last_reset_(0), idle_(false)
+        {}
+
+        bool committed_;                // accounted for in committed memory
+        boost::uint64_t last_reset_;    // time of last reset_stack (in ns)
+        boost::atomic<bool> idle_;      // registered by register_idle_stack
+    };
+
 #if defined(HPX_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) \
  && _POSIX_MAPPED_FILES > 0
 
-    inline void* alloc_stack(std::size_t size)
-    {
-        void* real_stack = ::mmap(NULL,
-            size + EXEC_PAGESIZE,
-            PROT_EXEC | PROT_READ | PROT_WRITE,
-#if defined(__APPLE__)
-            MAP_PRIVATE | MAP_ANON | MAP_NORESERVE,
-#else
-            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
-#endif
-            -1,
-            0
-            );
+    // Allocate a stack from the slab pool of the calling worker thread, a new
+    // slab is mapped if the pool does not hold any stack of the given size.
+    HPX_EXPORT void* alloc_stack(std::size_t size);
 
-        if (real_stack == MAP_FAILED)
-        {
-            if (ENOMEM == errno)
-                throw std::runtime_error("mmap() failed to allocate thread stack due "
-                    "to insufficient resources, "
-                    "increase /proc/sys/vm/max_map_count or add "
-                    "-Ihpx.stacks.use_guard_pages=0 to the command line");
-            else
-                throw std::runtime_error("mmap() failed to allocate thread stack");
-        }
+    // Return a stack to the slab pool of the calling worker thread.
+    HPX_EXPORT void free_stack(void* stack, std::size_t size);
 
-#if defined(HPX_HAVE_THREAD_GUARD_PAGE)
-        if (use_guard_pages)
-        {
-            // Add a guard page.
-            ::mprotect(real_stack, EXEC_PAGESIZE, PROT_NONE);
+    // Return the amount of stack memory currently kept committed by the
+    // release_high_water_mark policy.
+    HPX_EXPORT boost::atomic<std::size_t>& get_committed_stack_memory();
 
-            void** stack = static_cast<void**>(real_stack) + (EXEC_PAGESIZE
-                / sizeof(void*));
-            return static_cast<void*>(stack);
-        }
-        return real_stack;
-#else
-        return real_stack;
-#endif
+    // The release_idle_timeout policy keeps the memory of a recycled stack
+    // committed until the stack is either reused or its memory is given back
+    // by release_idle_stacks().
+    HPX_EXPORT void register_idle_stack(void* stack, std::size_t size,
+        stack_state& state);
+    HPX_EXPORT void unregister_idle_stack(stack_state& state);
+
+    // Give back the memory of stacks which were not reused for
+    // stack_idle_timeout milliseconds and unmap slabs none of whose stacks
+    // were used for the same time. This is called by idling worker threads.
+    HPX_EXPORT void release_idle_stacks();
+
+    inline bool release_stack_memory(void* stack, std::size_t size)
+    {
+        return ::madvise(stack, size, MADV_DONTNEED) == 0;
     }
 
     inline void watermark_stack(void* stack, std::size_t size)
@@ -131,37 +160,81 @@ namespace posix
         *watermark = reinterpret_cast<void*>(0xDEADBEEFDEADBEEFull);
     }
 
-    inline bool reset_stack(void* stack, std::size_t size)
+    inline bool reset_stack(void* stack, std::size_t size, stack_state& state)
     {
         void** watermark = static_cast<void**>(stack) + ((size - EXEC_PAGESIZE)
             / sizeof(void*));
 
-        // If the watermark has been overwritten, then we've gone past the first
-        // page.
-        if ((reinterpret_cast<void*>(0xDEADBEEFDEADBEEFull)) != *watermark)
+        // If the watermark is still intact, then we've never gone past the
+        // first page.
+        if ((reinterpret_cast<void*>(0xDEADBEEFDEADBEEFull)) == *watermark)
+            return false;
+
+        std::size_t const used = size - EXEC_PAGESIZE;
+        switch (release_policy)
         {
-            // We never free up the first page, as it's initialized only when the
-            // stack is created.
-            ::madvise(stack, size - EXEC_PAGESIZE, MADV_DONTNEED);
-            return true;
+        case release_never:
+            return false;
+
+        case release_high_water_mark:
+            {
+                if (state.committed_)
+                    return false;           // already accounted for
+
+                boost::atomic<std::size_t>& committed =
+                    get_committed_stack_memory();
+                if (committed.fetch_add(used) + used <= stack_high_water_mark)
+                {
+                    state.committed_ = true;
+                    return false;
+                }
+                committed.fetch_sub(used);
+            }
+            break;
+
+        case release_idle_timeout:
+            // keep the memory until the stack is either reused or
+            // release_idle_stacks() finds it idle for too long
+            state.last_reset_ = hpx::util::high_resolution_clock::now();
+            register_idle_stack(stack, size, state);
+            return false;
+
+        case release_always:
+        default:
+            break;
         }
 
-        return false;
+        // We never free up the first page, as it's initialized only when the
+        // stack is created. Re-arm the watermark to be able to detect whether
+        // the released pages are touched again.
+        if (!release_stack_memory(stack, used))
+            return false;           // the memory is still committed
+
+        *watermark = reinterpret_cast<void*>(0xDEADBEEFDEADBEEFull);
+        return true;
     }
 
-    inline void free_stack(void* stack, std::size_t size)
+    // Called before a recycled stack is reused.
+    inline void rebind_stack_state(stack_state& state)
+    {
+        if (state.idle_.load(boost::memory_order_acquire))
+            unregister_idle_stack(state);
+    }
+
+    inline void release_stack_state(stack_state& state, std::size_t size)
     {
-#if defined(HPX_HAVE_THREAD_GUARD_PAGE)
-        if (use_guard_pages) {
-            void** real_stack =
-                static_cast<void**>(stack) - (EXEC_PAGESIZE / sizeof(void*));
-            ::munmap(static_cast<void*>(real_stack), size + EXEC_PAGESIZE);
-        } else {
-            ::munmap(stack, size);
+        rebind_stack_state(state);
+        if (state.committed_)
+        {
+            get_committed_stack_memory().fetch_sub(size - EXEC_PAGESIZE);
+            state.committed_ = false;
         }
-#else
-        ::munmap(stack, size);
-#endif
+    }
+
+    inline void free_stack(void* stack, std::size_t size, stack_state& state)
+    {
+        release_stack_state(state, size);
+        free_stack(stack, size);
     }
 
 #else  // non-mmap()
@@ -192,16 +265,30 @@ namespace posix
     inline void watermark_stack(void* stack, std::size_t size)
     {} // no-op
 
-    inline bool reset_stack(void* stack, std::size_t size)
+    inline bool reset_stack(void* stack, std::size_t size, stack_state&)
     {
         return false;
     }
 
+    inline void rebind_stack_state(stack_state&)
+    {}
+
+    inline void release_stack_state(stack_state&, std::size_t)
+    {}
+
+    inline void release_idle_stacks()
+    {}
+
     inline void free_stack(void* stack, std::size_t size)
     {
         delete[] static_cast<stack_aligner*>(stack);
     }
 
+    inline void free_stack(void* stack, std::size_t size, stack_state&)
+    {
+        free_stack(stack, size);
+    }
+
 #endif  // non-mmap() implementation of alloc_stack()/free_stack()
 
     /**
@@ -82,18 +82,22 @@ namespace hpx { namespace threads { namespace detail
         }
 
         // create the new thread
+        std::size_t num_thread = data.num_os_thread;
         if (thread_priority_critical == data.priority ||
             thread_priority_boost == data.priority)
         {
             // For critical priority threads, create the thread immediately.
             scheduler->create_thread(data, 0, initial_state, true, ec,
-                data.num_os_thread);
+                num_thread);
         }
         else {
             // Create a task description for the new thread.
             scheduler->create_thread(data, 0, initial_state, false, ec,
-                data.num_os_thread);
+                num_thread);
         }
+
+        // potentially wake up waiting thread
+        scheduler->do_some_work(num_thread);
     }
 }}}
 
@@ -29,6 +29,17 @@ namespace hpx { namespace threads { namespace detail
         return state == state_running || state == state_suspended;
     }
 
+    // Worker threads removed from a running scheduler are marked suspended
+    // (see scheduler_base::suspend_punit), their periodic maintenance stops.
+    template <typename SchedulingPolicy>
+    inline bool is_running_state(SchedulingPolicy const& scheduler,
+        hpx::state state)
+    {
+        if (state == state_suspended && scheduler.supports_punit_removal())
+            return false;
+        return is_running_state(state);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename SchedulingPolicy>
     inline void periodic_maintenance_handler(SchedulingPolicy& scheduler,
@@ -40,7 +51,7 @@ namespace hpx { namespace threads { namespace detail
     inline void periodic_maintenance_handler(SchedulingPolicy& scheduler,
         boost::atomic<hpx::state>& global_state, boost::mpl::true_)
     {
-        bool running = is_running_state(global_state.load());
+        bool running = is_running_state(scheduler, global_state.load());
         scheduler.periodic_maintenance(running);
 
         if (running)
@@ -74,7 +85,8 @@ namespace hpx { namespace threads { namespace detail
     inline void start_periodic_maintenance(SchedulingPolicy& scheduler,
         boost::atomic<hpx::state>& global_state, boost::mpl::true_)
     {
-        scheduler.periodic_maintenance(is_running_state(global_state.load()));
+        scheduler.periodic_maintenance(
+            is_running_state(scheduler, global_state.load()));
 
         // create timer firing in correspondence with given time
         typedef boost::asio::basic_deadline_timer<
@@ -14,12 +14,16 @@
 #include <hpx/runtime/get_config_entry.hpp>
 #include <hpx/util/itt_notify.hpp>
 #include <hpx/util/hardware/timestamp.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/function.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
 
 #include <boost/cstdint.hpp>
 
+#if defined(HPX_HAVE_THREAD_STACK_MMAP)
+#include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#endif
 #if defined(HPX_HAVE_APEX)
 #include <hpx/util/apex.hpp>
 #endif
@@ -222,17 +226,24 @@ namespace hpx { namespace threads { namespace detail
                 std::size_t max_background_threads =
                     hpx::util::safe_lexical_cast<std::size_t>(
                         hpx::get_config_entry("hpx.max_background_threads",
-                            (std::numeric_limits<std::size_t>::max)())))
+                            (std::numeric_limits<std::size_t>::max)())),
+                boost::int64_t max_idle_loop_count =
+                    hpx::util::safe_lexical_cast<boost::int64_t>(
+                        hpx::get_config_entry("hpx.max_idle_loop_count",
+                            std::size_t(HPX_IDLE_LOOP_COUNT_MAX)),
+                        HPX_IDLE_LOOP_COUNT_MAX))
           : outer_(std::move(outer)),
             inner_(std::move(inner)),
             background_(std::move(background)),
-            max_background_threads_(max_background_threads)
+            max_background_threads_(max_background_threads),
+            max_idle_loop_count_(max_idle_loop_count)
         {}
 
         callback_type outer_;
         callback_type inner_;
         background_callback_type background_;
         std::size_t max_background_threads_;
+        boost::int64_t max_idle_loop_count_;    // idle loops before calling outer_
     };
 
     template <typename SchedulingPolicy>
@@ -395,6 +406,13 @@ namespace hpx { namespace threads { namespace detail
 #ifdef HPX_HAVE_THREAD_CUMULATIVE_COUNTS
                     ++counters.executed_threads_;
 #endif
+                    boost::uint64_t deadline = thrd->get_deadline();
+                    if (deadline != 0 &&
+                        hpx::util::high_resolution_clock::now() > deadline)
+                    {
+                        scheduler.SchedulingPolicy::record_deadline_miss(
+                            num_thread);
+                    }
                     scheduler.SchedulingPolicy::destroy_thread(thrd, busy_loop_count);
                 }
             }
@@ -438,8 +456,17 @@ namespace hpx { namespace threads { namespace detail
             }
 
             // something went badly wrong, give up
-            if (this_state.load() == state_terminating)
+            hpx::state current_state = this_state.load();
+            if (current_state == state_terminating)
+                break;
+
+            // this worker thread was removed from the scheduler, its remaining
+            // work is handed to the other worker threads by the thread pool
+            if (current_state == state_suspended &&
+                scheduler.SchedulingPolicy::supports_punit_removal())
+            {
                 break;
+            }
 
             if (busy_loop_count > HPX_BUSY_LOOP_COUNT_MAX)
             {
@@ -455,16 +482,21 @@ namespace hpx { namespace threads { namespace detail
                 }
             }
             else if ((scheduler.get_scheduler_mode() & policies::fast_idle_mode) ||
-                idle_loop_count > HPX_IDLE_LOOP_COUNT_MAX)
+                idle_loop_count > callbacks.max_idle_loop_count_)
             {
                 // clean up terminated threads
-                if (idle_loop_count > HPX_IDLE_LOOP_COUNT_MAX)
+                if (idle_loop_count > callbacks.max_idle_loop_count_)
                     idle_loop_count = 0;
 
                 // call back into invoking context
                 if (!callbacks.outer_.empty())
                     callbacks.outer_();
 
+#if defined(HPX_HAVE_THREAD_STACK_MMAP)
+                // give back the memory of stacks which were not used recently
+                coroutines::detail::posix::release_idle_stacks();
+#endif
+
                 // break if we were idling after 'may_exit'
                 if (may_exit)
                 {
@@ -50,6 +50,11 @@ namespace hpx { namespace threads { namespace detail
         template <typename Lock>
         void stop_locked(Lock& l, bool blocking = true);
 
+        void add_processing_unit(std::unique_lock<boost::mutex>& l,
+            std::size_t virt_core, std::size_t thread_num, error_code& ec);
+        void remove_processing_unit(std::unique_lock<boost::mutex>& l,
+            std::size_t virt_core, error_code& ec);
+
         std::size_t get_worker_thread_num() const;
         std::size_t get_os_thread_count() const
         {
@@ -97,6 +102,9 @@ namespace hpx { namespace threads { namespace detail
         boost::int64_t avg_idle_rate(bool reset);
         boost::int64_t avg_idle_rate(std::size_t num_thread, bool reset);
 
+        void get_idle_rate_times(boost::uint64_t& exec_time,
+            boost::uint64_t& total_time) const;
+
 #if defined(HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES)
         boost::int64_t avg_creation_idle_rate(bool reset);
         boost::int64_t avg_cleanup_idle_rate(bool reset);
@@ -120,8 +128,16 @@ namespace hpx { namespace threads { namespace detail
         boost::int64_t get_num_stolen_to_pending(std::size_t num, bool reset);
         boost::int64_t get_num_stolen_from_staged(std::size_t num, bool reset);
         boost::int64_t get_num_stolen_to_staged(std::size_t num, bool reset);
+        boost::int64_t get_average_steal_batch_size(std::size_t num,
+            bool reset);
 #endif
 
+        boost::int64_t get_parked_time(std::size_t num, bool reset);
+        boost::int64_t get_average_wakeup_latency(std::size_t num, bool reset);
+        boost::int64_t get_deadline_misses(std::size_t num, bool reset);
+        boost::int64_t get_active_processing_units(std::size_t num,
+            bool reset);
+
         boost::int64_t get_thread_count(thread_state_enum state,
             thread_priority priority, std::size_t num_thread, bool reset) const;
 
@@ -149,7 +165,9 @@ namespace hpx { namespace threads { namespace detail
         void deinit_tss();
 
         void thread_func(std::size_t num_thread, topology const& topology,
-            boost::barrier& startup);
+            boost::barrier* startup);
+
+        void update_used_processing_units(topology const& topology);
 
     private:
         // this thread manager has exactly as many OS-threads as requested
@@ -0,0 +1,124 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_EXECUTORS_DEADLINE_EXECUTOR_HPP)
+#define HPX_RUNTIME_THREADS_EXECUTORS_DEADLINE_EXECUTOR_HPP
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime/threads/policies/scheduler_mode.hpp>
+#include <hpx/runtime/threads/thread_executor.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <boost/chrono/chrono.hpp>
+#include <boost/cstdint.hpp>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace threads { namespace executors
+{
+    namespace detail
+    {
+        class HPX_EXPORT deadline_executor
+          : public threads::detail::scheduled_executor_base
+        {
+        public:
+            // Every thread created by this executor has to finish within
+            // rel_deadline after it was scheduled.
+            deadline_executor(
+                boost::chrono::steady_clock::duration const& rel_deadline,
+                thread_priority priority, thread_stacksize stacksize);
+
+            // Every thread created by this executor has to finish until
+            // abs_deadline.
+            deadline_executor(
+                boost::chrono::steady_clock::time_point const& abs_deadline,
+                thread_priority priority, thread_stacksize stacksize);
+
+            // Schedule the specified function for execution in this executor.
+            // Depending on the subclass implementation, this may block in some
+            // situations.
+            void add(closure_type && f,
+                util::thread_description const& description,
+                threads::thread_state_enum initial_state, bool run_now,
+                threads::thread_stacksize stacksize, error_code& ec);
+
+            // Schedule given function for execution in this executor no sooner
+            // than time abs_time. This call never blocks, and may violate
+            // bounds on the executor's queue size.
+            void add_at(
+                boost::chrono::steady_clock::time_point const& abs_time,
+                closure_type && f, util::thread_description const& description,
+                threads::thread_stacksize stacksize, error_code& ec);
+
+            // Schedule given function for execution in this executor no sooner
+            // than time rel_time from now. This call never blocks, and may
+            // violate bounds on the executor's queue size.
+            inline void add_after(
+                boost::chrono::steady_clock::duration const& rel_time,
+                closure_type && f, util::thread_description const& description,
+                threads::thread_stacksize stacksize, error_code& ec)
+            {
+                return add_at(boost::chrono::steady_clock::now() + rel_time,
+                    std::move(f), description, stacksize, ec);
+            }
+
+            // Return an estimate of the number of waiting tasks.
+            boost::uint64_t num_pending_closures(error_code& ec) const;
+
+            // Reset internal (round robin) thread distribution scheme
+            void reset_thread_distribution();
+
+            /// Set the new scheduler mode
+            void set_scheduler_mode(threads::policies::scheduler_mode mode);
+
+        protected:
+            static threads::thread_state_enum thread_function_nullary(
+                closure_type func);
+
+            // Return the requested policy element
+            std::size_t get_policy_element(
+                threads::detail::executor_parameter p, error_code& ec) const;
+
+            // Return the absolute deadline (see thread_init_data::deadline)
+            // for a thread which is scheduled now
+            boost::uint64_t get_deadline() const;
+
+        private:
+            boost::uint64_t rel_deadline_;      // in nanoseconds
+            boost::uint64_t abs_deadline_;      // in nanoseconds
+            thread_stacksize stacksize_;
+            thread_priority priority_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The deadline_executor attaches a deadline to each of the HPX-threads it
+    /// creates. The deadline scheduler (--hpx:queuing=deadline) runs
+    /// HPX-threads in the order of their deadlines, all schedulers count the
+    /// HPX-threads finishing after their deadline
+    /// (/threads/count/deadline-misses).
+    struct deadline_executor : public scheduled_executor
+    {
+        explicit deadline_executor(
+                boost::chrono::steady_clock::duration const& rel_deadline,
+                thread_priority priority = thread_priority_default,
+                thread_stacksize stacksize = thread_stacksize_default)
+          : scheduled_executor(new detail::deadline_executor(
+                rel_deadline, priority, stacksize))
+        {}
+
+        explicit deadline_executor(
+                boost::chrono::steady_clock::time_point const& abs_deadline,
+                thread_priority priority = thread_priority_default,
+                thread_stacksize stacksize = thread_stacksize_default)
+          : scheduled_executor(new detail::deadline_executor(
+                abs_deadline, priority, stacksize))
+        {}
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
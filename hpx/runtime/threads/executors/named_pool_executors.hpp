@@ -0,0 +1,84 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_EXECUTORS_NAMED_POOL_EXECUTORS_HPP)
+#define HPX_RUNTIME_THREADS_EXECUTORS_NAMED_POOL_EXECUTORS_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/exception_fwd.hpp>
+#include <hpx/runtime/threads/thread_executor.hpp>
+#include <hpx/runtime/threads/executors/thread_pool_os_executors.hpp>
+
+#include <boost/intrusive_ptr.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace util
+{
+    class section;
+}}
+
+namespace hpx { namespace threads { namespace executors
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Create a new thread pool which can be referred to by its name.
+    ///
+    /// Each named pool runs its own OS threads, managed by its own instance
+    /// of the given scheduling policy. It is independent of the thread pool
+    /// of the runtime and of all other named pools.
+    ///
+    /// \param name         [in] The name of the new pool. The name must not
+    ///                     contain any of the characters '#', '/', '{', or
+    ///                     '}' as it is used in the names of the performance
+    ///                     counters of the pool.
+    /// \param scheduler    [in] The scheduling policy of the pool, one of
+    ///                     'local', 'local-priority', 'static',
+    ///                     'static-priority', 'chase-lev-priority', or
+    ///                     'deadline' (as supported by \a --hpx:queuing).
+    /// \param num_threads  [in] The number of OS threads to run.
+    /// \param affinity_desc [in] The mapping of the OS threads of the pool
+    ///                     to processing units, as supported by
+    ///                     \a --hpx:bind.
+    ///
+    HPX_EXPORT void create_named_pool(std::string const& name,
+        std::string const& scheduler, std::size_t num_threads,
+        std::string const& affinity_desc = "", error_code& ec = throws);
+
+    /// Return whether a thread pool with the given name exists.
+    HPX_EXPORT bool has_named_pool(std::string const& name);
+
+    /// Return the names of all existing named thread pools.
+    HPX_EXPORT std::vector<std::string> get_named_pools();
+
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+        HPX_EXPORT boost::intrusive_ptr<thread_pool_os_executor_base>
+            get_named_pool(std::string const& name, error_code& ec = throws);
+
+        // create all pools described in the [hpx.threadpools] section
+        HPX_EXPORT void create_named_pools(util::section const& ini);
+
+        // stop all named pools, they are removed during shutdown
+        HPX_EXPORT void remove_named_pools();
+        /// \endcond
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// An executor scheduling all work on the thread pool with the given
+    /// name. All named_pool_executors referring to the same pool share it.
+    struct HPX_EXPORT named_pool_executor : public scheduled_executor
+    {
+        explicit named_pool_executor(std::string const& pool_name);
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -7,6 +7,7 @@
 #define HPX_RUNTIME_THREADS_EXECUTORS_OS_POOL_EXECUTORS_AUG_22_2015_0319PM
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
 #include <hpx/runtime/threads/thread_executor.hpp>
 #include <hpx/runtime/threads/detail/thread_pool.hpp>
 #include <hpx/runtime/threads/policies/callback_notifier.hpp>
@@ -15,6 +16,7 @@
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/atomic.hpp>
 #include <boost/chrono.hpp>
+#include <boost/cstdint.hpp>
 
 #include <string>
 
@@ -24,14 +26,47 @@ namespace hpx { namespace threads { namespace executors
 {
     namespace detail
     {
+        //////////////////////////////////////////////////////////////////////
+        // Common interface of the executors running their own pool of OS
+        // threads. It exposes the name of the pool and the values needed
+        // for the performance counters of the pool.
+        class HPX_EXPORT thread_pool_os_executor_base
+          : public threads::detail::scheduled_executor_base
+        {
+        public:
+            virtual std::string const& get_name() const = 0;
+            virtual std::size_t get_os_thread_count() const = 0;
+
+            virtual boost::int64_t get_thread_count(thread_state_enum state,
+                thread_priority priority, std::size_t num_thread,
+                bool reset) const = 0;
+            virtual boost::int64_t get_queue_length(
+                std::size_t num_thread) const = 0;
+            virtual boost::int64_t get_cumulative_duration(std::size_t num,
+                bool reset) = 0;
+            virtual boost::int64_t get_active_processing_units(
+                std::size_t num, bool reset) = 0;
+#if defined(HPX_HAVE_THREAD_CUMULATIVE_COUNTS)
+            virtual boost::int64_t get_executed_threads(std::size_t num,
+                bool reset) = 0;
+#endif
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+            // std::size_t(-1) returns the average over all worker threads
+            virtual boost::int64_t avg_idle_rate(std::size_t num,
+                bool reset) = 0;
+#endif
+        };
+
         //////////////////////////////////////////////////////////////////////
         template <typename Scheduler>
         class HPX_EXPORT thread_pool_os_executor
-          : public threads::detail::scheduled_executor_base
+          : public thread_pool_os_executor_base
         {
         public:
+            // an empty name generates a unique name for the pool
             thread_pool_os_executor(std::size_t num_threads,
-                std::string const& affinity_desc = "");
+                std::string const& affinity_desc = "",
+                std::string const& name = "");
             ~thread_pool_os_executor();
 
             // Schedule the specified function for execution in this executor.
@@ -78,6 +113,52 @@ namespace hpx { namespace threads { namespace executors
                 pool_.set_scheduler_mode(mode);
             }
 
+            // Access to the pool used by its performance counters
+            std::string const& get_name() const
+            {
+                return executor_name_;
+            }
+            std::size_t get_os_thread_count() const
+            {
+                return num_threads_;
+            }
+
+            boost::int64_t get_thread_count(thread_state_enum state,
+                thread_priority priority, std::size_t num_thread,
+                bool reset) const
+            {
+                return pool_.get_thread_count(state, priority, num_thread,
+                    reset);
+            }
+            boost::int64_t get_queue_length(std::size_t num_thread) const
+            {
+                return pool_.get_queue_length(num_thread);
+            }
+            boost::int64_t get_cumulative_duration(std::size_t num,
+                bool reset)
+            {
+                return pool_.get_cumulative_duration(num, reset);
+            }
+            boost::int64_t get_active_processing_units(std::size_t num,
+                bool reset)
+            {
+                return pool_.get_active_processing_units(num, reset);
+            }
+#if defined(HPX_HAVE_THREAD_CUMULATIVE_COUNTS)
+            boost::int64_t get_executed_threads(std::size_t num, bool reset)
+            {
+                return pool_.get_executed_threads(num, reset);
+            }
+#endif
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+            boost::int64_t avg_idle_rate(std::size_t num, bool reset)
+            {
+                if (num == std::size_t(-1))
+                    return pool_.avg_idle_rate(reset);
+                return pool_.avg_idle_rate(num, reset);
+            }
+#endif
+
         protected:
             // Return the requested policy element
             std::size_t get_policy_element(
@@ -67,6 +67,7 @@ namespace hpx { namespace threads { namespace policies { namespace detail
 
         void add_punit(std::size_t virt_core, std::size_t thread_num,
             topology const& topology);
+        void rebind_punit(std::size_t virt_core, std::size_t thread_num);
 
     protected:
         void init_cached_pu_nums(std::size_t hardware_concurrency,
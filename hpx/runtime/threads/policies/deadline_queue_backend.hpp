@@ -0,0 +1,157 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADS_POLICIES_DEADLINE_QUEUE_BACKEND_HPP)
+#define HPX_THREADS_POLICIES_DEADLINE_QUEUE_BACKEND_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_DEADLINE_SCHEDULER)
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/util/spinlock.hpp>
+#include <hpx/util/tuple.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace hpx { namespace threads { namespace policies
+{
+    struct deadline_edf;
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // extract the deadline from the items stored in the thread queues
+        inline boost::uint64_t get_deadline(thread_data const* thrd)
+        {
+            return thrd->get_deadline();
+        }
+
+        inline boost::uint64_t get_deadline(thread_init_data const& data)
+        {
+            return data.deadline;
+        }
+
+        template <typename Tuple>
+        inline boost::uint64_t get_deadline(Tuple const* t)
+        {
+            return get_deadline(util::get<0>(*t));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Earliest deadline first: items are popped in the order of their
+    // deadlines, both by the owning worker thread and by stealing worker
+    // threads. Items without a deadline are ordered after all items with a
+    // deadline, in FIFO order.
+    template <typename T>
+    struct deadline_edf_backend
+    {
+        typedef T value_type;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef boost::uint64_t size_type;
+
+    private:
+        typedef hpx::util::spinlock mutex_type;
+
+        struct entry
+        {
+            entry(boost::uint64_t deadline, boost::uint64_t sequence,
+                    const_reference value)
+              : deadline_(deadline), sequence_(sequence), value_(value)
+            {}
+
+            boost::uint64_t deadline_;
+            boost::uint64_t sequence_;
+            T value_;
+        };
+
+        // std::push_heap/pop_heap build a max-heap, the comparison puts
+        // later deadlines first to turn it into a min-heap
+        struct later
+        {
+            bool operator()(entry const& lhs, entry const& rhs) const
+            {
+                if (lhs.deadline_ != rhs.deadline_)
+                    return lhs.deadline_ > rhs.deadline_;
+                return lhs.sequence_ > rhs.sequence_;
+            }
+        };
+
+    public:
+        deadline_edf_backend(
+            size_type initial_size = 0
+          , size_type num_thread = size_type(-1)
+            )
+          : sequence_(0), size_(0)
+        {
+            heap_.reserve(std::size_t(initial_size));
+        }
+
+        bool push(const_reference val, bool /*other_end*/ = false)
+        {
+            boost::uint64_t deadline = detail::get_deadline(val);
+            if (deadline == 0)
+                deadline = (std::numeric_limits<boost::uint64_t>::max)();
+
+            boost::lock_guard<mutex_type> l(mtx_);
+            heap_.push_back(entry(deadline, sequence_++, val));
+            std::push_heap(heap_.begin(), heap_.end(), later());
+            size_.store(heap_.size(), boost::memory_order_relaxed);
+            return true;
+        }
+
+        bool pop(reference val, bool /*steal*/ = true)
+        {
+            if (empty())
+                return false;
+
+            boost::lock_guard<mutex_type> l(mtx_);
+            if (heap_.empty())
+                return false;
+
+            std::pop_heap(heap_.begin(), heap_.end(), later());
+            val = heap_.back().value_;
+            heap_.pop_back();
+            size_.store(heap_.size(), boost::memory_order_relaxed);
+            return true;
+        }
+
+        bool empty()
+        {
+            return size_.load(boost::memory_order_relaxed) == 0;
+        }
+
+        void on_start_thread() {}
+        void on_stop_thread() {}
+
+    private:
+        mutex_type mtx_;
+        std::vector<entry> heap_;
+        boost::uint64_t sequence_;
+        boost::atomic<std::size_t> size_;
+    };
+
+    struct deadline_edf
+    {
+        template <typename T>
+        struct apply
+        {
+            typedef deadline_edf_backend<T> type;
+        };
+    };
+}}}
+
+#endif
+
+#endif
@@ -19,6 +19,7 @@
 #include <boost/atomic.hpp>
 #include <boost/mpl/bool.hpp>
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -79,21 +80,30 @@ namespace hpx { namespace threads { namespace policies
               : num_queues_(1),
                 max_queue_thread_count_(max_thread_count),
                 numa_sensitive_(0),
-                description_("local_priority_queue_scheduler")
+                description_("local_priority_queue_scheduler"),
+                steal_batch_size_(1),
+                hierarchical_stealing_(false),
+                remote_steal_backoff_(0)
             {}
 
             init_parameter(std::size_t num_queues,
                     std::size_t num_high_priority_queues = std::size_t(-1),
                     std::size_t max_queue_thread_count = max_thread_count,
                     std::size_t numa_sensitive = 0,
-                    char const* description = "local_priority_queue_scheduler")
+                    char const* description = "local_priority_queue_scheduler",
+                    std::size_t steal_batch_size = 1,
+                    bool hierarchical_stealing = false,
+                    std::size_t remote_steal_backoff = 0)
               : num_queues_(num_queues),
                 num_high_priority_queues_(
                     num_high_priority_queues == std::size_t(-1) ?
                         num_queues : num_high_priority_queues),
                 max_queue_thread_count_(max_queue_thread_count),
                 numa_sensitive_(numa_sensitive),
-                description_(description)
+                description_(description),
+                steal_batch_size_(steal_batch_size),
+                hierarchical_stealing_(hierarchical_stealing),
+                remote_steal_backoff_(remote_steal_backoff)
             {}
 
             init_parameter(std::size_t num_queues, char const* description)
@@ -101,7 +111,10 @@ namespace hpx { namespace threads { namespace policies
                 num_high_priority_queues_(num_queues),
                 max_queue_thread_count_(max_thread_count),
                 numa_sensitive_(false),
-                description_(description)
+                description_(description),
+                steal_batch_size_(1),
+                hierarchical_stealing_(false),
+                remote_steal_backoff_(0)
             {}
 
             std::size_t num_queues_;
@@ -109,6 +122,15 @@ namespace hpx { namespace threads { namespace policies
             std::size_t max_queue_thread_count_;
             std::size_t numa_sensitive_;
             char const* description_;
+            // maximal number of pending threads moved from a victim queue by
+            // a single steal operation (0: move half of the victim's queue)
+            std::size_t steal_batch_size_;
+            // select victims hierarchically: core siblings first, then other
+            // cores in the same NUMA domain, then other NUMA domains
+            bool hierarchical_stealing_;
+            // number of idle loops to wait before stealing from other NUMA
+            // domains (hierarchical stealing only)
+            std::size_t remote_steal_backoff_;
         };
         typedef init_parameter init_parameter_type;
 
@@ -118,21 +140,28 @@ namespace hpx { namespace threads { namespace policies
             max_queue_thread_count_(init.max_queue_thread_count_),
             queues_(init.num_queues_),
             high_priority_queues_(init.num_high_priority_queues_),
-            low_priority_queue_(init.max_queue_thread_count_),
+            low_priority_queue_(std::size_t(-1), init.max_queue_thread_count_),
             curr_queue_(0),
             numa_sensitive_(init.numa_sensitive_),
+            steal_batch_size_(init.steal_batch_size_),
+            hierarchical_stealing_(init.hierarchical_stealing_),
+            remote_steal_backoff_(
+                static_cast<boost::int64_t>(init.remote_steal_backoff_)),
 #if !defined(HPX_NATIVE_MIC)        // we know that the MIC has one NUMA domain only
             steals_in_numa_domain_(),
             steals_outside_numa_domain_(),
 #endif
 #if !defined(HPX_HAVE_MORE_THAN_64_THREADS) || defined(HPX_HAVE_MAX_CPU_COUNT)
             numa_domain_masks_(init.num_queues_),
-            outside_numa_domain_masks_(init.num_queues_)
+            outside_numa_domain_masks_(init.num_queues_),
 #else
             numa_domain_masks_(init.num_queues_, topology_.get_machine_affinity_mask()),
             outside_numa_domain_masks_(init.num_queues_,
-                topology_.get_machine_affinity_mask())
+                topology_.get_machine_affinity_mask()),
 #endif
+            core_victims_(init.num_queues_),
+            numa_victims_(init.num_queues_),
+            remote_victims_(init.num_queues_)
         {
 #if !defined(HPX_NATIVE_MIC)        // we know that the MIC has one NUMA domain only
             resize(steals_in_numa_domain_, init.num_queues_);
@@ -142,13 +171,14 @@ namespace hpx { namespace threads { namespace policies
             {
                 BOOST_ASSERT(init.num_queues_ != 0);
                 for (std::size_t i = 0; i < init.num_queues_; ++i)
-                    queues_[i] = new thread_queue_type(init.max_queue_thread_count_);
+                    queues_[i] = new thread_queue_type(i,
+                        init.max_queue_thread_count_);
 
                 BOOST_ASSERT(init.num_high_priority_queues_ != 0);
                 BOOST_ASSERT(init.num_high_priority_queues_ <= init.num_queues_);
                 for (std::size_t i = 0; i < init.num_high_priority_queues_; ++i) {
-                    high_priority_queues_[i] =
-                        new thread_queue_type(init.max_queue_thread_count_);
+                    high_priority_queues_[i] = new thread_queue_type(i,
+                        init.max_queue_thread_count_);
                 }
             }
         }
@@ -163,6 +193,56 @@ namespace hpx { namespace threads { namespace policies
 
         bool numa_sensitive() const { return numa_sensitive_ != 0; }
 
+        bool supports_punit_removal() const { return true; }
+
+        // Move the pending and staged work items of the given (removed)
+        // worker thread to the next active worker thread, work items
+        // sneaking in later are picked up by stealing.
+        void drain_punit(std::size_t num_thread)
+        {
+            HPX_ASSERT(num_thread < queues_.size());
+
+            // the removed worker thread does not clean up its queues anymore
+            queues_[num_thread]->cleanup_terminated(true);
+            if (num_thread < high_priority_queues_.size())
+                high_priority_queues_[num_thread]->cleanup_terminated(true);
+
+            std::size_t const target = select_active_punit(num_thread);
+            if (target == num_thread)
+                return;
+
+            boost::int64_t const all =
+                (std::numeric_limits<boost::int64_t>::max)();
+
+            queues_[target]->move_work_items_from(queues_[num_thread], all);
+            queues_[target]->move_task_items_from(queues_[num_thread], all);
+
+            std::size_t const high_priority_queues =
+                high_priority_queues_.size();
+            if (num_thread < high_priority_queues)
+            {
+                // keep high priority work in a high priority queue, if
+                // possible
+                thread_queue_type* dest = queues_[target];
+                for (std::size_t i = 1; i != high_priority_queues; ++i)
+                {
+                    std::size_t const idx =
+                        (num_thread + i) % high_priority_queues;
+                    if (is_active_punit(idx))
+                    {
+                        dest = high_priority_queues_[idx];
+                        break;
+                    }
+                }
+
+                thread_queue_type* src = high_priority_queues_[num_thread];
+                dest->move_work_items_from(src, all);
+                dest->move_task_items_from(src, all);
+            }
+
+            do_some_work(std::size_t(-1));
+        }
+
         static std::string get_scheduler_name()
         {
             return "local_priority_queue_scheduler";
@@ -411,6 +491,47 @@ namespace hpx { namespace threads { namespace policies
             }
             return num_stolen_threads;
         }
+
+        boost::int64_t get_average_steal_batch_size(std::size_t num_thread,
+            bool reset)
+        {
+            boost::int64_t num_batches = 0;
+            boost::int64_t num_items = 0;
+
+            if (num_thread == std::size_t(-1))
+            {
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                {
+                    num_batches += queues_[i]->get_num_steal_batches(reset);
+                    num_items += queues_[i]->get_num_steal_batch_items(reset);
+                }
+
+                for (std::size_t i = 0; i != high_priority_queues_.size(); ++i)
+                {
+                    num_batches += high_priority_queues_[i]->
+                        get_num_steal_batches(reset);
+                    num_items += high_priority_queues_[i]->
+                        get_num_steal_batch_items(reset);
+                }
+            }
+            else
+            {
+                num_batches += queues_[num_thread]->
+                    get_num_steal_batches(reset);
+                num_items += queues_[num_thread]->
+                    get_num_steal_batch_items(reset);
+
+                if (num_thread < high_priority_queues_.size())
+                {
+                    num_batches += high_priority_queues_[num_thread]->
+                        get_num_steal_batches(reset);
+                    num_items += high_priority_queues_[num_thread]->
+                        get_num_steal_batch_items(reset);
+                }
+            }
+
+            return num_batches ? num_items / num_batches : 0;
+        }
 #endif
 
         ///////////////////////////////////////////////////////////////////////
@@ -467,6 +588,8 @@ namespace hpx { namespace threads { namespace policies
             if (num_thread >= queue_size)
                 num_thread %= queue_size;
 
+            num_thread = select_active_punit(num_thread);
+
             // now create the thread
             if (data.priority == thread_priority_critical) {
                 std::size_t num = num_thread % high_priority_queues_.size();
@@ -494,6 +617,118 @@ namespace hpx { namespace threads { namespace policies
                 run_now, ec);
         }
 
+        /// Steal pending work from the \a victim queue into the \a thief
+        /// queue and return the next thread to be executed from it. Depending
+        /// on the configured steal batch size this moves a whole block of
+        /// pending threads in one go.
+        bool steal_next_thread(thread_queue_type* victim,
+            thread_queue_type* thief, threads::thread_data*& thrd)
+        {
+            if (steal_batch_size_ == 1)
+            {
+                if (victim->get_next_thread(thrd))
+                {
+                    victim->increment_num_stolen_from_pending();
+                    thief->increment_num_stolen_to_pending();
+                    thief->increment_num_steal_batches(1);
+                    return true;
+                }
+                return false;
+            }
+
+            std::size_t stolen =
+                thief->steal_work_items_from(victim, steal_batch_size_);
+            if (0 == stolen)
+                return false;
+
+            victim->increment_num_stolen_from_pending(stolen);
+            thief->increment_num_stolen_to_pending(stolen);
+            thief->increment_num_steal_batches(stolen);
+
+            // other workers might have stolen the moved work from us already
+            return thief->get_next_thread(thrd);
+        }
+
+        // Pick a pseudo-random starting point in a list of victims. This
+        // varies with every idle loop so that idle workers of the same NUMA
+        // domain don't hammer on the same victim.
+        static std::size_t random_victim(std::size_t num_thread,
+            boost::int64_t idle_loop_count, std::size_t num_victims)
+        {
+            boost::uint64_t seed = boost::uint64_t(idle_loop_count) *
+                0x9e3779b97f4a7c15ull + num_thread;
+            seed ^= seed >> 29;
+            return std::size_t(seed % num_victims);
+        }
+
+        bool steal_from_victims(std::vector<std::size_t> const& victims,
+            std::size_t start, std::size_t num_thread,
+            thread_queue_type* this_high_priority_queue,
+            thread_queue_type* this_queue, threads::thread_data*& thrd)
+        {
+            std::size_t high_priority_queues = high_priority_queues_.size();
+            std::size_t num_victims = victims.size();
+            for (std::size_t i = 0; i != num_victims; ++i)
+            {
+                std::size_t const idx = victims[(i + start) % num_victims];
+
+                HPX_ASSERT(idx != num_thread);
+
+                if (idx < high_priority_queues &&
+                    num_thread < high_priority_queues)
+                {
+                    if (steal_next_thread(high_priority_queues_[idx],
+                            this_high_priority_queue, thrd))
+                    {
+                        return true;
+                    }
+                }
+
+                if (steal_next_thread(queues_[idx], this_queue, thrd))
+                    return true;
+            }
+            return false;
+        }
+
+        /// Steal pending work using the hierarchical victim selection: try
+        /// the workers sharing our core first, then random workers of our
+        /// NUMA domain, and - after the configured back-off - workers of
+        /// other NUMA domains.
+        bool steal_hierarchical(std::size_t num_thread,
+            boost::int64_t idle_loop_count,
+            thread_queue_type* this_high_priority_queue,
+            thread_queue_type* this_queue, threads::thread_data*& thrd)
+        {
+            if (steal_from_victims(core_victims_[num_thread], 0, num_thread,
+                    this_high_priority_queue, this_queue, thrd))
+            {
+                return true;
+            }
+
+            std::vector<std::size_t> const& numa_victims =
+                numa_victims_[num_thread];
+            if (!numa_victims.empty() && steal_from_victims(numa_victims,
+                    random_victim(num_thread, idle_loop_count,
+                        numa_victims.size()),
+                    num_thread, this_high_priority_queue, this_queue, thrd))
+            {
+                return true;
+            }
+
+            std::vector<std::size_t> const& remote_victims =
+                remote_victims_[num_thread];
+            if (remote_victims.empty() ||
+                idle_loop_count < remote_steal_backoff_)
+            {
+                return false;
+            }
+
+            return steal_from_victims(remote_victims,
+                random_victim(num_thread, idle_loop_count,
+                    remote_victims.size()),
+                num_thread, this_high_priority_queue, this_queue, thrd);
+        }
+
         /// Return the next thread to be executed, return false if none is
         /// available
         virtual bool get_next_thread(std::size_t num_thread,
@@ -533,7 +768,16 @@ namespace hpx { namespace threads { namespace policies
                     return false;
             }
 
-            if (numa_sensitive_ != 0)   // limited or no stealing across domains
+            if (hierarchical_stealing_)
+            {
+                if (steal_hierarchical(num_thread, idle_loop_count,
+                        this_high_priority_queue, this_queue, thrd))
+                {
+                    return true;
+                }
+            }
+
+            else if (numa_sensitive_ != 0)   // limited or no stealing across domains
             {
 
                 // steal thread from other queue of same NUMA domain
@@ -558,22 +802,15 @@ namespace hpx { namespace threads { namespace policies
                         if (idx < high_priority_queues &&
                             num_thread < high_priority_queues)
                         {
-                            thread_queue_type* q = high_priority_queues_[idx];
-                            if (q->get_next_thread(thrd))
+                            if (steal_next_thread(high_priority_queues_[idx],
+                                    this_high_priority_queue, thrd))
                             {
-                                q->increment_num_stolen_from_pending();
-                                this_high_priority_queue->
-                                    increment_num_stolen_to_pending();
                                 return true;
                             }
                         }
 
-                        if (queues_[idx]->get_next_thread(thrd))
-                        {
-                            queues_[idx]->increment_num_stolen_from_pending();
-                            this_queue->increment_num_stolen_to_pending();
+                        if (steal_next_thread(queues_[idx], this_queue, thrd))
                             return true;
-                        }
                     }
                 }
 
@@ -597,22 +834,15 @@ namespace hpx { namespace threads { namespace policies
                         if (idx < high_priority_queues &&
                             num_thread < high_priority_queues)
                         {
-                            thread_queue_type* q = high_priority_queues_[idx];
-                            if (q->get_next_thread(thrd))
+                            if (steal_next_thread(high_priority_queues_[idx],
+                                    this_high_priority_queue, thrd))
                             {
-                                q->increment_num_stolen_from_pending();
-                                this_high_priority_queue->
-                                    increment_num_stolen_to_pending();
                                 return true;
                             }
                         }
 
-                        if (queues_[idx]->get_next_thread(thrd))
-                        {
-                            queues_[idx]->increment_num_stolen_from_pending();
-                            this_queue->increment_num_stolen_to_pending();
+                        if (steal_next_thread(queues_[idx], this_queue, thrd))
                             return true;
-                        }
                     }
                 }
 #endif
@@ -630,22 +860,15 @@ namespace hpx { namespace threads { namespace policies
                     if (idx < high_priority_queues &&
                         num_thread < high_priority_queues)
                     {
-                        thread_queue_type* q = high_priority_queues_[idx];
-                        if (q->get_next_thread(thrd))
+                        if (steal_next_thread(high_priority_queues_[idx],
+                                this_high_priority_queue, thrd))
                         {
-                            q->increment_num_stolen_from_pending();
-                            this_high_priority_queue->
-                                increment_num_stolen_to_pending();
                             return true;
                         }
                     }
 
-                    if (queues_[idx]->get_next_thread(thrd))
-                    {
-                        queues_[idx]->increment_num_stolen_from_pending();
-                        this_queue->increment_num_stolen_to_pending();
+                    if (steal_next_thread(queues_[idx], this_queue, thrd))
                         return true;
-                    }
                 }
             }
 
@@ -660,6 +883,8 @@ namespace hpx { namespace threads { namespace policies
             if (std::size_t(-1) == num_thread)
                 num_thread = curr_queue_++ % queues_.size();
 
+            num_thread = select_active_punit(num_thread);
+
             if (priority == thread_priority_critical ||
                 priority == thread_priority_boost)
             {
@@ -682,6 +907,8 @@ namespace hpx { namespace threads { namespace policies
             if (std::size_t(-1) == num_thread)
                 num_thread = curr_queue_++ % queues_.size();
 
+            num_thread = select_active_punit(num_thread);
+
             if (priority == thread_priority_critical ||
                 priority == thread_priority_boost)
             {
@@ -951,6 +1178,51 @@ namespace hpx { namespace threads { namespace policies
         }
 #endif
 
+        // Convert staged tasks of the given victims into pending threads of
+        // this worker, returns whether any work was added.
+        bool add_new_from_victims(std::vector<std::size_t> const& victims,
+            std::size_t start, std::size_t num_thread, bool running,
+            boost::int64_t& idle_loop_count, bool& result,
+            thread_queue_type* this_high_priority_queue,
+            thread_queue_type* this_queue)
+        {
+            std::size_t high_priority_queues = high_priority_queues_.size();
+            std::size_t num_victims = victims.size();
+            std::size_t added = 0;
+            for (std::size_t i = 0; i != num_victims; ++i)
+            {
+                std::size_t const idx = victims[(i + start) % num_victims];
+
+                HPX_ASSERT(idx != num_thread);
+
+                if (idx < high_priority_queues &&
+                    num_thread < high_priority_queues)
+                {
+                    thread_queue_type* q =  high_priority_queues_[idx];
+                    result = this_high_priority_queue->
+                        wait_or_add_new(running, idle_loop_count, added, q)
+                       && result;
+                    if (0 != added)
+                    {
+                        q->increment_num_stolen_from_staged(added);
+                        this_high_priority_queue->
+                            increment_num_stolen_to_staged(added);
+                        return true;
+                    }
+                }
+
+                result = this_queue->wait_or_add_new(running,
+                    idle_loop_count, added, queues_[idx]) && result;
+                if (0 != added)
+                {
+                    queues_[idx]->increment_num_stolen_from_staged(added);
+                    this_queue->increment_num_stolen_to_staged(added);
+                    return true;
+                }
+            }
+            return false;
+        }
+
         /// This is a function which gets called periodically by the thread
         /// manager to allow for maintenance tasks to be executed in the
         /// scheduler. Returns true if the OS thread calling this function
@@ -981,7 +1253,42 @@ namespace hpx { namespace threads { namespace policies
                 running, idle_loop_count, added) && result;
             if (0 != added) return result;
 
-            if (numa_sensitive_ != 0)   // limited or no cross domain stealing
+            if (hierarchical_stealing_)
+            {
+                // same victim order as for stealing pending threads
+                if (add_new_from_victims(core_victims_[num_thread], 0,
+                        num_thread, running, idle_loop_count, result,
+                        this_high_priority_queue, this_queue))
+                {
+                    return result;
+                }
+
+                std::vector<std::size_t> const& numa_victims =
+                    numa_victims_[num_thread];
+                if (!numa_victims.empty() && add_new_from_victims(numa_victims,
+                        random_victim(num_thread, idle_loop_count,
+                            numa_victims.size()),
+                        num_thread, running, idle_loop_count, result,
+                        this_high_priority_queue, this_queue))
+                {
+                    return result;
+                }
+
+                std::vector<std::size_t> const& remote_victims =
+                    remote_victims_[num_thread];
+                if (!remote_victims.empty() &&
+                    idle_loop_count >= remote_steal_backoff_ &&
+                    add_new_from_victims(remote_victims,
+                        random_victim(num_thread, idle_loop_count,
+                            remote_victims.size()),
+                        num_thread, running, idle_loop_count, result,
+                        this_high_priority_queue, this_queue))
+                {
+                    return result;
+                }
+            }
+
+            else if (numa_sensitive_ != 0)   // limited or no cross domain stealing
             {
                 // steal work items: first try to steal from other cores in
                 // the same NUMA node
@@ -1157,12 +1464,12 @@ namespace hpx { namespace threads { namespace policies
             if (0 == queues_[num_thread])
             {
                 queues_[num_thread] =
-                    new thread_queue_type(max_queue_thread_count_);
+                    new thread_queue_type(num_thread, max_queue_thread_count_);
 
                 if (num_thread < high_priority_queues_.size())
                 {
-                    high_priority_queues_[num_thread] =
-                        new thread_queue_type(max_queue_thread_count_);
+                    high_priority_queues_[num_thread] = new thread_queue_type(
+                        num_thread, max_queue_thread_count_);
                 }
             }
 
@@ -1208,6 +1515,49 @@ namespace hpx { namespace threads { namespace policies
                 outside_numa_domain_masks_[num_thread] =
                     not_(node_mask) & machine_mask;
             }
+
+            if (hierarchical_stealing_)
+                init_victims(num_thread, num_pu);
+        }
+
+        // pre-calculate the victims for hierarchical stealing
+        void init_victims(std::size_t num_thread, std::size_t num_pu)
+        {
+            mask_cref_type core_mask =
+                topology_.get_core_affinity_mask(num_pu, true);
+            mask_cref_type node_mask =
+                topology_.get_numa_node_affinity_mask(num_pu, true);
+
+            // numa_sensitive_ == 2 disables stealing across NUMA domains,
+            // numa_sensitive_ == 1 allows it for the boundary cores only
+            bool steal_remote = numa_sensitive_ == 0;
+#if !defined(HPX_NATIVE_MIC)        // we know that the MIC has one NUMA domain only
+            if (numa_sensitive_ == 1)
+                steal_remote = test(steals_outside_numa_domain_, num_pu); //-V600
+#endif
+
+            std::vector<std::size_t>& core_victims = core_victims_[num_thread];
+            std::vector<std::size_t>& numa_victims = numa_victims_[num_thread];
+            std::vector<std::size_t>& remote_victims =
+                remote_victims_[num_thread];
+
+            core_victims.clear();
+            numa_victims.clear();
+            remote_victims.clear();
+
+            std::size_t queues_size = queues_.size();
+            for (std::size_t i = 1; i != queues_size; ++i)
+            {
+                std::size_t const idx = (i + num_thread) % queues_size;
+                std::size_t pu_num = get_pu_num(idx);
+
+                if (any(core_mask) && test(core_mask, pu_num)) //-V600
+                    core_victims.push_back(idx);
+                else if (any(node_mask) && test(node_mask, pu_num)) //-V600
+                    numa_victims.push_back(idx);
+                else if (steal_remote)
+                    remote_victims.push_back(idx);
+            }
         }
 
         void on_stop_thread(std::size_t num_thread)
@@ -1242,6 +1592,9 @@ namespace hpx { namespace threads { namespace policies
         thread_queue_type low_priority_queue_;
         boost::atomic<std::size_t> curr_queue_;
         std::size_t numa_sensitive_;
+        std::size_t steal_batch_size_;
+        bool hierarchical_stealing_;
+        boost::int64_t remote_steal_backoff_;
 
 #if !defined(HPX_NATIVE_MIC)        // we know that the MIC has one NUMA domain only
         mask_type steals_in_numa_domain_;
@@ -1249,6 +1602,11 @@ namespace hpx { namespace threads { namespace policies
 #endif
         std::vector<mask_type> numa_domain_masks_;
         std::vector<mask_type> outside_numa_domain_masks_;
+
+        // victims for hierarchical stealing, one list per worker thread
+        std::vector<std::vector<std::size_t> > core_victims_;
+        std::vector<std::vector<std::size_t> > numa_victims_;
+        std::vector<std::vector<std::size_t> > remote_victims_;
     };
 }}}
 
@@ -19,6 +19,7 @@
 #include <boost/atomic.hpp>
 #include <boost/mpl/bool.hpp>
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -143,6 +144,31 @@ namespace hpx { namespace threads { namespace policies
 
         bool numa_sensitive() const { return numa_sensitive_ != 0; }
 
+        bool supports_punit_removal() const { return true; }
+
+        // Move the pending and staged work items of the given (removed)
+        // worker thread to the next active worker thread, work items
+        // sneaking in later are picked up by stealing.
+        void drain_punit(std::size_t num_thread)
+        {
+            HPX_ASSERT(num_thread < queues_.size());
+
+            // the removed worker thread does not clean up its queue anymore
+            queues_[num_thread]->cleanup_terminated(true);
+
+            std::size_t const target = select_active_punit(num_thread);
+            if (target == num_thread)
+                return;
+
+            boost::int64_t const all =
+                (std::numeric_limits<boost::int64_t>::max)();
+
+            queues_[target]->move_work_items_from(queues_[num_thread], all);
+            queues_[target]->move_task_items_from(queues_[num_thread], all);
+
+            do_some_work(std::size_t(-1));
+        }
+
         static std::string get_scheduler_name()
         {
             return "local_queue_scheduler";
@@ -304,6 +330,8 @@ namespace hpx { namespace threads { namespace policies
             if (num_thread >= queue_size)
                 num_thread %= queue_size;
 
+            num_thread = select_active_punit(num_thread);
+
             HPX_ASSERT(num_thread < queue_size);
             queues_[num_thread]->create_thread(data, id, initial_state,
                 run_now, ec);
@@ -429,6 +457,8 @@ namespace hpx { namespace threads { namespace policies
             if (std::size_t(-1) == num_thread)
                 num_thread = curr_queue_++ % queues_.size();
 
+            num_thread = select_active_punit(num_thread);
+
             HPX_ASSERT(num_thread < queues_.size());
             queues_[num_thread]->schedule_thread(thrd);
         }
@@ -440,6 +470,8 @@ namespace hpx { namespace threads { namespace policies
             if (std::size_t(-1) == num_thread)
                 num_thread = curr_queue_++ % queues_.size();
 
+            num_thread = select_active_punit(num_thread);
+
             HPX_ASSERT(num_thread < queues_.size());
             queues_[num_thread]->schedule_thread(thrd, true);
         }
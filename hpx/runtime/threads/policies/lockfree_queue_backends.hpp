@@ -15,6 +15,16 @@
 #include <boost/lockfree/stack.hpp>
 #include <hpx/util/lockfree/deque.hpp>
 
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+#include <hpx/util/lockfree/chase_lev_deque.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <boost/atomic.hpp>
+#if !defined(HPX_NATIVE_TLS)
+#include <boost/thread/tss.hpp>
+#endif
+#endif
+
 namespace hpx { namespace threads { namespace policies
 {
 
@@ -53,6 +63,9 @@ struct basic_lockfree_queue_backend
         return queue_.empty();
     }
 
+    void on_start_thread() {}
+    void on_stop_thread() {}
+
   private:
     container_type queue_;
 };
@@ -118,6 +131,9 @@ struct lockfree_abp_fifo_backend
         return queue_.empty();
     }
 
+    void on_start_thread() {}
+    void on_stop_thread() {}
+
   private:
     container_type queue_;
 };
@@ -168,6 +184,9 @@ struct lockfree_abp_lifo_backend
         return queue_.empty();
     }
 
+    void on_start_thread() {}
+    void on_stop_thread() {}
+
   private:
     container_type queue_;
 };
@@ -183,6 +202,122 @@ struct lockfree_abp_lifo
 
 #endif // HPX_HAVE_ABP_SCHEDULER
 
+///////////////////////////////////////////////////////////////////////////////
+// LIFO for the owning worker thread + FIFO stealing at opposite end.
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+struct lockfree_chase_lev;
+
+namespace detail
+{
+    // Identifies the OS thread calling this function. The worker numbers
+    // stored by thread_num_tss_ can't be used for this as they are unique
+    // within a single thread pool only.
+#if defined(HPX_NATIVE_TLS)
+    inline void const* chase_lev_owner_token()
+    {
+        static HPX_NATIVE_TLS char token = 0;
+        return &token;
+    }
+#else
+    inline void const* chase_lev_owner_token()
+    {
+        static boost::thread_specific_ptr<char> token;
+        if (token.get() == 0)
+            token.reset(new char(0));
+        return token.get();
+    }
+#endif
+}
+
+// The Chase-Lev deque may be modified at its bottom end by the OS thread
+// owning the queue only. That is the worker thread the queue was created for
+// (num_thread), which claims the queue from on_start_thread. Items pushed by
+// any other thread (or pushed to the other end) are routed through a separate
+// lock-free FIFO which is drained after the deque is empty. A queue without
+// an owner (num_thread == -1) uses that FIFO exclusively.
+template <typename T>
+struct lockfree_chase_lev_backend
+{
+    typedef boost::lockfree::chase_lev_deque<T> container_type;
+    typedef T value_type;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef boost::uint64_t size_type;
+
+    lockfree_chase_lev_backend(
+        size_type initial_size = 0
+      , size_type num_thread = size_type(-1)
+        )
+      : queue_(std::size_t(initial_size)),
+        overflow_queue_(std::size_t(initial_size)),
+        num_thread_(std::size_t(num_thread)),
+        owner_(0)
+    {}
+
+    bool push(const_reference val, bool other_end = false)
+    {
+        if (!other_end && is_owner())
+            return queue_.push_bottom(val);
+        return overflow_queue_.push(val);
+    }
+
+    bool pop(reference val, bool /*steal*/ = true)
+    {
+        if (is_owner())
+        {
+            if (queue_.pop_bottom(val))
+                return true;
+        }
+        else if (queue_.steal(val))
+        {
+            return true;
+        }
+        return overflow_queue_.pop(val);
+    }
+
+    bool empty()
+    {
+        return queue_.empty() && overflow_queue_.empty();
+    }
+
+    // called by the worker thread the queue was created for
+    void on_start_thread()
+    {
+        if (num_thread_ != std::size_t(-1))
+            owner_.store(detail::chase_lev_owner_token());
+    }
+
+    // items left in the deque can still be stolen by other threads
+    void on_stop_thread()
+    {
+        if (is_owner())
+            owner_.store(0);
+    }
+
+  private:
+    bool is_owner() const
+    {
+        return owner_.load(boost::memory_order_relaxed) ==
+            detail::chase_lev_owner_token();
+    }
+
+    container_type queue_;
+    boost::lockfree::queue<T> overflow_queue_;
+    std::size_t const num_thread_;
+    boost::atomic<void const*> owner_;
+};
+
+struct lockfree_chase_lev
+{
+    template <typename T>
+    struct apply
+    {
+        typedef lockfree_chase_lev_backend<T> type;
+    };
+};
+
+#endif // HPX_HAVE_CHASE_LEV_SCHEDULER
+
 }}}
 
 #endif // HPX_FB3518C8_4493_450E_A823_A9F8A3185B2D
@@ -12,7 +12,9 @@
 #include <hpx/runtime/threads/detail/periodic_maintenance.hpp>
 #include <hpx/runtime/threads/policies/local_priority_queue_scheduler.hpp>
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads { namespace policies
@@ -69,156 +71,105 @@ namespace hpx { namespace threads { namespace policies
             // periodic maintenance redistributes work and is responsible that
             // every OS-Thread has enough work
 
-            std::size_t queue_size = this->queues_.size();
+            // the queues of removed worker threads don't take part, their
+            // work was moved to the remaining worker threads
+            std::vector<thread_queue_type*> queues;
+            queues.reserve(this->queues_.size());
 
+            for (std::size_t i = 0; i != this->high_priority_queues_.size(); ++i)
             {
-                std::size_t high_priority_queue_size =
-                    this->high_priority_queues_.size();
+                if (this->is_active_punit(i))
+                    queues.push_back(this->high_priority_queues_[i]);
+            }
+            balance_queues(queues);
 
-                // Calculate the average ...
-                boost::int64_t average_task_count = 0;
-                boost::int64_t average_work_count = 0;
-                for(std::size_t i = 0; i != high_priority_queue_size; ++i)
-                {
-                    thread_queue_type* q = this->high_priority_queues_[i];
-                    average_task_count += q->get_staged_queue_length();
-                    average_work_count += q->get_pending_queue_length();
-                }
+            queues.clear();
+            for (std::size_t i = 0; i != this->queues_.size(); ++i)
+            {
+                if (this->is_active_punit(i))
+                    queues.push_back(this->queues_[i]);
+            }
+            balance_queues(queues);
 
-                average_task_count = average_task_count / high_priority_queue_size;
-                average_work_count = average_work_count / high_priority_queue_size;
+            return true;
+        }
 
-                // Remove items from queues that have more than the average
-                // FIXME: We should be able to avoid using a thread_queue as
-                // a temporary.
-                thread_queue_type tmp_queue;
-                for(std::size_t i = 0; i != high_priority_queue_size; ++i)
-                {
-                    thread_queue_type* q = this->high_priority_queues_[i];
-                    boost::int64_t task_items = q->get_staged_queue_length();
-                    boost::int64_t work_items = q->get_pending_queue_length();
-
-                    if(task_items > average_task_count)
-                    {
-                        boost::int64_t count = task_items - average_task_count;
-                        tmp_queue.move_task_items_from(q, count);
-                    }
-
-                    if(work_items > average_work_count)
-                    {
-                        boost::int64_t count = work_items - average_work_count;
-                        tmp_queue.move_work_items_from(q, count);
-                    }
-                }
+    private:
+        static void balance_queues(std::vector<thread_queue_type*> const& queues)
+        {
+            std::size_t queue_size = queues.size();
+            if (queue_size == 0)
+                return;
+
+            // Calculate the average ...
+            boost::int64_t average_task_count = 0;
+            boost::int64_t average_work_count = 0;
+            for(std::size_t i = 0; i != queue_size; ++i)
+            {
+                thread_queue_type* q = queues[i];
+                average_task_count += q->get_staged_queue_length();
+                average_work_count += q->get_pending_queue_length();
+            }
 
-                // And re-add them to the queues which didn't have enough work ...
-                for (std::size_t i = 0; i != high_priority_queue_size; ++i)
-                {
-                    thread_queue_type* q = this->high_priority_queues_[i];
-                    boost::int64_t task_items = q->get_staged_queue_length();
-                    boost::int64_t work_items = q->get_pending_queue_length();
-
-                    if(task_items < average_task_count)
-                    {
-                        boost::int64_t count = average_task_count - task_items;
-                        q->move_task_items_from(&tmp_queue, count);
-                    }
-
-                    if(work_items < average_work_count)
-                    {
-                        boost::int64_t count = average_work_count - work_items;
-                        q->move_work_items_from(&tmp_queue, count);
-                    }
-                }
+            average_task_count = average_task_count / queue_size;
+            average_work_count = average_work_count / queue_size;
 
-                // Some items might remain in the tmp_queue ... re-add them
-                // round robin
-                for (std::size_t i = 0; tmp_queue.get_staged_queue_length();
-                        i = (i + 1) % high_priority_queue_size)
+            // Remove items from queues that have more than the average
+            // FIXME: We should be able to avoid using a thread_queue as
+            // a temporary.
+            thread_queue_type tmp_queue;
+            for(std::size_t i = 0; i != queue_size; ++i)
+            {
+                thread_queue_type* q = queues[i];
+                boost::int64_t task_items = q->get_staged_queue_length();
+                boost::int64_t work_items = q->get_pending_queue_length();
+
+                if(task_items > average_task_count)
                 {
-                    this->high_priority_queues_[i]->
-                        move_task_items_from(&tmp_queue, 1);
+                    boost::int64_t count = task_items - average_task_count;
+                    tmp_queue.move_task_items_from(q, count);
                 }
 
-                for (std::size_t i = 0; tmp_queue.get_pending_queue_length();
-                     i = (i + 1) % high_priority_queue_size)
+                if(work_items > average_work_count)
                 {
-                    this->high_priority_queues_[i]->
-                        move_work_items_from(&tmp_queue, 1);
+                    boost::int64_t count = work_items - average_work_count;
+                    tmp_queue.move_work_items_from(q, count);
                 }
             }
 
+            // And re-add them to the queues which didn't have enough work ...
+            for(std::size_t i = 0; i != queue_size; ++i)
             {
-                // Calculate the average ...
-                boost::int64_t average_task_count = 0;
-                boost::int64_t average_work_count = 0;
-                for(std::size_t i = 0; i != queue_size; ++i)
-                {
-                    thread_queue_type* q = this->queues_[i];
-                    average_task_count += q->get_staged_queue_length();
-                    average_work_count += q->get_pending_queue_length();
-                }
-
-                average_task_count = average_task_count / queue_size;
-                average_work_count = average_work_count / queue_size;
-
-                // Remove items from queues that have more than the average
-                thread_queue_type tmp_queue;
-                for(std::size_t i = 0; i != queue_size; ++i)
-                {
-                    thread_queue_type* q = this->queues_[i];
-                    boost::int64_t task_items = q->get_staged_queue_length();
-                    boost::int64_t work_items = q->get_pending_queue_length();
-
-                    if(task_items > average_task_count)
-                    {
-                        boost::int64_t count = task_items - average_task_count;
-                        tmp_queue.move_task_items_from(q, count);
-                    }
-
-                    if(work_items > average_work_count)
-                    {
-                        boost::int64_t count = work_items - average_work_count;
-                        tmp_queue.move_work_items_from(q, count);
-                    }
-                }
+                thread_queue_type* q = queues[i];
+                boost::int64_t task_items = q->get_staged_queue_length();
+                boost::int64_t work_items = q->get_pending_queue_length();
 
-                // And re-add them to the queues which didn't have enough work ...
-                for(std::size_t i = 0; i != queue_size; ++i)
+                if(task_items < average_task_count)
                 {
-                    thread_queue_type* q = this->queues_[i];
-                    boost::int64_t task_items = q->get_staged_queue_length();
-                    boost::int64_t work_items = q->get_pending_queue_length();
-
-                    if(task_items < average_task_count)
-                    {
-                        boost::int64_t count = average_task_count - task_items;
-                        q->move_task_items_from(&tmp_queue, count);
-                    }
-
-                    if(work_items < average_work_count)
-                    {
-                        boost::int64_t count = average_work_count - work_items;
-                        q->move_work_items_from(&tmp_queue, count);
-                    }
+                    boost::int64_t count = average_task_count - task_items;
+                    q->move_task_items_from(&tmp_queue, count);
                 }
 
-                // Some items might remain in the tmp_queue ... re-add them
-                // round robin
-                for (std::size_t i = 0; tmp_queue.get_staged_queue_length();
-                     i = (i + 1) % queue_size)
+                if(work_items < average_work_count)
                 {
-                    this->queues_[i]->move_task_items_from(&tmp_queue, 1);
+                    boost::int64_t count = average_work_count - work_items;
+                    q->move_work_items_from(&tmp_queue, count);
                 }
+            }
 
-                for (std::size_t i = 0; tmp_queue.get_pending_queue_length();
-                     i = (i + 1) % queue_size)
-                {
-                    this->queues_[i]->move_work_items_from(&tmp_queue, 1);
-                }
+            // Some items might remain in the tmp_queue ... re-add them
+            // round robin
+            for (std::size_t i = 0; tmp_queue.get_staged_queue_length();
+                 i = (i + 1) % queue_size)
+            {
+                queues[i]->move_task_items_from(&tmp_queue, 1);
             }
 
-            return true;
+            for (std::size_t i = 0; tmp_queue.get_pending_queue_length();
+                 i = (i + 1) % queue_size)
+            {
+                queues[i]->move_work_items_from(&tmp_queue, 1);
+            }
         }
     };
 }}}
@@ -10,6 +10,7 @@
 #define HPX_F0153C92_99B1_4F31_8FA9_4208DB2F26CE
 
 #include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 
@@ -30,6 +31,105 @@ namespace hpx { namespace threads { namespace policies
 ///////////////////////////////////////////////////////////////////////////////
 namespace detail
 {
+    ///////////////////////////////////////////////////////////////////////////
+    // Intrusive doubly linked list of all threads managed by a thread_queue.
+    // The links are stored in the thread_data objects themselves, thus
+    // inserting and erasing threads never allocates. The list does not hold
+    // any references to the threads and it is not thread-safe, the owning
+    // queue protects it with its mutex.
+    class thread_list
+    {
+    public:
+        class const_iterator
+        {
+        public:
+            explicit const_iterator(thread_data* p = 0)
+              : p_(p)
+            {}
+
+            thread_data* operator*() const
+            {
+                return p_;
+            }
+
+            const_iterator& operator++()
+            {
+                p_ = p_->get_queue_next();
+                return *this;
+            }
+
+            friend bool operator==(const_iterator const& lhs,
+                const_iterator const& rhs)
+            {
+                return lhs.p_ == rhs.p_;
+            }
+            friend bool operator!=(const_iterator const& lhs,
+                const_iterator const& rhs)
+            {
+                return lhs.p_ != rhs.p_;
+            }
+
+        private:
+            thread_data* p_;
+        };
+
+        thread_list()
+          : head_(0)
+        {}
+
+        void push_front(thread_data* thrd)
+        {
+            HPX_ASSERT(thrd->get_queue_prev() == 0);
+            HPX_ASSERT(thrd->get_queue_next() == 0);
+
+            thrd->set_queue_links(0, head_);
+            if (head_ != 0)
+                head_->set_queue_links(thrd, head_->get_queue_next());
+            head_ = thrd;
+        }
+
+        void erase(thread_data* thrd)
+        {
+            thread_data* prev = thrd->get_queue_prev();
+            thread_data* next = thrd->get_queue_next();
+
+            if (prev != 0)
+                prev->set_queue_links(prev->get_queue_prev(), next);
+            else
+            {
+                HPX_ASSERT(head_ == thrd);
+                head_ = next;
+            }
+
+            if (next != 0)
+                next->set_queue_links(prev, next->get_queue_next());
+
+            thrd->set_queue_links(0, 0);
+        }
+
+        thread_data* front() const
+        {
+            return head_;
+        }
+
+        bool empty() const
+        {
+            return head_ == 0;
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(head_);
+        }
+        const_iterator end() const
+        {
+            return const_iterator();
+        }
+
+    private:
+        thread_data* head_;
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     // debug helper function, logs all suspended threads
     // this returns true if all threads in the map are currently suspended
@@ -62,7 +162,7 @@ namespace detail
         typename Map::const_iterator end = tm.end();
         for (typename Map::const_iterator it = tm.begin(); it != end; ++it)
         {
-            threads::thread_data const* thrd = (*it).get();
+            threads::thread_data const* thrd = *it;
             threads::thread_state state = thrd->get_state();
             threads::thread_state marked_state = thrd->get_marked_state();
 
@@ -86,7 +186,7 @@ namespace detail
                     LTM_(error) << "queue(" << num_thread << "): " //-V128
                                 << get_thread_state_name(state)
                                 << "(" << std::hex << std::setw(8)
-                                    << std::setfill('0') << (*it).get()
+                                    << std::setfill('0') << thrd
                                 << "." << std::hex << std::setw(2)
                                     << std::setfill('0') << thrd->get_thread_phase()
                                 << "/" << std::hex << std::setw(8)
@@ -104,7 +204,7 @@ namespace detail
                                 << "queue(" << num_thread << "): "
                                 << get_thread_state_name(state)
                                 << "(" << std::hex << std::setw(8)
-                                    << std::setfill('0') << (*it).get()
+                                    << std::setfill('0') << thrd
                                 << "." << std::hex << std::setw(2)
                                     << std::setfill('0') << thrd->get_thread_phase()
                                 << "/" << std::hex << std::setw(8)
@@ -14,6 +14,8 @@
 #include <hpx/runtime/threads/policies/scheduler_mode.hpp>
 #include <hpx/runtime/agas/interface.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
 #if defined(HPX_HAVE_SCHEDULER_LOCAL_STORAGE)
 #include <hpx/runtime/threads/coroutines/detail/tss.hpp>
 #include <boost/shared_ptr.hpp>
@@ -32,6 +34,7 @@
 #include <algorithm>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads { namespace policies
@@ -75,6 +78,14 @@ namespace hpx { namespace threads { namespace policies
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
           , wait_count_(0)
 #endif
+          , parking_enabled_(false)
+          , parked_count_(0)
+          , wakeup_time_(0)
+          , parked_time_(num_threads, 0)
+          , wakeup_latency_(num_threads, 0)
+          , wakeups_(num_threads, 0)
+          , deadline_misses_(num_threads, 0)
+          , suspended_punits_(0)
           , description_(description)
         {
             states_.resize(num_threads);
@@ -103,12 +114,87 @@ namespace hpx { namespace threads { namespace policies
             affinity_data_.add_punit(virt_core, thread_num, topology_);
         }
 
+        void rebind_punit(std::size_t virt_core, std::size_t thread_num)
+        {
+            affinity_data_.rebind_punit(virt_core, thread_num);
+        }
+
         std::size_t init(init_affinity_data const& data,
             topology const& topology)
         {
             return affinity_data_.init(data, topology);
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Worker threads can be removed from a running scheduler, their state
+        // is set to suspended. New work is not scheduled onto suspended
+        // worker threads anymore.
+        bool suspend_punit(std::size_t num_thread)
+        {
+            HPX_ASSERT(num_thread < states_.size());
+
+            hpx::state expected = state_running;
+            if (!states_[num_thread].compare_exchange_strong(
+                    expected, state_suspended))
+            {
+                return false;
+            }
+            ++suspended_punits_;
+
+            // make sure the suspended worker thread is not parked
+            std::lock_guard<boost::mutex> l(park_mtx_);
+            park_cond_.notify_all();
+            return true;
+        }
+
+        bool resume_punit(std::size_t num_thread)
+        {
+            HPX_ASSERT(num_thread < states_.size());
+
+            hpx::state expected = state_suspended;
+            if (!states_[num_thread].compare_exchange_strong(
+                    expected, state_running))
+            {
+                return false;
+            }
+            --suspended_punits_;
+            return true;
+        }
+
+        bool is_active_punit(std::size_t num_thread) const
+        {
+            HPX_ASSERT(num_thread < states_.size());
+            return states_[num_thread].load(boost::memory_order_relaxed) !=
+                state_suspended;
+        }
+
+        // Return the given worker thread if it is active, otherwise the next
+        // active one.
+        std::size_t select_active_punit(std::size_t num_thread) const
+        {
+            if (suspended_punits_.load(boost::memory_order_relaxed) == 0)
+                return num_thread;
+
+            std::size_t const size = states_.size();
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                std::size_t const idx = (num_thread + i) % size;
+                if (is_active_punit(idx))
+                    return idx;
+            }
+            return num_thread;
+        }
+
+        // Schedulers supporting the removal of worker threads have to move
+        // the work of a removed worker thread to the remaining ones (see
+        // drain_punit) and have to steal from the queues of removed worker
+        // threads.
+        virtual bool supports_punit_removal() const { return false; }
+
+        // Move the remaining work of a removed worker thread to the queues of
+        // the active worker threads.
+        virtual void drain_punit(std::size_t num_thread) {}
+
         void idle_callback(std::size_t /*num_thread*/)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
@@ -128,6 +214,75 @@ namespace hpx { namespace threads { namespace policies
 #endif
         }
 
+        /// Enable parking idle worker threads, this has to be called before
+        /// any of the worker threads is started.
+        void enable_parking()
+        {
+            parking_enabled_.store(true);
+        }
+
+        bool parking_enabled() const
+        {
+            return parking_enabled_.load(boost::memory_order_relaxed);
+        }
+
+        /// Park the calling worker thread until new work is added (see
+        /// \a do_some_work) or until max_park_time (in milliseconds) has
+        /// elapsed. This is used as the idle callback if the idle policy
+        /// 'park' was selected (see hpx.idle_policy).
+        void park_callback(std::size_t num_thread, std::size_t max_park_time)
+        {
+            HPX_ASSERT(num_thread < parked_time_.size());
+
+            // The first active worker thread is never parked if it does the
+            // background work of the parcel layer, as nothing would wake it
+            // up if new parcels arrive.
+            if ((get_scheduler_mode() & do_background_work) &&
+                select_active_punit(0) == num_thread)
+            {
+                return;
+            }
+
+            boost::unique_lock<boost::mutex> l(park_mtx_);
+
+            // Announce this thread as being parked before looking for work
+            // one last time. Producers check parked_count_ only after having
+            // added new work, thus no wake up can get lost.
+            ++parked_count_;
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+
+            if (states_[num_thread].load() != state_running ||
+                get_queue_length() != 0)
+            {
+                --parked_count_;
+                return;
+            }
+
+            boost::uint64_t start = util::high_resolution_clock::now();
+
+#if BOOST_VERSION < 105000
+            bool woken_up = park_cond_.timed_wait(l,
+                boost::posix_time::millisec(max_park_time));
+#else
+            bool woken_up = park_cond_.wait_for(l,
+                boost::chrono::milliseconds(max_park_time)) ==
+                    boost::cv_status::no_timeout;
+#endif
+
+            --parked_count_;
+
+            boost::uint64_t now = util::high_resolution_clock::now();
+            parked_time_[num_thread] += now - start;
+
+            boost::uint64_t wakeup_time =
+                wakeup_time_.load(boost::memory_order_relaxed);
+            if (woken_up && wakeup_time > start && now > wakeup_time)
+            {
+                wakeup_latency_[num_thread] += now - wakeup_time;
+                ++wakeups_[num_thread];
+            }
+        }
+
         bool background_callback(std::size_t num_thread)
         {
             bool result = false;
@@ -152,6 +307,97 @@ namespace hpx { namespace threads { namespace policies
             else
                 cond_.notify_one();
 #endif
+
+            // wake up exactly one parked worker thread for the new work, all
+            // of them if the scheduler is about to stop
+            if (!parking_enabled_.load(boost::memory_order_relaxed))
+                return;
+
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            if (parked_count_.load(boost::memory_order_relaxed) != 0)
+            {
+                std::lock_guard<boost::mutex> l(park_mtx_);
+                wakeup_time_.store(util::high_resolution_clock::now(),
+                    boost::memory_order_relaxed);
+
+                if (has_reached_state(state_stopping))
+                    park_cond_.notify_all();
+                else
+                    park_cond_.notify_one();
+            }
+        }
+
+        // return the overall time the given worker thread(s) were parked
+        boost::int64_t get_parked_time(std::size_t num_thread, bool reset)
+        {
+            if (num_thread != std::size_t(-1))
+            {
+                HPX_ASSERT(num_thread < parked_time_.size());
+                return boost::int64_t(
+                    util::get_and_reset_value(parked_time_[num_thread], reset));
+            }
+
+            boost::uint64_t parked_time = 0;
+            for (std::size_t i = 0; i != parked_time_.size(); ++i)
+                parked_time += util::get_and_reset_value(parked_time_[i], reset);
+            return boost::int64_t(parked_time);
+        }
+
+        // return the average time between a parked worker thread being
+        // notified about new work and it resuming to run
+        boost::int64_t get_average_wakeup_latency(std::size_t num_thread,
+            bool reset)
+        {
+            boost::uint64_t wakeup_latency = 0;
+            boost::int64_t wakeups = 0;
+
+            if (num_thread != std::size_t(-1))
+            {
+                HPX_ASSERT(num_thread < wakeup_latency_.size());
+                wakeup_latency = util::get_and_reset_value(
+                    wakeup_latency_[num_thread], reset);
+                wakeups = util::get_and_reset_value(wakeups_[num_thread], reset);
+            }
+            else
+            {
+                for (std::size_t i = 0; i != wakeup_latency_.size(); ++i)
+                {
+                    wakeup_latency +=
+                        util::get_and_reset_value(wakeup_latency_[i], reset);
+                    wakeups += util::get_and_reset_value(wakeups_[i], reset);
+                }
+            }
+
+            if (wakeups == 0)
+                return 0;
+            return boost::int64_t(wakeup_latency / wakeups);
+        }
+
+        // keep track of HPX-threads which finished after their deadline
+        void record_deadline_miss(std::size_t num_thread)
+        {
+            HPX_ASSERT(num_thread < deadline_misses_.size());
+            ++deadline_misses_[num_thread];
+        }
+
+        // return the number of HPX-threads executed by the given worker
+        // thread(s) which finished after their deadline
+        boost::int64_t get_deadline_misses(std::size_t num_thread, bool reset)
+        {
+            if (num_thread != std::size_t(-1))
+            {
+                HPX_ASSERT(num_thread < deadline_misses_.size());
+                return boost::int64_t(util::get_and_reset_value(
+                    deadline_misses_[num_thread], reset));
+            }
+
+            boost::uint64_t deadline_misses = 0;
+            for (std::size_t i = 0; i != deadline_misses_.size(); ++i)
+            {
+                deadline_misses +=
+                    util::get_and_reset_value(deadline_misses_[i], reset);
+            }
+            return boost::int64_t(deadline_misses);
         }
 
         // allow to access/manipulate states
@@ -245,6 +491,13 @@ namespace hpx { namespace threads { namespace policies
             bool reset) = 0;
         virtual boost::int64_t get_num_stolen_to_staged(std::size_t num_thread,
             bool reset) = 0;
+
+        // schedulers not supporting batched stealing report zero
+        virtual boost::int64_t get_average_steal_batch_size(
+            std::size_t num_thread, bool reset)
+        {
+            return 0;
+        }
 #endif
 
         virtual boost::int64_t get_queue_length(
@@ -310,6 +563,22 @@ namespace hpx { namespace threads { namespace policies
         boost::atomic<boost::uint32_t> wait_count_;
 #endif
 
+        // support for parking worker threads on idle queues
+        boost::atomic<bool> parking_enabled_;
+        boost::mutex park_mtx_;
+        boost::condition_variable park_cond_;
+        boost::atomic<boost::int32_t> parked_count_;
+        boost::atomic<boost::uint64_t> wakeup_time_;
+
+        std::vector<boost::uint64_t> parked_time_;
+        std::vector<boost::uint64_t> wakeup_latency_;
+        std::vector<boost::int64_t> wakeups_;
+
+        std::vector<boost::uint64_t> deadline_misses_;
+
+        // number of worker threads removed at runtime
+        boost::atomic<std::size_t> suspended_punits_;
+
         boost::ptr_vector<boost::atomic<hpx::state> > states_;
         char const* description_;
 
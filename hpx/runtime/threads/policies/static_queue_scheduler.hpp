@@ -68,6 +68,10 @@ namespace hpx { namespace threads { namespace policies
             return "static_queue_scheduler";
         }
 
+        // there is no stealing which could pick up work items left behind by
+        // removed worker threads
+        bool supports_punit_removal() const { return false; }
+
         /// Return the next thread to be executed, return false if none is
         /// available
         virtual bool get_next_thread(std::size_t num_thread,
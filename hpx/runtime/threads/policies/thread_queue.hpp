@@ -14,9 +14,11 @@
 #include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/block_profiler.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/unused.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/threads/policies/queue_helpers.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
+#include <hpx/runtime/threads/policies/deadline_queue_backend.hpp>
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
 #   include <hpx/util/tick_counter.hpp>
@@ -25,12 +27,16 @@
 #include <boost/thread/condition.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/atomic.hpp>
+#include <boost/lockfree/stack.hpp>
+#if defined(HPX_HAVE_THREAD_QUEUE_DEBUG_MAP)
 #include <boost/unordered_set.hpp>
+#endif
 
 #include <map>
 #include <memory>
 #include <mutex>
 
+#if defined(HPX_HAVE_THREAD_QUEUE_DEBUG_MAP)
 ///////////////////////////////////////////////////////////////////////////////
 namespace boost
 {
@@ -45,6 +51,7 @@ namespace boost
         boost::hash<std::size_t> hasher_;
     };
 }
+#endif
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads { namespace policies
@@ -86,6 +93,10 @@ namespace hpx { namespace threads { namespace policies
     //     bool pop(reference val, bool steal = true);
     //
     //     bool empty();
+    //
+    //     // called by the worker thread owning the queue
+    //     void on_start_thread();
+    //     void on_stop_thread();
     // };
     //
     // struct queue_policy
@@ -114,8 +125,19 @@ namespace hpx { namespace threads { namespace policies
             max_delete_count = 1000
         };
 
-        // this is the type of a map holding all threads (except depleted ones)
+        // this is the type of the list linking all threads (except depleted
+        // ones), it does not allocate while adding or removing threads
+        typedef detail::thread_list thread_list_type;
+
+#if defined(HPX_HAVE_THREAD_QUEUE_DEBUG_MAP)
+        // this is the type of a map holding all threads (except depleted
+        // ones), it is used to verify the consistency of the thread list only
         typedef boost::unordered_set<thread_id_type> thread_map_type;
+#endif
+
+        // this is the type of the caches of recycled thread objects (one for
+        // each stack size), the thread objects keep their stacks alive
+        typedef boost::lockfree::stack<thread_data*> thread_heap_type;
 
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
         typedef
@@ -141,67 +163,84 @@ namespace hpx { namespace threads { namespace policies
             apply<thread_data*>::type terminated_items_type;
 
     protected:
-        template <typename Lock>
-        void create_thread_object(threads::thread_id_type& thrd,
-            threads::thread_init_data& data, thread_state_enum state, Lock& lk)
+        thread_heap_type& get_thread_heap(std::ptrdiff_t stacksize)
         {
-            HPX_ASSERT(lk.owns_lock());
-            HPX_ASSERT(data.stacksize != 0);
+            if (stacksize == get_stack_size(thread_stacksize_small))
+                return thread_heap_small_;
 
-            std::ptrdiff_t stacksize = data.stacksize;
+            if (stacksize == get_stack_size(thread_stacksize_medium))
+                return thread_heap_medium_;
 
-            std::list<thread_id_type>* heap = 0;
+            if (stacksize == get_stack_size(thread_stacksize_large))
+                return thread_heap_large_;
 
-            if (stacksize == get_stack_size(thread_stacksize_small))
-            {
-                heap = &thread_heap_small_;
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_medium))
-            {
-                heap = &thread_heap_medium_;
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_large))
-            {
-                heap = &thread_heap_large_;
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_huge))
-            {
-                heap = &thread_heap_huge_;
-            }
-            else {
-                switch(stacksize) {
-                case thread_stacksize_small:
-                    heap = &thread_heap_small_;
-                    break;
+            if (stacksize == get_stack_size(thread_stacksize_huge))
+                return thread_heap_huge_;
 
-                case thread_stacksize_medium:
-                    heap = &thread_heap_medium_;
-                    break;
+            if (stacksize == get_stack_size(thread_stacksize_nostack))
+                return thread_heap_nostack_;
 
-                case thread_stacksize_large:
-                    heap = &thread_heap_large_;
-                    break;
+            switch(stacksize) {
+            case thread_stacksize_small:
+                return thread_heap_small_;
 
-                case thread_stacksize_huge:
-                    heap = &thread_heap_huge_;
-                    break;
+            case thread_stacksize_medium:
+                return thread_heap_medium_;
 
-                default:
-                    break;
-                }
+            case thread_stacksize_large:
+                return thread_heap_large_;
+
+            case thread_stacksize_huge:
+                return thread_heap_huge_;
+
+            case thread_stacksize_nostack:
+                return thread_heap_nostack_;
+
+            default:
+                break;
             }
-            HPX_ASSERT(heap);
 
-            // Check for an unused thread object.
-            if (!heap->empty())
+            HPX_ASSERT(false);
+            return thread_heap_small_;
+        }
+
+        // Try to reuse a recycled thread object (and its stack). This does
+        // not require to hold the queue's mutex.
+        bool reuse_thread_object(threads::thread_id_type& thrd,
+            threads::thread_init_data& data, thread_state_enum state)
+        {
+            HPX_ASSERT(data.stacksize != 0);
+
+            thread_data* p = 0;
+            if (!get_thread_heap(data.stacksize).pop(p))
+                return false;
+
+            // Take ownership of the reference held by the heap and rebind the
+            // thread object.
+            thrd = thread_id_type(p, false);
+            thrd->rebind(data, state);
+            return true;
+        }
+
+        void create_thread_object(threads::thread_id_type& thrd,
+            threads::thread_init_data& data, thread_state_enum state)
+        {
+            // Check for an unused thread object, allocate a new one otherwise.
+            if (!reuse_thread_object(thrd, data, state))
             {
-                // Take ownership of the thread object and rebind it.
-                thrd = heap->front();
-                heap->pop_front();
-                thrd->rebind(data, state);
+                thrd = threads::thread_data::create(
+                    data, memory_pool_, state);
             }
+        }
 
-            else
+        template <typename Lock>
+        void create_thread_object(threads::thread_id_type& thrd,
+            threads::thread_init_data& data, thread_state_enum state, Lock& lk)
+        {
+            HPX_ASSERT(lk.owns_lock());
+
+            // Check for an unused thread object.
+            if (!reuse_thread_object(thrd, data, state))
             {
                 hpx::util::unlock_guard<Lock> ull(lk);
 
@@ -211,6 +250,62 @@ namespace hpx { namespace threads { namespace policies
             }
         }
 
+        // Add the thread to the threads managed by this queue. The queue
+        // holds a reference to each of its threads until it gets recycled or
+        // deleted. This does not require to hold mtx_, the thread is pushed
+        // onto a lock-free stack of new threads which is moved to the list of
+        // all threads whenever that list is accessed.
+        void add_to_thread_map(thread_id_type const& thrd)
+        {
+            thread_data* p = thrd.get();
+            intrusive_ptr_add_ref(p);
+            ++thread_map_count_;
+
+            thread_data* head = new_threads_.load(boost::memory_order_relaxed);
+            do {
+                p->set_queue_links(0, head);
+            } while (!new_threads_.compare_exchange_weak(head, p,
+                boost::memory_order_release, boost::memory_order_relaxed));
+        }
+
+        // Link all threads added since the last call into the list of
+        // threads managed by this queue. This has to be called while holding
+        // mtx_, before thread_list_ is accessed.
+        void link_new_threads() const
+        {
+            thread_data* p = new_threads_.exchange(0, boost::memory_order_acquire);
+            while (p != 0)
+            {
+                thread_data* next = p->get_queue_next();
+                p->set_queue_links(0, 0);
+
+#if defined(HPX_HAVE_THREAD_QUEUE_DEBUG_MAP)
+                bool inserted = thread_map_.insert(thread_id_type(p)).second;
+                HPX_ASSERT(inserted);
+                HPX_UNUSED(inserted);
+#endif
+                thread_list_.push_front(p);
+                p = next;
+            }
+        }
+
+        // Unlink the thread from the list of threads managed by this queue.
+        // The reference held by the queue is not released. This has to be
+        // called while holding mtx_.
+        void remove_from_thread_map(thread_data* thrd)
+        {
+            link_new_threads();
+
+#if defined(HPX_HAVE_THREAD_QUEUE_DEBUG_MAP)
+            // this thread has to be in this map
+            HPX_ASSERT(thread_map_.find(thrd) != thread_map_.end());
+            thread_map_.erase(thrd);
+#endif
+            thread_list_.erase(thrd);
+            --thread_map_count_;
+            HPX_ASSERT(thread_map_count_ >= 0);
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // add new threads if there is some amount of work available
         std::size_t add_new(boost::int64_t add_count, thread_queue* addfrom,
@@ -247,16 +342,7 @@ namespace hpx { namespace threads { namespace policies
                 delete task;
 
                 // add the new entry to the map of all threads
-                std::pair<thread_map_type::iterator, bool> p =
-                    thread_map_.insert(thrd);
-
-                if (HPX_UNLIKELY(!p.second)) {
-                    HPX_THROW_EXCEPTION(hpx::out_of_memory,
-                        "threadmanager::add_new",
-                        "Couldn't add new thread to the thread map");
-                    return 0;
-                }
-                ++thread_map_count_;
+                add_to_thread_map(thrd);
 
                 // only insert the thread into the work-items queue if it is in
                 // pending state
@@ -267,8 +353,6 @@ namespace hpx { namespace threads { namespace policies
                     schedule_thread(thrd.get());
                 }
 
-                // this thread has to be in the map now
-                HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
                 HPX_ASSERT(thrd->get_pool() == &memory_pool_);
             }
 
@@ -297,7 +381,8 @@ namespace hpx { namespace threads { namespace policies
             // if the map doesn't hold max_count threads yet add some
             // FIXME: why do we have this test? can max_count_ ever be zero?
             if (HPX_LIKELY(max_count_)) {
-                std::size_t count = thread_map_.size();
+                std::size_t count =
+                    static_cast<std::size_t>(thread_map_count_.load());
                 if (max_count_ >= count + min_add_new_count) { //-V104
                     HPX_ASSERT(max_count_ - count <
                         static_cast<std::size_t>((std::numeric_limits
@@ -335,7 +420,8 @@ namespace hpx { namespace threads { namespace policies
             // if we are desperate (no work in the queues), add some even if the
             // map holds more than max_count
             if (HPX_LIKELY(max_count_)) {
-                std::size_t count = thread_map_.size();
+                std::size_t count =
+                    static_cast<std::size_t>(thread_map_count_.load());
                 if (max_count_ >= count + min_add_new_count) { //-V104
                     HPX_ASSERT(max_count_ - count <
                         static_cast<std::size_t>((std::numeric_limits
@@ -360,50 +446,11 @@ namespace hpx { namespace threads { namespace policies
             return addednew != 0;
         }
 
-        void recycle_thread(thread_id_type thrd)
+        // Put the thread object into the cache matching its stack size. The
+        // reference previously held by the queue is handed over to the cache.
+        void recycle_thread(thread_data* thrd)
         {
-            std::ptrdiff_t stacksize = thrd->get_stack_size();
-
-            if (stacksize == get_stack_size(thread_stacksize_small))
-            {
-                thread_heap_small_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_medium))
-            {
-                thread_heap_medium_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_large))
-            {
-                thread_heap_large_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_huge))
-            {
-                thread_heap_huge_.push_front(thrd);
-            }
-            else
-            {
-                switch(stacksize) {
-                case thread_stacksize_small:
-                    thread_heap_small_.push_front(thrd);
-                    break;
-
-                case thread_stacksize_medium:
-                    thread_heap_medium_.push_front(thrd);
-                    break;
-
-                case thread_stacksize_large:
-                    thread_heap_large_.push_front(thrd);
-                    break;
-
-                case thread_stacksize_huge:
-                    thread_heap_huge_.push_front(thrd);
-                    break;
-
-                default:
-                    HPX_ASSERT(false);
-                    break;
-                }
-            }
+            get_thread_heap(thrd->get_stack_size()).push(thrd);
         }
 
     public:
@@ -418,7 +465,7 @@ namespace hpx { namespace threads { namespace policies
             util::tick_counter tc(cleanup_terminated_time_);
 #endif
 
-            if (terminated_items_count_ == 0 && thread_map_.empty())
+            if (terminated_items_count_ == 0 && thread_map_count_ == 0)
                 return true;
 
             if (delete_all) {
@@ -428,15 +475,8 @@ namespace hpx { namespace threads { namespace policies
                 {
                     --terminated_items_count_;
 
-                    // this thread has to be in this map
-                    HPX_ASSERT(thread_map_.find(todelete) != thread_map_.end());
-
-                    bool deleted = thread_map_.erase(todelete) != 0;
-                    HPX_ASSERT(deleted);
-                    if (deleted) {
-                        --thread_map_count_;
-                        HPX_ASSERT(thread_map_count_ >= 0);
-                    }
+                    remove_from_thread_map(todelete);
+                    intrusive_ptr_release(todelete);
                 }
             }
             else {
@@ -451,16 +491,8 @@ namespace hpx { namespace threads { namespace policies
                 {
                     --terminated_items_count_;
 
-                    thread_map_type::iterator it = thread_map_.find(todelete);
-
-                    // this thread has to be in this map
-                    HPX_ASSERT(it != thread_map_.end());
-
-                    recycle_thread(*it);
-
-                    thread_map_.erase(it);
-                    --thread_map_count_;
-                    HPX_ASSERT(thread_map_count_ >= 0);
+                    remove_from_thread_map(todelete);
+                    recycle_thread(todelete);
 
                     --delete_count;
                 }
@@ -471,7 +503,7 @@ namespace hpx { namespace threads { namespace policies
         bool cleanup_terminated_locked(bool delete_all = false)
         {
             return cleanup_terminated_locked_helper(delete_all) &&
-                thread_map_.empty();
+                thread_map_count_ == 0;
         }
 
     public:
@@ -510,7 +542,8 @@ namespace hpx { namespace threads { namespace policies
 
         thread_queue(std::size_t queue_num = std::size_t(-1),
                 std::size_t max_count = max_thread_count)
-          : thread_map_count_(0),
+          : new_threads_(0),
+            thread_map_count_(0),
             work_items_(128, queue_num),
             work_items_count_(0),
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
@@ -529,10 +562,11 @@ namespace hpx { namespace threads { namespace policies
             new_tasks_wait_count_(0),
 #endif
             memory_pool_(64),
-            thread_heap_small_(),
-            thread_heap_medium_(),
-            thread_heap_large_(),
-            thread_heap_huge_(),
+            thread_heap_small_(128),
+            thread_heap_medium_(128),
+            thread_heap_large_(128),
+            thread_heap_huge_(128),
+            thread_heap_nostack_(128),
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
             add_new_time_(0),
             cleanup_terminated_time_(0),
@@ -544,10 +578,31 @@ namespace hpx { namespace threads { namespace policies
             stolen_from_staged_(0),
             stolen_to_pending_(0),
             stolen_to_staged_(0),
+            steal_batches_(0),
+            steal_batch_items_(0),
 #endif
             add_new_logger_("thread_queue::add_new")
         {}
 
+        ~thread_queue()
+        {
+            // release the references held for all remaining threads, this
+            // has to happen before the memory pool goes out of scope
+            link_new_threads();
+            while (!thread_list_.empty())
+            {
+                thread_data* thrd = thread_list_.front();
+                remove_from_thread_map(thrd);
+                intrusive_ptr_release(thrd);
+            }
+
+            release_thread_heap(thread_heap_small_);
+            release_thread_heap(thread_heap_medium_);
+            release_thread_heap(thread_heap_large_);
+            release_thread_heap(thread_heap_huge_);
+            release_thread_heap(thread_heap_nostack_);
+        }
+
         void set_max_count(std::size_t max_count = max_thread_count)
         {
             max_count_ = (0 == max_count) ? max_thread_count : max_count; //-V105
@@ -663,6 +718,22 @@ namespace hpx { namespace threads { namespace policies
         {
             stolen_to_staged_ += num;
         }
+
+        boost::int64_t get_num_steal_batches(bool reset)
+        {
+            return util::get_and_reset_value(steal_batches_, reset);
+        }
+
+        boost::int64_t get_num_steal_batch_items(bool reset)
+        {
+            return util::get_and_reset_value(steal_batch_items_, reset);
+        }
+
+        void increment_num_steal_batches(std::size_t num)
+        {
+            ++steal_batches_;
+            steal_batch_items_ += num;
+        }
 #else
         void increment_num_pending_misses(std::size_t num = 1) {}
         void increment_num_pending_accesses(std::size_t num = 1) {}
@@ -670,6 +741,7 @@ namespace hpx { namespace threads { namespace policies
         void increment_num_stolen_from_staged(std::size_t num = 1) {}
         void increment_num_stolen_to_pending(std::size_t num = 1) {}
         void increment_num_stolen_to_staged(std::size_t num = 1) {}
+        void increment_num_steal_batches(std::size_t num) {}
 #endif
 
         ///////////////////////////////////////////////////////////////////////
@@ -685,41 +757,24 @@ namespace hpx { namespace threads { namespace policies
             {
                 threads::thread_id_type thrd;
 
-                // The mutex can not be locked while a new thread is getting
-                // created, as it might have that the current HPX thread gets
-                // suspended.
-                {
-                    typename mutex_type::scoped_lock lk(mtx_);
-
-                    create_thread_object(thrd, data, initial_state, lk);
-
-                    // add a new entry in the map for this thread
-                    std::pair<thread_map_type::iterator, bool> p =
-                        thread_map_.insert(thrd);
+                // The thread object is taken from the (lock-free) caches of
+                // recycled threads or is allocated, and it is added to the
+                // threads of this queue without locking the mutex.
+                create_thread_object(thrd, data, initial_state);
+                add_to_thread_map(thrd);
 
-                    if (HPX_UNLIKELY(!p.second)) {
-                        HPX_THROWS_IF(ec, hpx::out_of_memory,
-                            "threadmanager::register_thread",
-                            "Couldn't add new thread to the map of threads");
-                        return;
-                    }
-                    ++thread_map_count_;
+                // return the thread_id of the newly created thread
+                if (id) *id = thrd;
 
-                    // return the thread_id of the newly created thread
-                    if (id) *id = thrd;
-
-                    // this thread has to be in the map now
-                    HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
-                    HPX_ASSERT(thrd->get_pool() == &memory_pool_);
+                HPX_ASSERT(thrd->get_pool() == &memory_pool_);
 
-                    // push the new thread in the pending queue thread
-                    if (initial_state == pending)
-                        schedule_thread(thrd.get());
+                // push the new thread in the pending queue thread
+                if (initial_state == pending)
+                    schedule_thread(thrd.get());
 
-                    if (&ec != &throws)
-                        ec = make_success_code();
-                    return;
-                }
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
             }
 
             // do not execute the work, but register a task description for
@@ -762,6 +817,43 @@ namespace hpx { namespace threads { namespace policies
             }
         }
 
+        /// Move a block of pending work items from the queue \a src (the
+        /// victim) to this queue, returns the number of moved work items.
+        /// At most half of the pending work items of \a src are moved,
+        /// \a count == 0 moves exactly half of them (but at least one).
+        std::size_t steal_work_items_from(thread_queue *src, std::size_t count)
+        {
+            boost::int64_t available =
+                src->work_items_count_.load(boost::memory_order_relaxed);
+            if (available <= 0)
+                return 0;
+
+            std::size_t half = std::size_t(available + 1) / 2;
+            if (count == 0 || count > half)
+                count = half;
+
+            std::size_t moved = 0;
+            thread_description* trd;
+            while (moved != count && src->work_items_.pop(trd, true))
+            {
+                --src->work_items_count_;
+
+#ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
+                if (maintain_queue_wait_times) {
+                    boost::uint64_t now = util::high_resolution_clock::now();
+                    src->work_items_wait_ += now - util::get<1>(*trd);
+                    ++src->work_items_wait_count_;
+                    util::get<1>(*trd) = now;
+                }
+#endif
+
+                ++work_items_count_;
+                work_items_.push(trd);
+                ++moved;
+            }
+            return moved;
+        }
+
         void move_task_items_from(thread_queue *src,
             boost::int64_t count)
         {
@@ -870,10 +962,11 @@ namespace hpx { namespace threads { namespace policies
 
             // acquire lock only if absolutely necessary
             std::lock_guard<mutex_type> lk(mtx_);
+            link_new_threads();
 
             boost::int64_t num_threads = 0;
-            thread_map_type::const_iterator end = thread_map_.end();
-            for (thread_map_type::const_iterator it = thread_map_.begin();
+            thread_list_type::const_iterator end = thread_list_.end();
+            for (thread_list_type::const_iterator it = thread_list_.begin();
                  it != end; ++it)
             {
                 if ((*it)->get_state() == state)
@@ -886,15 +979,16 @@ namespace hpx { namespace threads { namespace policies
         void abort_all_suspended_threads()
         {
             std::lock_guard<mutex_type> lk(mtx_);
-            thread_map_type::iterator end =  thread_map_.end();
-            for (thread_map_type::iterator it = thread_map_.begin();
+            link_new_threads();
+            thread_list_type::const_iterator end = thread_list_.end();
+            for (thread_list_type::const_iterator it = thread_list_.begin();
                  it != end; ++it)
             {
                 if ((*it)->get_state() == suspended)
                 {
                     (*it)->set_state_ex(wait_abort);
                     (*it)->set_state(pending);
-                    schedule_thread((*it).get());
+                    schedule_thread(*it);
                 }
             }
         }
@@ -954,7 +1048,8 @@ namespace hpx { namespace threads { namespace policies
 #else
             if (minimal_deadlock_detection) {
                 std::lock_guard<mutex_type> lk(mtx_);
-                return detail::dump_suspended_threads(num_thread, thread_map_
+                link_new_threads();
+                return detail::dump_suspended_threads(num_thread, thread_list_
                   , idle_loop_count, running);
             }
             return false;
@@ -962,15 +1057,35 @@ namespace hpx { namespace threads { namespace policies
         }
 
         ///////////////////////////////////////////////////////////////////////
-        void on_start_thread(std::size_t num_thread) {}
-        void on_stop_thread(std::size_t num_thread) {}
+        void on_start_thread(std::size_t num_thread)
+        {
+            work_items_.on_start_thread();
+        }
+        void on_stop_thread(std::size_t num_thread)
+        {
+            work_items_.on_stop_thread();
+        }
         void on_error(std::size_t num_thread, boost::exception_ptr const& e) {}
 
+    private:
+        static void release_thread_heap(thread_heap_type& heap)
+        {
+            thread_data* thrd = 0;
+            while (heap.pop(thrd))
+                intrusive_ptr_release(thrd);
+        }
+
     private:
         mutable mutex_type mtx_;                    ///< mutex protecting the members
 
-        thread_map_type thread_map_;
-        ///< mapping of thread id's to HPX-threads
+        mutable thread_list_type thread_list_;
+        ///< list of all HPX-threads managed by this queue
+        mutable boost::atomic<thread_data*> new_threads_;
+        ///< HPX-threads added since thread_list_ was accessed last
+#if defined(HPX_HAVE_THREAD_QUEUE_DEBUG_MAP)
+        mutable thread_map_type thread_map_;
+        ///< mapping of thread id's to HPX-threads (for verification only)
+#endif
         boost::atomic<boost::int64_t> thread_map_count_;
         ///< overall count of work items
 
@@ -1006,10 +1121,11 @@ namespace hpx { namespace threads { namespace policies
         threads::thread_pool memory_pool_;          ///< OS thread local memory pools for
                                                     ///< HPX-threads
 
-        std::list<thread_id_type> thread_heap_small_;
-        std::list<thread_id_type> thread_heap_medium_;
-        std::list<thread_id_type> thread_heap_large_;
-        std::list<thread_id_type> thread_heap_huge_;
+        thread_heap_type thread_heap_small_;        ///< caches of recycled
+        thread_heap_type thread_heap_medium_;       ///< HPX-threads (and
+        thread_heap_type thread_heap_large_;        ///< their stacks)
+        thread_heap_type thread_heap_huge_;
+        thread_heap_type thread_heap_nostack_;
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
         boost::uint64_t add_new_time_;
@@ -1031,6 +1147,10 @@ namespace hpx { namespace threads { namespace policies
         ///< count of work_items stolen to this queue from other queues
         boost::atomic<boost::int64_t> stolen_to_staged_;
         ///< count of new_tasks stolen to this queue from other queues
+        boost::atomic<boost::int64_t> steal_batches_;
+        ///< count of steal operations moving work_items to this queue
+        boost::atomic<boost::int64_t> steal_batch_items_;
+        ///< count of work_items moved to this queue by those operations
 #endif
 
         util::block_profiler<add_new_tag> add_new_logger_;
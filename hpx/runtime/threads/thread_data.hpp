@@ -110,6 +110,8 @@ namespace hpx { namespace threads
         ~thread_data()
         {
             free_thread_exit_callbacks();
+            if (stackless_tss_)
+                coroutines::detail::delete_tss_storage(stackless_tss_);
             LTM_(debug) << "~thread(" << this << "), description(" //-V128
                         << get_description() << "), phase("
                         << get_thread_phase() << ")";
@@ -473,11 +475,36 @@ namespace hpx { namespace threads
             return stacksize_;
         }
 
+        /// Return the absolute deadline of this thread (see
+        /// \a thread_init_data::deadline), zero if it has none
+        boost::uint64_t get_deadline() const
+        {
+            return deadline_;
+        }
+
         pool_type* get_pool()
         {
             return pool_;
         }
 
+        /// The owning thread_queue links all threads it manages into an
+        /// intrusive list, which avoids allocating any bookkeeping nodes
+        /// while creating threads. These links must be accessed while
+        /// holding the queue's mutex only.
+        thread_data* get_queue_prev() const
+        {
+            return queue_prev_;
+        }
+        thread_data* get_queue_next() const
+        {
+            return queue_next_;
+        }
+        void set_queue_links(thread_data* prev, thread_data* next)
+        {
+            queue_prev_ = prev;
+            queue_next_ = next;
+        }
+
         /// \brief Execute the thread function
         ///
         /// \returns        This function returns the thread state the thread
@@ -490,13 +517,26 @@ namespace hpx { namespace threads
             current_state_ex_.store(thread_state_ex(wait_signaled,
                 current_state_ex.get_tag() + 1), boost::memory_order_release);
 
+            if (is_stackless())
+                return invoke_stackless(current_state_ex);
+
             HPX_ASSERT(this_() == coroutine_.get_thread_id());
 
             return coroutine_(current_state_ex);
         }
 
+        /// Return whether this thread runs directly on the stack of the
+        /// worker thread executing it (see \a thread_stacksize_nostack).
+        bool is_stackless() const
+        {
+            return stacksize_ == nostack_stack_size;
+        }
+
         thread_id_type get_thread_id() const
         {
+            if (is_stackless())
+                return thread_id_type(const_cast<thread_data*>(this));
+
             return thread_id_type(
                     reinterpret_cast<thread_data*>(coroutine_.get_thread_id())
                 );
@@ -507,18 +547,28 @@ namespace hpx { namespace threads
 #ifndef HPX_HAVE_THREAD_PHASE_INFORMATION
             return 0;
 #else
-            return coroutine_.get_thread_phase();
+            return is_stackless() ? 0 : coroutine_.get_thread_phase();
 #endif
         }
 
 #ifdef HPX_HAVE_THREAD_LOCAL_STORAGE
         std::size_t get_thread_data() const
         {
+            if (is_stackless())
+            {
+                return stackless_tss_ ?
+                    coroutines::detail::get_tss_thread_data(stackless_tss_) : 0;
+            }
             return coroutine_.get_thread_data();
         }
 
         std::size_t set_thread_data(std::size_t data)
         {
+            if (is_stackless())
+            {
+                return coroutines::detail::set_tss_thread_data(
+                    stackless_tss_, data);
+            }
             return coroutine_.set_thread_data(data);
         }
 #endif
@@ -532,6 +582,13 @@ namespace hpx { namespace threads
 
             rebind_base(init_data, newstate);
 
+            if (is_stackless())
+            {
+                stackless_func_ = std::move(init_data.func);
+                stackless_target_ = std::move(init_data.target);
+                return;
+            }
+
             coroutine_.rebind(std::move(init_data.func),
                 std::move(init_data.target), this_());
 
@@ -576,9 +633,12 @@ namespace hpx { namespace threads
             scheduler_base_(init_data.scheduler_base),
             count_(0),
             stacksize_(init_data.stacksize),
-            coroutine_(std::move(init_data.func), std::move(init_data.target),
-                this_(), init_data.stacksize),
-            pool_(&pool)
+            deadline_(init_data.deadline),
+            coroutine_(create_coroutine(init_data, this_())),
+            pool_(&pool),
+            stackless_tss_(0),
+            queue_prev_(0),
+            queue_next_(0)
         {
             LTM_(debug) << "thread::thread(" << this << "), description("
                         << get_description() << ")";
@@ -598,9 +658,30 @@ namespace hpx { namespace threads
                 parent_locality_id_ = get_locality_id();
 #endif
             HPX_ASSERT(init_data.stacksize != 0);
-            HPX_ASSERT(coroutine_.is_ready());
+            HPX_ASSERT(is_stackless() || coroutine_.is_ready());
+
+            if (is_stackless())
+            {
+                stackless_func_ = std::move(init_data.func);
+                stackless_target_ = std::move(init_data.target);
+            }
+        }
+
+        // stackless threads don't need a coroutine (and its stack)
+        static coroutine_type create_coroutine(thread_init_data& init_data,
+            thread_id_repr_type id)
+        {
+            if (init_data.stacksize == nostack_stack_size)
+                return coroutine_type();
+
+            return coroutine_type(std::move(init_data.func),
+                std::move(init_data.target), id, init_data.stacksize);
         }
 
+        // run the thread function directly on the stack of the calling
+        // worker thread
+        thread_state_enum invoke_stackless(thread_state_ex_enum state_ex);
+
         void rebind_base(thread_init_data& init_data, thread_state_enum newstate)
         {
             free_thread_exit_callbacks();
@@ -631,6 +712,7 @@ namespace hpx { namespace threads
             ran_exit_funcs_ = false;
             exit_funcs_.clear();
             scheduler_base_ = init_data.scheduler_base;
+            deadline_ = init_data.deadline;
 
             HPX_ASSERT(init_data.stacksize == get_stack_size());
 
@@ -703,9 +785,20 @@ namespace hpx { namespace threads
         boost::detail::atomic_count count_;
 
         std::ptrdiff_t stacksize_;
+        boost::uint64_t deadline_;
 
         coroutine_type coroutine_;
         pool_type* pool_;
+
+        // the function and target of stackless threads (these are held by
+        // the coroutine otherwise)
+        function_type stackless_func_;
+        naming::id_type stackless_target_;
+        coroutines::detail::tss_storage* stackless_tss_;
+
+        // links maintained by the owning thread_queue
+        thread_data* queue_prev_;
+        thread_data* queue_next_;
     };
 
     typedef thread_data::pool_type thread_pool;
@@ -26,8 +26,9 @@ namespace hpx { namespace threads
     class HPX_EXPORT threadmanager_impl;
 
     typedef thread_state_enum thread_function_sig(thread_state_ex_enum);
-    typedef util::unique_function_nonser<thread_function_sig>
-        thread_function_type;
+    typedef util::unique_function<
+            thread_function_sig, false, HPX_THREAD_FUNCTION_STORAGE_SIZE
+        > thread_function_type;
 
     class HPX_EXPORT executor;
 
@@ -12,6 +12,7 @@
 #include <hpx/runtime/threads/detail/tagged_thread_state.hpp>
 
 #include <cstddef>
+#include <limits>
 
 namespace hpx { namespace threads
 {
@@ -87,12 +88,21 @@ namespace hpx { namespace threads
         thread_stacksize_medium = 2,        ///< use medium sized stack size
         thread_stacksize_large = 3,         ///< use large stack size
         thread_stacksize_huge = 4,          ///< use very large stack size
+        thread_stacksize_nostack = 5,       ///< run on the stack of the worker
+                                            ///< thread, can't suspend
 
         thread_stacksize_default = thread_stacksize_small,  ///< use default stack size
         thread_stacksize_minimal = thread_stacksize_small,  ///< use minimally stack size
         thread_stacksize_maximal = thread_stacksize_huge,   ///< use maximally stack size
     };
 
+    /// \cond NOINTERNAL
+    // the (invalid) stack size used to mark threads created with
+    // thread_stacksize_nostack
+    std::ptrdiff_t const nostack_stack_size =
+        (std::numeric_limits<std::ptrdiff_t>::max)();
+    /// \endcond
+
     HPX_API_EXPORT char const* get_stack_size_name(std::ptrdiff_t size);
 }}
 
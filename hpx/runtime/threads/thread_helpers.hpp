@@ -19,6 +19,7 @@
 #include <hpx/util/function.hpp>
 #include <hpx/util/thread_description.hpp>
 
+#include <boost/cstdint.hpp>
 #include <boost/exception_ptr.hpp>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -438,6 +439,15 @@ namespace hpx { namespace threads
 
     /// Set the new scheduler mode
     HPX_API_EXPORT void set_scheduler_mode(threads::policies::scheduler_mode);
+
+    /// Retrieve the accumulated time the worker threads spent executing
+    /// HPX-threads (\a exec_time) and the accumulated time they spent in the
+    /// scheduling loop (\a total_time), both in nanoseconds. The idle rate
+    /// over a period of time is 1 - (exec_time difference / total_time
+    /// difference). Returns false if the idle rates are not collected (see
+    /// HPX_WITH_THREAD_IDLE_RATES) or if the runtime is not running.
+    HPX_API_EXPORT bool get_idle_rate_times(boost::uint64_t& exec_time,
+        boost::uint64_t& total_time);
 }}
 
 namespace hpx { namespace this_thread
@@ -458,6 +468,10 @@ namespace hpx { namespace this_thread
     ///         If this function is called while the thread-manager is not
     ///         running, it will throw an \a hpx#exception with an error code of
     ///         \a hpx#invalid_status.
+    ///         Threads created with \a thread_stacksize_nostack can't be
+    ///         suspended. For those this function returns immediately if
+    ///         \a state is \a pending and throws an \a hpx#exception with an
+    ///         error code of \a hpx#invalid_status otherwise.
     ///
     HPX_API_EXPORT threads::thread_state_ex_enum suspend(
         threads::thread_state_enum state = threads::pending,
@@ -12,6 +12,8 @@
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/util/thread_description.hpp>
 
+#include <boost/cstdint.hpp>
+
 namespace hpx { namespace threads
 {
     HPX_API_EXPORT std::ptrdiff_t get_default_stack_size();
@@ -37,6 +39,7 @@ namespace hpx { namespace threads
             priority(thread_priority_normal),
             num_os_thread(std::size_t(-1)),
             stacksize(get_default_stack_size()),
+            deadline(0),
             scheduler_base(0)
         {}
 
@@ -55,6 +58,7 @@ namespace hpx { namespace threads
             priority(rhs.priority),
             num_os_thread(rhs.num_os_thread),
             stacksize(rhs.stacksize),
+            deadline(rhs.deadline),
             target(std::move(rhs.target)),
             scheduler_base(rhs.scheduler_base)
         {}
@@ -80,6 +84,7 @@ namespace hpx { namespace threads
             priority(priority_), num_os_thread(os_thread),
             stacksize(stacksize_ == std::ptrdiff_t(-1) ?
                 get_default_stack_size() : stacksize_),
+            deadline(0),
             target(target_),
             scheduler_base(scheduler_base_)
         {}
@@ -102,6 +107,10 @@ namespace hpx { namespace threads
         std::size_t num_os_thread;
         std::ptrdiff_t stacksize;
 
+        // optional absolute deadline (in nanoseconds, as returned by
+        // util::high_resolution_clock::now()), zero if none
+        boost::uint64_t deadline;
+
         naming::id_type target;
 
         policies::scheduler_base* scheduler_base;
@@ -195,10 +195,34 @@ namespace hpx { namespace threads
 #endif
 #endif
 
+#ifdef HPX_HAVE_THREAD_IDLE_RATES
+        /// Return the accumulated time the worker threads spent executing
+        /// HPX-threads and the accumulated time they spent in the scheduling
+        /// loop (in nanoseconds), counter resets don't affect these values.
+        virtual void get_idle_rate_times(boost::uint64_t& exec_time,
+            boost::uint64_t& total_time) = 0;
+#endif
+
         // Returns the mask identifying all processing units used by this
         // thread manager.
         virtual mask_cref_type get_used_processing_units() const = 0;
 
+        /// \brief Restart a worker thread removed earlier
+        ///
+        /// \param virt_core [in] The number of the worker thread to restart.
+        /// \param thread_num [in] The number of the processing unit the
+        ///               worker thread should be bound to.
+        virtual void add_processing_unit(std::size_t virt_core,
+            std::size_t thread_num, error_code& ec = throws) = 0;
+
+        /// \brief Stop a worker thread, its remaining work is moved to the
+        ///        other worker threads
+        ///
+        /// \param virt_core [in] The number of the worker thread to stop. This
+        ///               must not be the worker thread running the caller.
+        virtual void remove_processing_unit(std::size_t virt_core,
+            error_code& ec = throws) = 0;
+
         ///////////////////////////////////////////////////////////////////////
         virtual std::size_t get_worker_thread_num(bool* numa_sensitive = 0) = 0;
 
@@ -185,6 +185,9 @@ namespace hpx { namespace threads
         /// Get percent maintenance time in main thread-manager loop.
         boost::int64_t avg_idle_rate(bool reset);
         boost::int64_t avg_idle_rate(std::size_t num_thread, bool reset);
+
+        void get_idle_rate_times(boost::uint64_t& exec_time,
+            boost::uint64_t& total_time);
 #endif
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
         boost::int64_t avg_creation_idle_rate(bool reset);
@@ -279,6 +282,20 @@ namespace hpx { namespace threads
             return pool_.get_used_processing_units();
         }
 
+        void add_processing_unit(std::size_t virt_core,
+            std::size_t thread_num, error_code& ec = throws)
+        {
+            std::unique_lock<mutex_type> lk(mtx_);
+            pool_.add_processing_unit(lk, virt_core, thread_num, ec);
+        }
+
+        void remove_processing_unit(std::size_t virt_core,
+            error_code& ec = throws)
+        {
+            std::unique_lock<mutex_type> lk(mtx_);
+            pool_.remove_processing_unit(lk, virt_core, ec);
+        }
+
         void set_scheduler_mode(threads::policies::scheduler_mode mode)
         {
             pool_.set_scheduler_mode(mode);
@@ -115,6 +115,28 @@ namespace hpx
             > abp_fifo_priority_queue_scheduler;
 #endif
 
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+            struct lockfree_chase_lev;
+
+            typedef local_priority_queue_scheduler<
+                boost::mutex,
+                lockfree_chase_lev, // owner LIFO + Chase-Lev pending queuing
+                lockfree_fifo, // FIFO staged queuing
+                lockfree_lifo  // LIFO terminated queuing
+            > chase_lev_priority_queue_scheduler;
+#endif
+
+#if defined(HPX_HAVE_DEADLINE_SCHEDULER)
+            struct deadline_edf;
+
+            typedef local_priority_queue_scheduler<
+                boost::mutex,
+                deadline_edf,  // earliest deadline first pending queuing
+                deadline_edf,  // earliest deadline first staged queuing
+                lockfree_lifo  // LIFO terminated queuing
+            > deadline_queue_scheduler;
+#endif
+
             // define the default scheduler to use
             typedef fifo_priority_queue_scheduler queue_scheduler;
 
@@ -20,6 +20,7 @@
 
 #include <boost/mpl/bool.hpp>
 
+#include <cstddef>
 #include <cstring>
 #include <string>
 #include <type_traits>
@@ -70,8 +71,10 @@ namespace hpx { namespace util { namespace detail
         serializable_function_vtable_ptr(construct_vtable<T>) HPX_NOEXCEPT
           : VTablePtr(construct_vtable<T>())
           , name("empty")
-          , save_object(&serializable_vtable::save_object<T>)
-          , load_object(&serializable_vtable::load_object<T>)
+          , save_object(&serializable_vtable::template save_object<
+                T, VTablePtr::function_storage_size>)
+          , load_object(&serializable_vtable::template load_object<
+                T, VTablePtr::function_storage_size>)
         {
             if (!this->empty)
             {
@@ -122,6 +125,10 @@ namespace hpx { namespace util { namespace detail
     {
         HPX_MOVABLE_ONLY(function_base);
 
+        // size of the small object buffer (in bytes)
+        static const std::size_t storage_size =
+            VTablePtr::function_storage_size;
+
         // make sure the empty table instance is initialized in time, even
         // during early startup
         static VTablePtr const* get_empty_table()
@@ -135,17 +142,21 @@ namespace hpx { namespace util { namespace detail
         function_base() HPX_NOEXCEPT
           : vptr(get_empty_table())
         {
-            std::memset(object, 0, vtable::function_storage_size);
-            vtable::default_construct<empty_function<R(Ts...)> >(object);
+            std::memset(object, 0, sizeof(object));
+            vtable::default_construct<
+                empty_function<R(Ts...)>, storage_size
+            >(object);
         }
 
         function_base(function_base&& other) HPX_NOEXCEPT
           : vptr(other.vptr)
         {
             // move-construct
-            std::memcpy(object, other.object, vtable::function_storage_size);
+            std::memcpy(object, other.object, sizeof(object));
             other.vptr = get_empty_table();
-            vtable::default_construct<empty_function<R(Ts...)> >(other.object);
+            vtable::default_construct<
+                empty_function<R(Ts...)>, storage_size
+            >(other.object);
         }
 
         ~function_base()
@@ -173,13 +184,17 @@ namespace hpx { namespace util { namespace detail
                 VTablePtr const* f_vptr = get_table_ptr<target_type>();
                 if (vptr == f_vptr)
                 {
-                    vtable::reconstruct<target_type>(object, std::forward<F>(f));
+                    vtable::reconstruct<target_type, storage_size>(
+                        object, std::forward<F>(f));
                 } else {
                     reset();
-                    vtable::delete_<empty_function<R(Ts...)> >(object);
+                    vtable::delete_<
+                        empty_function<R(Ts...)>, storage_size
+                    >(object);
 
                     vptr = f_vptr;
-                    vtable::construct<target_type>(object, std::forward<F>(f));
+                    vtable::construct<target_type, storage_size>(
+                        object, std::forward<F>(f));
                 }
             } else {
                 reset();
@@ -193,7 +208,9 @@ namespace hpx { namespace util { namespace detail
                 vptr->delete_(object);
 
                 vptr = get_empty_table();
-                vtable::default_construct<empty_function<R(Ts...)> >(object);
+                vtable::default_construct<
+                    empty_function<R(Ts...)>, storage_size
+                >(object);
             }
         }
 
@@ -239,7 +256,7 @@ namespace hpx { namespace util { namespace detail
             if (vptr != f_vptr || empty())
                 return 0;
 
-            return &vtable::get<target_type>(object);
+            return &vtable::get<target_type, storage_size>(object);
         }
 
         template <typename T>
@@ -255,7 +272,7 @@ namespace hpx { namespace util { namespace detail
             if (vptr != f_vptr || empty())
                 return 0;
 
-            return &vtable::get<target_type>(object);
+            return &vtable::get<target_type, storage_size>(object);
         }
 
         HPX_FORCEINLINE R operator()(Ts... vs) const
@@ -277,7 +294,8 @@ namespace hpx { namespace util { namespace detail
 
     protected:
         VTablePtr const *vptr;
-        mutable void* object[vtable::function_storage_size];
+        mutable void* object[
+            (storage_size + sizeof(void*) - 1) / sizeof(void*)];
     };
 
     template <typename Sig, typename VTablePtr>
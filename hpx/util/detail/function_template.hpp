@@ -16,15 +16,19 @@
 #include <hpx/util/detail/vtable/copyable_vtable.hpp>
 #include <hpx/util/detail/vtable/vtable.hpp>
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
 namespace hpx { namespace util { namespace detail
 {
     ///////////////////////////////////////////////////////////////////////////
-    template <typename Sig>
+    template <typename Sig,
+        std::size_t Size = vtable::function_storage_size>
     struct function_vtable_ptr
     {
+        static const std::size_t function_storage_size = Size;
+
         typename callable_vtable<Sig>::invoke_t invoke;
         typename callable_vtable<Sig>::get_function_address_t get_function_address;
         copyable_vtable::copy_t copy;
@@ -35,25 +39,26 @@ namespace hpx { namespace util { namespace detail
 
         template <typename T>
         function_vtable_ptr(construct_vtable<T>) HPX_NOEXCEPT
-          : invoke(&callable_vtable<Sig>::template invoke<T>)
-          , get_function_address(&callable_vtable<Sig>::template get_function_address<T>)
-          , copy(&copyable_vtable::template copy<T>)
+          : invoke(&callable_vtable<Sig>::template invoke<T, Size>)
+          , get_function_address(
+                &callable_vtable<Sig>::template get_function_address<T, Size>)
+          , copy(&copyable_vtable::template copy<T, Size>)
           , get_type(&vtable::template get_type<T>)
-          , destruct(&vtable::template destruct<T>)
-          , delete_(&vtable::template delete_<T>)
+          , destruct(&vtable::template destruct<T, Size>)
+          , delete_(&vtable::template delete_<T, Size>)
           , empty(std::is_same<T, empty_function<Sig> >::value)
         {}
 
         template <typename T, typename Arg>
         HPX_FORCEINLINE static void construct(void** v, Arg&& arg)
         {
-            vtable::construct<T>(v, std::forward<Arg>(arg));
+            vtable::construct<T, Size>(v, std::forward<Arg>(arg));
         }
 
         template <typename T, typename Arg>
         HPX_FORCEINLINE static void reconstruct(void** v, Arg&& arg)
         {
-            vtable::reconstruct<T>(v, std::forward<Arg>(arg));
+            vtable::reconstruct<T, Size>(v, std::forward<Arg>(arg));
         }
     };
 }}}
@@ -61,17 +66,21 @@ namespace hpx { namespace util { namespace detail
 namespace hpx { namespace util
 {
     ///////////////////////////////////////////////////////////////////////////
-    template <typename Sig, bool Serializable = true>
+    // StorageSize is the size of the small object buffer (in bytes), larger
+    // function objects are allocated on the heap.
+    template <typename Sig, bool Serializable = true,
+        std::size_t StorageSize = detail::vtable::function_storage_size>
     class function;
 
-    template <typename R, typename ...Ts, bool Serializable>
-    class function<R(Ts...), Serializable>
+    template <typename R, typename ...Ts, bool Serializable,
+        std::size_t StorageSize>
+    class function<R(Ts...), Serializable, StorageSize>
       : public detail::basic_function<
-            detail::function_vtable_ptr<R(Ts...)>
+            detail::function_vtable_ptr<R(Ts...), StorageSize>
           , R(Ts...), Serializable
         >
     {
-        typedef detail::function_vtable_ptr<R(Ts...)> vtable_ptr;
+        typedef detail::function_vtable_ptr<R(Ts...), StorageSize> vtable_ptr;
         typedef detail::basic_function<vtable_ptr, R(Ts...), Serializable> base_type;
 
     public:
@@ -85,7 +94,7 @@ namespace hpx { namespace util
           : base_type()
         {
             detail::vtable::delete_<
-                detail::empty_function<R(Ts...)>
+                detail::empty_function<R(Ts...)>, StorageSize
             >(this->object);
 
             this->vptr = other.vptr;
@@ -119,7 +128,7 @@ namespace hpx { namespace util
             {
                 reset();
                 detail::vtable::delete_<
-                    detail::empty_function<R(Ts...)>
+                    detail::empty_function<R(Ts...)>, StorageSize
                 >(this->object);
 
                 this->vptr = other.vptr;
@@ -159,9 +168,9 @@ namespace hpx { namespace util
         using base_type::target;
     };
 
-    template <typename Sig, bool Serializable>
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
     static bool is_empty_function(
-        function<Sig, Serializable> const& f) HPX_NOEXCEPT
+        function<Sig, Serializable, StorageSize> const& f) HPX_NOEXCEPT
     {
         return f.empty();
     }
@@ -242,11 +251,12 @@ namespace hpx { namespace util
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace traits
 {
-    template <typename Sig, bool Serializable>
-    struct get_function_address<util::function<Sig, Serializable> >
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
+    struct get_function_address<
+        util::function<Sig, Serializable, StorageSize> >
     {
-        static std::size_t
-            call(util::function<Sig, Serializable> const& f) HPX_NOEXCEPT
+        static std::size_t call(
+            util::function<Sig, Serializable, StorageSize> const& f) HPX_NOEXCEPT
         {
             return f.get_function_address();
         }
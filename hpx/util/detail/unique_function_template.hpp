@@ -15,15 +15,19 @@
 #include <hpx/util/detail/vtable/callable_vtable.hpp>
 #include <hpx/util/detail/vtable/vtable.hpp>
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
 namespace hpx { namespace util { namespace detail
 {
     ///////////////////////////////////////////////////////////////////////
-    template <typename Sig>
+    template <typename Sig,
+        std::size_t Size = vtable::function_storage_size>
     struct unique_function_vtable_ptr
     {
+        static const std::size_t function_storage_size = Size;
+
         typename callable_vtable<Sig>::invoke_t invoke;
         typename callable_vtable<Sig>::get_function_address_t get_function_address;
         vtable::get_type_t get_type;
@@ -33,24 +37,25 @@ namespace hpx { namespace util { namespace detail
 
         template <typename T>
         unique_function_vtable_ptr(construct_vtable<T>) HPX_NOEXCEPT
-          : invoke(&callable_vtable<Sig>::template invoke<T>)
-          , get_function_address(&callable_vtable<Sig>::template get_function_address<T>)
+          : invoke(&callable_vtable<Sig>::template invoke<T, Size>)
+          , get_function_address(
+                &callable_vtable<Sig>::template get_function_address<T, Size>)
           , get_type(&vtable::template get_type<T>)
-          , destruct(&vtable::template destruct<T>)
-          , delete_(&vtable::template delete_<T>)
+          , destruct(&vtable::template destruct<T, Size>)
+          , delete_(&vtable::template delete_<T, Size>)
           , empty(std::is_same<T, empty_function<Sig> >::value)
         {}
 
         template <typename T, typename Arg>
         HPX_FORCEINLINE static void construct(void** v, Arg&& arg)
         {
-            vtable::construct<T>(v, std::forward<Arg>(arg));
+            vtable::construct<T, Size>(v, std::forward<Arg>(arg));
         }
 
         template <typename T, typename Arg>
         HPX_FORCEINLINE static void reconstruct(void** v, Arg&& arg)
         {
-            vtable::reconstruct<T>(v, std::forward<Arg>(arg));
+            vtable::reconstruct<T, Size>(v, std::forward<Arg>(arg));
         }
     };
 }}}
@@ -58,17 +63,21 @@ namespace hpx { namespace util { namespace detail
 namespace hpx { namespace util
 {
     ///////////////////////////////////////////////////////////////////////////
-    template <typename Sig, bool Serializable = true>
+    // StorageSize is the size of the small object buffer (in bytes), larger
+    // function objects are allocated on the heap.
+    template <typename Sig, bool Serializable = true,
+        std::size_t StorageSize = detail::vtable::function_storage_size>
     class unique_function;
 
-    template <typename R, typename ...Ts, bool Serializable>
-    class unique_function<R(Ts...), Serializable>
+    template <typename R, typename ...Ts, bool Serializable,
+        std::size_t StorageSize>
+    class unique_function<R(Ts...), Serializable, StorageSize>
       : public detail::basic_function<
-            detail::unique_function_vtable_ptr<R(Ts...)>
+            detail::unique_function_vtable_ptr<R(Ts...), StorageSize>
           , R(Ts...), Serializable
         >
     {
-        typedef detail::unique_function_vtable_ptr<R(Ts...)> vtable_ptr;
+        typedef detail::unique_function_vtable_ptr<R(Ts...), StorageSize> vtable_ptr;
         typedef detail::basic_function<vtable_ptr, R(Ts...), Serializable> base_type;
 
         HPX_MOVABLE_ONLY(unique_function);
@@ -120,9 +129,9 @@ namespace hpx { namespace util
         using base_type::target;
     };
 
-    template <typename Sig, bool Serializable>
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
     static bool is_empty_function(
-        unique_function<Sig, Serializable> const& f) HPX_NOEXCEPT
+        unique_function<Sig, Serializable, StorageSize> const& f) HPX_NOEXCEPT
     {
         return f.empty();
     }
@@ -196,11 +205,12 @@ namespace hpx { namespace util
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace traits
 {
-    template <typename Sig, bool Serializable>
-    struct get_function_address<util::unique_function<Sig, Serializable> >
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
+    struct get_function_address<
+        util::unique_function<Sig, Serializable, StorageSize> >
     {
-        static std::size_t
-            call(util::unique_function<Sig, Serializable> const& f) HPX_NOEXCEPT
+        static std::size_t call(
+            util::unique_function<Sig, Serializable, StorageSize> const& f) HPX_NOEXCEPT
         {
             return f.get_function_address();
         }
@@ -13,6 +13,7 @@
 #include <hpx/util/detail/vtable/vtable.hpp>
 #include <hpx/util/invoke.hpp>
 
+#include <cstddef>
 #include <typeinfo>
 #include <utility>
 
@@ -20,10 +21,12 @@ namespace hpx { namespace util { namespace detail
 {
     struct callable_vtable_base
     {
-        template <typename T>
+        template <typename T,
+            std::size_t Size = vtable::function_storage_size>
         HPX_FORCEINLINE static std::size_t get_function_address(void** f)
         {
-            return traits::get_function_address<T>::call(vtable::get<T>(f));
+            return traits::get_function_address<T>::call(
+                vtable::get<T, Size>(f));
         }
         typedef std::size_t (*get_function_address_t)(void**);
     };
@@ -34,11 +37,12 @@ namespace hpx { namespace util { namespace detail
     template <typename R, typename ...Ts>
     struct callable_vtable<R(Ts...)> : callable_vtable_base
     {
-        template <typename T>
+        template <typename T,
+            std::size_t Size = vtable::function_storage_size>
         HPX_FORCEINLINE static R invoke(void** f, Ts&&... vs)
         {
             return util::invoke<R>(
-                vtable::get<T>(f), std::forward<Ts>(vs)...);
+                vtable::get<T, Size>(f), std::forward<Ts>(vs)...);
         }
         typedef R (*invoke_t)(void**, Ts&&...);
     };
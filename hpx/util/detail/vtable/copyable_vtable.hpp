@@ -11,18 +11,21 @@
 #include <hpx/config/forceinline.hpp>
 #include <hpx/util/detail/vtable/vtable.hpp>
 
+#include <cstddef>
+
 namespace hpx { namespace util { namespace detail
 {
     struct copyable_vtable : vtable
     {
-        template <typename T>
+        template <typename T,
+            std::size_t Size = vtable::function_storage_size>
         HPX_FORCEINLINE static void copy(void** v, void* const* src)
         {
-            if (sizeof(T) <= vtable::function_storage_size)
+            if (sizeof(T) <= Size)
             {
-                new (v) T(get<T>(src));
+                new (v) T(get<T, Size>(src));
             } else {
-                *v = new T(get<T>(src));
+                *v = new T(get<T, Size>(src));
             }
         }
         typedef void (*copy_t)(void**, void* const*);
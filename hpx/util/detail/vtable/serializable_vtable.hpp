@@ -12,25 +12,29 @@
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
 #include <hpx/util/detail/vtable/vtable.hpp>
 
+#include <cstddef>
+
 namespace hpx { namespace util { namespace detail
 {
     struct serializable_vtable
     {
-        template <typename T>
+        template <typename T,
+            std::size_t Size = vtable::function_storage_size>
         static void save_object(void* const* v,
             serialization::output_archive& ar, unsigned version)
         {
-            ar << vtable::get<T>(v);
+            ar << vtable::get<T, Size>(v);
         }
         typedef void (*save_object_t)(void* const*,
             serialization::output_archive&, unsigned);
 
-        template <typename T>
+        template <typename T,
+            std::size_t Size = vtable::function_storage_size>
         static void load_object(void** v,
             serialization::input_archive& ar, unsigned version)
         {
-            vtable::default_construct<T>(v);
-            ar >> vtable::get<T>(v);
+            vtable::default_construct<T, Size>(v);
+            ar >> vtable::get<T, Size>(v);
         }
         typedef void (*load_object_t)(void**,
             serialization::input_archive&, unsigned);
@@ -8,8 +8,10 @@
 #ifndef HPX_UTIL_DETAIL_VTABLE_VTABLE_HPP
 #define HPX_UTIL_DETAIL_VTABLE_VTABLE_HPP
 
+#include <hpx/config.hpp>
 #include <hpx/config/forceinline.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <typeinfo>
 #include <utility>
@@ -19,7 +21,11 @@ namespace hpx { namespace util { namespace detail
     ///////////////////////////////////////////////////////////////////////////
     struct vtable
     {
-        static const std::size_t function_storage_size = 3*sizeof(void*);
+        // Default size of the small object buffer of function objects (in
+        // bytes), larger callables are allocated on the heap. All functions
+        // below accept the size of the buffer they operate on.
+        static const std::size_t function_storage_size =
+            HPX_FUNCTION_STORAGE_SIZE;
 
         template <typename T>
         HPX_FORCEINLINE static std::type_info const& get_type()
@@ -28,10 +34,10 @@ namespace hpx { namespace util { namespace detail
         }
         typedef std::type_info const& (*get_type_t)();
 
-        template <typename T>
+        template <typename T, std::size_t Size = function_storage_size>
         HPX_FORCEINLINE static T& get(void** v)
         {
-            if (sizeof(T) <= function_storage_size)
+            if (sizeof(T) <= Size)
             {
                 return *reinterpret_cast<T*>(v);
             } else {
@@ -39,10 +45,10 @@ namespace hpx { namespace util { namespace detail
             }
         }
 
-        template <typename T>
+        template <typename T, std::size_t Size = function_storage_size>
         HPX_FORCEINLINE static T const& get(void* const* v)
         {
-            if (sizeof(T) <= function_storage_size)
+            if (sizeof(T) <= Size)
             {
                 return *reinterpret_cast<T const*>(v);
             } else {
@@ -50,10 +56,10 @@ namespace hpx { namespace util { namespace detail
             }
         }
 
-        template <typename T>
+        template <typename T, std::size_t Size = function_storage_size>
         HPX_FORCEINLINE static void default_construct(void** v)
         {
-            if (sizeof(T) <= function_storage_size)
+            if (sizeof(T) <= Size)
             {
                 ::new (static_cast<void*>(v)) T;
             } else {
@@ -61,10 +67,11 @@ namespace hpx { namespace util { namespace detail
             }
         }
 
-        template <typename T, typename Arg>
+        template <typename T, std::size_t Size = function_storage_size,
+            typename Arg>
         HPX_FORCEINLINE static void construct(void** v, Arg&& arg)
         {
-            if (sizeof(T) <= function_storage_size)
+            if (sizeof(T) <= Size)
             {
                 ::new (static_cast<void*>(v)) T(std::forward<Arg>(arg));
             } else {
@@ -72,28 +79,29 @@ namespace hpx { namespace util { namespace detail
             }
         }
 
-        template <typename T, typename Arg>
+        template <typename T, std::size_t Size = function_storage_size,
+            typename Arg>
         HPX_FORCEINLINE static void reconstruct(void** v, Arg&& arg)
         {
-            delete_<T>(v);
-            construct<T, Arg>(v, std::forward<Arg>(arg));
+            delete_<T, Size>(v);
+            construct<T, Size>(v, std::forward<Arg>(arg));
         }
 
-        template <typename T>
+        template <typename T, std::size_t Size = function_storage_size>
         HPX_FORCEINLINE static void destruct(void** v)
         {
-            get<T>(v).~T();
+            get<T, Size>(v).~T();
         }
         typedef void (*destruct_t)(void**);
 
-        template <typename T>
+        template <typename T, std::size_t Size = function_storage_size>
         HPX_FORCEINLINE static void delete_(void** v)
         {
-            if (sizeof(T) <= function_storage_size)
+            if (sizeof(T) <= Size)
             {
-                destruct<T>(v);
+                destruct<T, Size>(v);
             } else {
-                delete &get<T>(v);
+                delete &get<T, Size>(v);
             }
         }
         typedef void (*delete_t)(void**);
@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithms from "Dynamic Circular Work-Stealing Deque"
+//  by D. Chase and Y. Lev
+//  Link: http://dl.acm.org/citation.cfm?id=1073974
+//
+//  Memory orderings follow "Correct and Efficient Work-Stealing for Weak
+//  Memory Models" by N. M. Le, A. Pop, A. Cohen and F. Zappa Nardelli
+//  Link: http://dl.acm.org/citation.cfm?id=2442524
+//
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Disclaimer: Not a Boost library.
+//
+//  Only a single thread (the owner) is allowed to call push_bottom() and
+//  pop_bottom(). Any thread may call steal(). The owner operations do not
+//  execute any atomic read-modify-write instruction except when the deque
+//  holds exactly one element and the owner races with thieves for it.
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_JUL_12_2016_0214PM)
+#define HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_JUL_12_2016_0214PM
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>
+
+namespace boost { namespace lockfree
+{
+
+// T has to be trivially copyable, as the elements are stored in atomics (the
+// thread queues store pointers only).
+template <typename T>
+struct chase_lev_deque
+{
+  private:
+    HPX_NON_COPYABLE(chase_lev_deque);
+
+    // Circular array of elements. Arrays are never shrunk. Arrays replaced
+    // by a larger one are kept alive (linked through previous_) until the
+    // deque is destroyed as concurrent thieves might still read from them.
+    struct circular_array
+    {
+        circular_array(boost::int64_t size, circular_array* previous)
+          : mask_(size - 1),
+            data_(new boost::atomic<T>[std::size_t(size)]),
+            previous_(previous)
+        {
+            HPX_ASSERT(size > 0 && (size & mask_) == 0);
+        }
+
+        ~circular_array()
+        {
+            delete [] data_;
+        }
+
+        boost::int64_t size() const
+        {
+            return mask_ + 1;
+        }
+
+        T get(boost::int64_t i) const
+        {
+            return data_[i & mask_].load(boost::memory_order_relaxed);
+        }
+
+        void put(boost::int64_t i, T const& val)
+        {
+            data_[i & mask_].store(val, boost::memory_order_relaxed);
+        }
+
+        circular_array* grow(boost::int64_t bottom, boost::int64_t top)
+        {
+            circular_array* a = new circular_array(2 * size(), this);
+            for (boost::int64_t i = top; i != bottom; ++i)
+                a->put(i, get(i));
+            return a;
+        }
+
+        boost::int64_t const mask_;
+        boost::atomic<T>* data_;
+        circular_array* previous_;
+    };
+
+    static boost::int64_t initial_array_size(std::size_t initial_size)
+    {
+        boost::int64_t size = 32;
+        while (size < boost::int64_t(initial_size))
+            size *= 2;
+        return size;
+    }
+
+  public:
+    typedef T value_type;
+
+    explicit chase_lev_deque(std::size_t initial_size = 0)
+      : top_(0),
+        bottom_(0),
+        array_(new circular_array(initial_array_size(initial_size), 0))
+    {}
+
+    ~chase_lev_deque()
+    {
+        circular_array* a = array_.load(boost::memory_order_relaxed);
+        while (a != 0)
+        {
+            circular_array* previous = a->previous_;
+            delete a;
+            a = previous;
+        }
+    }
+
+    // Owner only: add an element at the bottom end of the deque.
+    bool push_bottom(T const& val)
+    {
+        boost::int64_t b = bottom_.load(boost::memory_order_relaxed);
+        boost::int64_t t = top_.load(boost::memory_order_acquire);
+        circular_array* a = array_.load(boost::memory_order_relaxed);
+
+        if (b - t > a->size() - 1)
+        {
+            a = a->grow(b, t);
+            array_.store(a, boost::memory_order_relaxed);
+        }
+
+        a->put(b, val);
+        boost::atomic_thread_fence(boost::memory_order_release);
+        bottom_.store(b + 1, boost::memory_order_relaxed);
+        return true;
+    }
+
+    // Owner only: remove the most recently pushed element.
+    bool pop_bottom(T& val)
+    {
+        boost::int64_t b = bottom_.load(boost::memory_order_relaxed) - 1;
+        circular_array* a = array_.load(boost::memory_order_relaxed);
+        bottom_.store(b, boost::memory_order_relaxed);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        boost::int64_t t = top_.load(boost::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // deque was empty
+            bottom_.store(b + 1, boost::memory_order_relaxed);
+            return false;
+        }
+
+        val = a->get(b);
+        if (t == b)
+        {
+            // last element, compete with thieves
+            bool result = top_.compare_exchange_strong(t, t + 1,
+                boost::memory_order_seq_cst, boost::memory_order_relaxed);
+            bottom_.store(b + 1, boost::memory_order_relaxed);
+            return result;
+        }
+        return true;
+    }
+
+    // Any thread: remove the least recently pushed element.
+    bool steal(T& val)
+    {
+        boost::int64_t t = top_.load(boost::memory_order_acquire);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        boost::int64_t b = bottom_.load(boost::memory_order_acquire);
+
+        while (t < b)
+        {
+            circular_array* a = array_.load(boost::memory_order_acquire);
+            val = a->get(t);
+            if (top_.compare_exchange_strong(t, t + 1,
+                    boost::memory_order_seq_cst, boost::memory_order_relaxed))
+            {
+                return true;
+            }
+
+            // lost the race with another thief or the owner, t has been
+            // reloaded by the failed exchange
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            b = bottom_.load(boost::memory_order_acquire);
+        }
+        return false;
+    }
+
+    bool empty() const
+    {
+        boost::int64_t b = bottom_.load(boost::memory_order_relaxed);
+        boost::int64_t t = top_.load(boost::memory_order_relaxed);
+        return b <= t;
+    }
+
+  private:
+    // top_ is modified by thieves, bottom_ by the owner only, keep them on
+    // separate cache lines
+    boost::atomic<boost::int64_t> top_;
+    char padding1_[BOOST_LOCKFREE_CACHELINE_BYTES
+        - sizeof(boost::atomic<boost::int64_t>)];
+
+    boost::atomic<boost::int64_t> bottom_;
+    boost::atomic<circular_array*> array_;
+    char padding2_[BOOST_LOCKFREE_CACHELINE_BYTES
+        - sizeof(boost::atomic<boost::int64_t>)
+        - sizeof(boost::atomic<circular_array*>)];
+};
+
+}}
+
+#endif
@@ -44,6 +44,8 @@ namespace hpx { namespace util
         ~pool_timer();
 
         bool start(bool evaluate = true);
+        bool start(hpx::util::steady_duration const& rel_time,
+            bool evaluate = true);
         bool stop();
 
         bool is_started() const;
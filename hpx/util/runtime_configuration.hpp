@@ -141,6 +141,7 @@ namespace hpx { namespace util
 
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         bool init_use_stack_guard_pages() const;
+        void init_stack_pool() const;
 #endif
 
         void pre_initialize_ini();
@@ -29,7 +29,9 @@ namespace hpx { namespace plugins { namespace parcel
         std::string const& name,
         get_counter_type num_parcels, get_counter_type num_messages,
         get_counter_type time_between_parcels,
-        get_counter_type average_time_between_parcels)
+        get_counter_type average_time_between_parcels,
+        get_counter_type batch_size, get_counter_type flush_timeout,
+        get_counter_type average_parcel_latency)
     {
         if (name.empty())
         {
@@ -41,7 +43,8 @@ namespace hpx { namespace plugins { namespace parcel
         counter_functions data =
         {
             num_parcels, num_messages,
-            time_between_parcels, average_time_between_parcels
+            time_between_parcels, average_time_between_parcels,
+            batch_size, flush_timeout, average_parcel_latency
         };
 
         auto it = map_.find(name);
@@ -142,6 +145,52 @@ namespace hpx { namespace plugins { namespace parcel
         return (*it).second.average_time_between_parcels;
     }
 
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_batch_size_counter(
+            std::string const& name) const
+    {
+        map_type::const_iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "coalescing_counter_registry::get_batch_size_counter",
+                "unknown action type");
+            return get_counter_type();
+        }
+        return (*it).second.batch_size;
+    }
+
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_flush_timeout_counter(
+            std::string const& name) const
+    {
+        map_type::const_iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "coalescing_counter_registry::get_flush_timeout_counter",
+                "unknown action type");
+            return get_counter_type();
+        }
+        return (*it).second.flush_timeout;
+    }
+
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_average_parcel_latency_counter(
+            std::string const& name) const
+    {
+        map_type::const_iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "coalescing_counter_registry::"
+                    "get_average_parcel_latency_counter",
+                "unknown action type");
+            return get_counter_type();
+        }
+        return (*it).second.average_parcel_latency;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     bool coalescing_counter_registry::counter_discoverer(
         performance_counters::counter_info const& info,
@@ -17,8 +17,10 @@
 #include <hpx/plugins/parcel/coalescing_message_handler.hpp>
 #include <hpx/plugins/parcel/coalescing_counter_registry.hpp>
 
+#include <boost/chrono/chrono.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
 #include <mutex>
 
 #include <string>
@@ -33,6 +35,10 @@ namespace hpx { namespace traits
     //      ...
     //      num_messages = 50
     //      interval = 100
+    //      allow_background_flush = 1
+    //      adaptive = 0
+    //      max_latency = 1000
+    //      max_num_messages = 1000
     //
     template <>
     struct plugin_config_data<hpx::plugins::parcel::coalescing_message_handler>
@@ -41,7 +47,10 @@ namespace hpx { namespace traits
         {
             return "num_messages = 50\n"
                    "interval = 100\n"
-                   "allow_background_flush = 1";
+                   "allow_background_flush = 1\n"
+                   "adaptive = 0\n"
+                   "max_latency = 1000\n"
+                   "max_num_messages = 1000";
         }
     };
 }}
@@ -82,6 +91,28 @@ namespace hpx { namespace plugins { namespace parcel
                 "1");
             return !value.empty() && value[0] != '0';
         }
+
+        bool get_adaptive()
+        {
+            std::string value = hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.adaptive", "0");
+            return !value.empty() && value[0] != '0';
+        }
+
+        std::size_t get_max_latency()
+        {
+            return boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.max_latency", 1000));
+        }
+
+        std::size_t get_max_num_messages(std::size_t num_messages)
+        {
+            std::size_t max_num_messages =
+                boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                    "hpx.plugins.coalescing_message_handler.max_num_messages",
+                    1000));
+            return (std::max)(max_num_messages, num_messages);
+        }
     }
 
     coalescing_message_handler::coalescing_message_handler(
@@ -97,12 +128,21 @@ namespace hpx { namespace plugins { namespace parcel
             true),
         stopped_(false),
         allow_background_flush_(detail::get_background_flush()),
+        adaptive_(detail::get_adaptive()),
+        batch_size_(buffer_.capacity()),
+        max_batch_size_(detail::get_max_num_messages(batch_size_)),
+        interval_(boost::int64_t(detail::get_interval(interval)) * 1000),
+        max_latency_(boost::int64_t(detail::get_max_latency()) * 1000),
+        arrival_interval_(0.), latency_(0.),
+        last_arrival_(0), first_arrival_(0), buffered_arrivals_(0),
         num_parcels_(0), reset_num_parcels_(0),
             reset_num_parcels_per_message_parcels_(0),
         num_messages_(0), reset_num_messages_(0),
             reset_num_parcels_per_message_messages_(0),
         started_at_(util::high_resolution_clock::now()),
-        reset_time_num_parcels_(0)
+        reset_time_num_parcels_(0),
+        num_sent_parcels_(0), reset_num_sent_parcels_(0),
+        parcel_latency_(0), reset_parcel_latency_(0)
     {
         // register performance counter functions
         using util::placeholders::_1;
@@ -112,7 +152,12 @@ namespace hpx { namespace plugins { namespace parcel
             util::bind(&coalescing_message_handler::
                 get_parcels_per_message_count, this, _1),
             util::bind(&coalescing_message_handler::
-                get_average_time_between_parcels, this, _1));
+                get_average_time_between_parcels, this, _1),
+            util::bind(&coalescing_message_handler::get_batch_size, this, _1),
+            util::bind(&coalescing_message_handler::
+                get_flush_timeout, this, _1),
+            util::bind(&coalescing_message_handler::
+                get_average_parcel_latency, this, _1));
     }
 
     void coalescing_message_handler::put_parcel(
@@ -131,21 +176,42 @@ namespace hpx { namespace plugins { namespace parcel
             return;
         }
 
+        // keep track of the parcel arrival rate, newer measurements are
+        // weighted more than older ones
+        boost::int64_t now = util::high_resolution_clock::now();
+        if (last_arrival_ != 0)
+        {
+            double sample = double(now - last_arrival_);
+            if (arrival_interval_ == 0.)
+                arrival_interval_ = sample;
+            else
+                arrival_interval_ = (7. * arrival_interval_ + sample) / 8.;
+        }
+        last_arrival_ = now;
+
         detail::message_buffer::message_buffer_append_state s =
             buffer_.append(dest, std::move(p), std::move(f));
 
+        if (buffer_.size() == 1)
+        {
+            first_arrival_ = now;
+            buffered_arrivals_ = 0;
+        }
+        else
+        {
+            buffered_arrivals_ += now - first_arrival_;
+        }
+
         switch(s) {
         case detail::message_buffer::first_message:
-            l.unlock();
-            timer_.start(false);        // start deadline timer to flush buffer
+            start_timer(l);             // start deadline timer to flush buffer
             break;
 
         case detail::message_buffer::normal:
             if (timer_.is_started())
                 break;
 
-            l.unlock();
-            timer_.start(false);        // start deadline timer to flush buffer
+            start_timer(l);             // start deadline timer to flush buffer
             break;
 
         case detail::message_buffer::buffer_now_full:
@@ -163,6 +229,17 @@ namespace hpx { namespace plugins { namespace parcel
         }
     }
 
+    void coalescing_message_handler::start_timer(
+        std::unique_lock<mutex_type>& l)
+    {
+        HPX_ASSERT(l.owns_lock());
+
+        boost::int64_t interval = interval_;
+        l.unlock();
+
+        timer_.start(boost::chrono::nanoseconds(interval), false);
+    }
+
     bool coalescing_message_handler::timer_flush()
     {
         // adjust timer if needed
@@ -210,7 +287,17 @@ namespace hpx { namespace plugins { namespace parcel
         if (buffer_.empty())
             return false;
 
-        detail::message_buffer buff (buffer_.capacity());
+        // account for the time the parcels have been held back
+        boost::int64_t now = util::high_resolution_clock::now();
+        boost::int64_t num_parcels = boost::int64_t(buffer_.size());
+        parcel_latency_ +=
+            num_parcels * (now - first_arrival_) - buffered_arrivals_;
+        num_sent_parcels_ += num_parcels;
+
+        if (adaptive_)
+            adapt_parameters(now);
+
+        detail::message_buffer buff (batch_size_);
         std::swap(buff, buffer_);
 
         ++num_messages_;
@@ -222,6 +309,43 @@ namespace hpx { namespace plugins { namespace parcel
         return true;
     }
 
+    // Choose the number of parcels to combine into one message and the
+    // time to wait for them such that the oldest parcel is held back no
+    // longer than allowed by the configured latency cap. Larger messages
+    // give a better throughput, thus the batch size is chosen as large as
+    // the observed parcel arrival rate allows.
+    void coalescing_message_handler::adapt_parameters(boost::int64_t now)
+    {
+        double sample = double(now - first_arrival_);
+        if (latency_ == 0.)
+            latency_ = sample;
+        else
+            latency_ = (7. * latency_ + sample) / 8.;
+
+        if (arrival_interval_ == 0.)
+            return;
+
+        // compensate for the overheads of flushing the messages if the
+        // parcels have been held back longer than allowed
+        double target = double(max_latency_);
+        if (latency_ > target)
+            target *= target / latency_;
+
+        double batch_size = target / arrival_interval_;
+        if (batch_size < 1.)
+            batch_size_ = 1;
+        else if (batch_size >= double(max_batch_size_))
+            batch_size_ = max_batch_size_;
+        else
+            batch_size_ = std::size_t(batch_size);
+
+        // wait somewhat longer than expected for the message to fill up
+        interval_ = (std::min)(max_latency_,
+            boost::int64_t(2. * double(batch_size_) * arrival_interval_));
+        if (interval_ < 1000)
+            interval_ = 1000;
+    }
+
     // performance counter values
     boost::int64_t
     coalescing_message_handler::get_average_time_between_parcels(bool reset)
@@ -303,6 +427,39 @@ namespace hpx { namespace plugins { namespace parcel
         return num_messages;
     }
 
+    boost::int64_t coalescing_message_handler::get_batch_size(bool reset)
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+        return boost::int64_t(batch_size_);
+    }
+
+    boost::int64_t coalescing_message_handler::get_flush_timeout(bool reset)
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+        return interval_;
+    }
+
+    boost::int64_t
+        coalescing_message_handler::get_average_parcel_latency(bool reset)
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        boost::int64_t num_parcels =
+            num_sent_parcels_ - reset_num_sent_parcels_;
+        boost::int64_t latency = parcel_latency_ - reset_parcel_latency_;
+
+        if (reset)
+        {
+            reset_num_sent_parcels_ = num_sent_parcels_;
+            reset_parcel_latency_ = parcel_latency_;
+        }
+
+        if (num_parcels == 0)
+            return 0;
+
+        return latency / num_parcels;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // register the given action (called during startup)
     void coalescing_message_handler::register_action(char const* action,
@@ -361,6 +361,238 @@ namespace hpx { namespace plugins { namespace parcel
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    struct batch_size_counter_surrogate
+    {
+        batch_size_counter_surrogate(std::string const& parameters)
+          : parameters_(parameters)
+        {}
+
+        boost::int64_t operator()(bool reset)
+        {
+            if (counter_.empty())
+            {
+                counter_ = coalescing_counter_registry::instance().
+                    get_batch_size_counter(parameters_);
+                if (counter_.empty())
+                    return 0;           // no counter available yet
+            }
+
+            // dispatch to actual counter
+            return counter_(reset);
+        }
+
+        hpx::util::function_nonser<boost::int64_t(bool)> counter_;
+        std::string parameters_;
+    };
+
+    hpx::naming::gid_type batch_size_counter_creator(
+        hpx::performance_counters::counter_info const& info, hpx::error_code& ec)
+    {
+        switch (info.type_) {
+        case performance_counters::counter_raw:
+            {
+                performance_counters::counter_path_elements paths;
+                performance_counters::get_counter_path_elements(
+                    info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "batch_size_counter_creator",
+                        "invalid counter name for batch size (instance "
+                        "name must not be a valid base counter name)");
+                    return naming::invalid_gid;
+                }
+
+                if (paths.parameters_.empty()) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "batch_size_counter_creator",
+                        "invalid counter parameter for batch size: must "
+                        "specify an action type");
+                    return naming::invalid_gid;
+                }
+
+                // ask registry
+                hpx::util::function_nonser<boost::int64_t(bool)> f =
+                    coalescing_counter_registry::instance().
+                        get_batch_size_counter(paths.parameters_);
+
+                if (!f.empty())
+                {
+                    return performance_counters::detail::create_raw_counter(
+                        info, std::move(f), ec);
+                }
+
+                // the counter is not available yet, create surrogate function
+                return performance_counters::detail::create_raw_counter(info,
+                    batch_size_counter_surrogate(paths.parameters_), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "batch_size_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct flush_timeout_counter_surrogate
+    {
+        flush_timeout_counter_surrogate(std::string const& parameters)
+          : parameters_(parameters)
+        {}
+
+        boost::int64_t operator()(bool reset)
+        {
+            if (counter_.empty())
+            {
+                counter_ = coalescing_counter_registry::instance().
+                    get_flush_timeout_counter(parameters_);
+                if (counter_.empty())
+                    return 0;           // no counter available yet
+            }
+
+            // dispatch to actual counter
+            return counter_(reset);
+        }
+
+        hpx::util::function_nonser<boost::int64_t(bool)> counter_;
+        std::string parameters_;
+    };
+
+    hpx::naming::gid_type flush_timeout_counter_creator(
+        hpx::performance_counters::counter_info const& info, hpx::error_code& ec)
+    {
+        switch (info.type_) {
+        case performance_counters::counter_raw:
+            {
+                performance_counters::counter_path_elements paths;
+                performance_counters::get_counter_path_elements(
+                    info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "flush_timeout_counter_creator",
+                        "invalid counter name for flush timeout (instance "
+                        "name must not be a valid base counter name)");
+                    return naming::invalid_gid;
+                }
+
+                if (paths.parameters_.empty()) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "flush_timeout_counter_creator",
+                        "invalid counter parameter for flush timeout: must "
+                        "specify an action type");
+                    return naming::invalid_gid;
+                }
+
+                // ask registry
+                hpx::util::function_nonser<boost::int64_t(bool)> f =
+                    coalescing_counter_registry::instance().
+                        get_flush_timeout_counter(paths.parameters_);
+
+                if (!f.empty())
+                {
+                    return performance_counters::detail::create_raw_counter(
+                        info, std::move(f), ec);
+                }
+
+                // the counter is not available yet, create surrogate function
+                return performance_counters::detail::create_raw_counter(info,
+                    flush_timeout_counter_surrogate(paths.parameters_), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "flush_timeout_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct average_parcel_latency_counter_surrogate
+    {
+        average_parcel_latency_counter_surrogate(std::string const& parameters)
+          : parameters_(parameters)
+        {}
+
+        boost::int64_t operator()(bool reset)
+        {
+            if (counter_.empty())
+            {
+                counter_ = coalescing_counter_registry::instance().
+                    get_average_parcel_latency_counter(parameters_);
+                if (counter_.empty())
+                    return 0;           // no counter available yet
+            }
+
+            // dispatch to actual counter
+            return counter_(reset);
+        }
+
+        hpx::util::function_nonser<boost::int64_t(bool)> counter_;
+        std::string parameters_;
+    };
+
+    hpx::naming::gid_type average_parcel_latency_counter_creator(
+        hpx::performance_counters::counter_info const& info, hpx::error_code& ec)
+    {
+        switch (info.type_) {
+        case performance_counters::counter_raw:
+            {
+                performance_counters::counter_path_elements paths;
+                performance_counters::get_counter_path_elements(
+                    info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "average_parcel_latency_counter_creator",
+                        "invalid counter name for parcel latency (instance "
+                        "name must not be a valid base counter name)");
+                    return naming::invalid_gid;
+                }
+
+                if (paths.parameters_.empty()) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "average_parcel_latency_counter_creator",
+                        "invalid counter parameter for parcel latency: must "
+                        "specify an action type");
+                    return naming::invalid_gid;
+                }
+
+                // ask registry
+                hpx::util::function_nonser<boost::int64_t(bool)> f =
+                    coalescing_counter_registry::instance().
+                        get_average_parcel_latency_counter(paths.parameters_);
+
+                if (!f.empty())
+                {
+                    return performance_counters::detail::create_raw_counter(
+                        info, std::move(f), ec);
+                }
+
+                // the counter is not available yet, create surrogate function
+                return performance_counters::detail::create_raw_counter(info,
+                    average_parcel_latency_counter_surrogate(
+                        paths.parameters_), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "average_parcel_latency_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // This function will be registered as a startup function for HPX below.
     //
@@ -411,6 +643,36 @@ namespace hpx { namespace plugins { namespace parcel
               &average_time_between_parcels_counter_creator,
               &counter_discoverer,
               "ns"
+            },
+            // /coalescing(...)/count/batch-size@action-name
+            { "/coalescing/count/batch-size", counter_raw,
+              "returns the current maximal number of parcels combined into "
+              "one message by the message handler associated with the action "
+              "which is given by the counter parameter",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &batch_size_counter_creator,
+              &counter_discoverer,
+              ""
+            },
+            // /coalescing(...)/time/flush-timeout@action-name
+            { "/coalescing/time/flush-timeout", counter_raw,
+              "returns the current time the message handler associated with "
+              "the action which is given by the counter parameter waits for "
+              "a message to fill up before sending it",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &flush_timeout_counter_creator,
+              &counter_discoverer,
+              "ns"
+            },
+            // /coalescing(...)/time/average-parcel-latency@action-name
+            { "/coalescing/time/average-parcel-latency", counter_raw,
+              "returns the average time parcels of the action which is given "
+              "by the counter parameter are held back by the message handler "
+              "before being sent",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &average_parcel_latency_counter_creator,
+              &counter_discoverer,
+              "ns"
             }
         };
 
@@ -0,0 +1,314 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config/defines.hpp>
+#include <hpx/config/warnings_prefix.hpp>
+
+#include <hpx/hpx_fwd.hpp>
+
+#include <hpx/plugins/parcelport_factory.hpp>
+#include <hpx/util/command_line_handling.hpp>
+
+// parcelport
+#include <hpx/runtime.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_impl.hpp>
+
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/header.hpp>
+#include <hpx/plugins/parcelport/shmem/sender.hpp>
+#include <hpx/plugins/parcelport/shmem/receiver.hpp>
+
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <boost/asio/ip/host_name.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <unistd.h>
+
+#include <random>
+#include <string>
+
+namespace hpx
+{
+    bool is_starting();
+}
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace shmem
+    {
+        class HPX_EXPORT parcelport;
+    }}
+
+    template <>
+    struct connection_handler_traits<policies::shmem::parcelport>
+    {
+        typedef policies::shmem::sender_connection connection_type;
+        typedef boost::mpl::false_ send_early_parcel;
+        typedef boost::mpl::true_ do_background_work;
+
+        static const char * type()
+        {
+            return "shmem";
+        }
+
+        static const char * pool_name()
+        {
+            return "parcel-pool-shmem";
+        }
+
+        static const char * pool_name_postfix()
+        {
+            return "-shmem";
+        }
+    };
+
+    namespace policies { namespace shmem
+    {
+        ring_writer& get_writer(channel & ch)
+        {
+            return ch.writer();
+        }
+
+        boost::uint64_t place_chunk(channel & ch,
+            serialization::serialization_chunk const& c)
+        {
+            return ch.place_chunk(c);
+        }
+
+        bool send_or_enqueue(channel & ch,
+            boost::shared_ptr<sender_connection> const& c)
+        {
+            return ch.send_or_enqueue(c);
+        }
+
+        // The shared memory parcelport connects localities running on the
+        // same host. Each locality owns a mailbox holding a ring buffer for
+        // every other locality sending messages to it, the ring buffers are
+        // polled from the background work of the parcelport. As the
+        // parcelport can't be used for bootstrapping, it is used only after
+        // all localities have been connected through the bootstrap
+        // parcelport.
+        class HPX_EXPORT parcelport
+          : public parcelport_impl<parcelport>
+        {
+            typedef parcelport_impl<parcelport> base_type;
+
+            // The nonce distinguishes the shared memory segments of this run
+            // from stale segments left behind by an earlier process which
+            // had the same process id.
+            static boost::uint32_t nonce()
+            {
+                static boost::uint32_t const value =
+                    std::random_device()() ^
+                    static_cast<boost::uint32_t>(
+                        util::high_resolution_clock::now());
+                return value;
+            }
+
+            static parcelset::locality here()
+            {
+                return
+                    parcelset::locality(
+                        locality(
+                            boost::asio::ip::host_name()
+                          , static_cast<boost::int32_t>(::getpid())
+                          , nonce()
+                        )
+                    );
+            }
+
+            static std::size_t ring_size(util::runtime_configuration const& ini)
+            {
+                // the size of the ring buffers has to be a power of two
+                std::size_t size = hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.shmem.ring_size", 1048576);
+
+                std::size_t result = 4096;
+                while (result < size)
+                    result <<= 1;
+                return result;
+            }
+
+            static std::size_t max_peers(util::runtime_configuration const& ini)
+            {
+                std::size_t peers = hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.shmem.max_peers", 32);
+                return peers != 0 ? peers : 1;
+            }
+
+            static std::size_t segment_threshold(
+                util::runtime_configuration const& ini)
+            {
+                return hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.shmem.segment_threshold", 262144);
+            }
+
+        public:
+            parcelport(util::runtime_configuration const& ini,
+                util::function_nonser<void(std::size_t, char const*)> const& on_start,
+                util::function_nonser<void()> const& on_stop)
+              : base_type(ini, here(), on_start, on_stop)
+              , stopped_(false)
+              , sender_(here_.get<locality>().pid(), segment_threshold(ini))
+              , receiver_(*this)
+            {
+                // The mailbox has to exist before the endpoints of this
+                // locality are made known to the other localities.
+                if (hpx::util::get_entry_as<int>(
+                        ini, "hpx.parcel.shmem.enable", 0) != 0)
+                {
+                    receiver_.create(here_.get<locality>(),
+                        max_peers(ini), ring_size(ini));
+                }
+            }
+
+            /// Start the handling of connections.
+            bool do_run()
+            {
+                for(std::size_t i = 0; i != io_service_pool_.size(); ++i)
+                {
+                    io_service_pool_.get_io_service(int(i)).post(
+                        hpx::util::bind(
+                            &parcelport::io_service_work, this
+                        )
+                    );
+                }
+                return true;
+            }
+
+            /// Stop the handling of connectons.
+            void do_stop()
+            {
+                while(do_background_work(0))
+                {
+                    if(threads::get_self_ptr())
+                        hpx::this_thread::suspend(hpx::threads::pending,
+                            "shmem::parcelport::do_stop");
+                }
+                stopped_ = true;
+            }
+
+            /// Only localities running on the same host can be reached
+            bool can_connect(parcelset::locality const & dest,
+                bool use_alternative)
+            {
+                if(use_alternative)
+                {
+                    return dest.get<locality>().host() ==
+                        here_.get<locality>().host();
+                }
+                return false;
+            }
+
+            /// Return the name of this locality
+            std::string get_locality_name() const
+            {
+                return here_.get<locality>().host();
+            }
+
+            boost::shared_ptr<sender_connection> create_connection(
+                parcelset::locality const& l, error_code& ec)
+            {
+                // A locality on the same host whose mailbox can't be used
+                // would never receive any parcels, so this is fatal.
+                return sender_.create_connection(
+                    l.get<locality>(), l, parcels_sent_, throws);
+            }
+
+            parcelset::locality agas_locality(
+                util::runtime_configuration const & ini) const
+            {
+                return parcelset::locality(locality());
+            }
+
+            parcelset::locality create_locality() const
+            {
+                return parcelset::locality(locality());
+            }
+
+            bool background_work(std::size_t num_thread)
+            {
+                if (stopped_)
+                    return false;
+
+                bool has_work = sender_.background_work();
+                has_work = receiver_.background_work(num_thread) || has_work;
+                return has_work;
+            }
+
+        private:
+            boost::atomic<bool> stopped_;
+
+            sender sender_;
+            receiver<parcelport> receiver_;
+
+            void io_service_work()
+            {
+                std::size_t k = 0;
+                // We only execute work on the IO service while HPX is starting
+                while(hpx::is_starting())
+                {
+                    bool has_work = sender_.background_work();
+                    has_work = receiver_.background_work(-1) || has_work;
+                    if(has_work)
+                    {
+                        k = 0;
+                    }
+                    else
+                    {
+                        ++k;
+                        hpx::lcos::local::spinlock::yield(k);
+                    }
+                }
+            }
+        };
+    }}
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+namespace hpx { namespace traits
+{
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.parcel.shmem]
+    //      ...
+    //      priority = 150
+    //
+    template <>
+    struct plugin_config_data<hpx::parcelset::policies::shmem::parcelport>
+    {
+        static char const* priority()
+        {
+            return "150";
+        }
+
+        static void init(int *argc, char ***argv, util::command_line_handling &cfg)
+        {
+        }
+
+        static char const* call()
+        {
+            return
+                "ring_size = ${HPX_PARCEL_SHMEM_RING_SIZE:1048576}\n"
+                "max_peers = ${HPX_PARCEL_SHMEM_MAX_PEERS:32}\n"
+                "segment_threshold = ${HPX_PARCEL_SHMEM_SEGMENT_THRESHOLD:262144}\n"
+                ;
+        }
+    };
+}}
+
+HPX_REGISTER_PARCELPORT(
+    hpx::parcelset::policies::shmem::parcelport,
+    shmem);
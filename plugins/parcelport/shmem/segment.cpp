@@ -0,0 +1,136 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config/defines.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    namespace detail
+    {
+        inline std::string last_error(char const* what,
+            std::string const& name)
+        {
+            int const err = errno;
+            return std::string(what) + " failed for shared memory segment '" +
+                name + "': " + std::strerror(err);
+        }
+    }
+
+    void segment::create(std::string const& name, std::size_t size,
+        error_code& ec)
+    {
+        unmap();
+
+        // remove a stale segment left behind by a process which happened to
+        // have the same process id
+        ::shm_unlink(name.c_str());
+
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR,
+            S_IRUSR | S_IWUSR);
+        if (fd == -1)
+        {
+            HPX_THROWS_IF(ec, kernel_error, "shmem::segment::create",
+                detail::last_error("shm_open", name));
+            return;
+        }
+
+        if (::ftruncate(fd, static_cast<off_t>(size)) == -1)
+        {
+            std::string msg = detail::last_error("ftruncate", name);
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            HPX_THROWS_IF(ec, kernel_error, "shmem::segment::create", msg);
+            return;
+        }
+
+        void* p = ::mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (p == MAP_FAILED)
+        {
+            std::string msg = detail::last_error("mmap", name);
+            ::shm_unlink(name.c_str());
+            HPX_THROWS_IF(ec, kernel_error, "shmem::segment::create", msg);
+            return;
+        }
+
+        data_ = static_cast<char*>(p);
+        size_ = size;
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    void segment::open(std::string const& name, error_code& ec)
+    {
+        unmap();
+
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd == -1)
+        {
+            HPX_THROWS_IF(ec, kernel_error, "shmem::segment::open",
+                detail::last_error("shm_open", name));
+            return;
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) == -1)
+        {
+            std::string msg = detail::last_error("fstat", name);
+            ::close(fd);
+            HPX_THROWS_IF(ec, kernel_error, "shmem::segment::open", msg);
+            return;
+        }
+
+        std::size_t size = static_cast<std::size_t>(st.st_size);
+        void* p = ::mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (p == MAP_FAILED)
+        {
+            HPX_THROWS_IF(ec, kernel_error, "shmem::segment::open",
+                detail::last_error("mmap", name));
+            return;
+        }
+
+        data_ = static_cast<char*>(p);
+        size_ = size;
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    void segment::unmap()
+    {
+        if (data_ != 0)
+        {
+            ::munmap(data_, size_);
+            data_ = 0;
+            size_ = 0;
+        }
+    }
+
+    void segment::remove(std::string const& name)
+    {
+        ::shm_unlink(name.c_str());
+    }
+}}}}
+
+#endif
+
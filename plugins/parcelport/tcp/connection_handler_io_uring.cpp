@@ -0,0 +1,384 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_TCP) && defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+#include <hpx/lcos/future.hpp>
+#include <hpx/exception_list.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/plugins/parcelport/tcp/io_uring/connection_handler.hpp>
+#include <hpx/plugins/parcelport/tcp/io_uring/sender.hpp>
+#include <hpx/plugins/parcelport/tcp/io_uring/receiver.hpp>
+#include <hpx/util/asio_util.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <cerrno>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace tcp {
+    namespace io_uring
+{
+    namespace detail
+    {
+        parcelset::locality parcelport_address(
+            util::runtime_configuration const & ini)
+        {
+            // load all components as described in the configuration information
+            if (ini.has_section("hpx.parcel")) {
+                util::section const* sec = ini.get_section("hpx.parcel");
+                if (NULL != sec) {
+                    return parcelset::locality(
+                        locality(
+                            sec->get_entry("address", HPX_INITIAL_IP_ADDRESS)
+                          , hpx::util::get_entry_as<boost::uint16_t>(
+                                *sec, "port", HPX_INITIAL_IP_PORT)
+                        )
+                    );
+                }
+            }
+            return
+                parcelset::locality(
+                    locality(
+                        HPX_INITIAL_IP_ADDRESS
+                      , HPX_INITIAL_IP_PORT
+                    )
+                );
+        }
+
+        // disable Nagle algorithm, disable lingering on close
+        void set_socket_options(int fd)
+        {
+            int nodelay = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY,
+                &nodelay, sizeof(nodelay));
+
+            ::linger l;
+            l.l_onoff = 1;
+            l.l_linger = 0;
+            ::setsockopt(fd, SOL_SOCKET, SO_LINGER, &l, sizeof(l));
+        }
+    }
+
+    connection_handler::connection_handler(util::runtime_configuration const& ini,
+            util::function_nonser<void(std::size_t, char const*)> const& on_start_thread,
+            util::function_nonser<void()> const& on_stop_thread)
+      : base_type(ini, detail::parcelport_address(ini), on_start_thread,
+            on_stop_thread)
+      , ring_(
+            hpx::util::get_entry_as<std::size_t>(
+                ini, "hpx.parcel.tcp.io_uring_entries", 256),
+            hpx::util::get_entry_as<std::size_t>(
+                ini, "hpx.parcel.tcp.io_uring_buffers", 256),
+            hpx::util::get_entry_as<std::size_t>(
+                ini, "hpx.parcel.tcp.io_uring_buffer_size", 16384))
+      , acceptor_(NULL)
+      , acceptor_fd_(-1)
+      , accept_op_(*this)
+    {
+        if (here_.type() != std::string("tcp")) {
+            HPX_THROW_EXCEPTION(network_error,
+                "tcp::io_uring::connection_handler::connection_handler",
+                "this parcelport was instantiated to represent an unexpected "
+                "locality type: " + std::string(here_.type()));
+        }
+    }
+
+    connection_handler::~connection_handler()
+    {
+        HPX_ASSERT(acceptor_ == NULL);
+    }
+
+    bool connection_handler::do_run()
+    {
+        using boost::asio::ip::tcp;
+        boost::asio::io_service& io_service = io_service_pool_.get_io_service();
+        if (NULL == acceptor_)
+            acceptor_ = new tcp::acceptor(io_service);
+
+        // initialize network, listen on the first endpoint which can be used
+        bool listening = false;
+        exception_list errors;
+        util::endpoint_iterator_type end = util::accept_end();
+        for (util::endpoint_iterator_type it =
+                util::accept_begin(here_.get<locality>(), io_service);
+             it != end && !listening; ++it)
+        {
+            try {
+                tcp::endpoint ep = *it;
+                acceptor_->open(ep.protocol());
+                acceptor_->set_option(tcp::acceptor::reuse_address(true));
+                acceptor_->bind(ep);
+                acceptor_->listen();
+                listening = true;
+            }
+            catch (boost::system::system_error const&) {
+                errors.add(boost::current_exception());
+
+                boost::system::error_code ec;
+                acceptor_->close(ec);
+            }
+        }
+
+        if (!listening) {
+            // all attempts failed
+            HPX_THROW_EXCEPTION(network_error,
+                "tcp::io_uring::connection_handler::run", errors.get_message());
+            return false;
+        }
+
+        acceptor_fd_ = acceptor_->native_handle();
+        start_accept();
+
+        // all completions are handled by the first thread of the parcel pool
+        io_service_pool_.get_io_service(0).post(
+            hpx::util::bind(&ring::run, &ring_));
+
+        return true;
+    }
+
+    void connection_handler::do_stop()
+    {
+        {
+            // close the accepted sockets, this completes their receive
+            // operations
+            std::lock_guard<lcos::local::spinlock> l(connections_mtx_);
+            for (boost::shared_ptr<receiver> const& c : accepted_connections_)
+            {
+                c->shutdown();
+            }
+
+            accepted_connections_.clear();
+#if defined(HPX_HOLDON_TO_OUTGOING_CONNECTIONS)
+            write_connections_.clear();
+#endif
+        }
+
+        // cancel the remaining operations and let the thread handling the
+        // completions exit
+        ring_.stop();
+
+        if(acceptor_ != NULL)
+        {
+            boost::system::error_code ec;
+            acceptor_->close(ec);
+            delete acceptor_;
+            acceptor_ = NULL;
+        }
+    }
+
+    boost::shared_ptr<sender> connection_handler::create_connection(
+        parcelset::locality const& l, error_code& ec)
+    {
+        boost::asio::io_service& io_service = io_service_pool_.get_io_service();
+
+        // The parcel gets serialized inside the connection constructor, no
+        // need to keep the original parcel alive after this call returned.
+        boost::shared_ptr<sender> sender_connection(new sender(
+            io_service, ring_, l, this->parcels_sent_));
+
+        // Connect to the target locality, retry if needed
+        boost::system::error_code error = boost::asio::error::try_again;
+        for (std::size_t i = 0; i < HPX_MAX_NETWORK_RETRIES; ++i)
+        {
+            // The acceptor is only NULL when the parcelport has been stopped.
+            // An exit here, avoids hangs when late parcels are in flight (those are
+            // mainly decref requests).
+            if(acceptor_ == NULL)
+                return boost::shared_ptr<sender>();
+            try {
+                util::endpoint_iterator_type end = util::connect_end();
+                for (util::endpoint_iterator_type it =
+                        util::connect_begin(l.get<locality>(), io_service);
+                      it != end; ++it)
+                {
+                    boost::asio::ip::tcp::socket& s = sender_connection->socket();
+                    s.close();
+                    s.connect(*it, error);
+                    if (!error)
+                        break;
+                }
+                if (!error)
+                    break;
+
+                // wait for a really short amount of time
+                if (hpx::threads::get_self_ptr()) {
+                    this_thread::suspend(hpx::threads::pending,
+                        "connection_handler(tcp::io_uring)::create_connection");
+                }
+                else {
+                    boost::this_thread::sleep(boost::get_system_time() +
+                        boost::posix_time::milliseconds(
+                            HPX_NETWORK_RETRIES_SLEEP));
+                }
+            }
+            catch (boost::system::system_error const& e) {
+                sender_connection->socket().close();
+                sender_connection.reset();
+
+                HPX_THROWS_IF(ec, network_error,
+                    "tcp::io_uring::connection_handler::get_connection",
+                    e.what());
+                return sender_connection;
+            }
+        }
+
+        if (error) {
+            sender_connection->socket().close();
+            sender_connection.reset();
+
+            std::ostringstream strm;
+            strm << error.message() << " (while trying to connect to: "
+                  << l << ")";
+
+            HPX_THROWS_IF(ec, network_error,
+                "tcp::io_uring::connection_handler::get_connection",
+                strm.str());
+            return sender_connection;
+        }
+
+        // make sure the Nagle algorithm is disabled for this socket,
+        // disable lingering on close
+        boost::asio::ip::tcp::socket& s = sender_connection->socket();
+        detail::set_socket_options(s.native_handle());
+
+#if defined(HPX_HOLDON_TO_OUTGOING_CONNECTIONS)
+        {
+            std::lock_guard<lcos::local::spinlock> lock(connections_mtx_);
+            write_connections_.insert(sender_connection);
+        }
+#endif
+#if defined(HPX_DEBUG)
+        HPX_ASSERT(l == sender_connection->destination());
+
+        std::string connection_addr = s.remote_endpoint().address().to_string();
+        boost::uint16_t connection_port = s.remote_endpoint().port();
+        HPX_ASSERT(l.get<locality>().address() == connection_addr);
+        HPX_ASSERT(l.get<locality>().port() == connection_port);
+#endif
+
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        return sender_connection;
+    }
+
+    parcelset::locality connection_handler::agas_locality(
+        util::runtime_configuration const & ini) const
+    {
+        // load all components as described in the configuration information
+        if (ini.has_section("hpx.agas")) {
+            util::section const* sec = ini.get_section("hpx.agas");
+            if (NULL != sec) {
+                return
+                    parcelset::locality(
+                        locality(
+                            sec->get_entry("address", HPX_INITIAL_IP_ADDRESS)
+                          , hpx::util::get_entry_as<boost::uint16_t>(
+                                *sec, "port", HPX_INITIAL_IP_PORT)
+                        )
+                    );
+            }
+        }
+        return
+            parcelset::locality(
+                locality(
+                    HPX_INITIAL_IP_ADDRESS
+                  , HPX_INITIAL_IP_PORT
+                )
+            );
+    }
+
+    parcelset::locality connection_handler::create_locality() const
+    {
+        return parcelset::locality(locality());
+    }
+
+    // A single multishot accept operation produces all incoming connections
+    bool connection_handler::start_accept()
+    {
+        int fd = acceptor_fd_;
+        return ring_.submit(accept_op_,
+            [fd](::io_uring_sqe* sqe)
+            {
+                ::io_uring_prep_multishot_accept(sqe, fd, 0, 0, 0);
+            });
+    }
+
+    // accepted new incoming connection
+    void connection_handler::handle_accept(int res, unsigned flags)
+    {
+        if (res >= 0)
+        {
+            // handle this incoming connection
+            boost::shared_ptr<receiver> c(new receiver(ring_, res,
+                get_max_inbound_message_size(), *this));
+
+            {
+                // keep track of all accepted connections
+                std::lock_guard<lcos::local::spinlock> l(connections_mtx_);
+                accepted_connections_.insert(c);
+            }
+
+            detail::set_socket_options(res);
+
+            // now accept the incoming connection by starting to read from the
+            // socket, the receiver must not keep itself alive through its
+            // handler
+            boost::weak_ptr<receiver> wc(c);
+            c->async_read(
+                [this, wc](boost::system::error_code const& e)
+                {
+                    handle_read_completion(e, wc.lock());
+                });
+        }
+        else if (res != -ECANCELED)
+        {
+            LPT_(error)
+                << "handle accept operation completion: error: "
+                << make_error_code(res).message();
+        }
+
+        // the accept operation may terminate, e.g. if there were too many
+        // open files, keep accepting until the ring is stopped
+        if (!(flags & IORING_CQE_F_MORE) && res != -ECANCELED)
+            start_accept();
+    }
+
+    // Handle termination of the read operations of a connection.
+    void connection_handler::handle_read_completion(
+        boost::system::error_code const& e,
+        boost::shared_ptr<receiver> receiver_conn)
+    {
+        if (!e) return;
+
+        if (e != boost::asio::error::operation_aborted &&
+            e != boost::asio::error::eof)
+        {
+            LPT_(error)
+                << "handle read operation completion: error: "
+                << e.message();
+        }
+
+        {
+            // remove this connection from the list of known connections
+            std::lock_guard<lcos::local::spinlock> l(connections_mtx_);
+            accepted_connections_.erase(receiver_conn);
+        }
+    }
+}}}}}
+
+#endif
@@ -0,0 +1,181 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config/defines.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_TCP) && defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/plugins/parcelport/tcp/io_uring/ring.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace tcp {
+    namespace io_uring
+{
+    namespace detail
+    {
+        inline std::string ring_error(char const* what, int err)
+        {
+            return std::string(what) + " failed: " + std::strerror(err) +
+                " (the tcp parcelport was built with "
+                "HPX_WITH_PARCELPORT_TCP_IO_URING=On, which requires "
+                "Linux 6.0 or newer)";
+        }
+
+        // the ring whose completions are handled by the current thread
+        HPX_NATIVE_TLS ring const* reaping_ring = 0;
+    }
+
+    ring::ring(std::size_t entries, std::size_t num_buffers,
+            std::size_t buffer_size)
+      : buffer_ring_(0)
+      , num_buffers_(1)
+      , buffer_size_(buffer_size)
+      , outstanding_(0)
+      , stopped_(false)
+    {
+        // the number of provided buffers has to be a power of two
+        while (num_buffers_ < num_buffers)
+            num_buffers_ <<= 1;
+
+        int ret = ::io_uring_queue_init(
+            static_cast<unsigned>(entries), &ring_, 0);
+        if (ret < 0)
+        {
+            HPX_THROW_EXCEPTION(network_error, "io_uring::ring::ring",
+                detail::ring_error("io_uring_queue_init", -ret));
+        }
+
+        buffer_ring_ = ::io_uring_setup_buf_ring(&ring_,
+            static_cast<unsigned>(num_buffers_), buffer_group(), 0, &ret);
+        if (buffer_ring_ == 0)
+        {
+            ::io_uring_queue_exit(&ring_);
+            HPX_THROW_EXCEPTION(network_error, "io_uring::ring::ring",
+                detail::ring_error("io_uring_setup_buf_ring", -ret));
+        }
+
+        buffers_.resize(num_buffers_ * buffer_size_);
+        for (std::size_t i = 0; i != num_buffers_; ++i)
+        {
+            ::io_uring_buf_ring_add(buffer_ring_,
+                buffers_.data() + i * buffer_size_,
+                static_cast<unsigned>(buffer_size_),
+                static_cast<unsigned short>(i),
+                ::io_uring_buf_ring_mask(static_cast<unsigned>(num_buffers_)),
+                static_cast<int>(i));
+        }
+        ::io_uring_buf_ring_advance(buffer_ring_,
+            static_cast<int>(num_buffers_));
+    }
+
+    ring::~ring()
+    {
+        ::io_uring_free_buf_ring(&ring_, buffer_ring_,
+            static_cast<unsigned>(num_buffers_), buffer_group());
+        ::io_uring_queue_exit(&ring_);
+    }
+
+    void ring::release_buffer(unsigned bid)
+    {
+        HPX_ASSERT(is_reaping());
+
+        ::io_uring_buf_ring_add(buffer_ring_,
+            buffers_.data() + bid * buffer_size_,
+            static_cast<unsigned>(buffer_size_),
+            static_cast<unsigned short>(bid),
+            ::io_uring_buf_ring_mask(static_cast<unsigned>(num_buffers_)), 0);
+        ::io_uring_buf_ring_advance(buffer_ring_, 1);
+    }
+
+    void ring::run()
+    {
+        detail::reaping_ring = this;
+
+        ::io_uring_cqe* cqes[64];
+        while (true)
+        {
+            // hand all submissions made by the completion handlers to the
+            // kernel at once
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (::io_uring_sq_ready(&ring_) != 0)
+                    ::io_uring_submit(&ring_);
+            }
+
+            if (stopped_ && outstanding_ == 0)
+                break;
+
+            ::io_uring_cqe* cqe = 0;
+            int ret = ::io_uring_wait_cqe(&ring_, &cqe);
+            if (ret < 0)
+            {
+                if (ret == -EINTR)
+                    continue;
+
+                HPX_THROW_EXCEPTION(network_error, "io_uring::ring::run",
+                    detail::ring_error("io_uring_wait_cqe", -ret));
+            }
+
+            unsigned count = ::io_uring_peek_batch_cqe(&ring_, cqes, 64);
+            for (unsigned i = 0; i != count; ++i)
+            {
+                operation_base* op = static_cast<operation_base*>(
+                    ::io_uring_cqe_get_data(cqes[i]));
+
+                // wake up and cancel requests don't have an operation
+                if (op == 0)
+                    continue;
+
+                int res = cqes[i]->res;
+                unsigned flags = cqes[i]->flags;
+                if (!(flags & IORING_CQE_F_MORE))
+                    --outstanding_;
+
+                op->complete(res, flags);
+            }
+            ::io_uring_cq_advance(&ring_, count);
+        }
+
+        detail::reaping_ring = 0;
+    }
+
+    void ring::stop()
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        stopped_ = true;
+
+        // cancel everything still in flight, the completion of the cancel
+        // request wakes up the reaping thread even if nothing is in flight
+        ::io_uring_sqe* sqe = get_sqe();
+        ::io_uring_prep_cancel(sqe, 0, IORING_ASYNC_CANCEL_ANY);
+        ::io_uring_sqe_set_data(sqe, 0);
+        ::io_uring_submit(&ring_);
+    }
+
+    ::io_uring_sqe* ring::get_sqe()
+    {
+        ::io_uring_sqe* sqe = ::io_uring_get_sqe(&ring_);
+        while (sqe == 0)
+        {
+            // the submission queue is full, make room
+            ::io_uring_submit(&ring_);
+            sqe = ::io_uring_get_sqe(&ring_);
+        }
+        return sqe;
+    }
+
+    bool ring::is_reaping() const
+    {
+        return detail::reaping_ring == this;
+    }
+}}}}}
+
+#endif
@@ -5,11 +5,25 @@
 
 #include <hpx/hpx_fwd.hpp>
 
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+#include <hpx/plugins/parcelport/tcp/io_uring/connection_handler.hpp>
+#include <hpx/plugins/parcelport/tcp/io_uring/sender.hpp>
+#else
 #include <hpx/plugins/parcelport/tcp/connection_handler.hpp>
 #include <hpx/plugins/parcelport/tcp/sender.hpp>
+#endif
 
 #include <hpx/plugins/parcelport_factory.hpp>
 
+namespace hpx { namespace parcelset { namespace policies { namespace tcp
+{
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+    typedef io_uring::connection_handler parcelport;
+#else
+    typedef connection_handler parcelport;
+#endif
+}}}}
+
 namespace hpx { namespace traits
 {
     // Inject additional configuration data into the factory registry for this
@@ -21,7 +35,7 @@ namespace hpx { namespace traits
     //      priority = 1
     //
     template <>
-    struct plugin_config_data<hpx::parcelset::policies::tcp::connection_handler>
+    struct plugin_config_data<hpx::parcelset::policies::tcp::parcelport>
     {
         static char const* priority()
         {
@@ -33,11 +47,19 @@ namespace hpx { namespace traits
         }
         static char const* call()
         {
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+            return
+                "io_uring_entries = ${HPX_PARCEL_TCP_IO_URING_ENTRIES:256}\n"
+                "io_uring_buffers = ${HPX_PARCEL_TCP_IO_URING_BUFFERS:256}\n"
+                "io_uring_buffer_size = ${HPX_PARCEL_TCP_IO_URING_BUFFER_SIZE:16384}\n"
+                ;
+#else
             return "";
+#endif
         }
     };
 }}
 
 HPX_REGISTER_PARCELPORT(
-    hpx::parcelset::policies::tcp::connection_handler,
+    hpx::parcelset::policies::tcp::parcelport,
     tcp);
@@ -504,6 +504,28 @@ namespace hpx
             }
         }
 
+        void ensure_work_stealing_compatibility(
+            boost::program_options::variables_map const& vm)
+        {
+            char const* const options[] = {
+                "hpx:steal-batch", "hpx:hierarchical-stealing",
+                "hpx:remote-steal-backoff"
+            };
+
+            for (char const* option : options)
+            {
+                if (vm.count(option)) {
+                    throw detail::command_line_error(
+                        std::string("Invalid command line option --") +
+                        option + ", valid for "
+                        "--hpx:queuing=local-priority, "
+                        "--hpx:queuing=abp-priority, "
+                        "--hpx:queuing=chase-lev-priority, or "
+                        "--hpx:queuing=deadline only");
+                }
+            }
+        }
+
         void ensure_hierarchy_arity_compatibility(
             boost::program_options::variables_map const& vm)
         {
@@ -519,6 +541,7 @@ namespace hpx
         {
             ensure_high_priority_compatibility(vm);
             ensure_numa_sensitivity_compatibility(vm);
+            ensure_work_stealing_compatibility(vm);
             ensure_hierarchy_arity_compatibility(vm);
         }
 
@@ -659,6 +682,31 @@ namespace hpx
             return num_high_priority_queues;
         }
 
+        std::size_t get_steal_batch_size(
+            util::command_line_handling const& cfg)
+        {
+            std::size_t steal_batch_size = 1;
+            if (cfg.vm_.count("hpx:steal-batch"))
+                steal_batch_size = cfg.vm_["hpx:steal-batch"].as<std::size_t>();
+            return steal_batch_size;
+        }
+
+        bool get_hierarchical_stealing(util::command_line_handling const& cfg)
+        {
+            return cfg.vm_.count("hpx:hierarchical-stealing") != 0;
+        }
+
+        std::size_t get_remote_steal_backoff(
+            util::command_line_handling const& cfg)
+        {
+            std::size_t remote_steal_backoff = 0;
+            if (cfg.vm_.count("hpx:remote-steal-backoff")) {
+                remote_steal_backoff =
+                    cfg.vm_["hpx:remote-steal-backoff"].as<std::size_t>();
+            }
+            return remote_steal_backoff;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         int run(hpx::runtime& rt,
             util::function_nonser<int(boost::program_options::variables_map& vm)>
@@ -721,6 +769,7 @@ namespace hpx
 #if defined(HPX_HAVE_LOCAL_SCHEDULER)
             ensure_high_priority_compatibility(cfg.vm_);
             ensure_hierarchy_arity_compatibility(cfg.vm_);
+            ensure_work_stealing_compatibility(cfg.vm_);
 
             std::size_t pu_offset = get_pu_offset(cfg);
             std::size_t pu_step = get_pu_step(cfg);
@@ -762,6 +811,7 @@ namespace hpx
 #if defined(HPX_HAVE_THROTTLE_SCHEDULER) && defined(HPX_HAVE_APEX)
             ensure_high_priority_compatibility(cfg.vm_);
             ensure_hierarchy_arity_compatibility(cfg.vm_);
+            ensure_work_stealing_compatibility(cfg.vm_);
 
             std::size_t pu_offset = get_pu_offset(cfg);
             std::size_t pu_step = get_pu_step(cfg);
@@ -804,6 +854,7 @@ namespace hpx
         {
 #if defined(HPX_HAVE_STATIC_PRIORITY_SCHEDULER)
             ensure_hierarchy_arity_compatibility(cfg.vm_);
+            ensure_work_stealing_compatibility(cfg.vm_);
 
             std::size_t num_high_priority_queues =
                 get_num_high_priority_queues(cfg);
@@ -850,6 +901,7 @@ namespace hpx
 #if defined(HPX_HAVE_STATIC_SCHEDULER)
             ensure_high_priority_compatibility(cfg.vm_);
             ensure_hierarchy_arity_compatibility(cfg.vm_);
+            ensure_work_stealing_compatibility(cfg.vm_);
 
             std::size_t pu_offset = get_pu_offset(cfg);
             std::size_t pu_step = get_pu_step(cfg);
@@ -905,7 +957,9 @@ namespace hpx
                 local_queue_policy;
             local_queue_policy::init_parameter_type init(
                 cfg.num_threads_, num_high_priority_queues, 1000,
-                numa_sensitive, "core-local_priority_queue_scheduler");
+                numa_sensitive, "core-local_priority_queue_scheduler",
+                get_steal_batch_size(cfg), get_hierarchical_stealing(cfg),
+                get_remote_steal_backoff(cfg));
             threads::policies::init_affinity_data affinity_init(
                 pu_offset, pu_step, affinity_domain, affinity_desc);
 
@@ -937,7 +991,9 @@ namespace hpx
                 abp_priority_queue_policy;
             abp_priority_queue_policy::init_parameter_type init(
                 cfg.num_threads_, num_high_priority_queues, 1000,
-                cfg.numa_sensitive_, "core-abp_fifo_priority_queue_scheduler");
+                cfg.numa_sensitive_, "core-abp_fifo_priority_queue_scheduler",
+                get_steal_batch_size(cfg), get_hierarchical_stealing(cfg),
+                get_remote_steal_backoff(cfg));
 
             // Build and configure this runtime instance.
             typedef hpx::runtime_impl<abp_priority_queue_policy> runtime_type;
@@ -953,6 +1009,99 @@ namespace hpx
 #endif
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // priority Chase-Lev scheduler: local priority deques for each OS
+        // thread, the owning OS thread works on the bottom of its deques
+        // without atomic read-modify-write operations, other OS threads steal
+        // from the top.
+        int run_priority_chase_lev(startup_function_type const& startup,
+            shutdown_function_type const& shutdown,
+            util::command_line_handling& cfg, bool blocking)
+        {
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+            ensure_hierarchy_arity_compatibility(cfg.vm_);
+
+            std::size_t num_high_priority_queues =
+                get_num_high_priority_queues(cfg);
+            std::size_t pu_offset = get_pu_offset(cfg);
+            std::size_t pu_step = get_pu_step(cfg);
+            std::string affinity_domain = get_affinity_domain(cfg);
+            std::string affinity_desc;
+            std::size_t numa_sensitive =
+                get_affinity_description(cfg, affinity_desc);
+
+            // scheduling policy
+            typedef hpx::threads::policies::chase_lev_priority_queue_scheduler
+                chase_lev_priority_queue_policy;
+            chase_lev_priority_queue_policy::init_parameter_type init(
+                cfg.num_threads_, num_high_priority_queues, 1000,
+                numa_sensitive, "core-chase_lev_priority_queue_scheduler",
+                get_steal_batch_size(cfg), get_hierarchical_stealing(cfg),
+                get_remote_steal_backoff(cfg));
+            threads::policies::init_affinity_data affinity_init(
+                pu_offset, pu_step, affinity_domain, affinity_desc);
+
+            // Build and configure this runtime instance.
+            typedef hpx::runtime_impl<chase_lev_priority_queue_policy>
+                runtime_type;
+            std::unique_ptr<hpx::runtime> rt(
+                new runtime_type(cfg.rtcfg_, cfg.mode_, cfg.num_threads_, init,
+                    affinity_init));
+
+            return run_or_start(blocking, std::move(rt), cfg, startup, shutdown);
+#else
+            throw detail::command_line_error("Command line option "
+                "--hpx:queuing=chase-lev-priority "
+                "is not configured in this build. Please rebuild with "
+                "'cmake -DHPX_WITH_THREAD_SCHEDULERS=chase-lev-priority'.");
+#endif
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // local scheduler with priority queues ordering the pending
+        // HPX-threads by their deadlines (earliest deadline first)
+        int run_deadline(startup_function_type const& startup,
+            shutdown_function_type const& shutdown,
+            util::command_line_handling& cfg, bool blocking)
+        {
+#if defined(HPX_HAVE_DEADLINE_SCHEDULER)
+            ensure_hierarchy_arity_compatibility(cfg.vm_);
+
+            std::size_t num_high_priority_queues =
+                get_num_high_priority_queues(cfg);
+            std::size_t pu_offset = get_pu_offset(cfg);
+            std::size_t pu_step = get_pu_step(cfg);
+            std::string affinity_domain = get_affinity_domain(cfg);
+            std::string affinity_desc;
+            std::size_t numa_sensitive =
+                get_affinity_description(cfg, affinity_desc);
+
+            // scheduling policy
+            typedef hpx::threads::policies::deadline_queue_scheduler
+                deadline_queue_policy;
+            deadline_queue_policy::init_parameter_type init(
+                cfg.num_threads_, num_high_priority_queues, 1000,
+                numa_sensitive, "core-deadline_queue_scheduler",
+                get_steal_batch_size(cfg), get_hierarchical_stealing(cfg),
+                get_remote_steal_backoff(cfg));
+            threads::policies::init_affinity_data affinity_init(
+                pu_offset, pu_step, affinity_domain, affinity_desc);
+
+            // Build and configure this runtime instance.
+            typedef hpx::runtime_impl<deadline_queue_policy> runtime_type;
+            std::unique_ptr<hpx::runtime> rt(
+                new runtime_type(cfg.rtcfg_, cfg.mode_, cfg.num_threads_, init,
+                    affinity_init));
+
+            return run_or_start(blocking, std::move(rt), cfg, startup, shutdown);
+#else
+            throw detail::command_line_error("Command line option "
+                "--hpx:queuing=deadline "
+                "is not configured in this build. Please rebuild with "
+                "'cmake -DHPX_WITH_THREAD_SCHEDULERS=deadline'.");
+#endif
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // hierarchical scheduler: The thread queues are built up hierarchically
         // this avoids contention during work stealing
@@ -964,6 +1113,7 @@ namespace hpx
             ensure_high_priority_compatibility(cfg.vm_);
             ensure_numa_sensitivity_compatibility(cfg.vm_);
             ensure_hwloc_compatibility(cfg.vm_);
+            ensure_work_stealing_compatibility(cfg.vm_);
 
             // scheduling policy
             typedef hpx::threads::policies::hierarchy_scheduler<> queue_policy;
@@ -998,6 +1148,7 @@ namespace hpx
 #if defined(HPX_HAVE_PERIODIC_PRIORITY_SCHEDULER)
             ensure_hierarchy_arity_compatibility(cfg.vm_);
             ensure_hwloc_compatibility(cfg.vm_);
+            ensure_work_stealing_compatibility(cfg.vm_);
 
             std::size_t num_high_priority_queues =
                 get_num_high_priority_queues(cfg);
@@ -1109,6 +1260,22 @@ namespace hpx
                     cfg.queuing_ = "abp-priority";
                     result = run_priority_abp(startup, shutdown, cfg, blocking);
                 }
+                else if (0 == std::string("chase-lev-priority").find(cfg.queuing_))
+                {
+                    // local scheduler with priority deque (one deque for each
+                    // OS thread plus separate dequeues for high priority
+                    // HPX-threads), uses Chase-Lev work-stealing deques
+                    cfg.queuing_ = "chase-lev-priority";
+                    result = run_priority_chase_lev(startup, shutdown, cfg,
+                        blocking);
+                }
+                else if (0 == std::string("deadline").find(cfg.queuing_))
+                {
+                    // local scheduler with priority queues, pending
+                    // HPX-threads are ordered by their deadlines
+                    cfg.queuing_ = "deadline";
+                    result = run_deadline(startup, shutdown, cfg, blocking);
+                }
                 else if (0 == std::string("hierarchy").find(cfg.queuing_))
                 {
                     // hierarchy scheduler: tree of queues, with work
@@ -1,4 +1,4 @@
-//  Copyright (c) 2015 Hartmut Kaiser
+//  Copyright (c) 2015-2016 Hartmut Kaiser
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -8,9 +8,135 @@
 #include <hpx/util/unique_function.hpp>
 #include <hpx/lcos/local/futures_factory.hpp>
 #include <hpx/lcos/detail/future_data.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <cstddef>
+#include <new>
 
 namespace hpx { namespace lcos { namespace detail
 {
+#if defined(HPX_HAVE_FUTURE_DATA_POOL)
+    namespace
+    {
+        // Shared states are rounded up to size classes of 16 bytes, larger
+        // ones are always allocated from the global heap.
+        std::size_t const shared_state_granularity = 16;
+        std::size_t const shared_state_size_classes = 32;
+
+        // Number of free blocks kept per size class, any additional blocks
+        // are returned to the global heap.
+        std::size_t const shared_state_cache_limit = 512;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Free blocks of all size classes, owned by one OS thread. Blocks
+        // freed on a different OS thread than the one which allocated them
+        // simply end up in the cache of the freeing thread.
+        struct shared_state_cache
+        {
+            struct free_block
+            {
+                free_block* next_;
+            };
+
+            shared_state_cache()
+            {
+                for (std::size_t i = 0; i != shared_state_size_classes; ++i)
+                {
+                    free_[i] = 0;
+                    count_[i] = 0;
+                }
+            }
+
+            ~shared_state_cache()
+            {
+                for (std::size_t i = 0; i != shared_state_size_classes; ++i)
+                {
+                    while (free_[i] != 0)
+                    {
+                        free_block* block = free_[i];
+                        free_[i] = block->next_;
+                        ::operator delete(block);
+                    }
+                }
+            }
+
+            void* pop(std::size_t index)
+            {
+                free_block* block = free_[index];
+                if (block == 0)
+                    return 0;
+
+                free_[index] = block->next_;
+                --count_[index];
+                return block;
+            }
+
+            bool push(void* p, std::size_t index)
+            {
+                if (count_[index] == shared_state_cache_limit)
+                    return false;
+
+                free_block* block = static_cast<free_block*>(p);
+                block->next_ = free_[index];
+                free_[index] = block;
+                ++count_[index];
+                return true;
+            }
+
+            free_block* free_[shared_state_size_classes];
+            std::size_t count_[shared_state_size_classes];
+        };
+
+        struct shared_state_cache_tag {};
+        util::thread_specific_ptr<
+                shared_state_cache, shared_state_cache_tag
+            > shared_state_cache_;
+
+        shared_state_cache& get_shared_state_cache()
+        {
+            if (0 == shared_state_cache_.get())
+                shared_state_cache_.reset(new shared_state_cache);
+
+            return *shared_state_cache_.get();
+        }
+    }
+
+    void* allocate_shared_state(std::size_t size)
+    {
+        std::size_t index = (size - 1) / shared_state_granularity;
+        if (index >= shared_state_size_classes)
+            return ::operator new(size);
+
+        void* p = get_shared_state_cache().pop(index);
+        if (p != 0)
+            return p;
+
+        // all blocks of a size class have the same size, this allows to
+        // reuse them for any shared state of that class
+        return ::operator new((index + 1) * shared_state_granularity);
+    }
+
+    void deallocate_shared_state(void* p, std::size_t size)
+    {
+        std::size_t index = (size - 1) / shared_state_granularity;
+        if (index >= shared_state_size_classes ||
+            !get_shared_state_cache().push(p, index))
+        {
+            ::operator delete(p);
+        }
+    }
+
+    void reset_shared_state_cache()
+    {
+        shared_state_cache_.reset();
+    }
+#else
+    void reset_shared_state_cache()
+    {
+    }
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
     bool run_on_completed_on_new_thread(
         util::unique_function_nonser<bool()> && f, error_code& ec)
     {
@@ -0,0 +1,153 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/lcos/local/big_reader_mutex.hpp>
+
+#include <hpx/lcos/local/queue_mutex.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/itt_notify.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+
+namespace hpx { namespace lcos { namespace local
+{
+    ///////////////////////////////////////////////////////////////////////////
+    big_reader_mutex::big_reader_mutex(char const* const description)
+      : num_indicators_((std::max)(hpx::get_os_thread_count(), std::size_t(1))),
+        indicators_(new reader_indicator[num_indicators_]),
+        writer_(false)
+    {
+        HPX_ITT_SYNC_CREATE(this, "lcos::local::big_reader_mutex", description);
+        HPX_ITT_SYNC_RENAME(this, "lcos::local::big_reader_mutex");
+    }
+
+    big_reader_mutex::~big_reader_mutex()
+    {
+        HPX_ASSERT(!writer_.load() && get_reader_count() == 0);
+        HPX_ITT_SYNC_DESTROY(this);
+    }
+
+    big_reader_mutex::reader_indicator&
+    big_reader_mutex::get_reader_indicator()
+    {
+        // threads not managed by HPX share the indicator of the last worker
+        std::size_t num_thread = hpx::get_worker_thread_num();
+        return indicators_[(std::min)(num_thread, num_indicators_ - 1)];
+    }
+
+    boost::int64_t big_reader_mutex::get_reader_count() const
+    {
+        boost::int64_t count = 0;
+        for (std::size_t i = 0; i != num_indicators_; ++i)
+            count += indicators_[i].count_.load();
+        return count;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void big_reader_mutex::lock_shared()
+    {
+        HPX_ITT_SYNC_PREPARE(this);
+
+        for (;;)
+        {
+            reader_indicator& indicator = get_reader_indicator();
+
+            // The increment has to be visible before the writer flag is
+            // read, a writer sets the flag before reading the indicators.
+            ++indicator.count_;
+            if (!writer_.load())
+                break;
+
+            --indicator.count_;
+
+            // wait for the writer to release the mutex
+            std::lock_guard<queue_mutex> l(writer_mtx_);
+        }
+
+        HPX_ITT_SYNC_ACQUIRED(this);
+    }
+
+    bool big_reader_mutex::try_lock_shared()
+    {
+        HPX_ITT_SYNC_PREPARE(this);
+
+        reader_indicator& indicator = get_reader_indicator();
+
+        ++indicator.count_;
+        if (writer_.load())
+        {
+            --indicator.count_;
+            HPX_ITT_SYNC_CANCEL(this);
+            return false;
+        }
+
+        HPX_ITT_SYNC_ACQUIRED(this);
+        return true;
+    }
+
+    void big_reader_mutex::unlock_shared()
+    {
+        HPX_ITT_SYNC_RELEASING(this);
+        --get_reader_indicator().count_;
+        HPX_ITT_SYNC_RELEASED(this);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void big_reader_mutex::lock()
+    {
+        HPX_ITT_SYNC_PREPARE(this);
+
+        writer_mtx_.lock();
+        writer_.store(true);
+
+        // wait for the active readers to release the mutex, the sum of all
+        // indicators never drops below the number of active readers
+        for (std::size_t k = 0; get_reader_count() != 0; ++k)
+            spinlock::yield(k);
+
+        HPX_ITT_SYNC_ACQUIRED(this);
+    }
+
+    bool big_reader_mutex::try_lock()
+    {
+        HPX_ITT_SYNC_PREPARE(this);
+
+        if (!writer_mtx_.try_lock())
+        {
+            HPX_ITT_SYNC_CANCEL(this);
+            return false;
+        }
+
+        writer_.store(true);
+        if (get_reader_count() != 0)
+        {
+            writer_.store(false);
+            writer_mtx_.unlock();
+
+            HPX_ITT_SYNC_CANCEL(this);
+            return false;
+        }
+
+        HPX_ITT_SYNC_ACQUIRED(this);
+        return true;
+    }
+
+    void big_reader_mutex::unlock()
+    {
+        HPX_ITT_SYNC_RELEASING(this);
+
+        writer_.store(false);
+        writer_mtx_.unlock();
+
+        HPX_ITT_SYNC_RELEASED(this);
+    }
+}}}
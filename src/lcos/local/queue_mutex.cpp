@@ -0,0 +1,170 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/lcos/local/queue_mutex.hpp>
+
+#include <hpx/exception.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/itt_notify.hpp>
+#include <hpx/util/register_locks.hpp>
+
+#include <cstddef>
+
+namespace hpx { namespace lcos { namespace local
+{
+    namespace
+    {
+        // the states of a queue node of a waiting thread
+        enum queue_node_state
+        {
+            node_waiting = 0,       // the thread has not been suspended yet
+            node_suspended = 1,     // the thread is (about to be) suspended
+            node_granted = 2        // the mutex has been handed to the thread
+        };
+
+        // number of times a waiting thread checks whether the mutex was
+        // handed to it before suspending itself
+        std::size_t const spin_count = 16;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    queue_mutex::queue_mutex(char const* const description)
+      : tail_(0)
+    {
+        HPX_ITT_SYNC_CREATE(this, "lcos::local::queue_mutex", description);
+        HPX_ITT_SYNC_RENAME(this, "lcos::local::queue_mutex");
+    }
+
+    queue_mutex::~queue_mutex()
+    {
+        HPX_ASSERT(tail_.load() == 0);
+        HPX_ITT_SYNC_DESTROY(this);
+    }
+
+    void queue_mutex::lock()
+    {
+        HPX_ASSERT(threads::get_self_ptr() != 0);
+
+        HPX_ITT_SYNC_PREPARE(this);
+
+        queue_node node;
+        queue_node* prev = tail_.load();
+        for (;;)
+        {
+            if (prev == 0)
+            {
+                // the mutex is free, the owner is represented by owner_
+                if (tail_.compare_exchange_weak(prev, &owner_))
+                    break;
+                continue;
+            }
+
+            node.id_ = threads::get_self_id().get();
+            if (!tail_.compare_exchange_weak(prev, &node))
+                continue;
+
+            // enqueue this thread behind its predecessor and wait for the
+            // mutex to be handed over
+            prev->next_.store(&node);
+
+            for (std::size_t k = 0; k != spin_count; ++k)
+            {
+                if (node.state_.load() == node_granted)
+                    break;
+                spinlock::yield(k);
+            }
+
+            int expected = node_waiting;
+            if (node.state_.compare_exchange_strong(expected, node_suspended))
+            {
+                // the thread releasing the mutex will resume this thread
+                this_thread::suspend(threads::suspended,
+                    "lcos::local::queue_mutex::lock");
+
+                while (node.state_.load() != node_granted)
+                {
+                    this_thread::suspend(threads::pending,
+                        "lcos::local::queue_mutex::lock");
+                }
+            }
+
+            // this thread owns the mutex now, move its successor (if any)
+            // over to owner_ as the node on the stack is about to go away
+            queue_node* next = node.next_.load();
+            if (next == 0)
+            {
+                owner_.next_.store(0);
+
+                queue_node* last = &node;
+                if (tail_.compare_exchange_strong(last, &owner_))
+                    break;
+
+                // another thread is about to enqueue itself behind us
+                for (std::size_t k = 0; (next = node.next_.load()) == 0; ++k)
+                    spinlock::yield(k);
+            }
+            owner_.next_.store(next);
+            break;
+        }
+
+        util::register_lock(this);
+        HPX_ITT_SYNC_ACQUIRED(this);
+    }
+
+    bool queue_mutex::try_lock()
+    {
+        HPX_ITT_SYNC_PREPARE(this);
+
+        queue_node* expected = 0;
+        if (!tail_.compare_exchange_strong(expected, &owner_))
+        {
+            HPX_ITT_SYNC_CANCEL(this);
+            return false;
+        }
+
+        util::register_lock(this);
+        HPX_ITT_SYNC_ACQUIRED(this);
+        return true;
+    }
+
+    void queue_mutex::unlock()
+    {
+        HPX_ITT_SYNC_RELEASING(this);
+
+        util::unregister_lock(this);
+
+        queue_node* next = owner_.next_.load();
+        if (next == 0)
+        {
+            queue_node* last = &owner_;
+            if (tail_.compare_exchange_strong(last, 0))
+            {
+                HPX_ITT_SYNC_RELEASED(this);
+                return;
+            }
+
+            // another thread is about to enqueue itself
+            for (std::size_t k = 0; (next = owner_.next_.load()) == 0; ++k)
+                spinlock::yield(k);
+        }
+
+        HPX_ITT_SYNC_RELEASED(this);
+
+        // hand the mutex over to the next thread, the node of that thread
+        // may go away as soon as it sees the mutex being granted
+        threads::thread_id_repr_type id = next->id_;
+        if (next->state_.exchange(node_granted) == node_suspended)
+        {
+            error_code ec(lightweight);
+            threads::set_thread_state(threads::thread_id_type(
+                    reinterpret_cast<threads::thread_data*>(id)),
+                threads::pending, threads::wait_signaled,
+                threads::thread_priority_default, ec);
+        }
+    }
+}}}
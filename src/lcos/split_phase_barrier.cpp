@@ -0,0 +1,101 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/runtime/actions/plain_action.hpp>
+#include <hpx/lcos/split_phase_barrier.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    struct split_phase_barrier_tag {};
+
+    typedef collective_mailbox_action<
+            bool, split_phase_barrier_tag
+        >::type split_phase_barrier_action;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Run the dissemination rounds of one phase starting with the given
+    // distance. The next round is started by the continuation attached to
+    // the notification of the current round.
+    hpx::future<void> split_phase_barrier_round(std::string const& name,
+        std::string const& sites, std::size_t num_sites,
+        std::size_t this_site, std::size_t round, std::size_t distance)
+    {
+        if (distance >= num_sites)
+            return hpx::make_ready_future();
+
+        send_to_site<split_phase_barrier_tag>(name, sites, round,
+            (this_site + distance) % num_sites, true);
+
+        return receive_from_site<split_phase_barrier_tag, bool>(name, round)
+            .then(
+                [=](hpx::future<bool> f) -> hpx::future<void>
+                {
+                    f.get();        // propagate exceptions
+                    return split_phase_barrier_round(name, sites, num_sites,
+                        this_site, round + 1, 2 * distance);
+                });
+    }
+}}}
+
+HPX_REGISTER_ACTION(hpx::lcos::detail::split_phase_barrier_action,
+    hpx_lcos_split_phase_barrier_action);
+
+namespace hpx { namespace lcos
+{
+    ///////////////////////////////////////////////////////////////////////////
+    split_phase_barrier::split_phase_barrier(std::string const& basename,
+            std::size_t num_sites, std::size_t this_site)
+      : basename_("/split_phase_barrier" + basename),
+        sites_(detail::collective_sites_name("/split_phase_barrier",
+            basename.c_str(), this_site != std::size_t(-1))),
+        num_sites_(num_sites),
+        this_site_(this_site),
+        generation_(0),
+        phase_(hpx::make_ready_future())
+    {
+        if (num_sites_ == std::size_t(-1))
+            num_sites_ = hpx::get_num_localities_sync();
+        if (this_site_ == std::size_t(-1))
+            this_site_ = hpx::get_locality_id();
+
+        if (this_site_ >= num_sites_)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "split_phase_barrier::split_phase_barrier",
+                "this locality does not participate in the barrier");
+        }
+
+        if (num_sites_ > 1)
+            detail::register_site(sites_, this_site_);
+    }
+
+    void split_phase_barrier::arrive()
+    {
+        std::string name(basename_ + "/" + std::to_string(generation_++));
+        phase_ = detail::split_phase_barrier_round(
+            name, sites_, num_sites_, this_site_, 0, 1);
+    }
+
+    hpx::future<void> split_phase_barrier::wait_async() const
+    {
+        return phase_.then(
+            [](hpx::shared_future<void> f)
+            {
+                f.get();            // propagate exceptions
+            });
+    }
+
+    void split_phase_barrier::wait(error_code& ec)
+    {
+        arrive();
+        wait_async().get(ec);
+    }
+}}
@@ -270,6 +270,8 @@ namespace hpx { namespace performance_counters
     ///    /objectname{parentinstancename#parentindex/instancename#instanceindex}
     ///       /countername#parameters
     ///    /objectname{parentinstancename#*/instancename#*}/countername#parameters
+    ///    /objectname{parentinstancename#parentindex/pool#poolname
+    ///       /instancename#instanceindex}/countername#parameters
     ///    /objectname{/basecounter}/countername,parameters
     ///
     namespace qi = boost::spirit::qi;
@@ -294,7 +296,11 @@ namespace hpx { namespace performance_counters
                     >> qi::attr(false)
                 ;
             child =
-                   +~qi::char_("#}")
+                   qi::raw[
+                        // optional thread pool: pool#<name>/
+                        -(qi::lit("pool#") >> +~qi::char_("#/}") >> '/')
+                    >>  +~qi::char_("#}")
+                    ]
                     >>  (   '#' >> raw_uint     // counter instance name
                         |  -qi::string("#*")    // counter instance skeleton name
                         )
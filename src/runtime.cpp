@@ -10,6 +10,7 @@
 #include <hpx/exception.hpp>
 #include <hpx/version.hpp>
 #include <hpx/include/runtime.hpp>
+#include <hpx/lcos/detail/future_data.hpp>
 #include <hpx/runtime/agas/big_boot_barrier.hpp>
 #include <hpx/runtime/components/runtime_support.hpp>
 #include <hpx/runtime/components/server/runtime_support.hpp>
@@ -546,6 +547,7 @@ namespace hpx
         util::reset_held_lock_data();
 
         threads::reset_continuation_recursion_count();
+        lcos::detail::reset_shared_state_cache();
     }
 
     std::string runtime::get_thread_name()
@@ -1273,6 +1275,20 @@ namespace hpx { namespace threads
         get_runtime().get_thread_manager().set_scheduler_mode(m);
     }
 
+    HPX_API_EXPORT bool get_idle_rate_times(boost::uint64_t& exec_time,
+        boost::uint64_t& total_time)
+    {
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+        if (!threads::threadmanager_is(state_running))
+            return false;
+        get_runtime().get_thread_manager().get_idle_rate_times(
+            exec_time, total_time);
+        return true;
+#else
+        return false;
+#endif
+    }
+
     HPX_API_EXPORT threads::mask_cref_type get_pu_mask(
         threads::topology& topo, std::size_t thread_num)
     {
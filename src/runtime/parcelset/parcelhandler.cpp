@@ -18,6 +18,7 @@
 #include <hpx/runtime/naming/resolver_client.hpp>
 #include <hpx/runtime/parcelset/parcelhandler.hpp>
 #include <hpx/runtime/parcelset/static_parcelports.hpp>
+#include <hpx/runtime/parcelset/receive_buffer_pool.hpp>
 #include <hpx/runtime/parcelset/policies/message_handler.hpp>
 #include <hpx/runtime/threads/threadmanager.hpp>
 #include <hpx/runtime/actions/continuation.hpp>
@@ -942,6 +943,10 @@ namespace hpx { namespace parcelset
             util::bind(&parcelhandler::get_outgoing_queue_length, this, _1));
         util::function_nonser<boost::int64_t(bool)> outgoing_routed_count(
             util::bind(&parcelhandler::get_parcel_routed_count, this, _1));
+        util::function_nonser<boost::int64_t(bool)> receive_buffer_pool_hits(
+            &detail::get_receive_buffer_pool_hits);
+        util::function_nonser<boost::int64_t(bool)> receive_buffer_pool_misses(
+            &detail::get_receive_buffer_pool_misses);
 
         performance_counters::generic_counter_type_data const counter_types[] =
         {
@@ -972,6 +977,27 @@ namespace hpx { namespace parcelset
                   _1, outgoing_routed_count, _2),
               &performance_counters::locality_counter_discoverer,
               ""
+            },
+            { "/parcelport/count/receive-buffer-pool/hits",
+              performance_counters::counter_raw,
+              "returns the number of buffers for received messages which "
+                  "were taken from the receive buffer pool",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, receive_buffer_pool_hits, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/parcelport/count/receive-buffer-pool/misses",
+              performance_counters::counter_raw,
+              "returns the number of buffers for received messages which "
+                  "had to be newly allocated as the receive buffer pool did "
+                  "not hold a suitable buffer",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, receive_buffer_pool_misses, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
             }
         };
         performance_counters::install_counter_types(
@@ -0,0 +1,161 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/parcelset/receive_buffer_pool.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    namespace
+    {
+        // blocks between 4kB and 16MB are pooled
+        std::size_t const min_size_class = 12;
+        std::size_t const max_size_class = 24;
+        std::size_t const num_size_classes =
+            max_size_class - min_size_class + 1;
+
+        // the memory kept by the pool for each size class is limited to
+        // 64MB (but at least 4 and at most 256 blocks)
+        std::size_t const max_pooled_bytes = std::size_t(1) << 26;
+
+        // return the size class the given size belongs to
+        std::size_t get_size_class(std::size_t size)
+        {
+            std::size_t size_class = min_size_class;
+            while (size_class <= max_size_class &&
+                (std::size_t(1) << size_class) < size)
+            {
+                ++size_class;
+            }
+            return size_class;
+        }
+
+        class receive_buffer_pool
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            struct size_class_data
+            {
+                mutex_type mtx_;
+                std::vector<void*> blocks_;
+            };
+
+        public:
+            receive_buffer_pool()
+              : hits_(0), misses_(0)
+            {}
+
+            ~receive_buffer_pool()
+            {
+                for (std::size_t i = 0; i != num_size_classes; ++i)
+                {
+                    for (void* p : size_classes_[i].blocks_)
+                        ::operator delete(p);
+                }
+            }
+
+            static receive_buffer_pool& get()
+            {
+                static receive_buffer_pool pool;
+                return pool;
+            }
+
+            void* allocate(std::size_t size)
+            {
+                std::size_t size_class = get_size_class(size);
+                if (size_class > max_size_class)
+                {
+                    ++misses_;
+                    return ::operator new(size);
+                }
+
+                size_class_data& data =
+                    size_classes_[size_class - min_size_class];
+                {
+                    std::lock_guard<mutex_type> l(data.mtx_);
+                    if (!data.blocks_.empty())
+                    {
+                        void* p = data.blocks_.back();
+                        data.blocks_.pop_back();
+                        ++hits_;
+                        return p;
+                    }
+                }
+
+                ++misses_;
+                return ::operator new(std::size_t(1) << size_class);
+            }
+
+            void deallocate(void* p, std::size_t size)
+            {
+                std::size_t size_class = get_size_class(size);
+                if (size_class <= max_size_class)
+                {
+                    std::size_t const max_blocks = (std::min)(
+                        std::size_t(256), (std::max)(std::size_t(4),
+                            max_pooled_bytes >> size_class));
+
+                    size_class_data& data =
+                        size_classes_[size_class - min_size_class];
+
+                    std::lock_guard<mutex_type> l(data.mtx_);
+                    if (data.blocks_.size() < max_blocks)
+                    {
+                        data.blocks_.push_back(p);
+                        return;
+                    }
+                }
+                ::operator delete(p);
+            }
+
+            boost::int64_t get_hits(bool reset)
+            {
+                return util::get_and_reset_value(hits_, reset);
+            }
+
+            boost::int64_t get_misses(bool reset)
+            {
+                return util::get_and_reset_value(misses_, reset);
+            }
+
+        private:
+            size_class_data size_classes_[num_size_classes];
+            boost::atomic<boost::int64_t> hits_;
+            boost::atomic<boost::int64_t> misses_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void* receive_buffer_allocate(std::size_t size)
+    {
+        return receive_buffer_pool::get().allocate(size);
+    }
+
+    void receive_buffer_deallocate(void* p, std::size_t size)
+    {
+        receive_buffer_pool::get().deallocate(p, size);
+    }
+
+    boost::int64_t get_receive_buffer_pool_hits(bool reset)
+    {
+        return receive_buffer_pool::get().get_hits(reset);
+    }
+
+    boost::int64_t get_receive_buffer_pool_misses(bool reset)
+    {
+        return receive_buffer_pool::get().get_misses(reset);
+    }
+}}}
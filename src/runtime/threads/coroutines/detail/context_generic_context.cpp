@@ -26,7 +26,7 @@ namespace hpx { namespace threads { namespace coroutines
             {
 #if defined(_POSIX_VERSION)
                 void* limit = static_cast<char*>(stack_pointer_) - stack_size_;
-                if(posix::reset_stack(limit, stack_size_))
+                if (posix::reset_stack(limit, stack_size_, stack_state_))
                     increment_stack_unbind_count();
 #else
                 // nothing we can do here ...
@@ -42,6 +42,9 @@ namespace hpx { namespace threads { namespace coroutines
             if (ctx_)
 #endif
             {
+#if defined(_POSIX_VERSION)
+                posix::rebind_stack_state(stack_state_);
+#endif
                 increment_stack_recycle_count();
 #if BOOST_VERSION < 105600
                 boost::context::fcontext_t* ctx =
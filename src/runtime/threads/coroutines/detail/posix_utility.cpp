@@ -0,0 +1,459 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+// include unist.d conditionally to check for POSIX version. Not all OSs have the
+// unistd header...
+#if defined(HPX_HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
+#if defined(_POSIX_VERSION)
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/spinlock.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace threads { namespace coroutines { namespace detail
+{
+    namespace posix
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // these globals are initialized from the [hpx.stacks] configuration
+        // section, see runtime_configuration
+        HPX_EXPORT std::size_t stack_slab_size = 8;
+        HPX_EXPORT huge_pages_mode use_huge_pages = huge_pages_none;
+        HPX_EXPORT stack_release_policy release_policy = release_always;
+        HPX_EXPORT std::size_t stack_high_water_mark = 0;
+        HPX_EXPORT boost::uint64_t stack_idle_timeout = 1000;
+
+#if defined(HPX_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) \
+ && _POSIX_MAPPED_FILES > 0
+
+        boost::atomic<std::size_t>& get_committed_stack_memory()
+        {
+            static boost::atomic<std::size_t> committed(0);
+            return committed;
+        }
+
+        namespace
+        {
+            // size of the pages used for explicit huge page mappings
+            std::size_t const huge_page_size = 2 * 1024 * 1024;
+
+            ///////////////////////////////////////////////////////////////////
+            // Free stacks, sorted by their size, for one worker thread.
+            struct stack_cache
+            {
+                typedef hpx::util::spinlock mutex_type;
+                typedef std::map<std::size_t, std::vector<void*> > stacks_type;
+
+                mutex_type mtx_;
+                stacks_type stacks_;
+            };
+
+            struct stack_caches
+            {
+                stack_caches()
+                  : size_(boost::thread::hardware_concurrency() + 1),
+                    caches_(new stack_cache[size_])
+                {}
+
+                // Non-HPX threads (get_worker_thread_num() == -1) share the
+                // first cache.
+                stack_cache& get()
+                {
+                    std::size_t num = hpx::get_worker_thread_num();
+                    return caches_[(num + 1) % size_];
+                }
+
+                std::size_t size_;
+                stack_cache* caches_;
+            };
+
+            stack_caches& get_stack_caches()
+            {
+                // Stacks are released during static destruction (the
+                // coroutine heaps are destroyed at exit), so the caches are
+                // intentionally never destroyed.
+                static stack_caches* caches = new stack_caches;
+                return *caches;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Bookkeeping for release_idle_stacks(): all mapped slabs and the
+            // recycled stacks kept committed by the release_idle_timeout
+            // policy.
+            struct slab
+            {
+                slab(std::size_t length, std::size_t size, std::size_t count)
+                  : length_(length), size_(size), count_(count), free_since_(0)
+                {}
+
+                std::size_t length_;            // length of the mapping
+                std::size_t size_;              // size of the stacks
+                std::size_t count_;             // number of stacks
+                boost::uint64_t free_since_;    // all stacks cached since
+            };
+
+            struct stack_registry
+            {
+                typedef hpx::util::spinlock mutex_type;
+                typedef std::map<char*, slab> slabs_type;
+                typedef std::map<stack_state*, std::pair<void*, std::size_t> >
+                    idle_stacks_type;
+
+                stack_registry()
+                  : next_sweep_(0)
+                {}
+
+                slabs_type::iterator find_slab(void* stack)
+                {
+                    slabs_type::iterator it =
+                        slabs_.upper_bound(static_cast<char*>(stack));
+                    HPX_ASSERT(it != slabs_.begin());
+                    --it;
+                    HPX_ASSERT(static_cast<char*>(stack) <
+                        it->first + it->second.length_);
+                    return it;
+                }
+
+                mutex_type slabs_mtx_;
+                slabs_type slabs_;
+
+                mutex_type idle_mtx_;
+                idle_stacks_type idle_stacks_;
+
+                boost::atomic<boost::uint64_t> next_sweep_;
+            };
+
+            stack_registry& get_stack_registry()
+            {
+                // see get_stack_caches()
+                static stack_registry* registry = new stack_registry;
+                return *registry;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            void* map_slab(std::size_t& size, bool& huge_pages)
+            {
+#if defined(__APPLE__)
+                int flags = MAP_PRIVATE | MAP_ANON | MAP_NORESERVE;
+#else
+                int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+#endif
+                void* slab = MAP_FAILED;
+
+#if defined(MAP_HUGETLB)
+                if (huge_pages)
+                {
+                    // fall back to normal pages if no huge pages are available
+                    std::size_t huge_size = (size + huge_page_size - 1) &
+                        ~(huge_page_size - 1);
+                    slab = ::mmap(NULL, huge_size,
+                        PROT_EXEC | PROT_READ | PROT_WRITE,
+                        flags | MAP_HUGETLB, -1, 0);
+                    if (slab != MAP_FAILED)
+                        size = huge_size;
+                }
+#endif
+                if (slab == MAP_FAILED)
+                {
+                    huge_pages = false;
+                    slab = ::mmap(NULL, size,
+                        PROT_EXEC | PROT_READ | PROT_WRITE, flags, -1, 0);
+                }
+
+                if (slab == MAP_FAILED)
+                {
+                    if (ENOMEM == errno)
+                        throw std::runtime_error("mmap() failed to allocate "
+                            "thread stack due to insufficient resources, "
+                            "increase /proc/sys/vm/max_map_count or add "
+                            "-Ihpx.stacks.use_guard_pages=0 to the command "
+                            "line");
+                    else
+                        throw std::runtime_error(
+                            "mmap() failed to allocate thread stack");
+                }
+
+#if defined(MADV_HUGEPAGE)
+                if (use_huge_pages == huge_pages_transparent)
+                    ::madvise(slab, size, MADV_HUGEPAGE);
+#endif
+                return slab;
+            }
+
+            std::size_t get_guard_size()
+            {
+#if defined(HPX_HAVE_THREAD_GUARD_PAGE)
+                if (use_guard_pages)
+                    return EXEC_PAGESIZE;
+#endif
+                return 0;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            void release_idle_stack_memory(stack_registry& registry,
+                boost::uint64_t now)
+            {
+                boost::uint64_t const timeout = stack_idle_timeout * 1000000;
+
+                boost::lock_guard<stack_registry::mutex_type> l(
+                    registry.idle_mtx_);
+
+                stack_registry::idle_stacks_type::iterator it =
+                    registry.idle_stacks_.begin();
+                while (it != registry.idle_stacks_.end())
+                {
+                    stack_state& state = *it->first;
+                    if (state.last_reset_ >= now ||
+                        now - state.last_reset_ < timeout)
+                    {
+                        ++it;
+                        continue;
+                    }
+
+                    // The first page is never released, see reset_stack().
+                    // Stacks whose memory can't be released are tried again
+                    // during the next sweep.
+                    void* stack = it->second.first;
+                    std::size_t size = it->second.second;
+                    if (!release_stack_memory(stack, size - EXEC_PAGESIZE))
+                    {
+                        ++it;
+                        continue;
+                    }
+
+                    watermark_stack(stack, size);
+                    state.idle_.store(false, boost::memory_order_release);
+                    registry.idle_stacks_.erase(it++);
+                }
+            }
+
+            void unmap_idle_slabs(stack_registry& registry,
+                boost::uint64_t now)
+            {
+                typedef stack_registry::slabs_type slabs_type;
+                typedef stack_cache::stacks_type stacks_type;
+
+                boost::uint64_t const timeout = stack_idle_timeout * 1000000;
+
+                boost::unique_lock<stack_registry::mutex_type> l(
+                    registry.slabs_mtx_, boost::try_to_lock);
+                if (!l.owns_lock())
+                    return;
+
+                stack_caches& caches = get_stack_caches();
+
+                // count the cached stacks of each slab
+                std::map<char*, std::size_t> cached;
+                for (std::size_t i = 0; i != caches.size_; ++i)
+                {
+                    stack_cache& cache = caches.caches_[i];
+                    boost::lock_guard<stack_cache::mutex_type> lc(cache.mtx_);
+
+                    for (stacks_type::iterator it = cache.stacks_.begin();
+                         it != cache.stacks_.end(); ++it)
+                    {
+                        for (std::size_t j = 0; j != it->second.size(); ++j)
+                            ++cached[registry.find_slab(it->second[j])->first];
+                    }
+                }
+
+                // slabs all of whose stacks are cached for longer than the
+                // idle timeout are unmapped
+                std::set<char*> expired;
+                for (slabs_type::iterator it = registry.slabs_.begin();
+                     it != registry.slabs_.end(); ++it)
+                {
+                    slab& s = it->second;
+                    if (cached[it->first] != s.count_)
+                        s.free_since_ = 0;
+                    else if (s.free_since_ == 0)
+                        s.free_since_ = now;
+                    else if (now - s.free_since_ >= timeout)
+                        expired.insert(it->first);
+                }
+
+                if (expired.empty())
+                    return;
+
+                // take the stacks of the expired slabs out of the caches
+                std::map<char*, std::vector<void*> > taken;
+                for (std::size_t i = 0; i != caches.size_; ++i)
+                {
+                    stack_cache& cache = caches.caches_[i];
+                    boost::lock_guard<stack_cache::mutex_type> lc(cache.mtx_);
+
+                    for (stacks_type::iterator it = cache.stacks_.begin();
+                         it != cache.stacks_.end(); ++it)
+                    {
+                        std::vector<void*>& stacks = it->second;
+                        std::vector<void*>::iterator last = stacks.begin();
+                        for (std::size_t j = 0; j != stacks.size(); ++j)
+                        {
+                            char* base = registry.find_slab(stacks[j])->first;
+                            if (expired.find(base) != expired.end())
+                                taken[base].push_back(stacks[j]);
+                            else
+                                *last++ = stacks[j];
+                        }
+                        stacks.erase(last, stacks.end());
+                    }
+                }
+
+                // A stack which was handed out after the slabs were counted
+                // keeps its slab mapped, the stacks taken from such a slab
+                // are given back to the cache.
+                stack_cache& cache = caches.get();
+                for (std::map<char*, std::vector<void*> >::iterator it =
+                         taken.begin(); it != taken.end(); ++it)
+                {
+                    slabs_type::iterator sit = registry.slabs_.find(it->first);
+                    slab& s = sit->second;
+                    if (it->second.size() == s.count_ &&
+                        ::munmap(it->first, s.length_) == 0)
+                    {
+                        registry.slabs_.erase(sit);
+                        continue;
+                    }
+
+                    s.free_since_ = 0;
+
+                    boost::lock_guard<stack_cache::mutex_type> lc(cache.mtx_);
+                    for (std::size_t j = 0; j != it->second.size(); ++j)
+                        cache.stacks_[s.size_].push_back(it->second[j]);
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void* alloc_stack(std::size_t size)
+        {
+            stack_cache& cache = get_stack_caches().get();
+
+            {
+                boost::lock_guard<stack_cache::mutex_type> l(cache.mtx_);
+                std::vector<void*>& stacks = cache.stacks_[size];
+                if (!stacks.empty())
+                {
+                    void* stack = stacks.back();
+                    stacks.pop_back();
+                    return stack;
+                }
+            }
+
+            // map a new slab, hand out its first stack and cache the others
+            std::size_t const count = stack_slab_size ? stack_slab_size : 1;
+            std::size_t const guard_size = get_guard_size();
+            std::size_t const stride = size + guard_size;
+
+            std::size_t length = stride * count;
+            bool huge_pages = (use_huge_pages == huge_pages_explicit);
+            char* slab = static_cast<char*>(map_slab(length, huge_pages));
+
+            // Guard pages can't be protected individually inside a mapping
+            // backed by explicit huge pages, runtime_configuration rejects
+            // this combination.
+            HPX_ASSERT(guard_size == 0 || !huge_pages);
+            if (guard_size != 0)
+            {
+                for (std::size_t i = 0; i != count; ++i)
+                    ::mprotect(slab + i * stride, guard_size, PROT_NONE);
+            }
+
+            {
+                stack_registry& registry = get_stack_registry();
+                boost::lock_guard<stack_registry::mutex_type> l(
+                    registry.slabs_mtx_);
+                registry.slabs_.insert(
+                    std::make_pair(slab, detail::posix::slab(length, size, count)));
+            }
+
+            if (count > 1)
+            {
+                boost::lock_guard<stack_cache::mutex_type> l(cache.mtx_);
+                std::vector<void*>& stacks = cache.stacks_[size];
+                for (std::size_t i = count - 1; i != 0; --i)
+                    stacks.push_back(slab + i * stride + guard_size);
+            }
+            return slab + guard_size;
+        }
+
+        void free_stack(void* stack, std::size_t size)
+        {
+            // The stack is kept for reuse, its slab is unmapped by
+            // release_idle_stacks() once none of the slab's stacks was used
+            // for a while. Its memory is given back to the system unless it
+            // should be kept committed, if this fails the memory is given
+            // back when the slab is unmapped.
+            if (release_policy != release_never)
+                release_stack_memory(stack, size);
+
+            stack_cache& cache = get_stack_caches().get();
+
+            boost::lock_guard<stack_cache::mutex_type> l(cache.mtx_);
+            cache.stacks_[size].push_back(stack);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void register_idle_stack(void* stack, std::size_t size,
+            stack_state& state)
+        {
+            stack_registry& registry = get_stack_registry();
+
+            boost::lock_guard<stack_registry::mutex_type> l(registry.idle_mtx_);
+            registry.idle_stacks_[&state] = std::make_pair(stack, size);
+            state.idle_.store(true, boost::memory_order_release);
+        }
+
+        void unregister_idle_stack(stack_state& state)
+        {
+            stack_registry& registry = get_stack_registry();
+
+            // this waits for release_idle_stacks() to finish with the stack
+            boost::lock_guard<stack_registry::mutex_type> l(registry.idle_mtx_);
+            registry.idle_stacks_.erase(&state);
+            state.idle_.store(false, boost::memory_order_release);
+        }
+
+        void release_idle_stacks()
+        {
+            stack_registry& registry = get_stack_registry();
+
+            // sweep at most twice per idle timeout
+            boost::uint64_t const now = hpx::util::high_resolution_clock::now();
+            boost::uint64_t next = registry.next_sweep_.load(
+                boost::memory_order_relaxed);
+            if (now < next || !registry.next_sweep_.compare_exchange_strong(
+                    next, now + stack_idle_timeout * 500000))
+            {
+                return;
+            }
+
+            release_idle_stack_memory(registry, now);
+            if (release_policy != release_never)
+                unmap_idle_slabs(registry, now);
+        }
+#endif
+    }
+}}}}
+
+#endif
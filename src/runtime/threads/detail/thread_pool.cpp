@@ -5,6 +5,7 @@
 
 #include <hpx/hpx_fwd.hpp>
 #include <hpx/exception.hpp>
+#include <hpx/runtime/get_config_entry.hpp>
 #include <hpx/runtime/threads/detail/thread_pool.hpp>
 #include <hpx/runtime/threads/detail/create_thread.hpp>
 #include <hpx/runtime/threads/detail/create_work.hpp>
@@ -279,6 +280,11 @@ namespace hpx { namespace threads { namespace detail
         if (!threads_.empty() || sched_.has_reached_state(state_running))
             return true;    // do nothing if already running
 
+        // the idle policy decides whether worker threads keep spinning or
+        // get parked if they run out of work
+        if (get_config_entry("hpx.idle_policy", "spin") == "park")
+            sched_.Scheduler::enable_parking();
+
         executed_threads_.resize(num_threads);
         executed_thread_phases_.resize(num_threads);
 
@@ -382,7 +388,7 @@ namespace hpx { namespace threads { namespace detail
                 // create a new thread
                 threads_.push_back(new boost::thread(
                         util::bind(&thread_pool::thread_func, this, thread_num,
-                            boost::ref(topology_), boost::ref(*startup_))
+                            boost::ref(topology_), startup_.get())
                     ));
 
                 // set the new threads affinity (on Windows systems)
@@ -475,15 +481,173 @@ namespace hpx { namespace threads { namespace detail
                         << "thread_pool::stop: " << pool_name_
                         << " join:" << i; //-V128
 
-                    // unlock the lock while joining
+                    // unlock the lock while joining, worker threads removed
+                    // at runtime have been joined already
                     util::unlock_guard<Lock> ul(l);
-                    threads_[i].join();
+                    if (threads_[i].joinable())
+                        threads_[i].join();
                 }
                 threads_.clear();
             }
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Scheduler>
+    void thread_pool<Scheduler>::update_used_processing_units(
+        topology const& topology)
+    {
+        threads::mask_type used = threads::mask_type();
+        resize(used, threads::hardware_concurrency());
+        for (std::size_t i = 0; i != threads_.size(); ++i)
+        {
+            if (sched_.is_active_punit(i))
+                used |= sched_.Scheduler::get_pu_mask(topology, i);
+        }
+        used_processing_units_ = used;
+    }
+
+    // Start a new OS thread for the given (previously removed) worker thread
+    // and bind it to the processing unit \a thread_num.
+    template <typename Scheduler>
+    void thread_pool<Scheduler>::add_processing_unit(
+        std::unique_lock<boost::mutex>& l, std::size_t virt_core,
+        std::size_t thread_num, error_code& ec)
+    {
+        HPX_ASSERT(l.owns_lock());
+
+        if (virt_core >= threads_.size())
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "thread_pool::add_processing_unit",
+                "invalid worker thread number");
+            return;
+        }
+        if (thread_num >= threads::hardware_concurrency())
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "thread_pool::add_processing_unit",
+                "invalid processing unit number");
+            return;
+        }
+        // the OS thread of a worker thread being removed concurrently is
+        // still joinable
+        if (sched_.is_active_punit(virt_core) ||
+            threads_[threads_.size() - virt_core - 1].joinable())
+        {
+            HPX_THROWS_IF(ec, invalid_status,
+                "thread_pool::add_processing_unit",
+                "the given worker thread is still running");
+            return;
+        }
+
+        LTM_(info) //-V128
+            << "thread_pool::add_processing_unit: " << pool_name_
+            << " restart OS thread " << virt_core //-V128
+            << " on processing unit " << thread_num;
+
+        topology const& topology_ = get_topology();
+        sched_.Scheduler::rebind_punit(virt_core, thread_num);
+
+        if (!sched_.Scheduler::resume_punit(virt_core))
+        {
+            HPX_THROWS_IF(ec, invalid_status,
+                "thread_pool::add_processing_unit",
+                "the given worker thread is not suspended");
+            return;
+        }
+
+        try {
+            // the new thread sets its own affinity (see thread_func)
+            threads_.replace(threads_.size() - virt_core - 1,
+                new boost::thread(
+                    util::bind(&thread_pool::thread_func, this, virt_core,
+                        boost::ref(topology_), static_cast<boost::barrier*>(0))
+                ));
+        }
+        catch (std::exception const& e) {
+            sched_.Scheduler::suspend_punit(virt_core);
+            HPX_THROWS_IF(ec, thread_resource_error,
+                "thread_pool::add_processing_unit",
+                std::string("failed to create OS thread: ") + e.what());
+            return;
+        }
+
+        update_used_processing_units(topology_);
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    // Stop the OS thread of the given worker thread and move its remaining
+    // work to the other worker threads. This blocks until the worker thread
+    // has finished executing its current HPX-thread.
+    template <typename Scheduler>
+    void thread_pool<Scheduler>::remove_processing_unit(
+        std::unique_lock<boost::mutex>& l, std::size_t virt_core,
+        error_code& ec)
+    {
+        HPX_ASSERT(l.owns_lock());
+
+        if (virt_core >= threads_.size())
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "thread_pool::remove_processing_unit",
+                "invalid worker thread number");
+            return;
+        }
+        if (!sched_.Scheduler::supports_punit_removal())
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "thread_pool::remove_processing_unit",
+                "the scheduler does not support removing worker threads");
+            return;
+        }
+        if (get_worker_thread_num() == virt_core)
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "thread_pool::remove_processing_unit",
+                "a worker thread can't remove itself");
+            return;
+        }
+
+        std::size_t active = 0;
+        for (std::size_t i = 0; i != threads_.size(); ++i)
+        {
+            if (sched_.is_active_punit(i))
+                ++active;
+        }
+        if (active <= 1 || !sched_.Scheduler::suspend_punit(virt_core))
+        {
+            HPX_THROWS_IF(ec, invalid_status,
+                "thread_pool::remove_processing_unit",
+                "the given worker thread is not running or is the last "
+                "running worker thread");
+            return;
+        }
+
+        LTM_(info) //-V128
+            << "thread_pool::remove_processing_unit: " << pool_name_
+            << " stop OS thread " << virt_core;
+
+        // make sure the worker thread is not waiting
+        sched_.Scheduler::do_some_work(std::size_t(-1));
+
+        {
+            // unlock the lock while joining
+            util::unlock_guard<std::unique_lock<boost::mutex> > ul(l);
+            boost::thread& t = threads_[threads_.size() - virt_core - 1];
+            if (t.joinable())
+                t.join();
+        }
+
+        sched_.Scheduler::drain_punit(virt_core);
+        update_used_processing_units(get_topology());
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     struct manage_active_thread_count
     {
@@ -523,7 +687,7 @@ namespace hpx { namespace threads { namespace detail
 
     template <typename Scheduler>
     void thread_pool<Scheduler>::thread_func(std::size_t num_thread,
-        topology const& topology, boost::barrier& startup)
+        topology const& topology, boost::barrier* startup)
     {
         // Set the affinity for the current thread.
         threads::mask_cref_type mask =
@@ -570,8 +734,10 @@ namespace hpx { namespace threads { namespace detail
         // manage the number of this thread in its TSS
         init_tss_helper<Scheduler> tss_helper(*this, num_thread);
 
-        // wait for all threads to start up before before starting HPX work
-        startup.wait();
+        // wait for all threads to start up before before starting HPX work,
+        // worker threads added at runtime start right away
+        if (startup != 0)
+            startup->wait();
 
         {
             LTM_(info) //-V128
@@ -591,11 +757,24 @@ namespace hpx { namespace threads { namespace detail
                         executed_thread_phases_[num_thread],
                         tfunc_times_[num_thread], exec_times_[num_thread]);
 
-                    detail::scheduling_callbacks callbacks(
-                        util::bind(
+                    detail::scheduling_callbacks::callback_type idle_callback;
+                    if (sched_.Scheduler::parking_enabled())
+                    {
+                        idle_callback = util::bind(
+                            &policies::scheduler_base::park_callback,
+                            &sched_, num_thread,
+                            util::safe_lexical_cast<std::size_t>(
+                                get_config_entry("hpx.max_park_time", 10), 10));
+                    }
+                    else
+                    {
+                        idle_callback = util::bind(
                             &policies::scheduler_base::idle_callback,
-                            &sched_, num_thread
-                        ),
+                            &sched_, num_thread);
+                    }
+
+                    detail::scheduling_callbacks callbacks(
+                        std::move(idle_callback),
                         detail::scheduling_callbacks::callback_type());
 
                     if (mode_ & policies::do_background_work)
@@ -610,10 +789,12 @@ namespace hpx { namespace threads { namespace detail
                         callbacks);
 
                     // the OS thread is allowed to exit only if no more HPX
-                    // threads exist or if some other thread has terminated
+                    // threads exist, if some other thread has terminated, or
+                    // if this worker thread was removed
                     HPX_ASSERT(!sched_.Scheduler::get_thread_count(
                             unknown, thread_priority_default, num_thread) ||
-                        sched_.get_state(num_thread) == state_terminating);
+                        sched_.get_state(num_thread) == state_terminating ||
+                        sched_.get_state(num_thread) == state_suspended);
                 }
                 catch (hpx::exception const& e) {
                     LFATAL_ //-V128
@@ -1220,6 +1401,16 @@ namespace hpx { namespace threads { namespace detail
         return boost::int64_t(10000. * percent);   // 0.01 percent
     }
 
+    template <typename Scheduler>
+    void thread_pool<Scheduler>::get_idle_rate_times(
+        boost::uint64_t& exec_time, boost::uint64_t& total_time) const
+    {
+        exec_time = std::accumulate(exec_times_.begin(), exec_times_.end(),
+            boost::uint64_t(0));
+        total_time = std::accumulate(tfunc_times_.begin(),
+            tfunc_times_.end(), boost::uint64_t(0));
+    }
+
 #if defined(HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES)
     template <typename Scheduler>
     boost::int64_t thread_pool<Scheduler>::avg_creation_idle_rate(bool reset)
@@ -1368,8 +1559,60 @@ namespace hpx { namespace threads { namespace detail
     {
         return sched_.Scheduler::get_num_stolen_to_staged(num, reset);
     }
+
+    template <typename Scheduler>
+    boost::int64_t thread_pool<Scheduler>::
+        get_average_steal_batch_size(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_average_steal_batch_size(num, reset);
+    }
 #endif
 
+    template <typename Scheduler>
+    boost::int64_t thread_pool<Scheduler>::
+        get_parked_time(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_parked_time(num, reset);
+    }
+
+    template <typename Scheduler>
+    boost::int64_t thread_pool<Scheduler>::
+        get_average_wakeup_latency(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_average_wakeup_latency(num, reset);
+    }
+
+    template <typename Scheduler>
+    boost::int64_t thread_pool<Scheduler>::
+        get_deadline_misses(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_deadline_misses(num, reset);
+    }
+
+    template <typename Scheduler>
+    boost::int64_t thread_pool<Scheduler>::
+        get_active_processing_units(std::size_t num, bool reset)
+    {
+        if (num != std::size_t(-1))
+        {
+            if (num >= executed_threads_.size())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "thread_pool::get_active_processing_units",
+                    "invalid worker thread number");
+            }
+            return sched_.is_active_punit(num) ? 1 : 0;
+        }
+
+        boost::int64_t active = 0;
+        for (std::size_t i = 0; i != executed_threads_.size(); ++i)
+        {
+            if (sched_.is_active_punit(i))
+                ++active;
+        }
+        return active;
+    }
+
 }}}
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1407,6 +1650,16 @@ template class HPX_EXPORT hpx::threads::detail::thread_pool<
     hpx::threads::policies::abp_fifo_priority_queue_scheduler>;
 #endif
 
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+template class HPX_EXPORT hpx::threads::detail::thread_pool<
+    hpx::threads::policies::chase_lev_priority_queue_scheduler>;
+#endif
+
+#if defined(HPX_HAVE_DEADLINE_SCHEDULER)
+template class HPX_EXPORT hpx::threads::detail::thread_pool<
+    hpx::threads::policies::deadline_queue_scheduler>;
+#endif
+
 #if defined(HPX_HAVE_HIERARCHY_SCHEDULER)
 #include <hpx/runtime/threads/policies/hierarchy_scheduler.hpp>
 template class HPX_EXPORT hpx::threads::detail::thread_pool<
@@ -0,0 +1,155 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime/threads/executors/deadline_executor.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/register_locks.hpp>
+
+#include <boost/chrono/chrono.hpp>
+#include <boost/cstdint.hpp>
+
+namespace hpx { namespace threads { namespace executors { namespace detail
+{
+    deadline_executor::deadline_executor(
+            boost::chrono::steady_clock::duration const& rel_deadline,
+            thread_priority priority, thread_stacksize stacksize)
+      : rel_deadline_(boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+            rel_deadline).count()),
+        abs_deadline_(0),
+        stacksize_(stacksize),
+        priority_(priority)
+    {}
+
+    // util::high_resolution_clock measures the time since the epoch of the
+    // steady clock
+    deadline_executor::deadline_executor(
+            boost::chrono::steady_clock::time_point const& abs_deadline,
+            thread_priority priority, thread_stacksize stacksize)
+      : rel_deadline_(0),
+        abs_deadline_(boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+            abs_deadline.time_since_epoch()).count()),
+        stacksize_(stacksize),
+        priority_(priority)
+    {}
+
+    threads::thread_state_enum
+    deadline_executor::thread_function_nullary(closure_type func)
+    {
+        // execute the actual thread function
+        func();
+
+        // Verify that there are no more registered locks for this
+        // OS-thread. This will throw if there are still any locks
+        // held.
+        util::force_error_on_lock();
+
+        return threads::terminated;
+    }
+
+    boost::uint64_t deadline_executor::get_deadline() const
+    {
+        if (abs_deadline_ != 0)
+            return abs_deadline_;
+        return util::high_resolution_clock::now() + rel_deadline_;
+    }
+
+    // Schedule the specified function for execution in this executor.
+    // Depending on the subclass implementation, this may block in some
+    // situations.
+    void deadline_executor::add(closure_type && f,
+        util::thread_description const& desc,
+        threads::thread_state_enum initial_state,
+        bool run_now, threads::thread_stacksize stacksize, error_code& ec)
+    {
+        if (stacksize == threads::thread_stacksize_default)
+            stacksize = stacksize_;
+
+        thread_init_data data(util::bind(
+            util::one_shot(&deadline_executor::thread_function_nullary),
+            std::move(f)), desc, 0, priority_, std::size_t(-1),
+            threads::get_stack_size(stacksize));
+        data.deadline = get_deadline();
+
+        register_thread_plain(data, initial_state, run_now, ec);
+    }
+
+    // Schedule given function for execution in this executor no sooner
+    // than time abs_time. This call never blocks, and may violate
+    // bounds on the executor's queue size.
+    void deadline_executor::add_at(
+        boost::chrono::steady_clock::time_point const& abs_time,
+        closure_type && f, util::thread_description const& desc,
+        threads::thread_stacksize stacksize, error_code& ec)
+    {
+        if (stacksize == threads::thread_stacksize_default)
+            stacksize = stacksize_;
+
+        // the deadline of a relative executor starts counting once the thread
+        // becomes runnable
+        thread_init_data data(util::bind(
+            util::one_shot(&deadline_executor::thread_function_nullary),
+            std::move(f)), desc, 0, priority_, std::size_t(-1),
+            threads::get_stack_size(stacksize));
+        data.deadline = abs_deadline_ != 0 ? abs_deadline_ :
+            boost::uint64_t(boost::chrono::duration_cast<
+                    boost::chrono::nanoseconds
+                >(abs_time.time_since_epoch()).count()) + rel_deadline_;
+
+        // create new thread
+        thread_id_type id = register_thread_plain(data, suspended, false, ec);
+        if (ec) return;
+
+        HPX_ASSERT(invalid_thread_id != id);    // would throw otherwise
+
+        // now schedule new thread for execution
+        set_thread_state(id, abs_time);
+    }
+
+    // Return an estimate of the number of waiting tasks.
+    boost::uint64_t deadline_executor::num_pending_closures(error_code& ec) const
+    {
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        return get_thread_count() - get_thread_count(terminated);
+    }
+
+    // Reset internal (round robin) thread distribution scheme
+    void deadline_executor::reset_thread_distribution()
+    {
+        threads::reset_thread_distribution();
+    }
+
+    // Set the new scheduler mode
+    void deadline_executor::set_scheduler_mode(
+        threads::policies::scheduler_mode mode)
+    {
+        threads::set_scheduler_mode(mode);
+    }
+
+    // Return the requested policy element
+    std::size_t deadline_executor::get_policy_element(
+        threads::detail::executor_parameter p, error_code& ec) const
+    {
+        switch(p) {
+        case threads::detail::min_concurrency:
+        case threads::detail::max_concurrency:
+        case threads::detail::current_concurrency:
+            return hpx::get_os_thread_count();
+
+        default:
+            break;
+        }
+
+        HPX_THROWS_IF(ec, bad_parameter,
+            "deadline_executor::get_policy_element",
+            "requested value of invalid policy element");
+        return std::size_t(-1);
+    }
+}}}}
@@ -0,0 +1,274 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_fwd.hpp>
+#include <hpx/throw_exception.hpp>
+#if defined(HPX_HAVE_LOCAL_SCHEDULER)
+#include <hpx/runtime/threads/policies/local_queue_scheduler.hpp>
+#endif
+#if defined(HPX_HAVE_STATIC_SCHEDULER)
+#include <hpx/runtime/threads/policies/static_queue_scheduler.hpp>
+#endif
+#include <hpx/runtime/threads/policies/local_priority_queue_scheduler.hpp>
+#if defined(HPX_HAVE_STATIC_PRIORITY_SCHEDULER)
+#include <hpx/runtime/threads/policies/static_priority_queue_scheduler.hpp>
+#endif
+#include <hpx/runtime/threads/executors/named_pool_executors.hpp>
+#include <hpx/util/ini.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace threads { namespace executors { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        typedef boost::intrusive_ptr<thread_pool_os_executor_base>
+            named_pool_ptr;
+
+        struct named_pool_registry
+        {
+            typedef boost::mutex mutex_type;
+
+            mutex_type mtx_;
+            std::map<std::string, named_pool_ptr> pools_;
+        };
+
+        named_pool_registry& get_named_pool_registry()
+        {
+            static named_pool_registry registry;
+            return registry;
+        }
+
+        thread_pool_os_executor_base* create_pool(std::string const& name,
+            std::string const& scheduler, std::size_t num_threads,
+            std::string const& affinity_desc)
+        {
+#if defined(HPX_HAVE_LOCAL_SCHEDULER)
+            if (scheduler == "local")
+            {
+                return new thread_pool_os_executor<
+                        policies::local_queue_scheduler<>
+                    >(num_threads, affinity_desc, name);
+            }
+#endif
+#if defined(HPX_HAVE_STATIC_SCHEDULER)
+            if (scheduler == "static")
+            {
+                return new thread_pool_os_executor<
+                        policies::static_queue_scheduler<>
+                    >(num_threads, affinity_desc, name);
+            }
+#endif
+#if defined(HPX_HAVE_STATIC_PRIORITY_SCHEDULER)
+            if (scheduler == "static-priority")
+            {
+                return new thread_pool_os_executor<
+                        policies::static_priority_queue_scheduler<>
+                    >(num_threads, affinity_desc, name);
+            }
+#endif
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+            if (scheduler == "chase-lev-priority")
+            {
+                return new thread_pool_os_executor<
+                        policies::chase_lev_priority_queue_scheduler
+                    >(num_threads, affinity_desc, name);
+            }
+#endif
+#if defined(HPX_HAVE_DEADLINE_SCHEDULER)
+            if (scheduler == "deadline")
+            {
+                return new thread_pool_os_executor<
+                        policies::deadline_queue_scheduler
+                    >(num_threads, affinity_desc, name);
+            }
+#endif
+            if (scheduler.empty() || scheduler == "local-priority")
+            {
+                return new thread_pool_os_executor<
+                        policies::local_priority_queue_scheduler<>
+                    >(num_threads, affinity_desc, name);
+            }
+
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "hpx::threads::executors::create_named_pool",
+                "unknown (or disabled) scheduling policy '" + scheduler +
+                "' for thread pool '" + name + "'");
+            return 0;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    named_pool_ptr get_named_pool(std::string const& name, error_code& ec)
+    {
+        named_pool_registry& p = get_named_pool_registry();
+
+        boost::lock_guard<named_pool_registry::mutex_type> l(p.mtx_);
+        std::map<std::string, named_pool_ptr>::const_iterator it =
+            p.pools_.find(name);
+        if (it == p.pools_.end())
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "hpx::threads::executors::detail::get_named_pool",
+                "unknown thread pool: " + name);
+            return named_pool_ptr();
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        return it->second;
+    }
+
+    // [hpx.threadpools.<name>]
+    // scheduler = local-priority
+    // threads = 1
+    // affinity = <as --hpx:bind>
+    void create_named_pools(util::section const& ini)
+    {
+        if (!ini.has_section("hpx.threadpools"))
+            return;
+
+        util::section const* sec = ini.get_section("hpx.threadpools");
+        if (NULL == sec)
+            return;
+
+        typedef util::section::section_map section_map;
+        section_map const& pools = sec->get_sections();
+        for (section_map::const_iterator it = pools.begin();
+             it != pools.end(); ++it)
+        {
+            util::section const& pool = it->second;
+
+            std::size_t num_threads =
+                util::get_entry_as<std::size_t>(pool, "threads", "1");
+
+            create_named_pool(it->first,
+                pool.get_entry("scheduler", "local-priority"), num_threads,
+                pool.get_entry("affinity", ""));
+        }
+    }
+
+    void remove_named_pools()
+    {
+        std::map<std::string, named_pool_ptr> pools;
+
+        {
+            named_pool_registry& p = get_named_pool_registry();
+            boost::lock_guard<named_pool_registry::mutex_type> l(p.mtx_);
+            std::swap(pools, p.pools_);
+        }
+
+        // stop the pools without holding the lock, this waits for all of
+        // their work to finish
+        pools.clear();
+    }
+}}}}
+
+namespace hpx { namespace threads { namespace executors
+{
+    ///////////////////////////////////////////////////////////////////////////
+    void create_named_pool(std::string const& name,
+        std::string const& scheduler, std::size_t num_threads,
+        std::string const& affinity_desc, error_code& ec)
+    {
+        if (name.empty() ||
+            name.find_first_of("#/{}") != std::string::npos)
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "hpx::threads::executors::create_named_pool",
+                "invalid thread pool name: '" + name + "'");
+            return;
+        }
+
+        if (num_threads == 0)
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "hpx::threads::executors::create_named_pool",
+                "thread pool '" + name + "' needs at least one thread");
+            return;
+        }
+
+        typedef detail::named_pool_registry::mutex_type mutex_type;
+        detail::named_pool_registry& p = detail::get_named_pool_registry();
+
+        {
+            boost::lock_guard<mutex_type> l(p.mtx_);
+            if (p.pools_.find(name) != p.pools_.end())
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "hpx::threads::executors::create_named_pool",
+                    "thread pool '" + name + "' already exists");
+                return;
+            }
+        }
+
+        // starting the pool launches its OS threads, don't hold the lock
+        detail::named_pool_ptr pool;
+        try {
+            pool.reset(detail::create_pool(name, scheduler, num_threads,
+                affinity_desc));
+        }
+        catch (hpx::exception const& e) {
+            if (&ec == &throws)
+                throw;
+            ec = make_error_code(e.get_error(), e.what(), hpx::rethrow);
+            return;
+        }
+
+        {
+            boost::lock_guard<mutex_type> l(p.mtx_);
+            if (!p.pools_.insert(std::make_pair(name, pool)).second)
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "hpx::threads::executors::create_named_pool",
+                    "thread pool '" + name + "' already exists");
+                return;
+            }
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    bool has_named_pool(std::string const& name)
+    {
+        detail::named_pool_registry& p = detail::get_named_pool_registry();
+
+        boost::lock_guard<detail::named_pool_registry::mutex_type> l(p.mtx_);
+        return p.pools_.find(name) != p.pools_.end();
+    }
+
+    std::vector<std::string> get_named_pools()
+    {
+        detail::named_pool_registry& p = detail::get_named_pool_registry();
+
+        std::vector<std::string> names;
+
+        boost::lock_guard<detail::named_pool_registry::mutex_type> l(p.mtx_);
+        names.reserve(p.pools_.size());
+
+        typedef std::map<std::string, detail::named_pool_ptr>::const_iterator
+            iterator;
+        for (iterator it = p.pools_.begin(); it != p.pools_.end(); ++it)
+            names.push_back(it->first);
+
+        return names;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    named_pool_executor::named_pool_executor(std::string const& pool_name)
+      : scheduled_executor(detail::get_named_pool(pool_name).get())
+    {}
+}}}
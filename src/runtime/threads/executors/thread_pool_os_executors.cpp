@@ -48,9 +48,10 @@ namespace hpx { namespace threads { namespace executors { namespace detail
     ///////////////////////////////////////////////////////////////////////////
     template <typename Scheduler>
     thread_pool_os_executor<Scheduler>::thread_pool_os_executor(
-            std::size_t num_punits, std::string const& affinity_desc)
+            std::size_t num_punits, std::string const& affinity_desc,
+            std::string const& name)
       : scheduler_(num_punits),
-        executor_name_(get_unique_name()),
+        executor_name_(name.empty() ? get_unique_name() : name),
         notifier_(get_notification_policy(executor_name_.c_str())),
         pool_(scheduler_, notifier_, executor_name_.c_str()),
         num_threads_(num_punits)
@@ -288,3 +289,39 @@ namespace hpx { namespace threads { namespace executors
     {}
 #endif
 }}}
+
+///////////////////////////////////////////////////////////////////////////////
+/// explicit template instantiations, used by the named thread pools
+#if defined(HPX_HAVE_LOCAL_SCHEDULER)
+template class HPX_EXPORT
+    hpx::threads::executors::detail::thread_pool_os_executor<
+        hpx::threads::policies::local_queue_scheduler<> >;
+#endif
+
+#if defined(HPX_HAVE_STATIC_SCHEDULER)
+template class HPX_EXPORT
+    hpx::threads::executors::detail::thread_pool_os_executor<
+        hpx::threads::policies::static_queue_scheduler<> >;
+#endif
+
+template class HPX_EXPORT
+    hpx::threads::executors::detail::thread_pool_os_executor<
+        hpx::threads::policies::local_priority_queue_scheduler<> >;
+
+#if defined(HPX_HAVE_STATIC_PRIORITY_SCHEDULER)
+template class HPX_EXPORT
+    hpx::threads::executors::detail::thread_pool_os_executor<
+        hpx::threads::policies::static_priority_queue_scheduler<> >;
+#endif
+
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+template class HPX_EXPORT
+    hpx::threads::executors::detail::thread_pool_os_executor<
+        hpx::threads::policies::chase_lev_priority_queue_scheduler>;
+#endif
+
+#if defined(HPX_HAVE_DEADLINE_SCHEDULER)
+template class HPX_EXPORT
+    hpx::threads::executors::detail::thread_pool_os_executor<
+        hpx::threads::policies::deadline_queue_scheduler>;
+#endif
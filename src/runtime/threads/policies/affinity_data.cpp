@@ -154,6 +154,24 @@ namespace hpx { namespace threads { namespace policies { namespace detail
         init_cached_pu_nums(num_system_pus, t);
     }
 
+    // means of binding a running thread manager's worker thread to another
+    // processing unit, the affinity domain is kept
+    void affinity_data::rebind_punit(std::size_t virt_core,
+        std::size_t thread_num)
+    {
+        HPX_ASSERT(virt_core < pu_nums_.size());
+        pu_nums_[virt_core] = thread_num;
+
+        // explicitly specified masks are replaced by the new processing unit
+        if (!affinity_masks_.empty())
+        {
+            mask_type m = mask_type();
+            threads::resize(m, hardware_concurrency());
+            threads::set(m, thread_num);
+            affinity_masks_[virt_core] = m;
+        }
+    }
+
     static mask_type get_empty_machine_mask()
     {
         threads::mask_type m = threads::mask_type();
@@ -10,6 +10,7 @@
 #include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/threads/threadmanager.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/runtime/threads/coroutines/detail/coroutine_self.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
@@ -82,6 +83,62 @@ namespace hpx { namespace threads
         exit_funcs_.clear();
     }
 
+    namespace
+    {
+        struct reset_self_on_exit
+        {
+            reset_self_on_exit(thread_self* val, thread_self* old_val)
+              : old_self_(old_val)
+            {
+                thread_self::set_self(val);
+            }
+
+            ~reset_self_on_exit()
+            {
+                thread_self::set_self(old_self_);
+            }
+
+            thread_self* old_self_;
+        };
+    }
+
+    thread_state_enum thread_data::invoke_stackless(
+        thread_state_ex_enum state_ex)
+    {
+        HPX_ASSERT(is_stackless());
+
+        thread_state_enum result = terminated;
+        {
+            thread_self* old_self = get_self_ptr();
+            thread_self self(this_(), old_self, &stackless_tss_,
+                thread_self::stackless_tag());
+            reset_self_on_exit on_exit(&self, old_self);
+
+            try {
+                result = stackless_func_(state_ex);
+            }
+            catch (...) {
+                stackless_func_.reset();
+                stackless_target_ = naming::invalid_id;
+                if (stackless_tss_)
+                    coroutines::detail::delete_tss_storage(stackless_tss_);
+                throw;
+            }
+        }
+
+        // if this thread returned 'terminated' we need to reset the functor,
+        // the target and the thread specific storage, as the coroutine does
+        // for stackful threads
+        if (result == terminated)
+        {
+            stackless_func_.reset();
+            stackless_target_ = naming::invalid_id;
+            if (stackless_tss_)
+                coroutines::detail::delete_tss_storage(stackless_tss_);
+        }
+        return result;
+    }
+
     bool thread_data::interruption_point(bool throw_on_interrupt)
     {
         // We do not protect enabled_interrupt_ and requested_interrupt_
@@ -439,6 +439,18 @@ namespace hpx { namespace this_thread
         threads::thread_self& self = threads::get_self();
         threads::thread_id_type id = threads::get_self_id();
 
+        // A stackless thread can't give up control. This includes plain
+        // yields, as returning right away would make any back-off loop spin
+        // on its worker thread, which might be the only one able to run the
+        // thread it waits for.
+        if (HPX_UNLIKELY(self.is_stackless()))
+        {
+            HPX_THROWS_IF(ec, invalid_status, "this_thread::suspend",
+                "a thread created with thread_stacksize_nostack can't be "
+                "suspended");
+            return threads::wait_unknown;
+        }
+
         // handle interruption, if needed
         threads::interruption_point(id, ec);
         if (ec) return threads::wait_unknown;
@@ -489,6 +501,14 @@ namespace hpx { namespace this_thread
         threads::thread_self& self = threads::get_self();
         threads::thread_id_type id = threads::get_self_id();
 
+        if (HPX_UNLIKELY(self.is_stackless()))
+        {
+            HPX_THROWS_IF(ec, invalid_status, "this_thread::suspend",
+                "a thread created with thread_stacksize_nostack can't be "
+                "suspended");
+            return threads::wait_unknown;
+        }
+
         // handle interruption, if needed
         threads::interruption_point(id, ec);
         if (ec) return threads::wait_unknown;
@@ -14,6 +14,7 @@
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/runtime/threads/detail/set_thread_state.hpp>
 #include <hpx/runtime/threads/executors/current_executor.hpp>
+#include <hpx/runtime/threads/executors/named_pool_executors.hpp>
 #include <hpx/include/performance_counters.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/runtime/actions/continuation.hpp>
@@ -32,6 +33,7 @@
 #include <mutex>
 #include <numeric>
 #include <sstream>
+#include <string>
 
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
 ///////////////////////////////////////////////////////////////////////////////
@@ -98,6 +100,7 @@ namespace hpx { namespace threads
             "medium",
             "large",
             "huge",
+            "nostack",
         };
     }
 
@@ -115,8 +118,10 @@ namespace hpx { namespace threads
             size = thread_stacksize_large;
         else if (rtcfg.get_stack_size(thread_stacksize_huge) == size)
             size = thread_stacksize_huge;
+        else if (rtcfg.get_stack_size(thread_stacksize_nostack) == size)
+            size = thread_stacksize_nostack;
 
-        if (size < thread_stacksize_small || size > thread_stacksize_huge)
+        if (size < thread_stacksize_small || size > thread_stacksize_nostack)
             return "custom";
 
         return strings::stack_size_names[size-1];
@@ -209,6 +214,153 @@ namespace hpx { namespace threads
 
     ///////////////////////////////////////////////////////////////////////////
     // counter creator and discovery functions
+    naming::gid_type
+    counter_creator(performance_counters::counter_info const& info,
+        performance_counters::counter_path_elements const& paths,
+        util::function_nonser<boost::int64_t(bool)> const& total_creator,
+        util::function_nonser<boost::int64_t(bool)> const& individual_creator,
+        char const* individual_name, std::size_t individual_count,
+        error_code& ec);
+
+    namespace
+    {
+        // The counter instances of the named thread pools are:
+        //
+        //   /threads{locality#%d/pool#<name>/total}/...
+        //   /threads{locality#%d/pool#<name>/worker-thread#%d}/...
+        //
+        // This removes the pool from the instance name and returns its name.
+        bool get_named_pool_instance(
+            performance_counters::counter_path_elements& paths,
+            std::string& pool_name)
+        {
+            if (paths.instancename_.compare(0, 5, "pool#") != 0)
+                return false;
+
+            std::string::size_type p = paths.instancename_.find('/');
+            if (p == std::string::npos)
+                return false;
+
+            pool_name = paths.instancename_.substr(5, p - 5);
+            paths.instancename_.erase(0, p + 1);
+            return true;
+        }
+
+        // The named pools stay alive until the runtime is shut down, after
+        // the counters are evaluated for the last time.
+        naming::gid_type named_pool_counter_creator(
+            performance_counters::counter_info const& info,
+            performance_counters::counter_path_elements const& paths,
+            std::string const& pool_name, error_code& ec)
+        {
+            typedef executors::detail::thread_pool_os_executor_base pool_type;
+
+            pool_type* pool =
+                executors::detail::get_named_pool(pool_name, ec).get();
+            if (ec) return naming::invalid_gid;
+
+            using util::placeholders::_1;
+
+            std::size_t const num_threads = pool->get_os_thread_count();
+            std::size_t const num =
+                static_cast<std::size_t>(paths.instanceindex_);
+
+            // /threadqueue{locality#%d/pool#<name>/total}/length
+            // /threadqueue{locality#%d/pool#<name>/worker-thread%d}/length
+            if (paths.objectname_ == "threadqueue")
+            {
+                if (paths.countername_ == "length")
+                {
+                    return counter_creator(info, paths,
+                        util::bind(&pool_type::get_queue_length, pool,
+                            std::size_t(-1)),
+                        util::bind(&pool_type::get_queue_length, pool, num),
+                        "worker-thread", num_threads, ec);
+                }
+            }
+            else if (paths.countername_ == "count/instantaneous/all")
+            {
+                return counter_creator(info, paths,
+                    util::bind(&pool_type::get_thread_count, pool, unknown,
+                        thread_priority_default, std::size_t(-1), _1),
+                    util::bind(&pool_type::get_thread_count, pool, unknown,
+                        thread_priority_default, num, _1),
+                    "worker-thread", num_threads, ec);
+            }
+            else if (paths.countername_ == "count/instantaneous/active")
+            {
+                return counter_creator(info, paths,
+                    util::bind(&pool_type::get_thread_count, pool, active,
+                        thread_priority_default, std::size_t(-1), _1),
+                    util::bind(&pool_type::get_thread_count, pool, active,
+                        thread_priority_default, num, _1),
+                    "worker-thread", num_threads, ec);
+            }
+            else if (paths.countername_ == "count/instantaneous/pending")
+            {
+                return counter_creator(info, paths,
+                    util::bind(&pool_type::get_thread_count, pool, pending,
+                        thread_priority_default, std::size_t(-1), _1),
+                    util::bind(&pool_type::get_thread_count, pool, pending,
+                        thread_priority_default, num, _1),
+                    "worker-thread", num_threads, ec);
+            }
+            else if (paths.countername_ == "count/instantaneous/suspended")
+            {
+                return counter_creator(info, paths,
+                    util::bind(&pool_type::get_thread_count, pool, suspended,
+                        thread_priority_default, std::size_t(-1), _1),
+                    util::bind(&pool_type::get_thread_count, pool, suspended,
+                        thread_priority_default, num, _1),
+                    "worker-thread", num_threads, ec);
+            }
+            else if (paths.countername_ == "count/active-processing-units")
+            {
+                return counter_creator(info, paths,
+                    util::bind(&pool_type::get_active_processing_units, pool,
+                        std::size_t(-1), _1),
+                    util::bind(&pool_type::get_active_processing_units, pool,
+                        num, _1),
+                    "worker-thread", num_threads, ec);
+            }
+            else if (paths.countername_ == "time/overall")
+            {
+                return counter_creator(info, paths,
+                    util::bind(&pool_type::get_cumulative_duration, pool,
+                        std::size_t(-1), _1),
+                    util::bind(&pool_type::get_cumulative_duration, pool,
+                        num, _1),
+                    "worker-thread", num_threads, ec);
+            }
+#if defined(HPX_HAVE_THREAD_CUMULATIVE_COUNTS)
+            else if (paths.countername_ == "count/cumulative")
+            {
+                return counter_creator(info, paths,
+                    util::bind(&pool_type::get_executed_threads, pool,
+                        std::size_t(-1), _1),
+                    util::bind(&pool_type::get_executed_threads, pool,
+                        num, _1),
+                    "worker-thread", num_threads, ec);
+            }
+#endif
+#if defined(HPX_HAVE_THREAD_IDLE_RATES)
+            else if (paths.countername_ == "idle-rate")
+            {
+                return counter_creator(info, paths,
+                    util::bind(&pool_type::avg_idle_rate, pool,
+                        std::size_t(-1), _1),
+                    util::bind(&pool_type::avg_idle_rate, pool, num, _1),
+                    "worker-thread", num_threads, ec);
+            }
+#endif
+
+            HPX_THROWS_IF(ec, bad_parameter, "named_pool_counter_creator",
+                "counter is not supported for thread pool '" + pool_name +
+                "': " + info.fullname_);
+            return naming::invalid_gid;
+        }
+    }
+
 
     // queue length(s) counter creation function
     template <typename SchedulingPolicy>
@@ -221,6 +373,10 @@ namespace hpx { namespace threads
         performance_counters::get_counter_path_elements(info.fullname_, paths, ec);
         if (ec) return naming::invalid_gid;
 
+        std::string pool_name;
+        if (get_named_pool_instance(paths, pool_name))
+            return named_pool_counter_creator(info, paths, pool_name, ec);
+
         // /threadqueue{locality#%d/total}/length
         // /threadqueue{locality#%d/worker-thread%d}/length
         if (paths.parentinstance_is_basename_) {
@@ -456,6 +612,10 @@ namespace hpx { namespace threads
         performance_counters::get_counter_path_elements(info.fullname_, paths, ec);
         if (ec) return naming::invalid_gid;
 
+        std::string pool_name;
+        if (get_named_pool_instance(paths, pool_name))
+            return named_pool_counter_creator(info, paths, pool_name, ec);
+
         // /threads{locality#%d/total}/idle-rate
         // /threads{locality#%d/worker-thread%d}/idle-rate
         if (paths.parentinstance_is_basename_) {
@@ -551,6 +711,10 @@ namespace hpx { namespace threads
         performance_counters::get_counter_path_elements(info.fullname_, paths, ec);
         if (ec) return naming::invalid_gid;
 
+        std::string pool_name;
+        if (get_named_pool_instance(paths, pool_name))
+            return named_pool_counter_creator(info, paths, pool_name, ec);
+
         struct creator_data
         {
             char const* const countername;
@@ -661,6 +825,40 @@ namespace hpx { namespace threads
                   static_cast<std::size_t>(paths.instanceindex_), _1),
               "worker-thread", shepherd_count
             },
+            // /threads{locality#%d/total}/time/parked
+            // /threads{locality#%d/worker-thread%d}/time/parked
+            { "time/parked",
+              util::bind(&spt::get_parked_time, &pool_, std::size_t(-1), _1),
+              util::bind(&spt::get_parked_time, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/time/average-wakeup-latency
+            // /threads{locality#%d/worker-thread%d}/time/average-wakeup-latency
+            { "time/average-wakeup-latency",
+              util::bind(&spt::get_average_wakeup_latency, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_average_wakeup_latency, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/active-processing-units
+            // /threads{locality#%d/worker-thread%d}/count/active-processing-units
+            { "count/active-processing-units",
+              util::bind(&spt::get_active_processing_units, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_active_processing_units, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/deadline-misses
+            // /threads{locality#%d/worker-thread%d}/count/deadline-misses
+            { "count/deadline-misses",
+              util::bind(&spt::get_deadline_misses, &pool_, std::size_t(-1), _1),
+              util::bind(&spt::get_deadline_misses, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
             // /threads{locality#%d/total}/count/instantaneous/all
             // /threads{locality#%d/worker-thread%d}/count/instantaneous/all
             { "count/instantaneous/all",
@@ -795,6 +993,15 @@ namespace hpx { namespace threads
               util::bind(&spt::get_num_stolen_to_staged, &pool_,
                   static_cast<std::size_t>(paths.instanceindex_), _1),
               "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/steal-batch-size
+            // /threads{locality#%d/worker-thread%d}/count/steal-batch-size
+            { "count/steal-batch-size",
+              util::bind(&spt::get_average_steal_batch_size, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_average_steal_batch_size, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
             }
 #endif
         };
@@ -937,6 +1144,39 @@ namespace hpx { namespace threads
               &performance_counters::locality_thread_counter_discoverer,
               "ns"
             },
+            { "/threads/time/parked", performance_counters::counter_raw,
+              "returns the overall time worker threads were parked while "
+              "waiting for new work (idle policy 'park' only)",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              "ns"
+            },
+            { "/threads/time/average-wakeup-latency",
+              performance_counters::counter_raw,
+              "returns the average time between notifying a parked worker "
+              "thread about new work and the worker thread resuming to run "
+              "(idle policy 'park' only)",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              "ns"
+            },
+            { "/threads/count/active-processing-units",
+              performance_counters::counter_raw,
+              "returns the number of worker threads currently running on "
+              "their processing unit (worker threads can be removed and "
+              "added at runtime)",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
+            { "/threads/count/deadline-misses",
+              performance_counters::counter_raw,
+              "returns the overall number of executed HPX-threads which "
+              "finished after their deadline",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
             { "/threads/count/instantaneous/all", performance_counters::counter_raw,
               "returns the overall current number of HPX-threads instantiated at the "
               "referenced locality", HPX_PERFORMANCE_COUNTER_V1, counts_creator,
@@ -1045,6 +1285,14 @@ namespace hpx { namespace threads
               counts_creator,
               &performance_counters::locality_thread_counter_discoverer,
               ""
+            },
+            { "/threads/count/steal-batch-size", performance_counters::counter_raw,
+              "returns the average number of pending HPX-threads moved from a "
+              "neighboring scheduler by a single steal operation for the "
+              "referenced locality", HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
             }
 #endif
         };
@@ -1178,6 +1426,13 @@ namespace hpx { namespace threads
         return pool_.avg_idle_rate(num_thread, reset);
     }
 
+    template <typename SchedulingPolicy>
+    void threadmanager_impl<SchedulingPolicy>::get_idle_rate_times(
+        boost::uint64_t& exec_time, boost::uint64_t& total_time)
+    {
+        pool_.get_idle_rate_times(exec_time, total_time);
+    }
+
 #if defined(HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES)
     template <typename SchedulingPolicy>
     boost::int64_t threadmanager_impl<SchedulingPolicy>::
@@ -1233,6 +1488,16 @@ template class HPX_EXPORT hpx::threads::threadmanager_impl<
     hpx::threads::policies::abp_fifo_priority_queue_scheduler>;
 #endif
 
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+template class HPX_EXPORT hpx::threads::threadmanager_impl<
+    hpx::threads::policies::chase_lev_priority_queue_scheduler>;
+#endif
+
+#if defined(HPX_HAVE_DEADLINE_SCHEDULER)
+template class HPX_EXPORT hpx::threads::threadmanager_impl<
+    hpx::threads::policies::deadline_queue_scheduler>;
+#endif
+
 #if defined(HPX_HAVE_HIERARCHY_SCHEDULER)
 #include <hpx/runtime/threads/policies/hierarchy_scheduler.hpp>
 template class HPX_EXPORT hpx::threads::threadmanager_impl<
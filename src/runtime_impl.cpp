@@ -18,6 +18,7 @@
 #include <hpx/runtime/components/server/console_error_sink.hpp>
 #include <hpx/runtime/components/runtime_support.hpp>
 #include <hpx/runtime/threads/threadmanager_impl.hpp>
+#include <hpx/runtime/threads/executors/named_pool_executors.hpp>
 #include <hpx/runtime/agas/big_boot_barrier.hpp>
 #include <hpx/runtime/get_config_entry.hpp>
 #include <hpx/include/performance_counters.hpp>
@@ -252,6 +253,12 @@ namespace hpx {
 
         parcel_handler_.enable_alternative_parcelports();
 
+        // launch the thread pools configured in [hpx.threadpools], all named
+        // pools are stopped during shutdown
+        add_shutdown_function(
+            &threads::executors::detail::remove_named_pools);
+        threads::executors::detail::create_named_pools(get_config());
+
         // reset all counters right before running main, if requested
         if (get_config_entry("hpx.print_counter.startup", "0") == "1")
         {
@@ -822,6 +829,16 @@ template class HPX_EXPORT hpx::runtime_impl<
     hpx::threads::policies::abp_fifo_priority_queue_scheduler>;
 #endif
 
+#if defined(HPX_HAVE_CHASE_LEV_SCHEDULER)
+template class HPX_EXPORT hpx::runtime_impl<
+    hpx::threads::policies::chase_lev_priority_queue_scheduler>;
+#endif
+
+#if defined(HPX_HAVE_DEADLINE_SCHEDULER)
+template class HPX_EXPORT hpx::runtime_impl<
+    hpx::threads::policies::deadline_queue_scheduler>;
+#endif
+
 #if defined(HPX_HAVE_HIERARCHY_SCHEDULER)
 #include <hpx/runtime/threads/policies/hierarchy_scheduler.hpp>
 template class HPX_EXPORT hpx::runtime_impl<
@@ -263,6 +263,26 @@ namespace hpx { namespace util
             return cfgmap.get_value<std::size_t>("hpx.numa_sensitive", default_);
         }
 
+        std::string handle_idle_policy(util::manage_config& cfgmap,
+            boost::program_options::variables_map& vm, std::string default_)
+        {
+            if (vm.count("hpx:idle-policy") != 0)
+            {
+                std::string idle_policy =
+                    vm["hpx:idle-policy"].as<std::string>();
+                if (idle_policy != "spin" && idle_policy != "park")
+                {
+                    throw hpx::detail::command_line_error("Invalid argument "
+                        "value for --hpx:idle-policy. Allowed values are "
+                        "'spin' or 'park'");
+                }
+                return idle_policy;
+            }
+
+            // use either cfgmap value or default
+            return cfgmap.get_value<std::string>("hpx.idle_policy", default_);
+        }
+
         ///////////////////////////////////////////////////////////////////////
         std::size_t handle_num_threads(util::manage_config& cfgmap,
             boost::program_options::variables_map& vm,
@@ -679,6 +699,9 @@ namespace hpx { namespace util
             affinity_bind_.empty() ? 0 : 1);
         ini_config += "hpx.numa_sensitive=" + std::to_string(numa_sensitive_);
 
+        ini_config += "hpx.idle_policy=" +
+            detail::handle_idle_policy(cfgmap, vm, "spin");
+
         // map host names to ip addresses, if requested
         hpx_host = mapnames.map(hpx_host, hpx_port);
         agas_host = mapnames.map(agas_host, agas_port);
@@ -450,7 +450,8 @@ namespace hpx { namespace util
                 ("hpx:queuing", value<std::string>(),
                   "the queue scheduling policy to use, options are "
                   "'local', 'local-priority', 'abp-priority', "
-                  "'hierarchy', 'static', 'static-priority', and "
+                  "'chase-lev-priority', 'deadline', 'hierarchy', 'static', "
+                  "'static-priority', and "
                   "'periodic-priority' (default: 'local-priority'; "
                   "all option values can be abbreviated)")
                 ("hpx:hierarchy-arity", value<std::size_t>(),
@@ -460,7 +461,31 @@ namespace hpx { namespace util
                   "the number of operating system threads maintaining a high "
                   "priority queue (default: number of OS threads), valid for "
                   "--hpx:queuing=local-priority,--hpx:queuing=static-priority, "
+                  "--hpx:queuing=chase-lev-priority, --hpx:queuing=deadline, "
                   " and --hpx:queuing=abp-priority only)")
+                ("hpx:steal-batch", value<std::size_t>(),
+                  "the maximal number of pending HPX-threads moved from a "
+                  "neighboring queue by a single steal operation (0: steal "
+                  "half of the neighboring queue, default: 1), valid for "
+                  "--hpx:queuing=local-priority, --hpx:queuing=abp-priority, "
+                  "--hpx:queuing=chase-lev-priority, and --hpx:queuing=deadline "
+                  "only")
+                ("hpx:hierarchical-stealing",
+                  "select work stealing victims hierarchically: the worker "
+                  "threads sharing a core first, then random worker threads "
+                  "of the same NUMA domain, and only then worker threads of "
+                  "other NUMA domains, valid for --hpx:queuing=local-priority, "
+                  "--hpx:queuing=abp-priority, --hpx:queuing=chase-lev-priority, "
+                  "and --hpx:queuing=deadline only")
+                ("hpx:remote-steal-backoff", value<std::size_t>(),
+                  "the number of idle scheduling loops a worker thread waits "
+                  "before stealing work from other NUMA domains (default: 0), "
+                  "valid for --hpx:hierarchical-stealing only")
+                ("hpx:idle-policy", value<std::string>(),
+                  "the policy applied by worker threads running out of work, "
+                  "options are 'spin' (keep looking for work) and 'park' "
+                  "(spin for a short time, then suspend the worker thread "
+                  "until new work is available) (default: 'spin')")
                 ("hpx:numa-sensitive", value<std::size_t>()->implicit_value(0),
                   "makes the local-priority scheduler NUMA sensitive ("
                   "allowed values: 0 - no NUMA sensitivity, 1 - allow only for "
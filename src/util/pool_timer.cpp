@@ -39,6 +39,8 @@ namespace hpx { namespace util { namespace detail
         ~pool_timer();
 
         bool start(bool evaluate);
+        bool start(boost::chrono::steady_clock::time_point const& abs_time,
+            bool evaluate);
         bool stop();
 
         bool is_started() const { return is_started_; }
@@ -137,6 +139,20 @@ namespace hpx { namespace util { namespace detail
         return false;
     }
 
+    bool pool_timer::start(
+        boost::chrono::steady_clock::time_point const& abs_time,
+        bool evaluate_)
+    {
+        {
+            boost::lock_guard<mutex_type> l(mtx_);
+            if (is_terminated_ || is_started_)
+                return false;
+
+            abs_time_ = abs_time;
+        }
+        return start(evaluate_);
+    }
+
     bool pool_timer::stop()
     {
         boost::lock_guard<mutex_type> l(mtx_);
@@ -215,6 +231,12 @@ namespace hpx { namespace util
         return timer_->start(evaluate);
     }
 
+    bool pool_timer::start(hpx::util::steady_duration const& rel_time,
+        bool evaluate)
+    {
+        return timer_->start(rel_time.from_now(), evaluate);
+    }
+
     bool pool_timer::stop()
     {
         return timer_->stop();
@@ -39,6 +39,10 @@
 #  include <unistd.h>
 #endif
 
+#if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
+#include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#endif
+
 #if (defined(__linux) || defined(linux) || defined(__linux__))
 #include <ifaddrs.h>
 #include <netinet/in.h>
@@ -184,6 +188,10 @@ namespace hpx { namespace util
             "pu_offset = 0",
             "numa_sensitive = 0",
             "max_background_threads = ${MAX_BACKGROUND_THREADS:$[hpx.os_threads]}",
+            "idle_policy = ${HPX_IDLE_POLICY:spin}",
+            "max_idle_loop_count = ${HPX_MAX_IDLE_LOOP_COUNT:"
+                BOOST_PP_STRINGIZE(HPX_IDLE_LOOP_COUNT_MAX) "}",
+            "max_park_time = ${HPX_MAX_PARK_TIME:10}",
 
             // connect back to the given latch if specified
             "[hpx.on_startup]",
@@ -200,6 +208,11 @@ namespace hpx { namespace util
                 BOOST_PP_STRINGIZE(HPX_HUGE_STACK_SIZE) "}",
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
             "use_guard_pages = ${HPX_USE_GUARD_PAGES:1}",
+            "slab_size = ${HPX_STACKS_SLAB_SIZE:8}",
+            "huge_pages = ${HPX_STACKS_HUGE_PAGES:none}",
+            "release_policy = ${HPX_STACKS_RELEASE_POLICY:always}",
+            "high_water_mark = ${HPX_STACKS_HIGH_WATER_MARK:268435456}",
+            "idle_timeout = ${HPX_STACKS_IDLE_TIMEOUT:1000}",
 #endif
 
             "[hpx.threadpools]",
@@ -463,6 +476,7 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
+        init_stack_pool();
 #endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
@@ -524,6 +538,7 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
+        init_stack_pool();
 #endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
@@ -915,6 +930,65 @@ namespace hpx { namespace util
         }
         return true;    // default is true
     }
+
+    void runtime_configuration::init_stack_pool() const
+    {
+        namespace posix = threads::coroutines::detail::posix;
+
+        util::section const* sec = get_section("hpx.stacks");
+        if (NULL == sec)
+            return;
+
+        posix::stack_slab_size =
+            hpx::util::get_entry_as<std::size_t>(*sec, "slab_size", "8");
+
+        std::string huge_pages = sec->get_entry("huge_pages", "none");
+        if (huge_pages == "none")
+            posix::use_huge_pages = posix::huge_pages_none;
+        else if (huge_pages == "transparent")
+            posix::use_huge_pages = posix::huge_pages_transparent;
+        else if (huge_pages == "explicit")
+            posix::use_huge_pages = posix::huge_pages_explicit;
+        else {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "runtime_configuration::init_stack_pool",
+                "invalid value for hpx.stacks.huge_pages \"" +
+                    huge_pages + "\"");
+        }
+
+#if defined(HPX_HAVE_THREAD_GUARD_PAGE)
+        // guard pages can't be protected inside of explicit huge pages
+        if (posix::use_huge_pages == posix::huge_pages_explicit &&
+            posix::use_guard_pages)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "runtime_configuration::init_stack_pool",
+                "hpx.stacks.huge_pages=explicit requires "
+                "hpx.stacks.use_guard_pages=0");
+        }
+#endif
+
+        std::string policy = sec->get_entry("release_policy", "always");
+        if (policy == "always")
+            posix::release_policy = posix::release_always;
+        else if (policy == "never")
+            posix::release_policy = posix::release_never;
+        else if (policy == "high-water-mark")
+            posix::release_policy = posix::release_high_water_mark;
+        else if (policy == "idle-timeout")
+            posix::release_policy = posix::release_idle_timeout;
+        else {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "runtime_configuration::init_stack_pool",
+                "invalid value for hpx.stacks.release_policy \"" +
+                    policy + "\"");
+        }
+
+        posix::stack_high_water_mark = hpx::util::get_entry_as<std::size_t>(
+            *sec, "high_water_mark", "268435456");
+        posix::stack_idle_timeout = hpx::util::get_entry_as<boost::uint64_t>(
+            *sec, "idle_timeout", "1000");
+    }
 #endif
 
     std::ptrdiff_t runtime_configuration::init_small_stack_size() const
@@ -1008,6 +1082,9 @@ namespace hpx { namespace util
         case threads::thread_stacksize_huge:
             return huge_stacksize;
 
+        case threads::thread_stacksize_nostack:
+            return threads::nostack_stack_size;
+
         default:
         case threads::thread_stacksize_small:
             break;
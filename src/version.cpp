@@ -180,6 +180,11 @@ namespace hpx
 #else
         strm << "  HPX_HAVE_PARCELPORT_TCP=OFF\n";
 #endif
+#if defined(HPX_HAVE_PARCELPORT_TCP_IO_URING)
+        strm << "  HPX_HAVE_PARCELPORT_TCP_IO_URING=ON\n";
+#else
+        strm << "  HPX_HAVE_PARCELPORT_TCP_IO_URING=OFF\n";
+#endif
 #if defined(HPX_HAVE_PARCELPORT_MPI)
         strm << "  HPX_HAVE_PARCELPORT_MPI=ON (" << mpi_version() << ")\n";
 #else
@@ -0,0 +1,162 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the throughput of lcos::local::channel for an
+// increasing number of HPX threads sending and receiving values through the
+// same channel (half of them are senders, the other half receivers). The
+// number of worker threads is controlled by the --hpx:threads command line
+// option.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/local/channel.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/format.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::util::high_resolution_timer;
+
+using hpx::cout;
+using hpx::flush;
+
+typedef hpx::lcos::local::channel<boost::uint64_t> channel_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void send_loop(channel_type& c, boost::uint64_t iterations)
+{
+    for (boost::uint64_t i = 0; i != iterations; ++i)
+        c.set_sync(i);
+}
+
+boost::uint64_t receive_loop(channel_type& c, boost::uint64_t iterations)
+{
+    boost::uint64_t sum = 0;
+    for (boost::uint64_t i = 0; i != iterations; ++i)
+        sum += c.get_sync();
+    return sum;
+}
+
+void measure(char const* name, channel_type& c, std::size_t num_pairs,
+    boost::uint64_t iterations, bool csv)
+{
+    std::vector<hpx::future<void> > senders;
+    std::vector<hpx::future<boost::uint64_t> > receivers;
+    senders.reserve(num_pairs);
+    receivers.reserve(num_pairs);
+
+    high_resolution_timer walltime;
+    for (std::size_t t = 0; t != num_pairs; ++t)
+    {
+        senders.push_back(hpx::async(&send_loop, std::ref(c), iterations));
+        receivers.push_back(
+            hpx::async(&receive_loop, std::ref(c), iterations));
+    }
+    hpx::wait_all(senders);
+    hpx::wait_all(receivers);
+
+    // stop the clock
+    double const duration = walltime.elapsed();
+    double const per_value =
+        duration * 1e9 / double(num_pairs * iterations);
+
+    boost::uint64_t sum = 0;
+    for (hpx::future<boost::uint64_t>& f : receivers)
+        sum += f.get();
+
+    boost::uint64_t const expected =
+        num_pairs * (iterations * (iterations - 1) / 2);
+    if (sum != expected)
+    {
+        cout << "error: received values don't match the sent values\n"
+             << flush;
+    }
+
+    if (csv)
+    {
+        cout << ( boost::format("%1%,%2%,%3%,%4%\n")
+                % name
+                % num_pairs
+                % duration
+                % per_value
+                )
+             << flush;
+    }
+    else
+    {
+        cout << ( boost::format("%1%: %2% senders/receivers, %3% seconds, "
+                    "%4% [ns] per value\n")
+                % name
+                % num_pairs
+                % duration
+                % per_value
+                )
+             << flush;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    {
+        boost::uint64_t const iterations =
+            vm["iterations"].as<boost::uint64_t>();
+        std::size_t const capacity = vm["capacity"].as<std::size_t>();
+        std::size_t const max_pairs = vm["max-pairs"].as<std::size_t>();
+        bool const csv = vm.count("csv") != 0;
+
+        for (std::size_t t = 1; t <= max_pairs; t *= 2)
+        {
+            {
+                channel_type c;
+                measure("unbounded", c, t, iterations, csv);
+            }
+            {
+                channel_type c(capacity);
+                measure("bounded", c, t, iterations, csv);
+            }
+        }
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "iterations"
+        , value<boost::uint64_t>()->default_value(100000)
+        , "number of values sent by each sender")
+
+        ( "capacity"
+        , value<std::size_t>()->default_value(64)
+        , "capacity of the bounded channel")
+
+        ( "max-pairs"
+        , value<std::size_t>()->default_value(32)
+        , "maximal number of senders and receivers using the channel (the "
+          "benchmark runs for 1, 2, 4, ... pairs)")
+
+        ( "csv"
+        , "output results as csv (format: channel,pairs,duration,ns_per_value)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
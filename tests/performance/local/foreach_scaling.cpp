@@ -8,6 +8,7 @@
 #include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/include/parallel_algorithm.hpp>
 #include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_executors.hpp>
 #include <hpx/include/iostreams.hpp>
 #include "worker_timed.hpp"
 
@@ -25,6 +26,21 @@ int test_count = 100;
 int chunk_size = 0;
 int num_overlapping_loops = 0;
 
+///////////////////////////////////////////////////////////////////////////////
+// This executor exposes async_execute only, the executor_traits launch the
+// tasks of a bulk execution one after the other from the calling thread.
+struct serial_spawn_executor : hpx::parallel::executor_tag
+{
+    typedef hpx::parallel::auto_chunk_size executor_parameters_type;
+
+    template <typename F>
+    hpx::future<typename hpx::util::result_of<F()>::type>
+    async_execute(F && f)
+    {
+        return hpx::async(hpx::launch::async, std::forward<F>(f));
+    }
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 void measure_sequential_foreach(std::size_t size)
 {
@@ -61,6 +77,26 @@ void measure_parallel_foreach(std::size_t size)
         });
 }
 
+void measure_parallel_foreach_serial_spawn(std::size_t size)
+{
+    std::vector<std::size_t> data_representation(size);
+    std::iota(boost::begin(data_representation),
+        boost::end(data_representation),
+        std::rand());
+
+    // create executor parameters object
+    hpx::parallel::static_chunk_size cs(chunk_size);
+
+    // invoke parallel for_each, launching all chunks from this thread
+    serial_spawn_executor exec;
+    hpx::parallel::for_each(hpx::parallel::par.on(exec).with(cs),
+        boost::begin(data_representation),
+        boost::end(data_representation),
+        [](std::size_t) {
+            worker_timed(delay);
+        });
+}
+
 hpx::future<void> measure_task_foreach(std::size_t size)
 {
     boost::shared_ptr<std::vector<std::size_t> > data_representation(
@@ -97,6 +133,17 @@ boost::uint64_t average_out_parallel(std::size_t vector_size)
     return (hpx::util::high_resolution_clock::now() - start) / test_count;
 }
 
+boost::uint64_t average_out_parallel_serial_spawn(std::size_t vector_size)
+{
+    boost::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    // average out 100 executions to avoid varying results
+    for(auto i = 0; i < test_count; i++)
+        measure_parallel_foreach_serial_spawn(vector_size);
+
+    return (hpx::util::high_resolution_clock::now() - start) / test_count;
+}
+
 boost::uint64_t average_out_task(std::size_t vector_size)
 {
     if (num_overlapping_loops <= 0)
@@ -157,13 +204,16 @@ int hpx_main(boost::program_options::variables_map& vm)
 
         //results
         boost::uint64_t par_time = average_out_parallel(vector_size);
+        boost::uint64_t par_serial_time =
+            average_out_parallel_serial_spawn(vector_size);
         boost::uint64_t task_time = average_out_task(vector_size);
         boost::uint64_t seq_time = average_out_sequential(vector_size);
 
         if(csvoutput) {
             hpx::cout << "," << seq_time/1e9
                       << "," << par_time/1e9
-                      << "," << task_time/1e9 << "\n" << hpx::flush;
+                      << "," << task_time/1e9
+                      << "," << par_serial_time/1e9 << "\n" << hpx::flush;
         }
         else {
         // print results(Formatted). Setw(x) assures that all output is right justified
@@ -180,6 +230,8 @@ int hpx_main(boost::program_options::variables_map& vm)
             hpx::cout << "------------------Average------------------\n"
                 << std::left << "Average parallel execution time  : "
                              << std::right << std::setw(8) << par_time/1e9 << "\n"
+                << std::left << "Average serial spawn parallel time: "
+                             << std::right << std::setw(7) << par_serial_time/1e9 << "\n"
                 << std::left << "Average task execution time      : "
                              << std::right << std::setw(8) << task_time/1e9 << "\n"
                 << std::left << "Average sequential execution time: "
@@ -189,6 +241,8 @@ int hpx_main(boost::program_options::variables_map& vm)
             hpx::cout << "---------Execution Time Difference---------\n"
                 << std::left << "Parallel Scale: " << std::right  << std::setw(27)
                              << (double(seq_time) / par_time) << "\n"
+                << std::left << "Serial Spawn Scale: " << std::right  << std::setw(23)
+                             << (double(seq_time) / par_serial_time) << "\n"
                 << std::left << "Task Scale    : " << std::right  << std::setw(27)
                              << (double(seq_time) / task_time) << "\n" << hpx::flush;
         }
@@ -5,12 +5,19 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/hpx_fwd.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/util/bind.hpp>
 #include <hpx/util/function.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/unique_function.hpp>
 
 #include "worker_timed.hpp"
 
+#include <cstddef>
+#include <cstdlib>
 #include <functional>
+#include <new>
+#include <utility>
 
 #include <boost/function.hpp>
 #include <boost/program_options.hpp>
@@ -35,6 +42,93 @@ struct foo
     template <typename Archive> void serialize(Archive&, unsigned int) {}
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// count all heap allocations, this benchmark is single threaded
+boost::uint64_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) HPX_NOEXCEPT
+{
+    std::free(p);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// a function object of the size of a typical continuation: it binds a shared
+// state and a couple of values
+struct continuation
+{
+    void operator()() const
+    {
+        worker_timed(delay * 1000);
+    }
+
+    void* shared_state_;
+    void* values_[4];
+};
+
+// this is what register_thread_nullary wraps around the function to run
+hpx::threads::thread_state_enum thread_function_nullary(
+    hpx::util::unique_function_nonser<void()> func)
+{
+    func();
+    return hpx::threads::terminated;
+}
+
+// create, move and invoke the functions needed to spawn a task running f
+template <typename F>
+void spawn(F const & f, boost::uint64_t local_iterations)
+{
+    boost::uint64_t start = allocations;
+    hpx::util::high_resolution_timer t;
+
+    boost::uint64_t i = 0;
+    for (; i < local_iterations; ++i)
+    {
+        hpx::util::unique_function_nonser<void()> func(f);
+        hpx::threads::thread_function_type thread_func(hpx::util::bind(
+            hpx::util::one_shot(&thread_function_nullary), std::move(func)));
+
+        // the scheduler moves the thread function into the thread object
+        hpx::threads::thread_function_type thread_data(std::move(thread_func));
+        thread_data(hpx::threads::wait_signaled);
+    }
+
+    double elapsed = t.elapsed();
+    std::cout << " allocations/task: "
+              << (double(allocations - start) / i)
+              << ", walltime/task: " << ((elapsed/i)*1e9) << " ns\n";
+}
+
+// create, move and invoke a continuation attached to a future
+template <typename Function, typename F>
+void attach(F const & f, boost::uint64_t local_iterations)
+{
+    boost::uint64_t start = allocations;
+    hpx::util::high_resolution_timer t;
+
+    boost::uint64_t i = 0;
+    for (; i < local_iterations; ++i)
+    {
+        Function on_completed(f);
+        Function moved(std::move(on_completed));
+        moved();
+    }
+
+    double elapsed = t.elapsed();
+    std::cout << " allocations/task: "
+              << (double(allocations - start) / i)
+              << ", walltime/task: " << ((elapsed/i)*1e9) << " ns\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
 template <typename F>
 void run(F const & f, boost::uint64_t local_iterations)
 {
@@ -79,6 +173,28 @@ int app_main(
         run(f, iterations);
     }
 
+    // heap allocations per spawned task and per attached continuation
+    {
+        std::cout << "spawn task (small function object)";
+        spawn(foo(), iterations);
+    }
+    {
+        std::cout << "spawn task (continuation sized function object)";
+        spawn(continuation(), iterations);
+    }
+    {
+        std::cout << "continuation (hpx::util::unique_function_nonser)";
+        attach<hpx::util::unique_function_nonser<void()> >(
+            continuation(), iterations);
+    }
+    {
+        std::cout << "continuation (hpx::util::unique_function, "
+            "HPX_THREAD_FUNCTION_STORAGE_SIZE)";
+        attach<hpx::util::unique_function<
+                void(), false, HPX_THREAD_FUNCTION_STORAGE_SIZE
+            > >(continuation(), iterations);
+    }
+
     return 0;
 }
 
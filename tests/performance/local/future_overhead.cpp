@@ -12,7 +12,9 @@
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/include/async.hpp>
 #include <hpx/include/iostreams.hpp>
+#include <hpx/include/local_lcos.hpp>
 
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -122,6 +124,69 @@ void measure_function_futures(boost::uint64_t count, bool csv)
               << flush;
 }
 
+// measures the creation of the shared state of a future only, the shared
+// states created by the promises are allocated from the thread-local pool
+// (if enabled, see HPX_WITH_FUTURE_DATA_POOL)
+void measure_promise_futures(boost::uint64_t count, bool csv)
+{
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (boost::uint64_t i = 0; i < count; ++i)
+    {
+        hpx::lcos::local::promise<double> p;
+        future<double> f = p.get_future();
+        p.set_value(null_function());
+        global_scratch += f.get();
+    }
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    if (csv)
+        cout << ( boost::format("%1%,%2%\n")
+                % count
+                % duration)
+              << flush;
+    else
+        cout << ( boost::format("invoked %1% futures (promises) in %2% seconds\n")
+                % count
+                % duration)
+              << flush;
+}
+
+// same as above, but the shared states are allocated from the global heap
+void measure_promise_futures_heap(boost::uint64_t count, bool csv)
+{
+    std::allocator<double> alloc;
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (boost::uint64_t i = 0; i < count; ++i)
+    {
+        hpx::lcos::local::promise<double> p(std::allocator_arg, alloc);
+        future<double> f = p.get_future();
+        p.set_value(null_function());
+        global_scratch += f.get();
+    }
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    if (csv)
+        cout << ( boost::format("%1%,%2%\n")
+                % count
+                % duration)
+              << flush;
+    else
+        cout << ( boost::format("invoked %1% futures (promises, "
+                    "std::allocator) in %2% seconds\n")
+                % count
+                % duration)
+              << flush;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(
     variables_map& vm
@@ -137,6 +202,8 @@ int hpx_main(
 
         measure_action_futures(count, vm.count("csv") != 0);
         measure_function_futures(count, vm.count("csv") != 0);
+        measure_promise_futures(count, vm.count("csv") != 0);
+        measure_promise_futures_heap(count, vm.count("csv") != 0);
     }
 
     finalize();
@@ -0,0 +1,178 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the overhead of acquiring and releasing the
+// different reader-writer mutex types for an increasing number of HPX threads
+// contending for the same mutex, most of the accesses are reads. The number
+// of worker threads is controlled by the --hpx:threads command line option.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/local/big_reader_mutex.hpp>
+#include <hpx/lcos/local/shared_mutex.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/format.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::util::high_resolution_timer;
+
+using hpx::cout;
+using hpx::flush;
+
+///////////////////////////////////////////////////////////////////////////////
+// we use globals here to prevent the delay from being optimized away
+double global_scratch = 0;
+boost::uint64_t delay_iterations = 0;
+
+double delay(double d)
+{
+    for (double j = 0.; j < delay_iterations; ++j)
+        d += 1. / (2. * j + 1.);
+    return d;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Mutex>
+double lock_loop(Mutex& mtx, double& shared, boost::uint64_t iterations,
+    boost::uint64_t write_ratio)
+{
+    double d = 0.;
+    for (boost::uint64_t i = 0; i != iterations; ++i)
+    {
+        if (write_ratio != 0 && i % write_ratio == 0)
+        {
+            std::unique_lock<Mutex> l(mtx);
+            shared = delay(shared);
+        }
+        else
+        {
+            boost::shared_lock<Mutex> l(mtx);
+            d = delay(d + shared);
+        }
+    }
+    return d;
+}
+
+template <typename Mutex>
+void measure(char const* name, std::size_t num_threads,
+    boost::uint64_t iterations, boost::uint64_t write_ratio, bool csv)
+{
+    Mutex mtx;
+    double shared = 0.;
+
+    std::vector<hpx::future<double> > futures;
+    futures.reserve(num_threads);
+
+    high_resolution_timer walltime;
+    for (std::size_t t = 0; t != num_threads; ++t)
+    {
+        futures.push_back(hpx::async(
+            [&]()
+            {
+                return lock_loop(mtx, shared, iterations, write_ratio);
+            }));
+    }
+    hpx::wait_all(futures);
+
+    // stop the clock
+    double const duration = walltime.elapsed();
+    double const per_lock = duration * 1e9 / double(num_threads * iterations);
+
+    global_scratch += shared;
+    for (hpx::future<double>& f : futures)
+        global_scratch += f.get();
+
+    if (csv)
+    {
+        cout << ( boost::format("%1%,%2%,%3%,%4%\n")
+                % name
+                % num_threads
+                % duration
+                % per_lock
+                )
+             << flush;
+    }
+    else
+    {
+        cout << ( boost::format("%1%: %2% threads, %3% seconds, "
+                    "%4% [ns] per lock\n")
+                % name
+                % num_threads
+                % duration
+                % per_lock
+                )
+             << flush;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    {
+        delay_iterations = vm["delay-iterations"].as<boost::uint64_t>();
+
+        boost::uint64_t const iterations =
+            vm["iterations"].as<boost::uint64_t>();
+        boost::uint64_t const write_ratio =
+            vm["write-ratio"].as<boost::uint64_t>();
+        std::size_t const max_threads = vm["max-threads"].as<std::size_t>();
+        bool const csv = vm.count("csv") != 0;
+
+        for (std::size_t t = 1; t <= max_threads; t *= 2)
+        {
+            measure<hpx::lcos::local::shared_mutex>(
+                "shared_mutex", t, iterations, write_ratio, csv);
+            measure<hpx::lcos::local::big_reader_mutex>(
+                "big_reader_mutex", t, iterations, write_ratio, csv);
+        }
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "iterations"
+        , value<boost::uint64_t>()->default_value(10000)
+        , "number of times each HPX thread acquires the mutex")
+
+        ( "write-ratio"
+        , value<boost::uint64_t>()->default_value(100)
+        , "acquire the mutex for writing every n-th time (0: never)")
+
+        ( "delay-iterations"
+        , value<boost::uint64_t>()->default_value(0)
+        , "number of iterations in the delay loop (inside of the critical "
+          "section)")
+
+        ( "max-threads"
+        , value<std::size_t>()->default_value(64)
+        , "maximal number of HPX threads contending for the mutex (the "
+          "benchmark runs for 1, 2, 4, ... threads)")
+
+        ( "csv"
+        , "output results as csv (format: mutex,threads,duration,ns_per_lock)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,101 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// All-reduce latency test
+
+#include <hpx/hpx.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+#define SKIP  10
+
+char const* allreduce_basename = "/osu/allreduce/";
+
+struct plus_vector
+{
+    std::vector<float> operator()(std::vector<float> const& lhs,
+        std::vector<float> const& rhs) const
+    {
+        std::vector<float> result(lhs.size());
+        std::transform(lhs.begin(), lhs.end(), rhs.begin(), result.begin(),
+            std::plus<float>());
+        return result;
+    }
+};
+
+HPX_REGISTER_ALL_REDUCE(std::vector<float>, osu_allreduce_vector_float);
+
+///////////////////////////////////////////////////////////////////////////////
+// executed on each of the localities
+double allreduce(std::size_t size, std::size_t loop, std::size_t generation)
+{
+    std::size_t const num_localities = hpx::get_num_localities_sync();
+    std::vector<float> data((std::max)(size / sizeof(float), std::size_t(1)),
+        1.0f);
+
+    hpx::util::high_resolution_timer t;
+
+    for (std::size_t i = 0; i != loop + SKIP; ++i)
+    {
+        // do not measure warm up phase
+        if (i == SKIP)
+            t.restart();
+
+        hpx::lcos::all_reduce(allreduce_basename, data, plus_vector(),
+            num_localities, generation + i).get();
+    }
+
+    double elapsed = t.elapsed();
+    return (elapsed * 1e6) / loop;
+}
+HPX_PLAIN_ACTION(allreduce);
+
+///////////////////////////////////////////////////////////////////////////////
+void print_header()
+{
+    hpx::cout << "# OSU HPX All-reduce Latency Test\n"
+              << "# Size    Avg Latency (microsec)"
+              << std::endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void run_benchmark(boost::program_options::variables_map & vm)
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    std::size_t loop = vm["loop"].as<std::size_t>();
+    std::size_t min_size = vm["min-size"].as<std::size_t>();
+    std::size_t max_size = vm["max-size"].as<std::size_t>();
+
+    if(max_size < min_size) std::swap(max_size, min_size);
+
+    std::size_t generation = 0;
+    for (std::size_t size = min_size; size <= max_size; size *= 2)
+    {
+        std::vector<hpx::future<double> > latencies;
+        latencies.reserve(localities.size());
+        for (hpx::id_type const& id : localities)
+        {
+            latencies.push_back(hpx::async<allreduce_action>(
+                id, size, loop, generation));
+        }
+        generation += loop + SKIP;
+
+        double latency = 0.0;
+        for (hpx::future<double>& f : latencies)
+            latency += f.get();
+
+        hpx::cout << std::left << std::setw(10) << size
+                  << latency / localities.size() << hpx::endl << hpx::flush;
+    }
+}
@@ -0,0 +1,123 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+char const* all_gather_basename = "/test/all_gather/";
+char const* all_gather_local_basename = "/test/all_gather_local/";
+char const* all_gather_sites_basename = "/test/all_gather_sites/";
+
+HPX_REGISTER_ALL_GATHER(boost::uint32_t, test_all_gather);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_all_gather()
+{
+    boost::uint32_t num_localities = hpx::get_num_localities_sync();
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        hpx::future<boost::uint32_t> value =
+            hpx::make_ready_future(hpx::get_locality_id());
+
+        hpx::future<std::vector<boost::uint32_t> > overall_result =
+            hpx::lcos::all_gather(all_gather_basename, std::move(value),
+                num_localities, i);
+
+        std::vector<boost::uint32_t> r = overall_result.get();
+        HPX_TEST_EQ(r.size(), std::size_t(num_localities));
+
+        for (std::size_t j = 0; j != r.size(); ++j)
+            HPX_TEST_EQ(r[j], j);
+    }
+}
+
+void test_all_gather_local_sites()
+{
+    boost::uint32_t num_localities = hpx::get_num_localities_sync();
+    boost::uint32_t this_locality = hpx::get_locality_id();
+    std::size_t const num_local_sites = hpx::get_os_thread_count();
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        std::vector<hpx::future<std::vector<boost::uint32_t> > > results;
+        results.reserve(num_local_sites);
+        for (std::size_t j = 0; j != num_local_sites; ++j)
+        {
+            boost::uint32_t value =
+                boost::uint32_t(this_locality * num_local_sites + j);
+
+            results.push_back(hpx::async(
+                [=]()
+                {
+                    return hpx::lcos::all_gather(all_gather_local_basename,
+                        value, num_localities, i, num_local_sites, j).get();
+                }));
+        }
+
+        for (hpx::future<std::vector<boost::uint32_t> >& f : results)
+        {
+            std::vector<boost::uint32_t> r = f.get();
+            HPX_TEST_EQ(r.size(), num_localities * num_local_sites);
+
+            for (std::size_t j = 0; j != r.size(); ++j)
+                HPX_TEST_EQ(r[j], j);
+        }
+    }
+}
+
+void test_all_gather_this_site()
+{
+    boost::uint32_t num_localities = hpx::get_num_localities_sync();
+
+    // number the sites in the reverse order of the localities
+    std::size_t this_site = num_localities - 1 - hpx::get_locality_id();
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        hpx::future<std::vector<boost::uint32_t> > overall_result =
+            hpx::lcos::all_gather(all_gather_sites_basename,
+                boost::uint32_t(this_site), num_localities, i, 1, 0,
+                this_site);
+
+        std::vector<boost::uint32_t> r = overall_result.get();
+        HPX_TEST_EQ(r.size(), std::size_t(num_localities));
+
+        for (std::size_t j = 0; j != r.size(); ++j)
+            HPX_TEST_EQ(r[j], j);
+    }
+
+    // the site number has to be smaller than the number of sites
+    hpx::future<std::vector<boost::uint32_t> > f = hpx::lcos::all_gather(
+        all_gather_sites_basename, boost::uint32_t(0), num_localities, 10,
+        1, 0, num_localities);
+    HPX_TEST(f.has_exception());
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_all_gather();
+    test_all_gather_local_sites();
+    test_all_gather_this_site();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.run_hpx_main!=1");
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
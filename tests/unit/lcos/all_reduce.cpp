@@ -0,0 +1,110 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+char const* all_reduce_basename = "/test/all_reduce/";
+char const* all_reduce_local_basename = "/test/all_reduce_local/";
+char const* all_reduce_sites_basename = "/test/all_reduce_sites/";
+
+HPX_REGISTER_ALL_REDUCE(boost::uint32_t, test_all_reduce);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_all_reduce()
+{
+    boost::uint32_t num_localities = hpx::get_num_localities_sync();
+    boost::uint32_t expected = num_localities * (num_localities - 1) / 2;
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        hpx::future<boost::uint32_t> value =
+            hpx::make_ready_future(hpx::get_locality_id());
+
+        hpx::future<boost::uint32_t> overall_result =
+            hpx::lcos::all_reduce(all_reduce_basename, std::move(value),
+                std::plus<boost::uint32_t>(), num_localities, i);
+
+        HPX_TEST_EQ(overall_result.get(), expected);
+    }
+}
+
+void test_all_reduce_local_sites()
+{
+    boost::uint32_t num_localities = hpx::get_num_localities_sync();
+    std::size_t const num_local_sites = hpx::get_os_thread_count();
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        // each of the call sites on this locality contributes one
+        std::vector<hpx::future<boost::uint32_t> > results;
+        results.reserve(num_local_sites);
+        for (std::size_t j = 0; j != num_local_sites; ++j)
+        {
+            results.push_back(hpx::async(
+                [=]()
+                {
+                    return hpx::lcos::all_reduce(all_reduce_local_basename,
+                        boost::uint32_t(1), std::plus<boost::uint32_t>(),
+                        num_localities, i, num_local_sites).get();
+                }));
+        }
+
+        for (hpx::future<boost::uint32_t>& f : results)
+            HPX_TEST_EQ(f.get(), num_localities * num_local_sites);
+    }
+}
+
+void test_all_reduce_this_site()
+{
+    boost::uint32_t num_localities = hpx::get_num_localities_sync();
+    boost::uint32_t expected = num_localities * (num_localities - 1) / 2;
+
+    // number the sites in the reverse order of the localities
+    std::size_t this_site = num_localities - 1 - hpx::get_locality_id();
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        hpx::future<boost::uint32_t> overall_result =
+            hpx::lcos::all_reduce(all_reduce_sites_basename,
+                boost::uint32_t(this_site), std::plus<boost::uint32_t>(),
+                num_localities, i, 1, this_site);
+
+        HPX_TEST_EQ(overall_result.get(), expected);
+    }
+
+    // the site number has to be smaller than the number of sites
+    hpx::future<boost::uint32_t> f = hpx::lcos::all_reduce(
+        all_reduce_sites_basename, boost::uint32_t(0),
+        std::plus<boost::uint32_t>(), num_localities, 10, 1, num_localities);
+    HPX_TEST(f.has_exception());
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_all_reduce();
+    test_all_reduce_local_sites();
+    test_all_reduce_this_site();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.run_hpx_main!=1");
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,98 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+char const* all_to_all_basename = "/test/all_to_all/";
+char const* all_to_all_sites_basename = "/test/all_to_all_sites/";
+
+HPX_REGISTER_ALL_TO_ALL(boost::uint32_t, test_all_to_all);
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    boost::uint32_t num_localities = hpx::get_num_localities_sync();
+    boost::uint32_t this_locality = hpx::get_locality_id();
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        // send 'this_locality * 100 + destination' to each locality
+        std::vector<boost::uint32_t> values(num_localities);
+        for (std::size_t j = 0; j != num_localities; ++j)
+            values[j] = boost::uint32_t(this_locality * 100 + j);
+
+        hpx::future<std::vector<boost::uint32_t> > overall_result =
+            hpx::lcos::all_to_all(all_to_all_basename, std::move(values),
+                num_localities, i);
+
+        std::vector<boost::uint32_t> r = overall_result.get();
+        HPX_TEST_EQ(r.size(), std::size_t(num_localities));
+
+        for (std::size_t j = 0; j != r.size(); ++j)
+            HPX_TEST_EQ(r[j], j * 100 + this_locality);
+    }
+
+    // number the sites in the reverse order of the localities
+    std::size_t this_site = num_localities - 1 - this_locality;
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        std::vector<boost::uint32_t> values(num_localities);
+        for (std::size_t j = 0; j != num_localities; ++j)
+            values[j] = boost::uint32_t(this_site * 100 + j);
+
+        hpx::future<std::vector<boost::uint32_t> > overall_result =
+            hpx::lcos::all_to_all(all_to_all_sites_basename,
+                std::move(values), num_localities, i, this_site);
+
+        std::vector<boost::uint32_t> r = overall_result.get();
+        HPX_TEST_EQ(r.size(), std::size_t(num_localities));
+
+        for (std::size_t j = 0; j != r.size(); ++j)
+            HPX_TEST_EQ(r[j], j * 100 + this_site);
+    }
+
+    // the site number has to be smaller than the number of sites
+    {
+        std::vector<boost::uint32_t> values(num_localities);
+        hpx::future<std::vector<boost::uint32_t> > f =
+            hpx::lcos::all_to_all(all_to_all_sites_basename,
+                std::move(values), num_localities, 10, num_localities);
+        HPX_TEST(f.has_exception());
+    }
+
+    // the number of values has to match the number of sites
+    {
+        std::vector<boost::uint32_t> values(num_localities + 1);
+        bool caught_exception = false;
+        try {
+            hpx::lcos::all_to_all(all_to_all_basename, std::move(values),
+                num_localities, 10).get();
+        }
+        catch (hpx::exception const&) {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.run_hpx_main!=1");
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
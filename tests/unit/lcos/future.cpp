@@ -315,6 +315,67 @@ void test_reference_promise()
     HPX_TEST_EQ(&f.get(), &i);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// allocator counting the number of currently allocated objects
+template <typename T>
+struct counting_allocator : std::allocator<T>
+{
+    template <typename U>
+    struct rebind
+    {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator(int& count)
+      : count_(count)
+    {}
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const& rhs)
+      : count_(rhs.count_)
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        ++count_;
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        --count_;
+        std::allocator<T>::deallocate(p, n);
+    }
+
+    int& count_;
+};
+
+void test_promise_with_allocator()
+{
+    int count = 0;
+    {
+        counting_allocator<int> alloc(count);
+        hpx::lcos::local::promise<int> p(std::allocator_arg, alloc);
+        HPX_TEST_EQ(count, 1);
+
+        hpx::lcos::future<int> f = p.get_future();
+        p.set_value(42);
+        HPX_TEST_EQ(f.get(), 42);
+    }
+    HPX_TEST_EQ(count, 0);
+
+    {
+        counting_allocator<int> alloc(count);
+        hpx::lcos::local::promise<void> p(std::allocator_arg, alloc);
+        HPX_TEST_EQ(count, 1);
+
+        hpx::lcos::future<void> f = p.get_future();
+        p.set_value();
+        f.get();
+    }
+    HPX_TEST_EQ(count, 0);
+}
+
 void do_nothing()
 {
 }
@@ -557,6 +618,7 @@ int hpx_main(variables_map&)
         test_task_stores_exception_if_function_throws();
         test_void_promise();
         test_reference_promise();
+        test_promise_with_allocator();
         test_task_returning_void();
         test_task_returning_reference();
         test_future_for_move_only_udt();
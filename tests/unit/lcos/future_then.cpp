@@ -139,6 +139,81 @@ void test_complex_then_chain_two()
     HPX_TEST(f2.get()==4);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+int inc(hpx::lcos::future<int> f)
+{
+    return f.get() + 1;
+}
+
+int throw_int(hpx::lcos::future<int> f)
+{
+    HPX_THROW_EXCEPTION(hpx::invalid_status, "throw_int", "throw_int");
+    return f.get();
+}
+
+void test_sync_then_ready_chain()
+{
+    hpx::thread::id id = hpx::this_thread::get_id();
+    bool same_thread = false;
+
+    // continuations of ready futures are run directly by the calling thread
+    hpx::lcos::future<int> f = hpx::make_ready_future(0)
+        .then(hpx::launch::sync, &inc)
+        .then(hpx::launch::sync, &inc)
+        .then(hpx::launch::sync,
+            [&](hpx::lcos::future<int> f) -> int
+            {
+                same_thread = (hpx::this_thread::get_id() == id);
+                return f.get() + 1;
+            });
+    HPX_TEST(f.is_ready());
+    HPX_TEST(same_thread);
+    HPX_TEST_EQ(f.get(), 3);
+
+    // exceptions are propagated along the chain
+    hpx::lcos::future<int> fe = hpx::make_ready_future(0)
+        .then(hpx::launch::sync, &throw_int)
+        .then(hpx::launch::sync, &inc);
+    HPX_TEST(fe.is_ready());
+    HPX_TEST(fe.has_exception());
+
+    // continuations returning futures are unwrapped
+    hpx::lcos::future<int> fu = hpx::make_ready_future(1)
+        .then(hpx::launch::sync, &p4);
+    HPX_TEST_EQ(fu.get(), 2);
+
+    // continuations returning void
+    hpx::lcos::future<void> fv = hpx::make_ready_future(1)
+        .then(hpx::launch::sync, [](hpx::lcos::future<int>) {});
+    HPX_TEST(fv.is_ready());
+
+    // the same applies to shared futures
+    hpx::lcos::shared_future<int> sf = hpx::make_ready_future(1).share();
+    hpx::lcos::future<int> fs = sf.then(hpx::launch::sync,
+        [](hpx::lcos::shared_future<int> f) -> int
+        {
+            return 2 * f.get();
+        });
+    HPX_TEST(fs.is_ready());
+    HPX_TEST_EQ(fs.get(), 2);
+}
+
+void test_sync_then_pending_chain()
+{
+    // continuations attached before the future becomes ready are not
+    // fused, but they are still run by the thread making the future ready
+    hpx::lcos::local::promise<int> p;
+    hpx::lcos::future<int> f = p.get_future()
+        .then(hpx::launch::sync, &inc)
+        .then(hpx::launch::sync, &inc)
+        .then(hpx::launch::sync, &inc);
+    HPX_TEST(!f.is_ready());
+
+    p.set_value(0);
+    HPX_TEST(f.is_ready());
+    HPX_TEST_EQ(f.get(), 3);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 using boost::program_options::variables_map;
 using boost::program_options::options_description;
@@ -154,6 +229,8 @@ int hpx_main(variables_map&)
         test_complex_then();
         test_complex_then_chain_one();
         test_complex_then_chain_two();
+        test_sync_then_ready_chain();
+        test_sync_then_pending_chain();
     }
 
     hpx::finalize();
@@ -0,0 +1,161 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#define NUM_PRODUCERS std::size_t(16)
+#define NUM_VALUES std::size_t(1000)
+
+typedef hpx::lcos::local::channel<std::size_t> channel_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void produce(channel_type& c, std::size_t first)
+{
+    for (std::size_t i = 0; i != NUM_VALUES; ++i)
+        c.set_sync(first + i);
+}
+
+std::size_t consume(channel_type& c, std::size_t count)
+{
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i != count; ++i)
+        sum += c.get_sync();
+    return sum;
+}
+
+void test_many_to_many(channel_type& c)
+{
+    std::vector<hpx::future<void> > producers;
+    std::vector<hpx::future<std::size_t> > consumers;
+
+    for (std::size_t i = 0; i != NUM_PRODUCERS; ++i)
+    {
+        producers.push_back(hpx::async(&produce, std::ref(c), i * NUM_VALUES));
+        consumers.push_back(hpx::async(&consume, std::ref(c), NUM_VALUES));
+    }
+
+    hpx::wait_all(producers);
+
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i != NUM_PRODUCERS; ++i)
+        sum += consumers[i].get();
+
+    // every value sent was received exactly once
+    std::size_t const n = NUM_PRODUCERS * NUM_VALUES;
+    HPX_TEST_EQ(sum, n * (n - 1) / 2);
+    HPX_TEST_EQ(c.size(), std::size_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    // values are received in the order they were sent
+    {
+        channel_type c;
+
+        for (std::size_t i = 0; i != 10; ++i)
+            HPX_TEST(c.set(i).is_ready());
+
+        HPX_TEST_EQ(c.size(), std::size_t(10));
+        for (std::size_t i = 0; i != 10; ++i)
+            HPX_TEST_EQ(c.get_sync(), i);
+    }
+
+    // a receiver waits for the next value
+    {
+        channel_type c;
+
+        hpx::future<std::size_t> f = c.get();
+        HPX_TEST(!f.is_ready());
+
+        HPX_TEST(c.set(42).is_ready());
+        HPX_TEST_EQ(f.get(), std::size_t(42));
+    }
+
+    // a sender is parked while a bounded channel is full
+    {
+        channel_type c(2);
+        HPX_TEST_EQ(c.capacity(), std::size_t(2));
+
+        HPX_TEST(c.set(1).is_ready());
+        HPX_TEST(c.set(2).is_ready());
+
+        hpx::future<void> f = c.set(3);
+        HPX_TEST(!f.is_ready());
+
+        HPX_TEST_EQ(c.get_sync(), std::size_t(1));
+        HPX_TEST(f.is_ready());
+
+        HPX_TEST_EQ(c.get_sync(), std::size_t(2));
+        HPX_TEST_EQ(c.get_sync(), std::size_t(3));
+    }
+
+    // closing a channel resumes waiting receivers
+    {
+        channel_type c;
+        c.set_sync(1);
+
+        hpx::future<std::size_t> f1 = c.get();
+        hpx::future<std::size_t> f2 = c.get();
+        HPX_TEST(f1.is_ready());
+        HPX_TEST(!f2.is_ready());
+
+        c.close();
+        HPX_TEST(c.is_closed());
+        HPX_TEST_EQ(f1.get(), std::size_t(1));
+
+        bool caught_exception = false;
+        try {
+            f2.get();
+        }
+        catch (hpx::exception const&) {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+
+        // sending through a closed channel fails
+        hpx::future<void> f3 = c.set(2);
+        HPX_TEST(f3.has_exception());
+
+        caught_exception = false;
+        try {
+            c.set_sync(2);
+        }
+        catch (hpx::exception const&) {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    // many producers and consumers
+    {
+        channel_type c;
+        test_many_to_many(c);
+    }
+
+    {
+        channel_type c(4);
+        test_many_to_many(c);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -7,8 +7,11 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/hpx_init.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/wait_all.hpp>
 #include <hpx/lcos/local/condition_variable.hpp>
 #include <hpx/lcos/local/mutex.hpp>
+#include <hpx/lcos/local/queue_mutex.hpp>
 #include <hpx/runtime/threads/thread.hpp>
 #include <hpx/runtime/threads/threadmanager.hpp>
 #include <hpx/util/lightweight_test.hpp>
@@ -17,6 +20,7 @@
 #include <boost/chrono.hpp>
 #include <boost/thread/locks.hpp>
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -285,6 +289,44 @@ void test_mutex()
     test_trylock<hpx::lcos::local::mutex>()();
 }
 
+void test_queue_mutex()
+{
+    test_lock<hpx::lcos::local::queue_mutex>()();
+    test_trylock<hpx::lcos::local::queue_mutex>()();
+}
+
+void test_queue_mutex_contention()
+{
+    typedef hpx::lcos::local::queue_mutex mutex_type;
+
+    std::size_t const num_threads = 64;
+    std::size_t const num_iterations = 1000;
+
+    mutex_type mtx;
+    std::size_t counter = 0;
+
+    std::vector<hpx::future<void> > futures;
+    futures.reserve(num_threads);
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        futures.push_back(hpx::async(
+            [&]()
+            {
+                for (std::size_t j = 0; j != num_iterations; ++j)
+                {
+                    boost::unique_lock<mutex_type> l(mtx);
+                    std::size_t value = counter;
+                    if (j % 10 == 0)
+                        hpx::this_thread::yield();
+                    counter = value + 1;
+                }
+            }));
+    }
+    hpx::wait_all(futures);
+
+    HPX_TEST_EQ(counter, num_threads * num_iterations);
+}
+
 void test_timed_mutex()
 {
 #if BOOST_VERSION >= 105000 // 1.49 has old timed lock interface
@@ -320,6 +362,8 @@ int hpx_main(variables_map&)
     {
         test_mutex();
         test_timed_mutex();
+        test_queue_mutex();
+        test_queue_mutex_contention();
         //~ test_recursive_mutex();
         //~ test_recursive_timed_mutex();
     }
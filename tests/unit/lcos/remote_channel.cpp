@@ -0,0 +1,80 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#define NUM_VALUES std::size_t(100)
+
+typedef hpx::lcos::channel<int> channel_type;
+
+HPX_REGISTER_CHANNEL(int, int);
+
+static const char* const channel_name = "channel_remote_test";
+
+///////////////////////////////////////////////////////////////////////////////
+void send_values(channel_type c, int first)
+{
+    for (std::size_t i = 0; i != NUM_VALUES; ++i)
+        c.set_value_sync(first + int(i));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::size_t num_localities = hpx::get_num_localities_sync();
+    std::size_t locality_id = hpx::get_locality_id();
+
+    channel_type c;
+    if (locality_id == 0)
+    {
+        // Create the channel on locality zero and register it, so that the
+        // other localities can connect to it.
+        c = hpx::new_<channel_type>(hpx::find_here(), std::size_t(8));
+        c.register_as(channel_name);
+    }
+    else
+    {
+        c.connect_to(channel_name);
+    }
+
+    // every locality sends its values through the same channel, senders
+    // are suspended while the channel is full
+    hpx::future<void> sent = hpx::async(&send_values, c,
+        int(locality_id * NUM_VALUES));
+
+    if (locality_id == 0)
+    {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i != num_localities * NUM_VALUES; ++i)
+            sum += std::size_t(c.get_value_sync());
+
+        std::size_t const n = num_localities * NUM_VALUES;
+        HPX_TEST_EQ(sum, n * (n - 1) / 2);
+    }
+
+    sent.get();
+
+    HPX_TEST_EQ(hpx::finalize(), 0);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    // make sure hpx_main will run on all localities
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.run_hpx_main!=1");
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
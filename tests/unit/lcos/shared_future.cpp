@@ -11,6 +11,7 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <boost/atomic.hpp>
 #include <boost/move/move.hpp>
 #include <boost/assign/std/vector.hpp>
 
@@ -1276,6 +1277,53 @@ void test_wait_for_either_of_five_futures_5()
 //     }
 // }
 
+///////////////////////////////////////////////////////////////////////////////
+// continuations attached concurrently with making the future ready have to be
+// run exactly once
+void attach_continuations(hpx::lcos::shared_future<int> f,
+    boost::atomic<int>* count, int num_continuations)
+{
+    for (int i = 0; i != num_continuations; ++i)
+    {
+        f.then(
+            [count](hpx::lcos::shared_future<int> f)
+            {
+                HPX_TEST_EQ(f.get(), 42);
+                ++*count;
+            });
+    }
+}
+
+void test_concurrent_continuations()
+{
+    int const num_attachers = 8;
+    int const num_continuations = 100;
+
+    for (int iteration = 0; iteration != 10; ++iteration)
+    {
+        hpx::lcos::local::promise<int> p;
+        hpx::lcos::shared_future<int> f = p.get_future();
+        boost::atomic<int> count(0);
+
+        std::vector<hpx::lcos::future<void> > attachers;
+        for (int i = 0; i != num_attachers; ++i)
+        {
+            attachers.push_back(hpx::async(&attach_continuations, f, &count,
+                num_continuations));
+        }
+
+        p.set_value(42);
+        hpx::wait_all(attachers);
+
+        // the continuations run asynchronously if they were attached before
+        // the value was set
+        while (count.load() != num_attachers * num_continuations)
+            hpx::this_thread::yield();
+
+        HPX_TEST_EQ(count.load(), num_attachers * num_continuations);
+    }
+}
+
 void test_wait_for_all_from_list()
 {
     unsigned const count = 10;
@@ -1558,6 +1606,7 @@ int hpx_main(variables_map&)
         test_void_promise();
         test_reference_promise();
         test_task_returning_void();
+        test_concurrent_continuations();
         test_task_returning_reference();
         test_shared_future();
         test_copies_of_shared_future_become_ready_together();
@@ -0,0 +1,148 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/lcos/local/big_reader_mutex.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+typedef hpx::lcos::local::big_reader_mutex shared_mutex_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_multiple_readers()
+{
+    std::size_t const number_of_threads = 10;
+
+    shared_mutex_type rw_mutex;
+    hpx::lcos::local::latch l(number_of_threads);
+
+    // all readers have to hold the mutex at the same time to get past the
+    // latch
+    std::vector<hpx::future<void> > futures;
+    for (std::size_t i = 0; i != number_of_threads; ++i)
+    {
+        futures.push_back(hpx::async(
+            [&]()
+            {
+                boost::shared_lock<shared_mutex_type> lk(rw_mutex);
+                l.count_down_and_wait();
+            }));
+    }
+    hpx::wait_all(futures);
+}
+
+void test_try_lock()
+{
+    shared_mutex_type rw_mutex;
+
+    {
+        std::unique_lock<shared_mutex_type> lk(rw_mutex);
+        HPX_TEST(!hpx::async(
+            [&]() { return rw_mutex.try_lock_shared(); }).get());
+        HPX_TEST(!hpx::async(
+            [&]() { return rw_mutex.try_lock(); }).get());
+    }
+
+    {
+        boost::shared_lock<shared_mutex_type> lk(rw_mutex);
+        HPX_TEST(!hpx::async(
+            [&]() { return rw_mutex.try_lock(); }).get());
+        HPX_TEST(hpx::async(
+            [&]()
+            {
+                if (!rw_mutex.try_lock_shared())
+                    return false;
+                rw_mutex.unlock_shared();
+                return true;
+            }).get());
+    }
+
+    HPX_TEST(rw_mutex.try_lock());
+    rw_mutex.unlock();
+}
+
+void test_readers_and_writers()
+{
+    std::size_t const number_of_threads = 64;
+    std::size_t const number_of_iterations = 1000;
+
+    shared_mutex_type rw_mutex;
+    boost::atomic<std::size_t> readers(0);
+    boost::atomic<std::size_t> writers(0);
+    std::size_t first = 0, second = 0;
+
+    std::vector<hpx::future<void> > futures;
+    for (std::size_t i = 0; i != number_of_threads; ++i)
+    {
+        futures.push_back(hpx::async(
+            [&, i]()
+            {
+                for (std::size_t j = 0; j != number_of_iterations; ++j)
+                {
+                    if ((i + j) % 10 == 0)
+                    {
+                        std::unique_lock<shared_mutex_type> lk(rw_mutex);
+
+                        HPX_TEST_EQ(++writers, std::size_t(1));
+                        HPX_TEST_EQ(readers.load(), std::size_t(0));
+
+                        ++first;
+                        hpx::this_thread::yield();
+                        ++second;
+
+                        --writers;
+                    }
+                    else
+                    {
+                        boost::shared_lock<shared_mutex_type> lk(rw_mutex);
+
+                        ++readers;
+                        HPX_TEST_EQ(writers.load(), std::size_t(0));
+                        HPX_TEST_EQ(first, second);
+                        --readers;
+                    }
+                }
+            }));
+    }
+    hpx::wait_all(futures);
+
+    HPX_TEST_EQ(first, second);
+    HPX_TEST_EQ(first, number_of_threads * number_of_iterations / 10);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_multiple_readers();
+    test_try_lock();
+    test_readers_and_writers();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=" +
+        std::to_string(hpx::threads::hardware_concurrency()));
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
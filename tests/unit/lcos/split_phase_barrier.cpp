@@ -0,0 +1,108 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// count the arrivals at the barrier on the root locality
+boost::atomic<std::size_t> arrivals(0);
+
+void arrive()
+{
+    ++arrivals;
+}
+HPX_PLAIN_ACTION(arrive);
+
+std::size_t get_arrivals()
+{
+    return arrivals.load();
+}
+HPX_PLAIN_ACTION(get_arrivals);
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    std::size_t num_localities = hpx::get_num_localities_sync();
+    hpx::id_type root = hpx::find_root_locality();
+
+    hpx::lcos::split_phase_barrier b("/test/split_phase_barrier/");
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        hpx::async<arrive_action>(root).get();
+
+        b.arrive();
+        HPX_TEST_EQ(b.generation(), i + 1);
+
+        // all localities must have arrived once the barrier is released
+        b.wait_async().get();
+        HPX_TEST(
+            hpx::async<get_arrivals_action>(root).get() >=
+                (i + 1) * num_localities);
+    }
+
+    // the blocking variant
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        hpx::async<arrive_action>(root).get();
+        b.wait();
+
+        HPX_TEST(
+            hpx::async<get_arrivals_action>(root).get() >=
+                (i + 11) * num_localities);
+    }
+
+    // number the sites in the reverse order of the localities
+    {
+        hpx::lcos::split_phase_barrier reversed(
+            "/test/split_phase_barrier_sites/", num_localities,
+            num_localities - 1 - hpx::get_locality_id());
+
+        for (std::size_t i = 0; i != 10; ++i)
+        {
+            hpx::async<arrive_action>(root).get();
+            reversed.wait();
+
+            HPX_TEST(
+                hpx::async<get_arrivals_action>(root).get() >=
+                    (i + 21) * num_localities);
+        }
+    }
+
+    // the site number has to be smaller than the number of sites
+    {
+        bool caught_exception = false;
+        try {
+            hpx::lcos::split_phase_barrier invalid(
+                "/test/split_phase_barrier_invalid/", num_localities,
+                num_localities);
+        }
+        catch (hpx::exception const& e) {
+            HPX_TEST_EQ(e.get_error(), hpx::bad_parameter);
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.run_hpx_main!=1");
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
@@ -114,6 +114,23 @@ void test_persistent_auto_chunk_size()
     }
 }
 
+void test_adaptive_chunk_size()
+{
+    {
+        hpx::parallel::adaptive_chunk_size acs;
+        chunk_size_test(acs);
+
+        // the measurements of the first runs are reused
+        chunk_size_test(acs);
+    }
+
+    {
+        hpx::parallel::adaptive_chunk_size acs(
+            boost::chrono::microseconds(10), boost::chrono::microseconds(20));
+        chunk_size_test(acs);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -129,6 +146,7 @@ int hpx_main(boost::program_options::variables_map& vm)
     test_guided_chunk_size();
     test_auto_chunk_size();
     test_persistent_auto_chunk_size();
+    test_adaptive_chunk_size();
 
     return hpx::finalize();
 }
@@ -0,0 +1,151 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/parallel/executors/named_pool_executors.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <boost/range/functions.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::thread::id test() { return hpx::this_thread::get_id(); }
+
+template <typename Executor>
+void test_sync(Executor& exec)
+{
+    typedef hpx::parallel::executor_traits<Executor> traits;
+
+    HPX_TEST(traits::execute(exec, &test) != hpx::this_thread::get_id());
+}
+
+template <typename Executor>
+void test_async(Executor& exec)
+{
+    typedef hpx::parallel::executor_traits<Executor> traits;
+
+    HPX_TEST(
+        traits::async_execute(exec, &test).get() !=
+        hpx::this_thread::get_id());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void bulk_test(hpx::thread::id tid, int value)
+{
+    HPX_TEST(tid != hpx::this_thread::get_id());
+}
+
+template <typename Executor>
+void test_bulk_async(Executor& exec)
+{
+    typedef hpx::parallel::executor_traits<Executor> traits;
+
+    hpx::thread::id tid = hpx::this_thread::get_id();
+
+    std::vector<int> v(107);
+    std::iota(boost::begin(v), boost::end(v), std::rand());
+
+    using hpx::util::placeholders::_1;
+    hpx::when_all(traits::async_execute(
+        exec, hpx::util::bind(&bulk_test, tid, _1), v)).get();
+}
+
+template <typename Executor>
+void test_named_pool_executor(Executor& exec)
+{
+    test_sync(exec);
+    test_async(exec);
+    test_bulk_async(exec);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t query_counter(std::string const& name)
+{
+    hpx::performance_counters::performance_counter counter(name);
+    return counter.get_value_sync<std::size_t>();
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    using hpx::threads::executors::create_named_pool;
+    using hpx::threads::executors::has_named_pool;
+
+    // the pool configured on the command line below
+    HPX_TEST(has_named_pool("network"));
+    {
+        hpx::parallel::named_pool_executor exec("network");
+        test_named_pool_executor(exec);
+
+        HPX_TEST_EQ(query_counter(
+            "/threads{locality#0/pool#network/total}"
+                "/count/active-processing-units"), std::size_t(1));
+    }
+
+    // pools can be created at runtime as well
+    create_named_pool("compute", "local-priority", 2);
+    HPX_TEST(has_named_pool("compute"));
+    {
+        hpx::parallel::named_pool_executor exec("compute");
+        test_named_pool_executor(exec);
+
+        HPX_TEST_EQ(query_counter(
+            "/threads{locality#0/pool#compute/total}"
+                "/count/active-processing-units"), std::size_t(2));
+        HPX_TEST_EQ(query_counter(
+            "/threads{locality#0/pool#compute/worker-thread#1}"
+                "/count/active-processing-units"), std::size_t(1));
+    }
+
+    // all executors referring to the same pool share it
+    {
+        hpx::parallel::named_pool_executor exec1("compute");
+        hpx::parallel::named_pool_executor exec2("compute");
+        HPX_TEST_EQ(hpx::get_os_thread_count(exec1), std::size_t(2));
+        HPX_TEST_EQ(hpx::get_os_thread_count(exec2), std::size_t(2));
+    }
+
+    // pool names are unique
+    {
+        hpx::error_code ec(hpx::lightweight);
+        create_named_pool("compute", "local", 1, "", ec);
+        HPX_TEST(ec);
+    }
+
+    // unknown pools are reported
+    {
+        bool caught_exception = false;
+        try {
+            hpx::parallel::named_pool_executor exec("unknown");
+        }
+        catch (hpx::exception const&) {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on one core (the pools create more
+    // threads)
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=1");
+    cfg.push_back("hpx.threadpools.network.scheduler=local-priority");
+    cfg.push_back("hpx.threadpools.network.threads=1");
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
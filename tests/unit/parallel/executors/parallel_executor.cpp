@@ -77,12 +77,37 @@ void test_bulk_async()
         exec, hpx::util::bind(&bulk_test, tid, _1), v)).get();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+int bulk_test_result(int value)
+{
+    return value;
+}
+
+void test_bulk_async_result()
+{
+    typedef hpx::parallel::parallel_executor executor;
+    typedef hpx::parallel::executor_traits<executor> traits;
+
+    std::vector<int> v(1007);
+    std::iota(boost::begin(v), boost::end(v), std::rand());
+
+    executor exec;
+    std::vector<hpx::future<int> > results =
+        traits::async_execute(exec, &bulk_test_result, v);
+
+    // the results are ordered as the elements of the shape
+    HPX_TEST_EQ(results.size(), v.size());
+    for (std::size_t i = 0; i != v.size(); ++i)
+        HPX_TEST_EQ(results[i].get(), v[i]);
+}
+
 int hpx_main(int argc, char* argv[])
 {
     test_sync();
     test_async();
     test_bulk_sync();
     test_bulk_async();
+    test_bulk_async_result();
 
     return hpx::finalize();
 }
@@ -217,6 +217,11 @@ int hpx_main(boost::program_options::variables_map& vm)
     print_counters("/parcels/count/*/sent");
     print_counters("/messages/count/*/sent");
 
+    // print the coalescing parameters used for the actions
+    print_counters("/coalescing/count/batch-size@*");
+    print_counters("/coalescing/time/flush-timeout@*");
+    print_counters("/coalescing/time/average-parcel-latency@*");
+
     return hpx::finalize();
 }
 
@@ -37,6 +37,36 @@ void test_shared()
     HPX_TEST_EQ(*op2, *ip);
 }
 
+void test_shared_reset_tracking()
+{
+    boost::shared_ptr<int> ip(new int(7));
+    boost::shared_ptr<int> op1;
+    boost::shared_ptr<int> op2;
+    {
+        std::vector<char> buffer;
+        std::size_t pos = 0;
+        {
+            hpx::serialization::output_archive oarchive(buffer);
+            oarchive << ip;
+
+            // the second pointer has to be readable on its own
+            oarchive.reset_pointer_tracker();
+            pos = oarchive.current_pos();
+            oarchive << ip;
+        }
+
+        hpx::serialization::input_archive iarchive1(buffer);
+        iarchive1.set_position(pos);
+        iarchive1 >> op2;
+
+        hpx::serialization::input_archive iarchive2(buffer);
+        iarchive2 >> op1;
+    }
+    HPX_TEST_NEQ(op1.get(), op2.get());
+    HPX_TEST_EQ(*op1, *ip);
+    HPX_TEST_EQ(*op2, *ip);
+}
+
 void test_unique()
 {
     std::unique_ptr<int> ip(new int(7));
@@ -114,6 +144,7 @@ void test_intrusive()
 int main()
 {
     test_shared();
+    test_shared_reset_tracking();
     test_unique();
     test_intrusive();
 
@@ -0,0 +1,110 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The worker threads of a named pool use the same (pool local) worker
+// numbers as the worker threads of the main pool. This test schedules work
+// and resumes suspended threads across both pools, which must not make the
+// workers of one pool act as the owners of the Chase-Lev deques of the
+// other pool.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/parallel/executors/named_pool_executors.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_tasks = 10000;
+
+std::vector<boost::atomic<boost::uint32_t> > executed(2 * num_tasks);
+
+void run_task(std::size_t i)
+{
+    ++executed[i];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// runs on the named pool, creates work on the main pool
+void spawn_on_main_pool(std::size_t first, std::size_t last)
+{
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(last - first);
+
+    for (std::size_t i = first; i != last; ++i)
+        tasks.push_back(hpx::async(&run_task, i));
+
+    hpx::wait_all(tasks);
+}
+
+// runs on the main pool, creates work on the named pool and waits for it,
+// which makes the named pool resume the threads of the main pool
+void spawn_on_named_pool(std::size_t first, std::size_t last)
+{
+    hpx::parallel::named_pool_executor exec("other");
+    typedef hpx::parallel::executor_traits<
+            hpx::parallel::named_pool_executor
+        > traits;
+
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(last - first);
+
+    for (std::size_t i = first; i != last; ++i)
+        tasks.push_back(traits::async_execute(exec,
+            hpx::util::bind(&run_task, i)));
+
+    hpx::wait_all(tasks);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    for (boost::atomic<boost::uint32_t>& e : executed)
+        e.store(0);
+
+    hpx::parallel::named_pool_executor exec("other");
+    typedef hpx::parallel::executor_traits<
+            hpx::parallel::named_pool_executor
+        > traits;
+
+    std::size_t const chunk = 100;
+
+    std::vector<hpx::future<void> > tasks;
+    for (std::size_t i = 0; i < num_tasks; i += chunk)
+    {
+        tasks.push_back(traits::async_execute(exec,
+            hpx::util::bind(&spawn_on_main_pool, i, i + chunk)));
+        tasks.push_back(hpx::async(&spawn_on_named_pool,
+            num_tasks + i, num_tasks + i + chunk));
+    }
+    hpx::wait_all(tasks);
+
+    // every task has to run exactly once
+    for (std::size_t i = 0; i != executed.size(); ++i)
+        HPX_TEST_EQ(executed[i].load(), 1u);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // both pools use the same worker numbers
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=2");
+    cfg.push_back("hpx.scheduler=chase-lev-priority");
+    cfg.push_back("hpx.threadpools.other.scheduler=chase-lev-priority");
+    cfg.push_back("hpx.threadpools.other.threads=2");
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
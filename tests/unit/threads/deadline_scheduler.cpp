@@ -0,0 +1,90 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The deadline scheduler has to run HPX-threads in the order of their
+// deadlines (earliest deadline first), HPX-threads without a deadline run
+// after all others in FIFO order. This test uses a single worker thread,
+// which is busy scheduling the work until all of it is queued.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/chrono/chrono.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_tasks = 100;
+std::size_t const num_tasks_without_deadline = 10;
+
+hpx::lcos::local::spinlock mtx;
+std::vector<std::size_t> order;
+
+void run_task(std::size_t i)
+{
+    std::lock_guard<hpx::lcos::local::spinlock> l(mtx);
+    order.push_back(i);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    // assign the deadlines in random order, task i has the i-th earliest
+    // deadline
+    std::vector<std::size_t> tasks(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+        tasks[i] = i;
+
+    std::mt19937 gen(42);
+    std::shuffle(tasks.begin(), tasks.end(), gen);
+
+    // keep all deadlines well in the future to avoid deadline misses
+    boost::chrono::steady_clock::time_point base =
+        boost::chrono::steady_clock::now() + boost::chrono::hours(1);
+
+    std::vector<hpx::future<void> > results;
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        // interleave HPX-threads without deadline
+        if (i % (num_tasks / num_tasks_without_deadline) == 0)
+        {
+            results.push_back(hpx::async(&run_task,
+                num_tasks + i / (num_tasks / num_tasks_without_deadline)));
+        }
+
+        hpx::threads::executors::deadline_executor exec(
+            base + boost::chrono::milliseconds(tasks[i]));
+        results.push_back(hpx::async(exec, &run_task, tasks[i]));
+    }
+
+    hpx::wait_all(results);
+
+    HPX_TEST_EQ(order.size(), num_tasks + num_tasks_without_deadline);
+    for (std::size_t i = 0; i != order.size(); ++i)
+        HPX_TEST_EQ(order[i], i);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // a single worker thread makes the execution order deterministic
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=1");
+    cfg.push_back("hpx.scheduler=deadline");
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,104 @@
+// Copyright (C) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/threadmanager.hpp>
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#define NUM_NOSTACK_TESTS 1000
+
+///////////////////////////////////////////////////////////////////////////////
+int test_nostack(int i)
+{
+    // the thread runs on the stack of the worker thread but still is a
+    // HPX-thread
+    HPX_TEST(hpx::threads::get_self_ptr());
+    HPX_TEST(hpx::threads::get_self().is_stackless());
+
+    hpx::threads::thread_id_type id = hpx::threads::get_self_id();
+    HPX_TEST(id != hpx::threads::invalid_thread_id);
+    HPX_TEST_EQ(hpx::threads::get_stack_size(id),
+        hpx::threads::nostack_stack_size);
+
+#if defined(HPX_HAVE_THREAD_LOCAL_STORAGE)
+    // thread data is stored with the thread object
+    HPX_TEST_EQ(hpx::threads::get_thread_data(id), std::size_t(0));
+    hpx::threads::set_thread_data(id, std::size_t(i + 1));
+    HPX_TEST_EQ(hpx::threads::get_thread_data(id), std::size_t(i + 1));
+#endif
+
+    return i;
+}
+
+void test_nostack_suspend()
+{
+    // stackless threads can't be suspended
+    bool caught_exception = false;
+    try {
+        hpx::this_thread::suspend(hpx::threads::suspended);
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    // the same when using an error_code
+    hpx::error_code ec(hpx::lightweight);
+    hpx::this_thread::suspend(hpx::threads::suspended, "test", ec);
+    HPX_TEST(ec);
+
+    // yielding would require giving up control as well
+    caught_exception = false;
+    try {
+        hpx::this_thread::suspend(hpx::threads::pending);
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+int hpx_main()
+{
+    hpx::threads::executors::default_executor exec(
+        hpx::threads::thread_stacksize_nostack);
+
+    {
+        std::vector<hpx::future<int> > results;
+        results.reserve(NUM_NOSTACK_TESTS);
+
+        for (int i = 0; i != NUM_NOSTACK_TESTS; ++i)
+            results.push_back(hpx::async(exec, &test_nostack, i));
+
+        for (int i = 0; i != NUM_NOSTACK_TESTS; ++i)
+            HPX_TEST_EQ(results[i].get(), i);
+    }
+
+    hpx::async(exec, &test_nostack_suspend).get();
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=" +
+        std::to_string(hpx::threads::hardware_concurrency()));
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,84 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// A stackless thread can't suspend, neither to wait for a lock nor to back
+// off while spinning on it. This test uses a single worker thread: the owner
+// of the contended lock is a pending HPX-thread which can run only after the
+// stackless thread has given up, so acquiring the lock has to fail instead
+// of spinning forever.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/register_locks.hpp>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Mutex>
+bool lock_from_stackless_thread(Mutex& mtx)
+{
+    try {
+        std::lock_guard<Mutex> l(mtx);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        return false;
+    }
+    return true;
+}
+
+template <typename Mutex>
+void test_contended_lock()
+{
+    hpx::threads::executors::default_executor exec(
+        hpx::threads::thread_stacksize_nostack);
+
+    Mutex mtx;
+    {
+        std::unique_lock<Mutex> l(mtx);
+
+        hpx::future<bool> f = hpx::async(exec,
+            &lock_from_stackless_thread<Mutex>, std::ref(mtx));
+
+        // let the stackless thread run while the lock is being held
+        {
+            hpx::util::ignore_while_checking<std::unique_lock<Mutex> > il(&l);
+            while (!f.is_ready())
+                hpx::this_thread::yield();
+        }
+
+        HPX_TEST(!f.get());
+    }
+
+    // the lock has to be usable after the failed attempt
+    HPX_TEST(hpx::async(exec,
+        &lock_from_stackless_thread<Mutex>, std::ref(mtx)).get());
+}
+
+int hpx_main()
+{
+    test_contended_lock<hpx::lcos::local::mutex>();
+    test_contended_lock<hpx::lcos::local::spinlock>();
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // the owner of the lock and the stackless thread share the worker thread
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=1");
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,97 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Work created through register_work (which is how actions and parcels are
+// scheduled) has to wake up parked worker threads. This test lets all worker
+// threads park, creates work from an external OS-thread, and verifies that
+// the work starts running long before hpx.max_park_time has elapsed.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/runtime/threads/policies/scheduler_mode.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+boost::uint64_t const max_park_time = 10000;            // [ms]
+boost::uint64_t const max_latency = 1000000000;         // [ns]
+
+boost::atomic<boost::uint64_t> submitted(0);
+boost::atomic<boost::uint64_t> started(0);
+
+void run_task(hpx::lcos::local::promise<void>& p)
+{
+    started.store(hpx::util::high_resolution_clock::now());
+    p.set_value();
+}
+
+// runs on an external OS-thread
+void submit_task(hpx::runtime* rt, hpx::lcos::local::promise<void>& p)
+{
+    // give all worker threads enough time to run out of work and to park
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    rt->register_thread("thread_park");
+
+    submitted.store(hpx::util::high_resolution_clock::now());
+    hpx::threads::register_work_nullary(
+        hpx::util::bind(&run_task, std::ref(p)), "thread_park");
+
+    rt->unregister_thread();
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    using namespace hpx::threads::policies;
+
+    // The first worker thread is never parked while it does the background
+    // work of the parcel layer, this test doesn't need any.
+    hpx::threads::set_scheduler_mode(
+        scheduler_mode(reduce_thread_priority | delay_exit));
+
+    {
+        hpx::lcos::local::promise<void> p;
+        hpx::future<void> f = p.get_future();
+
+        std::thread t(&submit_task, hpx::get_runtime_ptr(), std::ref(p));
+
+        // suspending this thread leaves all worker threads without work
+        f.get();
+        t.join();
+    }
+
+    HPX_TEST_LT(started.load() - submitted.load(), max_latency);
+
+    hpx::threads::set_scheduler_mode(scheduler_mode(
+        do_background_work | reduce_thread_priority | delay_exit));
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // without being woken up, a parked worker thread would pick up the new
+    // work only after max_park_time
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=2");
+    cfg.push_back("hpx.idle_policy=park");
+    cfg.push_back("hpx.max_park_time=" + std::to_string(max_park_time));
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
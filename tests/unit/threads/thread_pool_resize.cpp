@@ -0,0 +1,114 @@
+// Copyright (C) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threadmanager.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+#include <vector>
+
+#define NUM_TASKS 1000
+
+///////////////////////////////////////////////////////////////////////////////
+int test_task(int i)
+{
+    hpx::this_thread::yield();
+    return i;
+}
+
+void run_tasks()
+{
+    std::vector<hpx::future<int> > results;
+    results.reserve(NUM_TASKS);
+
+    for (int i = 0; i != NUM_TASKS; ++i)
+        results.push_back(hpx::async(&test_task, i));
+
+    for (int i = 0; i != NUM_TASKS; ++i)
+        HPX_TEST_EQ(results[i].get(), i);
+}
+
+std::size_t count_active_workers()
+{
+    hpx::performance_counters::performance_counter active(
+        "/threads{locality#0/total}/count/active-processing-units");
+    return active.get_value_sync<std::size_t>();
+}
+
+int hpx_main()
+{
+    hpx::threads::threadmanager_base& tm =
+        hpx::get_runtime().get_thread_manager();
+
+    std::size_t num_threads = hpx::get_os_thread_count();
+    HPX_TEST(num_threads >= 2);
+
+    std::size_t active = count_active_workers();
+    HPX_TEST_EQ(active, num_threads);
+
+    // queue some work before removing the worker thread
+    std::vector<hpx::future<int> > results;
+    results.reserve(NUM_TASKS);
+    for (int i = 0; i != NUM_TASKS; ++i)
+        results.push_back(hpx::async(&test_task, i));
+
+    // remove a worker thread not running this HPX-thread
+    std::size_t self = hpx::get_worker_thread_num();
+    std::size_t victim = (self + 1) % num_threads;
+    std::size_t pu_num = tm.get_pu_num(victim);
+
+    tm.remove_processing_unit(victim);
+    HPX_TEST_EQ(count_active_workers(), active - 1);
+
+    // the work of the removed worker thread is executed by the other ones
+    for (int i = 0; i != NUM_TASKS; ++i)
+        HPX_TEST_EQ(results[i].get(), i);
+
+    run_tasks();
+
+    // a removed worker thread can't be removed again
+    {
+        hpx::error_code ec(hpx::lightweight);
+        tm.remove_processing_unit(victim, ec);
+        HPX_TEST(ec);
+    }
+
+    // a worker thread can't remove itself
+    {
+        hpx::error_code ec(hpx::lightweight);
+        tm.remove_processing_unit(hpx::get_worker_thread_num(), ec);
+        HPX_TEST(ec);
+    }
+
+    // bring the worker thread back on its original processing unit
+    tm.add_processing_unit(victim, pu_num);
+    HPX_TEST_EQ(count_active_workers(), active);
+    HPX_TEST_EQ(tm.get_pu_num(victim), pu_num);
+
+    // a running worker thread can't be added again
+    {
+        hpx::error_code ec(hpx::lightweight);
+        tm.add_processing_unit(victim, pu_num, ec);
+        HPX_TEST(ec);
+    }
+
+    run_tasks();
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=4");
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}